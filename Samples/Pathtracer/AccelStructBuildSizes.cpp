@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "AccelStructBuildSizes.h"
+
+#include <nvrhi/d3d12.h>
+#include <nvrhi/vulkan.h>
+
+#include <d3d12.h>
+
+#include <algorithm>
+#include <vector>
+
+// Build and geometry flags of NVRHI share their values with both APIs, PerformUpdate and the NVRHI specific flags are dropped
+static const uint32_t c_BuildFlagMask = uint32_t(nvrhi::rt::AccelStructBuildFlags::AllowUpdate) | uint32_t(nvrhi::rt::AccelStructBuildFlags::AllowCompaction) |
+                                        uint32_t(nvrhi::rt::AccelStructBuildFlags::PreferFastTrace) | uint32_t(nvrhi::rt::AccelStructBuildFlags::PreferFastBuild) |
+                                        uint32_t(nvrhi::rt::AccelStructBuildFlags::MinimizeMemory);
+
+static uint64_t GetBufferAddress(nvrhi::IBuffer* buffer, uint64_t offset)
+{
+    return buffer ? buffer->getGpuVirtualAddress() + offset : 0;
+}
+
+static uint32_t GetTriangleNum(const nvrhi::rt::GeometryTriangles& triangles)
+{
+    return (triangles.indexBuffer ? triangles.indexCount : triangles.vertexCount) / 3;
+}
+
+static AccelStructBuildSizes GetBuildSizesD3D12(nvrhi::IDevice* device, const nvrhi::rt::AccelStructDesc& desc)
+{
+    nvrhi::RefCountPtr<ID3D12Device5> device5;
+    ID3D12Device* nativeDevice = device->getNativeObject(nvrhi::ObjectTypes::D3D12_Device);
+    if (!nativeDevice || FAILED(nativeDevice->QueryInterface(IID_PPV_ARGS(&device5))))
+        return AccelStructBuildSizes();
+
+    D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS inputs = {};
+    inputs.DescsLayout = D3D12_ELEMENTS_LAYOUT_ARRAY;
+    inputs.Flags = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAGS(uint32_t(desc.buildFlags) & c_BuildFlagMask);
+
+    std::vector<D3D12_RAYTRACING_GEOMETRY_DESC> geometryDescs;
+    if (desc.isTopLevel)
+    {
+        inputs.Type = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL;
+        inputs.NumDescs = UINT(desc.topLevelMaxInstances);
+    }
+    else
+    {
+        for (const nvrhi::rt::GeometryDesc& geometry : desc.bottomLevelGeometries)
+        {
+            D3D12_RAYTRACING_GEOMETRY_DESC geometryDesc = {};
+            geometryDesc.Flags = D3D12_RAYTRACING_GEOMETRY_FLAGS(uint32_t(geometry.flags));
+
+            if (geometry.geometryType == nvrhi::rt::GeometryType::Triangles)
+            {
+                const nvrhi::rt::GeometryTriangles& triangles = geometry.geometryData.triangles;
+                geometryDesc.Type = D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES;
+                geometryDesc.Triangles.IndexFormat = triangles.indexBuffer ? nvrhi::d3d12::convertFormat(triangles.indexFormat) : DXGI_FORMAT_UNKNOWN;
+                geometryDesc.Triangles.IndexCount = triangles.indexBuffer ? triangles.indexCount : 0;
+                geometryDesc.Triangles.IndexBuffer = GetBufferAddress(triangles.indexBuffer, triangles.indexOffset);
+                geometryDesc.Triangles.VertexFormat = nvrhi::d3d12::convertFormat(triangles.vertexFormat);
+                geometryDesc.Triangles.VertexCount = triangles.vertexCount;
+                geometryDesc.Triangles.VertexBuffer.StartAddress = GetBufferAddress(triangles.vertexBuffer, triangles.vertexOffset);
+                geometryDesc.Triangles.VertexBuffer.StrideInBytes = triangles.vertexStride;
+            }
+            else
+            {
+                const nvrhi::rt::GeometryAABBs& aabbs = geometry.geometryData.aabbs;
+                geometryDesc.Type = D3D12_RAYTRACING_GEOMETRY_TYPE_PROCEDURAL_PRIMITIVE_AABBS;
+                geometryDesc.AABBs.AABBCount = aabbs.count;
+                geometryDesc.AABBs.AABBs.StartAddress = GetBufferAddress(aabbs.buffer, aabbs.offset);
+                geometryDesc.AABBs.AABBs.StrideInBytes = aabbs.stride;
+            }
+
+            geometryDescs.push_back(geometryDesc);
+        }
+
+        inputs.Type = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL;
+        inputs.NumDescs = UINT(geometryDescs.size());
+        inputs.pGeometryDescs = geometryDescs.data();
+    }
+
+    D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO prebuildInfo = {};
+    device5->GetRaytracingAccelerationStructurePrebuildInfo(&inputs, &prebuildInfo);
+
+    AccelStructBuildSizes sizes;
+    sizes.resultSize = prebuildInfo.ResultDataMaxSizeInBytes;
+    sizes.buildScratchSize = prebuildInfo.ScratchDataSizeInBytes;
+    sizes.updateScratchSize = prebuildInfo.UpdateScratchDataSizeInBytes;
+
+    return sizes;
+}
+
+static AccelStructBuildSizes GetBuildSizesVulkan(nvrhi::IDevice* device, const nvrhi::rt::AccelStructDesc& desc)
+{
+    VkDevice nativeDevice = device->getNativeObject(nvrhi::ObjectTypes::VK_Device);
+    if (!nativeDevice)
+        return AccelStructBuildSizes();
+
+    std::vector<vk::AccelerationStructureGeometryKHR> geometries;
+    std::vector<uint32_t> primitiveNums;
+    if (desc.isTopLevel)
+    {
+        vk::AccelerationStructureGeometryInstancesDataKHR instances;
+        instances.setArrayOfPointers(false);
+
+        geometries.push_back(vk::AccelerationStructureGeometryKHR().setGeometryType(vk::GeometryTypeKHR::eInstances).setGeometry(instances));
+        primitiveNums.push_back(uint32_t(desc.topLevelMaxInstances));
+    }
+    else
+    {
+        for (const nvrhi::rt::GeometryDesc& geometry : desc.bottomLevelGeometries)
+        {
+            vk::AccelerationStructureGeometryKHR geometryDesc;
+            geometryDesc.setFlags(vk::GeometryFlagsKHR(uint32_t(geometry.flags)));
+
+            if (geometry.geometryType == nvrhi::rt::GeometryType::Triangles)
+            {
+                const nvrhi::rt::GeometryTriangles& triangles = geometry.geometryData.triangles;
+
+                // Only the presence of a transform is checked, through its host address
+                vk::AccelerationStructureGeometryTrianglesDataKHR trianglesData;
+                trianglesData.setVertexFormat(vk::Format(nvrhi::vulkan::convertFormat(triangles.vertexFormat)))
+                    .setVertexData(GetBufferAddress(triangles.vertexBuffer, triangles.vertexOffset))
+                    .setVertexStride(triangles.vertexStride)
+                    .setMaxVertex(std::max(triangles.vertexCount, 1u) - 1)
+                    .setIndexType(!triangles.indexBuffer                            ? vk::IndexType::eNoneKHR
+                                  : triangles.indexFormat == nvrhi::Format::R16_UINT ? vk::IndexType::eUint16
+                                                                                     : vk::IndexType::eUint32)
+                    .setIndexData(GetBufferAddress(triangles.indexBuffer, triangles.indexOffset))
+                    .setTransformData(vk::DeviceOrHostAddressConstKHR().setHostAddress(geometry.useTransform ? geometry.transform : nullptr));
+
+                geometryDesc.setGeometryType(vk::GeometryTypeKHR::eTriangles).setGeometry(trianglesData);
+                primitiveNums.push_back(GetTriangleNum(triangles));
+            }
+            else
+            {
+                const nvrhi::rt::GeometryAABBs& aabbs = geometry.geometryData.aabbs;
+
+                vk::AccelerationStructureGeometryAabbsDataKHR aabbsData;
+                aabbsData.setData(GetBufferAddress(aabbs.buffer, aabbs.offset)).setStride(aabbs.stride);
+
+                geometryDesc.setGeometryType(vk::GeometryTypeKHR::eAabbs).setGeometry(aabbsData);
+                primitiveNums.push_back(aabbs.count);
+            }
+
+            geometries.push_back(geometryDesc);
+        }
+    }
+
+    vk::AccelerationStructureBuildGeometryInfoKHR buildInfo;
+    buildInfo.setType(desc.isTopLevel ? vk::AccelerationStructureTypeKHR::eTopLevel : vk::AccelerationStructureTypeKHR::eBottomLevel)
+        .setMode(vk::BuildAccelerationStructureModeKHR::eBuild)
+        .setFlags(vk::BuildAccelerationStructureFlagsKHR(uint32_t(desc.buildFlags) & c_BuildFlagMask))
+        .setGeometries(geometries);
+
+    const vk::AccelerationStructureBuildSizesInfoKHR buildSizes =
+        vk::Device(nativeDevice).getAccelerationStructureBuildSizesKHR(vk::AccelerationStructureBuildTypeKHR::eDevice, buildInfo, primitiveNums);
+
+    AccelStructBuildSizes sizes;
+    sizes.resultSize = buildSizes.accelerationStructureSize;
+    sizes.buildScratchSize = buildSizes.buildScratchSize;
+    sizes.updateScratchSize = buildSizes.updateScratchSize;
+
+    return sizes;
+}
+
+AccelStructBuildSizes GetAccelStructBuildSizes(nvrhi::IDevice* device, const nvrhi::rt::AccelStructDesc& desc)
+{
+    switch (device->getGraphicsAPI())
+    {
+    case nvrhi::GraphicsAPI::D3D12:
+        return GetBuildSizesD3D12(device, desc);
+    case nvrhi::GraphicsAPI::VULKAN:
+        return GetBuildSizesVulkan(device, desc);
+    default:
+        return AccelStructBuildSizes();
+    }
+}
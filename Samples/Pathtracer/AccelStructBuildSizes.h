@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <nvrhi/nvrhi.h>
+
+// Memory requirements of an acceleration structure build as reported by the driver. NVRHI queries them when it records a build
+// but doesn't expose them, so the same query is made through the native device. Only counts, formats and flags of the descriptor
+// change the result. Returns zero sizes if the graphics API doesn't support the query
+struct AccelStructBuildSizes
+{
+    uint64_t resultSize = 0;
+    uint64_t buildScratchSize = 0;
+    uint64_t updateScratchSize = 0;
+};
+
+// Thread safe, both APIs allow the query on any thread
+AccelStructBuildSizes GetAccelStructBuildSizes(nvrhi::IDevice* device, const nvrhi::rt::AccelStructDesc& desc);
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "CachedScene.h"
+
+#include <donut/core/log.h>
+#include <donut/engine/SceneGraph.h>
+#include <donut/engine/TextureCache.h>
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "SceneCache.h"
+
+using namespace donut;
+using namespace donut::math;
+using namespace donut::engine;
+
+static_assert(sizeof(float3) == sizeof(float) * 3 && sizeof(float2) == sizeof(float) * 2, "Cache sections are copied as they are");
+
+// Cache transforms are row major 3x4 matrices applied to column vectors, Donut applies the transposed matrix to row vectors
+static void SetNodeTransform(SceneGraphNode& node, const float transform[12])
+{
+    const daffine3 affine(
+        double3x3(transform[0], transform[4], transform[8], transform[1], transform[5], transform[9], transform[2], transform[6], transform[10]),
+        double3(transform[3], transform[7], transform[11]));
+
+    double3 translation, scaling;
+    dquat rotation;
+    decomposeAffine<double>(affine, &translation, &rotation, &scaling);
+    node.SetTransform(&translation, &rotation, &scaling);
+}
+
+static MaterialDomain GetMaterialDomain(uint32_t flags)
+{
+    if (flags & SceneCacheMaterialFlags_AlphaBlended)
+        return MaterialDomain::AlphaBlended;
+    if (flags & SceneCacheMaterialFlags_AlphaTested)
+        return MaterialDomain::AlphaTested;
+
+    return MaterialDomain::Opaque;
+}
+
+static std::shared_ptr<Light> CreateLight(const SceneCacheLight& cacheLight)
+{
+    switch (SceneCacheLightType(cacheLight.type))
+    {
+    case SceneCacheLightType::Directional: {
+        auto light = std::make_shared<DirectionalLight>();
+        light->irradiance = cacheLight.intensity;
+        light->angularSize = cacheLight.angularSize;
+        return light;
+    }
+    case SceneCacheLightType::Point: {
+        auto light = std::make_shared<PointLight>();
+        light->intensity = cacheLight.intensity;
+        light->radius = cacheLight.radius;
+        light->range = cacheLight.range;
+        return light;
+    }
+    case SceneCacheLightType::Spot: {
+        auto light = std::make_shared<SpotLight>();
+        light->intensity = cacheLight.intensity;
+        light->radius = cacheLight.radius;
+        light->range = cacheLight.range;
+        light->innerAngle = cacheLight.innerAngle;
+        light->outerAngle = cacheLight.outerAngle;
+        return light;
+    }
+    default:
+        return nullptr;
+    }
+}
+
+CachedScene::CachedScene(nvrhi::IDevice* device, ShaderFactory& shaderFactory, std::shared_ptr<vfs::IFileSystem> fs, std::shared_ptr<TextureCache> textureCache,
+    std::shared_ptr<DescriptorTableManager> descriptorTable)
+    : Scene(device, shaderFactory, fs, textureCache, descriptorTable, nullptr)
+    , m_textureCache(textureCache)
+{
+}
+
+bool CachedScene::LoadCache(const std::filesystem::path& cachePath)
+{
+    if (!std::filesystem::exists(cachePath))
+        return false;
+
+    SceneCacheReader reader;
+    if (!reader.Open(cachePath))
+    {
+        log::warning("Scene cache '%s' is invalid", cachePath.string().c_str());
+        return false;
+    }
+
+    if (reader.GetFlags() & SceneCacheFlags_Partial)
+    {
+        log::info("Scene cache '%s' doesn't hold the whole scene", cachePath.string().c_str());
+        return false;
+    }
+
+    const std::filesystem::path cacheDirectory = cachePath.parent_path();
+    if (!reader.IsCurrent(cacheDirectory))
+    {
+        log::info("Scene cache '%s' is older than its sources", cachePath.string().c_str());
+        return false;
+    }
+
+    uint32_t positionNum, normalNum, texCoordNum, indexNum, geometryNum, meshNum, materialNum, instanceNum, lightNum, cameraNum;
+    const float* positions = reader.GetSection<float>(SceneCacheSection::Positions, positionNum);
+    const float* normals = reader.GetSection<float>(SceneCacheSection::Normals, normalNum);
+    const float* texCoords = reader.GetSection<float>(SceneCacheSection::TexCoords, texCoordNum);
+    const uint32_t* indices = reader.GetSection<uint32_t>(SceneCacheSection::Indices, indexNum);
+    const SceneCacheGeometry* geometries = reader.GetSection<SceneCacheGeometry>(SceneCacheSection::Geometries, geometryNum);
+    const SceneCacheMesh* meshes = reader.GetSection<SceneCacheMesh>(SceneCacheSection::Meshes, meshNum);
+    const SceneCacheMaterial* materials = reader.GetSection<SceneCacheMaterial>(SceneCacheSection::Materials, materialNum);
+    const SceneCacheInstance* instances = reader.GetSection<SceneCacheInstance>(SceneCacheSection::Instances, instanceNum);
+    const SceneCacheLight* lights = reader.GetSection<SceneCacheLight>(SceneCacheSection::Lights, lightNum);
+    const SceneCacheCamera* cameras = reader.GetSection<SceneCacheCamera>(SceneCacheSection::Cameras, cameraNum);
+
+    // The sections are copied as they are, only the normals are packed like the glTF importer does
+    auto buffers = std::make_shared<BufferGroup>();
+    buffers->indexData.assign(indices, indices + indexNum);
+    buffers->positionData.resize(positionNum / 3);
+    memcpy(buffers->positionData.data(), positions, buffers->positionData.size() * sizeof(float3));
+    buffers->texcoord1Data.resize(texCoordNum / 2);
+    memcpy(buffers->texcoord1Data.data(), texCoords, buffers->texcoord1Data.size() * sizeof(float2));
+    buffers->normalData.resize(normalNum / 3);
+    for (size_t vertexIndex = 0; vertexIndex < buffers->normalData.size(); ++vertexIndex)
+        buffers->normalData[vertexIndex] = vectorToSnorm8(float3(normals[vertexIndex * 3], normals[vertexIndex * 3 + 1], normals[vertexIndex * 3 + 2]));
+
+    // Textures are loaded on the loading thread and finished in SceneLoaded(), as for the glTF importer
+    auto loadTexture = [&](uint32_t path, bool sRGB) -> std::shared_ptr<LoadedTexture> {
+        const char* pathString = reader.GetString(path);
+        return *pathString ? m_textureCache->LoadTextureFromFileDeferred(cacheDirectory / pathString, sRGB) : nullptr;
+    };
+
+    std::vector<std::shared_ptr<Material>> sceneMaterials(materialNum);
+    for (uint32_t materialIndex = 0; materialIndex < materialNum; ++materialIndex)
+    {
+        const SceneCacheMaterial& cacheMaterial = materials[materialIndex];
+
+        auto material = std::make_shared<Material>();
+        material->name = reader.GetString(cacheMaterial.name);
+        material->materialID = int(materialIndex);
+        material->domain = GetMaterialDomain(cacheMaterial.flags);
+        material->doubleSided = (cacheMaterial.flags & SceneCacheMaterialFlags_DoubleSided) != 0;
+        material->baseOrDiffuseColor = float3(cacheMaterial.baseColor[0], cacheMaterial.baseColor[1], cacheMaterial.baseColor[2]);
+        material->opacity = cacheMaterial.baseColor[3];
+        material->emissiveColor = float3(cacheMaterial.emissiveColor[0], cacheMaterial.emissiveColor[1], cacheMaterial.emissiveColor[2]);
+        material->emissiveIntensity = 1.f;
+        material->roughness = cacheMaterial.roughness;
+        material->metalness = cacheMaterial.metalness;
+        material->alphaCutoff = cacheMaterial.alphaCutoff;
+        material->baseOrDiffuseTexture = loadTexture(cacheMaterial.baseColorTexture, true);
+        material->metalRoughOrSpecularTexture = loadTexture(cacheMaterial.metalRoughTexture, false);
+        material->normalTexture = loadTexture(cacheMaterial.normalTexture, false);
+        material->emissiveTexture = loadTexture(cacheMaterial.emissiveTexture, true);
+
+        sceneMaterials[materialIndex] = material;
+    }
+
+    // Geometries are addressed relative to the first geometry of their mesh, the reader has checked that none starts before it
+    std::vector<std::shared_ptr<MeshInfo>> sceneMeshes(meshNum);
+    for (uint32_t meshIndex = 0; meshIndex < meshNum; ++meshIndex)
+    {
+        const SceneCacheMesh& cacheMesh = meshes[meshIndex];
+        const SceneCacheGeometry& firstGeometry = geometries[cacheMesh.geometryOffset];
+
+        auto mesh = std::make_shared<MeshInfo>();
+        mesh->name = reader.GetString(cacheMesh.name);
+        mesh->buffers = buffers;
+        mesh->indexOffset = firstGeometry.indexOffset;
+        mesh->vertexOffset = firstGeometry.vertexOffset;
+        mesh->totalIndices = 0;
+        mesh->totalVertices = 0;
+        mesh->objectSpaceBounds = box3::empty();
+
+        for (uint32_t geometryIndex = cacheMesh.geometryOffset; geometryIndex < cacheMesh.geometryOffset + cacheMesh.geometryCount; ++geometryIndex)
+        {
+            const SceneCacheGeometry& cacheGeometry = geometries[geometryIndex];
+
+            auto geometry = std::make_shared<MeshGeometry>();
+            geometry->material = sceneMaterials[cacheGeometry.materialIndex];
+            geometry->indexOffsetInMesh = cacheGeometry.indexOffset - mesh->indexOffset;
+            geometry->vertexOffsetInMesh = cacheGeometry.vertexOffset - mesh->vertexOffset;
+            geometry->numIndices = cacheGeometry.indexCount;
+            geometry->numVertices = cacheGeometry.vertexCount;
+
+            geometry->objectSpaceBounds = box3::empty();
+            for (uint32_t vertexIndex = cacheGeometry.vertexOffset; vertexIndex < cacheGeometry.vertexOffset + cacheGeometry.vertexCount; ++vertexIndex)
+                geometry->objectSpaceBounds = geometry->objectSpaceBounds | buffers->positionData[vertexIndex];
+
+            mesh->objectSpaceBounds = mesh->objectSpaceBounds | geometry->objectSpaceBounds;
+            mesh->totalIndices = std::max(mesh->totalIndices, geometry->indexOffsetInMesh + geometry->numIndices);
+            mesh->totalVertices = std::max(mesh->totalVertices, geometry->vertexOffsetInMesh + geometry->numVertices);
+            mesh->geometries.push_back(geometry);
+        }
+
+        sceneMeshes[meshIndex] = mesh;
+    }
+
+    auto sceneGraph = std::make_shared<SceneGraph>();
+    auto rootNode = std::make_shared<SceneGraphNode>();
+    rootNode->SetName(cachePath.filename().string());
+    sceneGraph->SetRootNode(rootNode);
+
+    for (uint32_t instanceIndex = 0; instanceIndex < instanceNum; ++instanceIndex)
+    {
+        const std::shared_ptr<MeshInfo>& mesh = sceneMeshes[instances[instanceIndex].meshIndex];
+
+        auto node = std::make_shared<SceneGraphNode>();
+        node->SetName(mesh->name);
+        SetNodeTransform(*node, instances[instanceIndex].transform);
+        node->SetLeaf(std::make_shared<MeshInstance>(mesh));
+        sceneGraph->Attach(rootNode, node);
+    }
+
+    for (uint32_t lightIndex = 0; lightIndex < lightNum; ++lightIndex)
+    {
+        const SceneCacheLight& cacheLight = lights[lightIndex];
+
+        std::shared_ptr<Light> light = CreateLight(cacheLight);
+        light->color = float3(cacheLight.color[0], cacheLight.color[1], cacheLight.color[2]);
+
+        auto node = std::make_shared<SceneGraphNode>();
+        node->SetName(reader.GetString(cacheLight.name));
+        SetNodeTransform(*node, cacheLight.transform);
+        node->SetLeaf(light);
+        sceneGraph->Attach(rootNode, node);
+
+        // The direction is set on the attached node, like the scene description loader does
+        if (cacheLight.flags & SceneCacheLightFlags_HasDirection)
+            light->SetDirection(double3(cacheLight.direction[0], cacheLight.direction[1], cacheLight.direction[2]));
+    }
+
+    for (uint32_t cameraIndex = 0; cameraIndex < cameraNum; ++cameraIndex)
+    {
+        const SceneCacheCamera& cacheCamera = cameras[cameraIndex];
+
+        auto camera = std::make_shared<PerspectiveCamera>();
+        camera->verticalFov = cacheCamera.verticalFov;
+        camera->zNear = cacheCamera.zNear;
+
+        auto node = std::make_shared<SceneGraphNode>();
+        node->SetName(reader.GetString(cacheCamera.name));
+        SetNodeTransform(*node, cacheCamera.transform);
+        node->SetLeaf(camera);
+        sceneGraph->Attach(rootNode, node);
+    }
+
+    m_SceneGraph = sceneGraph;
+
+    log::info("Loaded scene cache '%s', %u meshes, %u instances", cachePath.string().c_str(), meshNum, instanceNum);
+
+    return true;
+}
+
+std::filesystem::path GetSceneCachePath(const std::filesystem::path& sceneFileName)
+{
+    std::filesystem::path cachePath = sceneFileName;
+    cachePath += ".scenecache";
+
+    return cachePath;
+}
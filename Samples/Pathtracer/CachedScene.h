@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <donut/engine/Scene.h>
+
+#include <filesystem>
+#include <memory>
+
+// Scene loaded from a compiled scene cache (SceneCache.h) instead of the scene description and its glTF models.
+// The cache file is mapped and its tables become the Donut meshes, materials, lights and cameras directly under the root
+// of a new scene graph. One buffer group holds the vertices and indices of all meshes. Scene::FinishedLoading() creates the
+// GPU resources as for a scene loaded from its description.
+
+class CachedScene : public donut::engine::Scene
+{
+public:
+    CachedScene(nvrhi::IDevice* device, donut::engine::ShaderFactory& shaderFactory, std::shared_ptr<donut::vfs::IFileSystem> fs,
+        std::shared_ptr<donut::engine::TextureCache> textureCache, std::shared_ptr<donut::engine::DescriptorTableManager> descriptorTable);
+
+    // Fails without changing the scene if the cache is missing, malformed, partial or older than its sources,
+    // the scene is then loaded with Scene::Load()
+    bool LoadCache(const std::filesystem::path& cachePath);
+
+private:
+    std::shared_ptr<donut::engine::TextureCache> m_textureCache;
+};
+
+// Cache of a scene description, written next to it by SceneCacheConverter
+std::filesystem::path GetSceneCachePath(const std::filesystem::path& sceneFileName);
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "GpuProfiler.h"
+
+GpuProfiler::GpuProfiler(nvrhi::IDevice* device, const FrameProfilerDesc& desc)
+    : m_device(device)
+    , m_startTime(std::chrono::steady_clock::now())
+    , m_frameProfiler(desc, *this)
+{
+    m_timerQueries.resize(m_frameProfiler.GetTimerNum());
+}
+
+void GpuProfiler::BeginFrame()
+{
+    m_frameProfiler.BeginFrame();
+}
+
+void GpuProfiler::EndFrame()
+{
+    m_frameProfiler.EndFrame();
+}
+
+uint32_t GpuProfiler::BeginScope(nvrhi::ICommandList* commandList, const char* name)
+{
+    const uint32_t timerIndex = m_frameProfiler.BeginScope(name);
+    if (timerIndex == FrameProfiler::c_InvalidTimer)
+        return timerIndex;
+
+    // Queries are created on first use, most frames only need a few of them
+    nvrhi::TimerQueryHandle& timerQuery = m_timerQueries[timerIndex];
+    if (!timerQuery)
+        timerQuery = m_device->createTimerQuery();
+    else
+        m_device->resetTimerQuery(timerQuery);
+
+    commandList->beginTimerQuery(timerQuery);
+
+    return timerIndex;
+}
+
+void GpuProfiler::EndScope(nvrhi::ICommandList* commandList, uint32_t timerIndex)
+{
+    if (timerIndex == FrameProfiler::c_InvalidTimer)
+        return;
+
+    commandList->endTimerQuery(m_timerQueries[timerIndex]);
+    m_frameProfiler.EndScope(timerIndex);
+}
+
+double GpuProfiler::GetCpuTime()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startTime).count();
+}
+
+bool GpuProfiler::IsTimerReady(uint32_t timerIndex)
+{
+    return m_timerQueries[timerIndex] && m_device->pollTimerQuery(m_timerQueries[timerIndex]);
+}
+
+double GpuProfiler::GetTimerTime(uint32_t timerIndex)
+{
+    return m_device->getTimerQueryTime(m_timerQueries[timerIndex]);
+}
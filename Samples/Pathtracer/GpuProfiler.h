@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <nvrhi/nvrhi.h>
+
+#include "FrameProfiler.h"
+
+#include <chrono>
+#include <vector>
+
+// FrameProfiler backed by timer queries, one query per scope and frame in flight
+class GpuProfiler : private FrameProfilerClock
+{
+public:
+    GpuProfiler(nvrhi::IDevice* device, const FrameProfilerDesc& desc);
+
+    const FrameProfiler& GetFrameProfiler() const
+    {
+        return m_frameProfiler;
+    }
+
+    void BeginFrame();
+    void EndFrame();
+
+    uint32_t BeginScope(nvrhi::ICommandList* commandList, const char* name);
+    void EndScope(nvrhi::ICommandList* commandList, uint32_t timerIndex);
+
+private:
+    double GetCpuTime() override;
+    bool IsTimerReady(uint32_t timerIndex) override;
+    double GetTimerTime(uint32_t timerIndex) override;
+
+    nvrhi::DeviceHandle m_device;
+    std::vector<nvrhi::TimerQueryHandle> m_timerQueries;
+    std::chrono::steady_clock::time_point m_startTime;
+
+    FrameProfiler m_frameProfiler;
+};
+
+// Debug marker around a range of commands, also timed when a profiler is given
+class ScopedMarker
+{
+public:
+    ScopedMarker(nvrhi::ICommandList* commandList, const char* name, GpuProfiler* profiler = nullptr) : m_commandList(commandList), m_profiler(profiler)
+    {
+        m_commandList->beginMarker(name);
+        if (m_profiler)
+            m_timerIndex = m_profiler->BeginScope(m_commandList, name);
+    }
+    ~ScopedMarker()
+    {
+        if (m_profiler)
+            m_profiler->EndScope(m_commandList, m_timerIndex);
+        m_commandList->endMarker();
+    }
+
+private:
+    nvrhi::ICommandList* m_commandList;
+    GpuProfiler* m_profiler;
+    uint32_t m_timerIndex = FrameProfiler::c_InvalidTimer;
+};
@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "BlasBuildBatcher.h"
+
+#include <algorithm>
+#include <numeric>
+
+std::vector<BlasBuildBatch> BatchBlasBuilds(const uint64_t* scratchSizes, uint32_t buildNum, uint64_t poolSize, uint64_t scratchAlignment)
+{
+    scratchAlignment = std::max(scratchAlignment, uint64_t(1));
+
+    std::vector<uint32_t> order(buildNum);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(), [scratchSizes](uint32_t a, uint32_t b) { return scratchSizes[a] > scratchSizes[b]; });
+
+    std::vector<BlasBuildBatch> batches;
+    for (uint32_t index : order)
+    {
+        const uint64_t scratchSize = (scratchSizes[index] + scratchAlignment - 1) / scratchAlignment * scratchAlignment;
+
+        auto batch = std::find_if(batches.begin(), batches.end(), [&](const BlasBuildBatch& batch) { return batch.scratchSize + scratchSize <= poolSize; });
+        if (batch == batches.end())
+            batch = batches.insert(batches.end(), BlasBuildBatch{ {}, 0 });
+
+        batch->builds.push_back({ index, batch->scratchSize });
+        batch->scratchSize += scratchSize;
+    }
+
+    return batches;
+}
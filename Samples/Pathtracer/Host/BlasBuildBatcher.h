@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Groups bottom level acceleration structure builds into submissions that share a pool of scratch memory.
+// Builds are taken from the largest scratch size down and placed into the first batch with enough room (first fit decreasing),
+// inside a batch every build gets its own aligned range of the pool. A build larger than the pool gets a batch of its own.
+
+struct BlasBuild
+{
+    uint32_t index; // Caller defined
+    uint64_t scratchOffset;
+};
+
+struct BlasBuildBatch
+{
+    std::vector<BlasBuild> builds; // Ordered by decreasing scratch size
+    uint64_t scratchSize;
+};
+
+std::vector<BlasBuildBatch> BatchBlasBuilds(const uint64_t* scratchSizes, uint32_t buildNum, uint64_t poolSize, uint64_t scratchAlignment);
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "FrameProfiler.h"
+
+#include <algorithm>
+
+FrameProfiler::FrameProfiler(const FrameProfilerDesc& desc, FrameProfilerClock& clock) : m_desc(desc), m_clock(clock)
+{
+    m_desc.frameLatency = std::max(m_desc.frameLatency, 1u);
+    m_desc.maxScopeNum = std::max(m_desc.maxScopeNum, 1u);
+    m_desc.historyWeight = std::clamp(m_desc.historyWeight, 0.0f, 1.0f);
+
+    m_frames.resize(m_desc.frameLatency);
+}
+
+void FrameProfiler::BeginFrame()
+{
+    // Oldest frame first, the GPU finishes them in order
+    for (uint32_t frameOffset = 0; frameOffset < m_desc.frameLatency; ++frameOffset)
+    {
+        const uint32_t frameSlot = uint32_t((m_frameIndex + frameOffset) % m_desc.frameLatency);
+        Frame& frame = m_frames[frameSlot];
+        if (!frame.isPending)
+            continue;
+
+        if (!IsFrameReady(frame, frameSlot))
+            break;
+
+        ResolveFrame(frame, frameSlot);
+    }
+
+    // The timers of the oldest frame are reused whether it has been read or not
+    Frame& frame = m_frames[m_frameIndex % m_desc.frameLatency];
+    if (frame.isPending)
+        m_droppedFrameNum++;
+
+    frame.scopes.clear();
+    frame.isPending = false;
+
+    m_scopeStack.clear();
+    m_pathStack.clear();
+    m_isRecording = true;
+}
+
+void FrameProfiler::EndFrame()
+{
+    if (!m_isRecording)
+        return;
+
+    Frame& frame = m_frames[m_frameIndex % m_desc.frameLatency];
+    frame.isPending = !frame.scopes.empty();
+
+    m_frameIndex++;
+    m_isRecording = false;
+}
+
+uint32_t FrameProfiler::BeginScope(const char* name)
+{
+    if (!m_isRecording)
+        return c_InvalidTimer;
+
+    const uint32_t frameSlot = uint32_t(m_frameIndex % m_desc.frameLatency);
+    Frame& frame = m_frames[frameSlot];
+    if (frame.scopes.size() >= m_desc.maxScopeNum)
+        return c_InvalidTimer;
+
+    std::string path = m_pathStack.empty() ? std::string(name) : m_pathStack.back() + "/" + name;
+
+    ScopeRecord record;
+    record.pathIndex = GetPathIndex(path, name, uint32_t(m_scopeStack.size()));
+    record.cpuBegin = m_clock.GetCpuTime();
+    record.cpuEnd = record.cpuBegin;
+    record.isClosed = false;
+
+    const uint32_t scopeIndex = uint32_t(frame.scopes.size());
+    frame.scopes.push_back(record);
+
+    m_scopeStack.push_back(scopeIndex);
+    m_pathStack.push_back(std::move(path));
+
+    return frameSlot * m_desc.maxScopeNum + scopeIndex;
+}
+
+void FrameProfiler::EndScope(uint32_t timerIndex)
+{
+    const uint32_t frameSlot = uint32_t(m_frameIndex % m_desc.frameLatency);
+    if (!m_isRecording || timerIndex == c_InvalidTimer || timerIndex / m_desc.maxScopeNum != frameSlot)
+        return;
+
+    Frame& frame = m_frames[frameSlot];
+    const uint32_t scopeIndex = timerIndex % m_desc.maxScopeNum;
+    if (scopeIndex >= frame.scopes.size())
+        return;
+
+    ScopeRecord& record = frame.scopes[scopeIndex];
+    record.cpuEnd = m_clock.GetCpuTime();
+    record.isClosed = true;
+
+    // Inner scopes left open are closed with their parent, they are not timed
+    while (!m_scopeStack.empty())
+    {
+        const uint32_t openScopeIndex = m_scopeStack.back();
+        m_scopeStack.pop_back();
+        m_pathStack.pop_back();
+
+        if (openScopeIndex == scopeIndex)
+            break;
+    }
+}
+
+bool FrameProfiler::IsFrameReady(const Frame& frame, uint32_t frameSlot)
+{
+    for (uint32_t scopeIndex = 0; scopeIndex < frame.scopes.size(); ++scopeIndex)
+    {
+        if (frame.scopes[scopeIndex].isClosed && !m_clock.IsTimerReady(frameSlot * m_desc.maxScopeNum + scopeIndex))
+            return false;
+    }
+
+    return true;
+}
+
+void FrameProfiler::ResolveFrame(Frame& frame, uint32_t frameSlot)
+{
+    // Repeated scopes of a frame are summed, the order of the first occurrence is kept
+    std::vector<double> cpuTimes(m_history.size(), 0.0);
+    std::vector<double> gpuTimes(m_history.size(), 0.0);
+    std::vector<uint32_t> pathOrder;
+
+    for (uint32_t scopeIndex = 0; scopeIndex < frame.scopes.size(); ++scopeIndex)
+    {
+        const ScopeRecord& record = frame.scopes[scopeIndex];
+        if (!record.isClosed)
+            continue;
+
+        if (std::find(pathOrder.begin(), pathOrder.end(), record.pathIndex) == pathOrder.end())
+            pathOrder.push_back(record.pathIndex);
+
+        cpuTimes[record.pathIndex] += record.cpuEnd - record.cpuBegin;
+        gpuTimes[record.pathIndex] += m_clock.GetTimerTime(frameSlot * m_desc.maxScopeNum + scopeIndex);
+    }
+
+    m_scopes.clear();
+    for (uint32_t pathIndex : pathOrder)
+    {
+        ScopeHistory& history = m_history[pathIndex];
+
+        // The first sample replaces the empty history
+        const double weight = history.hasHistory ? double(m_desc.historyWeight) : 1.0;
+        history.cpuTime += (cpuTimes[pathIndex] - history.cpuTime) * weight;
+        history.gpuTime += (gpuTimes[pathIndex] - history.gpuTime) * weight;
+        history.hasHistory = true;
+
+        FrameProfilerScope scope;
+        scope.name = history.name;
+        scope.depth = history.depth;
+        scope.cpuTime = history.cpuTime;
+        scope.gpuTime = history.gpuTime;
+        m_scopes.push_back(scope);
+    }
+
+    frame.isPending = false;
+    m_resolvedFrameNum++;
+}
+
+uint32_t FrameProfiler::GetPathIndex(const std::string& path, const char* name, uint32_t depth)
+{
+    auto it = m_pathIndices.find(path);
+    if (it != m_pathIndices.end())
+        return it->second;
+
+    const uint32_t pathIndex = uint32_t(m_history.size());
+    m_pathIndices.emplace(path, pathIndex);
+
+    ScopeHistory history;
+    history.name = name;
+    history.depth = depth;
+    m_history.push_back(history);
+
+    return pathIndex;
+}
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Collects nested CPU and GPU timings of named scopes.
+// Every scope of a frame owns one timer, the timers of a frame are read once all of them are ready, which takes a few frames
+// on the GPU. The profiler never waits: a frame whose timers are still pending when its slot in the ring is needed again is dropped.
+// Scopes are identified by their path in the hierarchy, repeated scopes of a frame are summed and the sums are smoothed over time.
+// Timestamps come from a FrameProfilerClock, so the ring and the aggregation can be driven by a fake clock.
+
+class FrameProfilerClock
+{
+public:
+    virtual ~FrameProfilerClock() = default;
+
+    // Current CPU time in seconds
+    virtual double GetCpuTime() = 0;
+
+    // GPU time in seconds between the begin and the end of a timer, only called once IsTimerReady() returned true
+    virtual bool IsTimerReady(uint32_t timerIndex) = 0;
+    virtual double GetTimerTime(uint32_t timerIndex) = 0;
+};
+
+struct FrameProfilerDesc
+{
+    // Frames in flight, the timers of a frame are reused after this many frames
+    uint32_t frameLatency = 3;
+
+    uint32_t maxScopeNum = 128; // Per frame
+
+    // Weight of a new sample in the smoothed times
+    float historyWeight = 0.1f;
+};
+
+// Smoothed times of a scope, in seconds
+struct FrameProfilerScope
+{
+    std::string name;
+    uint32_t depth;
+    double cpuTime;
+    double gpuTime;
+};
+
+class FrameProfiler
+{
+public:
+    static const uint32_t c_InvalidTimer = ~0u;
+
+    FrameProfiler(const FrameProfilerDesc& desc, FrameProfilerClock& clock);
+
+    const FrameProfilerDesc& GetDesc() const
+    {
+        return m_desc;
+    }
+
+    // Timers are indexed in [0, GetTimerNum())
+    uint32_t GetTimerNum() const
+    {
+        return m_desc.frameLatency * m_desc.maxScopeNum;
+    }
+
+    // Reads the finished frames and starts recording into the next slot of the ring
+    void BeginFrame();
+    void EndFrame();
+
+    // Returns the timer the caller has to start and stop around the GPU work of the scope, c_InvalidTimer if the frame is out of scopes
+    uint32_t BeginScope(const char* name);
+    void EndScope(uint32_t timerIndex);
+
+    // Scopes of the last read frame in recording order
+    const std::vector<FrameProfilerScope>& GetScopes() const
+    {
+        return m_scopes;
+    }
+
+    uint64_t GetResolvedFrameNum() const
+    {
+        return m_resolvedFrameNum;
+    }
+
+    uint64_t GetDroppedFrameNum() const
+    {
+        return m_droppedFrameNum;
+    }
+
+private:
+    struct ScopeRecord
+    {
+        uint32_t pathIndex;
+        double cpuBegin;
+        double cpuEnd;
+        bool isClosed;
+    };
+
+    struct Frame
+    {
+        std::vector<ScopeRecord> scopes;
+        bool isPending = false;
+    };
+
+    struct ScopeHistory
+    {
+        std::string name;
+        uint32_t depth = 0;
+        double cpuTime = 0.0;
+        double gpuTime = 0.0;
+        bool hasHistory = false;
+    };
+
+    bool IsFrameReady(const Frame& frame, uint32_t frameSlot);
+    void ResolveFrame(Frame& frame, uint32_t frameSlot);
+    uint32_t GetPathIndex(const std::string& path, const char* name, uint32_t depth);
+
+    FrameProfilerDesc m_desc;
+    FrameProfilerClock& m_clock;
+
+    std::vector<Frame> m_frames;
+    uint64_t m_frameIndex = 0;
+    bool m_isRecording = false;
+
+    // Open scopes of the recorded frame and their paths
+    std::vector<uint32_t> m_scopeStack;
+    std::vector<std::string> m_pathStack;
+
+    std::unordered_map<std::string, uint32_t> m_pathIndices;
+    std::vector<ScopeHistory> m_history;
+
+    std::vector<FrameProfilerScope> m_scopes;
+    uint64_t m_resolvedFrameNum = 0;
+    uint64_t m_droppedFrameNum = 0;
+};
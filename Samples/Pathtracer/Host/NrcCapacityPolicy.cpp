@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "NrcCapacityPolicy.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+uint32_t AlignUp(uint32_t value, uint32_t alignment)
+{
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+uint32_t NextPowerOfTwo(uint32_t value)
+{
+    uint32_t result = 1;
+    while (result < value)
+        result *= 2;
+
+    return result;
+}
+
+// Headroom up to 'maxHeadroom', never below the request or the minimum
+uint32_t AddHeadroom(uint32_t request, uint32_t withHeadroom, uint32_t minCapacity, uint32_t maxHeadroom)
+{
+    return std::max({ request, minCapacity, std::min(withHeadroom, maxHeadroom) });
+}
+} // namespace
+
+NrcCapacityPolicy::NrcCapacityPolicy(const NrcCapacityPolicyDesc& desc) : m_desc(desc)
+{
+    m_desc.resolutionHeadroom = std::max(m_desc.resolutionHeadroom, 1.0f);
+    m_desc.resolutionAlignment = std::max(m_desc.resolutionAlignment, 1u);
+}
+
+NrcCapacity NrcCapacityPolicy::ComputeCapacity(const NrcCapacity& request) const
+{
+    const NrcCapacity& minCapacity = m_desc.minCapacity;
+    const NrcCapacity& maxHeadroom = m_desc.maxHeadroomCapacity;
+
+    NrcCapacity capacity;
+    capacity.width = AddHeadroom(request.width, AlignUp(uint32_t(std::ceil(request.width * m_desc.resolutionHeadroom)), m_desc.resolutionAlignment), minCapacity.width,
+        maxHeadroom.width);
+    capacity.height = AddHeadroom(request.height, AlignUp(uint32_t(std::ceil(request.height * m_desc.resolutionHeadroom)), m_desc.resolutionAlignment), minCapacity.height,
+        maxHeadroom.height);
+    capacity.samplesPerPixel = AddHeadroom(request.samplesPerPixel, NextPowerOfTwo(request.samplesPerPixel), minCapacity.samplesPerPixel, maxHeadroom.samplesPerPixel);
+    capacity.maxPathVertices = AddHeadroom(request.maxPathVertices, request.maxPathVertices, minCapacity.maxPathVertices, maxHeadroom.maxPathVertices);
+
+    return capacity;
+}
+
+NrcCapacityAction NrcCapacityPolicy::Update(uint64_t frameIndex, const NrcCapacity& request)
+{
+    NrcCapacityAction action = NrcCapacityAction::None;
+
+    if (!m_hasCapacity)
+    {
+        m_capacity = ComputeCapacity(request);
+        m_hasCapacity = true;
+        action = NrcCapacityAction::Reallocate;
+    }
+    else if (!m_capacity.Covers(request))
+    {
+        // Only the dimensions that don't fit grow, so alternating requests (e.g. a window resized narrower but taller) settle quickly
+        const NrcCapacity grown = ComputeCapacity(request);
+        if (request.width > m_capacity.width)
+            m_capacity.width = grown.width;
+        if (request.height > m_capacity.height)
+            m_capacity.height = grown.height;
+        if (request.samplesPerPixel > m_capacity.samplesPerPixel)
+            m_capacity.samplesPerPixel = grown.samplesPerPixel;
+        if (request.maxPathVertices > m_capacity.maxPathVertices)
+            m_capacity.maxPathVertices = grown.maxPathVertices;
+        action = NrcCapacityAction::Reallocate;
+    }
+    else if (!(request == m_request))
+    {
+        action = NrcCapacityAction::Reconfigure;
+    }
+
+    // Shrinking only pays off if a fresh envelope would be smaller
+    const bool isBelowShrinkFraction = (action != NrcCapacityAction::Reallocate) &&
+                                       (double(request.GetQueryNum()) < double(m_capacity.GetQueryNum()) * m_desc.shrinkFraction) &&
+                                       !(ComputeCapacity(request) == m_capacity);
+    if (!isBelowShrinkFraction)
+    {
+        m_isBelowShrinkFraction = false;
+    }
+    else if (!m_isBelowShrinkFraction)
+    {
+        m_isBelowShrinkFraction = true;
+        m_belowShrinkFractionFrame = frameIndex;
+    }
+    else if (frameIndex >= m_belowShrinkFractionFrame + m_desc.shrinkFrameNum)
+    {
+        m_capacity = ComputeCapacity(request);
+        m_isBelowShrinkFraction = false;
+        action = NrcCapacityAction::Reallocate;
+    }
+
+    if (action == NrcCapacityAction::Reallocate)
+    {
+        m_reallocationNum++;
+        m_isBelowShrinkFraction = false;
+    }
+    else if (action == NrcCapacityAction::Reconfigure)
+    {
+        m_reconfigurationNum++;
+    }
+
+    m_request = request;
+    return action;
+}
+
+void NrcCapacityPolicy::Reset()
+{
+    m_capacity = NrcCapacity();
+    m_request = NrcCapacity();
+    m_hasCapacity = false;
+    m_isBelowShrinkFraction = false;
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+// Decides when the NRC buffers have to be reallocated as the context settings change.
+// The buffers are sized for a capacity envelope of resolution, samples per pixel and path vertices with headroom beyond
+// the requested settings, so a window resize or a settings change within the envelope only reconfigures the context with
+// the buffers it already has. The envelope grows when a request doesn't fit and shrinks to the request once the request
+// has used only a small part of it for a while. The policy has no knowledge of time other than the frame indices passed in.
+
+struct NrcCapacity
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t samplesPerPixel = 0;
+    uint32_t maxPathVertices = 0;
+
+    bool operator==(const NrcCapacity& other) const = default;
+
+    // Every dimension at least as large as in 'other'
+    bool Covers(const NrcCapacity& other) const
+    {
+        return width >= other.width && height >= other.height && samplesPerPixel >= other.samplesPerPixel && maxPathVertices >= other.maxPathVertices;
+    }
+
+    // Query paths per frame, the bulk of the NRC memory scales with it
+    uint64_t GetQueryNum() const
+    {
+        return uint64_t(width) * height * samplesPerPixel;
+    }
+};
+
+struct NrcCapacityPolicyDesc
+{
+    // The envelope never gets smaller, covers the common window sizes and all training bounces of the UI
+    NrcCapacity minCapacity = { 1920, 1080, 1, 8 };
+
+    // No headroom is added beyond, larger requests are still met exactly
+    NrcCapacity maxHeadroomCapacity = { 3840, 2160, 16, 8 };
+
+    // Per axis, the result is aligned. Samples per pixel are rounded up to a power of two
+    float resolutionHeadroom = 1.25f;
+    uint32_t resolutionAlignment = 64;
+
+    // Shrink once the requests have used less than this fraction of the query paths for 'shrinkFrameNum' frames
+    float shrinkFraction = 0.25f;
+    uint32_t shrinkFrameNum = 600;
+};
+
+enum class NrcCapacityAction
+{
+    None,
+    Reconfigure, // The request changed within the envelope, configure the context with the current buffers
+    Reallocate,  // The envelope changed, the buffers have to be recreated with GetCapacity()
+};
+
+class NrcCapacityPolicy
+{
+public:
+    explicit NrcCapacityPolicy(const NrcCapacityPolicyDesc& desc = NrcCapacityPolicyDesc());
+
+    const NrcCapacityPolicyDesc& GetDesc() const
+    {
+        return m_desc;
+    }
+
+    // Called once per frame with the settings the frame needs
+    NrcCapacityAction Update(uint64_t frameIndex, const NrcCapacity& request);
+
+    // Forgets the envelope, the next Update() reallocates, e.g. after the context was recreated
+    void Reset();
+
+    // Envelope for a request without history, what a fresh reallocation would pick
+    NrcCapacity ComputeCapacity(const NrcCapacity& request) const;
+
+    const NrcCapacity& GetCapacity() const
+    {
+        return m_capacity;
+    }
+
+    const NrcCapacity& GetRequest() const
+    {
+        return m_request;
+    }
+
+    uint32_t GetReallocationNum() const
+    {
+        return m_reallocationNum;
+    }
+
+    uint32_t GetReconfigurationNum() const
+    {
+        return m_reconfigurationNum;
+    }
+
+private:
+    NrcCapacityPolicyDesc m_desc;
+
+    NrcCapacity m_capacity;
+    NrcCapacity m_request;
+    bool m_hasCapacity = false;
+
+    bool m_isBelowShrinkFraction = false;
+    uint64_t m_belowShrinkFractionFrame = 0; // First frame of the current run below the fraction
+
+    uint32_t m_reallocationNum = 0;
+    uint32_t m_reconfigurationNum = 0;
+};
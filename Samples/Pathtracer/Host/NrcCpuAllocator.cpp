@@ -0,0 +1,322 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "NrcCpuAllocator.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace
+{
+const size_t c_Alignment = 16;
+const size_t c_MinPoolAllocationSize = 16;
+
+size_t AlignUp(size_t size, size_t alignment)
+{
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+void UpdatePeak(std::atomic<uint64_t>& peak, uint64_t value)
+{
+    uint64_t previous = peak.load(std::memory_order_relaxed);
+    while (previous < value && !peak.compare_exchange_weak(previous, value, std::memory_order_relaxed))
+        ;
+}
+} // namespace
+
+NrcCpuAllocator::NrcCpuAllocator(const NrcCpuAllocatorDesc& desc) : m_desc(desc), m_mode(desc.mode)
+{
+    static_assert(sizeof(Header) == c_Alignment, "The header keeps the allocations aligned");
+
+    m_desc.maxPoolAllocationSize = std::max<uint32_t>(m_desc.maxPoolAllocationSize, c_MinPoolAllocationSize);
+    m_desc.maxArenaAllocationSize = std::min(m_desc.maxArenaAllocationSize, m_desc.arenaChunkSize - uint32_t(sizeof(Header)));
+
+    for (size_t allocationSize = c_MinPoolAllocationSize;; allocationSize *= 2)
+    {
+        std::unique_ptr<SizeClass> sizeClass = std::make_unique<SizeClass>();
+        sizeClass->blockSize = uint32_t(sizeof(Header) + allocationSize);
+        m_sizeClasses.push_back(std::move(sizeClass));
+
+        if (allocationSize >= m_desc.maxPoolAllocationSize)
+            break;
+    }
+
+    m_desc.maxPoolAllocationSize = m_sizeClasses.back()->blockSize - uint32_t(sizeof(Header));
+    m_desc.poolPageSize = std::max(m_desc.poolPageSize, m_sizeClasses.back()->blockSize);
+}
+
+NrcCpuAllocator::~NrcCpuAllocator()
+{
+    for (const std::unique_ptr<SizeClass>& sizeClass : m_sizeClasses)
+    {
+        for (void* page : sizeClass->pages)
+            free(page);
+    }
+
+    for (ArenaChunk* chunk : m_chunks)
+    {
+        free(chunk->memory);
+        delete chunk;
+    }
+}
+
+void* NrcCpuAllocator::Allocate(size_t size)
+{
+    const NrcAllocatorMode mode = GetMode();
+    if (mode == NrcAllocatorMode::System)
+        return AllocateFromSystem(size, NrcAllocationTag::System);
+
+    if (mode == NrcAllocatorMode::PoolsAndFrameArena && size <= m_desc.maxArenaAllocationSize)
+    {
+        if (void* pointer = AllocateFromArena(size))
+            return pointer;
+    }
+
+    if (size <= m_desc.maxPoolAllocationSize)
+        return AllocateFromPool(size);
+
+    return AllocateFromSystem(size, NrcAllocationTag::Large);
+}
+
+void NrcCpuAllocator::Deallocate(void* pointer, size_t size)
+{
+    if (!pointer)
+        return;
+
+    Header* header = (Header*)pointer - 1;
+    const NrcAllocationTag tag = header->tag;
+    RemoveAllocation(tag, size);
+
+    switch (tag)
+    {
+    case NrcAllocationTag::Pool:
+    {
+        SizeClass& sizeClass = *m_sizeClasses[header->sizeClass];
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        *(void**)header = sizeClass.freeList;
+        sizeClass.freeList = header;
+        break;
+    }
+    case NrcAllocationTag::FrameArena:
+        FreeArenaAllocation((ArenaChunk*)header->chunk);
+        break;
+    default:
+        free(header);
+        break;
+    }
+}
+
+void* NrcCpuAllocator::AllocateFromPool(size_t size)
+{
+    uint32_t sizeClassIndex = 0;
+    while ((c_MinPoolAllocationSize << sizeClassIndex) < size)
+        sizeClassIndex++;
+
+    SizeClass& sizeClass = *m_sizeClasses[sizeClassIndex];
+    void* block;
+    {
+        std::lock_guard<std::mutex> lock(sizeClass.mutex);
+        if (!sizeClass.freeList)
+        {
+            uint8_t* page = (uint8_t*)malloc(m_desc.poolPageSize);
+            if (!page)
+                return nullptr;
+
+            sizeClass.pages.push_back(page);
+            m_reservedSize.fetch_add(m_desc.poolPageSize, std::memory_order_relaxed);
+
+            // Thread the blocks of the page into the free list
+            const uint32_t blockNum = m_desc.poolPageSize / sizeClass.blockSize;
+            for (uint32_t blockIndex = blockNum; blockIndex-- > 0;)
+            {
+                void* freeBlock = page + size_t(blockIndex) * sizeClass.blockSize;
+                *(void**)freeBlock = sizeClass.freeList;
+                sizeClass.freeList = freeBlock;
+            }
+        }
+
+        block = sizeClass.freeList;
+        sizeClass.freeList = *(void**)block;
+    }
+
+    Header* header = (Header*)block;
+    header->tag = NrcAllocationTag::Pool;
+    header->sizeClass = sizeClassIndex;
+    header->chunk = nullptr;
+    AddAllocation(NrcAllocationTag::Pool, size);
+
+    return header + 1;
+}
+
+void* NrcCpuAllocator::AllocateFromArena(size_t size)
+{
+    const size_t blockSize = AlignUp(sizeof(Header) + size, c_Alignment);
+
+    Header* header;
+    {
+        std::lock_guard<std::mutex> lock(m_arenaMutex);
+        if (!m_isFrameActive)
+            return nullptr;
+
+        if (m_arenaChunk && m_arenaChunk->offset + blockSize > m_desc.arenaChunkSize)
+        {
+            RetireChunk(m_arenaChunk);
+            m_arenaChunk = nullptr;
+        }
+
+        if (!m_arenaChunk)
+        {
+            if (!m_freeChunks.empty())
+            {
+                m_arenaChunk = m_freeChunks.back();
+                m_freeChunks.pop_back();
+            }
+            else if (m_chunks.size() < m_desc.maxArenaChunkNum)
+            {
+                uint8_t* memory = (uint8_t*)malloc(m_desc.arenaChunkSize);
+                if (!memory)
+                    return nullptr;
+
+                m_arenaChunk = new ArenaChunk();
+                m_arenaChunk->memory = memory;
+                m_chunks.push_back(m_arenaChunk);
+                m_reservedSize.fetch_add(m_desc.arenaChunkSize, std::memory_order_relaxed);
+            }
+            else
+            {
+                return nullptr;
+            }
+
+            m_arenaChunk->offset = 0;
+            m_arenaChunk->isRetired = false;
+        }
+
+        header = (Header*)(m_arenaChunk->memory + m_arenaChunk->offset);
+        m_arenaChunk->offset += blockSize;
+        m_arenaChunk->liveAllocationNum++;
+
+        header->chunk = m_arenaChunk;
+    }
+
+    header->tag = NrcAllocationTag::FrameArena;
+    header->sizeClass = 0;
+    AddAllocation(NrcAllocationTag::FrameArena, size);
+
+    return header + 1;
+}
+
+void* NrcCpuAllocator::AllocateFromSystem(size_t size, NrcAllocationTag tag)
+{
+    Header* header = (Header*)malloc(sizeof(Header) + size);
+    if (!header)
+        return nullptr;
+
+    header->tag = tag;
+    header->sizeClass = 0;
+    header->chunk = nullptr;
+    AddAllocation(tag, size);
+
+    return header + 1;
+}
+
+void NrcCpuAllocator::FreeArenaAllocation(ArenaChunk* chunk)
+{
+    std::lock_guard<std::mutex> lock(m_arenaMutex);
+
+    chunk->liveAllocationNum--;
+    if (chunk->isRetired && chunk->liveAllocationNum == 0)
+        ReleaseChunk(chunk);
+}
+
+void NrcCpuAllocator::RetireChunk(ArenaChunk* chunk)
+{
+    chunk->isRetired = true;
+    if (chunk->liveAllocationNum == 0)
+        ReleaseChunk(chunk);
+}
+
+void NrcCpuAllocator::ReleaseChunk(ArenaChunk* chunk)
+{
+    if (m_freeChunks.size() < m_desc.maxFreeArenaChunkNum)
+    {
+        m_freeChunks.push_back(chunk);
+        return;
+    }
+
+    m_chunks.erase(std::find(m_chunks.begin(), m_chunks.end(), chunk));
+    m_reservedSize.fetch_sub(m_desc.arenaChunkSize, std::memory_order_relaxed);
+    free(chunk->memory);
+    delete chunk;
+}
+
+void NrcCpuAllocator::BeginFrame()
+{
+    std::lock_guard<std::mutex> lock(m_arenaMutex);
+    m_isFrameActive = true;
+}
+
+void NrcCpuAllocator::EndFrame()
+{
+    std::lock_guard<std::mutex> lock(m_arenaMutex);
+    m_isFrameActive = false;
+
+    // The next frame starts a chunk of its own
+    if (m_arenaChunk)
+    {
+        RetireChunk(m_arenaChunk);
+        m_arenaChunk = nullptr;
+    }
+}
+
+void NrcCpuAllocator::AddAllocation(NrcAllocationTag tag, size_t size)
+{
+    TagCounters& counters = m_tagCounters[uint32_t(tag)];
+    counters.allocationNum.fetch_add(1, std::memory_order_relaxed);
+    counters.liveAllocationNum.fetch_add(1, std::memory_order_relaxed);
+    const uint64_t liveSize = counters.liveSize.fetch_add(size, std::memory_order_relaxed) + size;
+    UpdatePeak(counters.peakSize, liveSize);
+}
+
+void NrcCpuAllocator::RemoveAllocation(NrcAllocationTag tag, size_t size)
+{
+    TagCounters& counters = m_tagCounters[uint32_t(tag)];
+    counters.liveAllocationNum.fetch_sub(1, std::memory_order_relaxed);
+    counters.liveSize.fetch_sub(size, std::memory_order_relaxed);
+}
+
+NrcAllocationTagStats NrcCpuAllocator::GetTagStats(NrcAllocationTag tag) const
+{
+    const TagCounters& counters = m_tagCounters[uint32_t(tag)];
+
+    NrcAllocationTagStats stats;
+    stats.allocationNum = counters.allocationNum.load(std::memory_order_relaxed);
+    stats.liveAllocationNum = counters.liveAllocationNum.load(std::memory_order_relaxed);
+    stats.liveSize = counters.liveSize.load(std::memory_order_relaxed);
+    stats.peakSize = counters.peakSize.load(std::memory_order_relaxed);
+
+    return stats;
+}
+
+const char* NrcCpuAllocator::GetTagName(NrcAllocationTag tag)
+{
+    switch (tag)
+    {
+    case NrcAllocationTag::Pool:
+        return "Pool";
+    case NrcAllocationTag::FrameArena:
+        return "FrameArena";
+    case NrcAllocationTag::Large:
+        return "Large";
+    case NrcAllocationTag::System:
+        return "System";
+    default:
+        return "Unknown";
+    }
+}
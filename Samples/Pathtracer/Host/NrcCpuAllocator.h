@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// CPU memory of the NRC SDK, handed to it through the allocator callbacks of nrc::GlobalSettings.
+// Allocations up to maxPoolAllocationSize come from power of two size class pools, every class keeps a free list of
+// blocks carved from pages. With the frame arena enabled, allocations up to maxArenaAllocationSize made between
+// BeginFrame() and EndFrame() are bump allocated from a chunk instead. A chunk is recycled once its frame has ended and
+// all of its allocations have been freed, allocations that outlive the frame stay valid but keep their chunk alive.
+// The chunk count is capped so that long lived allocations can't pin memory without bounds.
+// Larger allocations go to the system allocator. Every allocation starts with a header naming where it came from,
+// so the mode can change at any time. All functions are thread safe.
+
+enum class NrcAllocatorMode : uint32_t
+{
+    System,
+    Pools,
+    PoolsAndFrameArena,
+};
+
+// Where an allocation came from, the statistics are kept per tag
+enum class NrcAllocationTag : uint32_t
+{
+    Pool,
+    FrameArena,
+    Large, // Too large for the pools
+    System, // Allocated in System mode
+
+    Count
+};
+
+struct NrcAllocationTagStats
+{
+    uint64_t allocationNum = 0; // Since creation
+    uint64_t liveAllocationNum = 0;
+    uint64_t liveSize = 0; // Requested bytes
+    uint64_t peakSize = 0;
+};
+
+struct NrcCpuAllocatorDesc
+{
+    NrcAllocatorMode mode = NrcAllocatorMode::Pools;
+
+    uint32_t maxPoolAllocationSize = 4096; // Rounded up to a power of two
+    uint32_t poolPageSize = 64 * 1024;
+
+    uint32_t maxArenaAllocationSize = 64 * 1024;
+    uint32_t arenaChunkSize = 1024 * 1024;
+    uint32_t maxFreeArenaChunkNum = 4; // Recycled chunks kept for the next frames
+    uint32_t maxArenaChunkNum = 64; // Allocations go to the pools while this many chunks are held
+};
+
+class NrcCpuAllocator
+{
+public:
+    explicit NrcCpuAllocator(const NrcCpuAllocatorDesc& desc = NrcCpuAllocatorDesc());
+    ~NrcCpuAllocator();
+
+    NrcCpuAllocator(const NrcCpuAllocator&) = delete;
+    NrcCpuAllocator& operator=(const NrcCpuAllocator&) = delete;
+
+    const NrcCpuAllocatorDesc& GetDesc() const
+    {
+        return m_desc;
+    }
+
+    NrcAllocatorMode GetMode() const
+    {
+        return m_mode.load(std::memory_order_relaxed);
+    }
+
+    void SetMode(NrcAllocatorMode mode)
+    {
+        m_mode.store(mode, std::memory_order_relaxed);
+    }
+
+    // 16 byte aligned, null if the system is out of memory
+    void* Allocate(size_t size);
+    void Deallocate(void* pointer, size_t size);
+
+    // Bounds of the frame arena allocations
+    void BeginFrame();
+    void EndFrame();
+
+    NrcAllocationTagStats GetTagStats(NrcAllocationTag tag) const;
+    static const char* GetTagName(NrcAllocationTag tag);
+
+    // Pages and arena chunks held from the system
+    uint64_t GetReservedSize() const
+    {
+        return m_reservedSize.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Header
+    {
+        NrcAllocationTag tag;
+        uint32_t sizeClass; // Pool
+        void* chunk; // FrameArena
+    };
+
+    struct SizeClass
+    {
+        std::mutex mutex;
+        uint32_t blockSize;
+        void* freeList = nullptr;
+        std::vector<void*> pages;
+    };
+
+    struct ArenaChunk
+    {
+        uint8_t* memory;
+        size_t offset = 0;
+        uint32_t liveAllocationNum = 0;
+        bool isRetired = false;
+    };
+
+    struct TagCounters
+    {
+        std::atomic<uint64_t> allocationNum = 0;
+        std::atomic<uint64_t> liveAllocationNum = 0;
+        std::atomic<uint64_t> liveSize = 0;
+        std::atomic<uint64_t> peakSize = 0;
+    };
+
+    void* AllocateFromPool(size_t size);
+    void* AllocateFromArena(size_t size);
+    void* AllocateFromSystem(size_t size, NrcAllocationTag tag);
+    void FreeArenaAllocation(ArenaChunk* chunk);
+    void RetireChunk(ArenaChunk* chunk);
+    void ReleaseChunk(ArenaChunk* chunk);
+
+    void AddAllocation(NrcAllocationTag tag, size_t size);
+    void RemoveAllocation(NrcAllocationTag tag, size_t size);
+
+    NrcCpuAllocatorDesc m_desc;
+    std::atomic<NrcAllocatorMode> m_mode;
+    std::atomic<uint64_t> m_reservedSize = 0;
+
+    std::vector<std::unique_ptr<SizeClass>> m_sizeClasses;
+
+    std::mutex m_arenaMutex;
+    bool m_isFrameActive = false;
+    ArenaChunk* m_arenaChunk = nullptr;
+    std::vector<ArenaChunk*> m_freeChunks;
+    std::vector<ArenaChunk*> m_chunks; // Every chunk held, released on destruction
+
+    TagCounters m_tagCounters[uint32_t(NrcAllocationTag::Count)];
+};
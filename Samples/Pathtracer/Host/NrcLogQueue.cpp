@@ -0,0 +1,415 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "NrcLogQueue.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+const uint64_t c_RateLimitWindow = 1000000000; // Nanoseconds
+
+uint32_t GetThreadIndex()
+{
+    static std::atomic<uint32_t> threadNum = 0;
+    thread_local const uint32_t threadIndex = threadNum.fetch_add(1, std::memory_order_relaxed);
+    return threadIndex;
+}
+
+void CopyText(char* destination, const char* text)
+{
+    uint32_t length = 0;
+    if (text)
+    {
+        while (length + 1 < c_NrcLogTextSize && text[length])
+        {
+            destination[length] = text[length];
+            length++;
+        }
+    }
+    destination[length] = '\0';
+}
+
+// Messages of the SDK come with their line break
+size_t GetTrimmedLength(const char* text)
+{
+    const char* end = (const char*)memchr(text, '\0', c_NrcLogTextSize);
+    size_t length = end ? size_t(end - text) : c_NrcLogTextSize;
+    while (length > 0 && (text[length - 1] == '\n' || text[length - 1] == '\r'))
+        length--;
+
+    return length;
+}
+
+void WriteJsonString(FILE* file, const char* text)
+{
+    const size_t length = GetTrimmedLength(text);
+
+    fputc('"', file);
+    for (size_t i = 0; i < length; ++i)
+    {
+        const unsigned char character = (unsigned char)text[i];
+        if (character == '"' || character == '\\')
+            fprintf(file, "\\%c", character);
+        else if (character < 0x20)
+            fprintf(file, "\\u%04x", character);
+        else
+            fputc(character, file);
+    }
+    fputc('"', file);
+}
+} // namespace
+
+const char* GetNrcLogLevelName(NrcLogLevel level)
+{
+    switch (level)
+    {
+    case NrcLogLevel::Debug:
+        return "Debug";
+    case NrcLogLevel::Info:
+        return "Info";
+    case NrcLogLevel::Warning:
+        return "Warning";
+    case NrcLogLevel::Error:
+        return "Error";
+    default:
+        return "Unknown";
+    }
+}
+
+const char* GetNrcMemoryEventName(NrcMemoryEventType eventType)
+{
+    switch (eventType)
+    {
+    case NrcMemoryEventType::Allocation:
+        return "Allocation";
+    case NrcMemoryEventType::Deallocation:
+        return "Deallocation";
+    case NrcMemoryEventType::MemoryStats:
+        return "MemoryStats";
+    default:
+        return "Unknown";
+    }
+}
+
+void FormatNrcLogRecord(const NrcLogRecord& record, char* buffer, size_t bufferSize)
+{
+    const double seconds = double(record.time) * 1e-9;
+    const int textLength = int(GetTrimmedLength(record.text));
+
+    if (record.type == NrcLogRecordType::Message)
+    {
+        snprintf(buffer, bufferSize, "[%.6f] [T%u] [%s] %.*s", seconds, record.threadIndex, GetNrcLogLevelName(record.level), textLength, record.text);
+    }
+    else if (record.memoryEventType == NrcMemoryEventType::MemoryStats)
+    {
+        snprintf(buffer, bufferSize, "[%.6f] [T%u] [Memory] %llu bytes currently allocated in total", seconds, record.threadIndex, (unsigned long long)record.size);
+    }
+    else
+    {
+        snprintf(buffer, bufferSize, "[%.6f] [T%u] [Memory] %s of %llu bytes (%.*s)", seconds, record.threadIndex, GetNrcMemoryEventName(record.memoryEventType),
+            (unsigned long long)record.size, textLength, record.text);
+    }
+}
+
+NrcLogFileSink::~NrcLogFileSink()
+{
+    if (m_file)
+        fclose(m_file);
+}
+
+bool NrcLogFileSink::Open(const std::string& path)
+{
+    if (m_file)
+        fclose(m_file);
+
+    m_file = fopen(path.c_str(), "w");
+    return m_file != nullptr;
+}
+
+void NrcLogFileSink::Write(const NrcLogRecord& record)
+{
+    if (!m_file)
+        return;
+
+    char line[c_NrcLogTextSize + 128];
+    FormatNrcLogRecord(record, line, sizeof(line));
+    fprintf(m_file, "%s\n", line);
+}
+
+void NrcLogFileSink::Flush()
+{
+    if (m_file)
+        fflush(m_file);
+}
+
+NrcLogJsonSink::~NrcLogJsonSink()
+{
+    if (m_file)
+        fclose(m_file);
+}
+
+bool NrcLogJsonSink::Open(const std::string& path)
+{
+    if (m_file)
+        fclose(m_file);
+
+    m_file = fopen(path.c_str(), "w");
+    return m_file != nullptr;
+}
+
+void NrcLogJsonSink::Write(const NrcLogRecord& record)
+{
+    if (!m_file)
+        return;
+
+    fprintf(m_file, "{\"time\":%.9f,\"thread\":%u,", double(record.time) * 1e-9, record.threadIndex);
+    if (record.type == NrcLogRecordType::Message)
+    {
+        fprintf(m_file, "\"level\":\"%s\",\"message\":", GetNrcLogLevelName(record.level));
+        WriteJsonString(m_file, record.text);
+    }
+    else
+    {
+        fprintf(m_file, "\"event\":\"%s\",\"size\":%llu", GetNrcMemoryEventName(record.memoryEventType), (unsigned long long)record.size);
+        if (record.memoryEventType != NrcMemoryEventType::MemoryStats)
+        {
+            fprintf(m_file, ",\"buffer\":");
+            WriteJsonString(m_file, record.text);
+        }
+    }
+    fprintf(m_file, "}\n");
+}
+
+void NrcLogJsonSink::Flush()
+{
+    if (m_file)
+        fflush(m_file);
+}
+
+NrcLogQueue::NrcLogQueue(const NrcLogQueueDesc& desc) : m_desc(desc), m_startTime(std::chrono::steady_clock::now())
+{
+    uint64_t capacity = 2;
+    while (capacity < m_desc.capacity)
+        capacity *= 2;
+    m_desc.capacity = uint32_t(capacity);
+    m_mask = capacity - 1;
+
+    // A cell is free for the push at the position equal to its sequence, and holds a record for the drain once it is one more
+    m_cells = std::make_unique<Cell[]>(capacity);
+    for (uint64_t cellIndex = 0; cellIndex < capacity; ++cellIndex)
+        m_cells[cellIndex].sequence.store(cellIndex, std::memory_order_relaxed);
+
+    m_thread = std::thread(&NrcLogQueue::DrainThread, this);
+}
+
+NrcLogQueue::~NrcLogQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeCondition.notify_one();
+    m_thread.join();
+}
+
+void NrcLogQueue::AddSink(NrcLogSink* sink)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sinks.push_back(sink);
+}
+
+void NrcLogQueue::RemoveSink(NrcLogSink* sink)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sinks.erase(std::remove(m_sinks.begin(), m_sinks.end(), sink), m_sinks.end());
+}
+
+bool NrcLogQueue::PushMessage(NrcLogLevel level, const char* message)
+{
+    const uint64_t time = GetTime();
+    if (IsRateLimited(time))
+        return false;
+
+    uint64_t position;
+    NrcLogRecord* record = BeginPush(position);
+    if (!record)
+        return false;
+
+    record->time = time;
+    record->size = 0;
+    record->type = NrcLogRecordType::Message;
+    record->level = level;
+    record->memoryEventType = NrcMemoryEventType::MemoryStats;
+    record->threadIndex = GetThreadIndex();
+    CopyText(record->text, message);
+
+    EndPush(position);
+    return true;
+}
+
+bool NrcLogQueue::PushMemoryEvent(NrcMemoryEventType eventType, uint64_t size, const char* bufferName)
+{
+    const uint64_t time = GetTime();
+    if (IsRateLimited(time))
+        return false;
+
+    uint64_t position;
+    NrcLogRecord* record = BeginPush(position);
+    if (!record)
+        return false;
+
+    record->time = time;
+    record->size = size;
+    record->type = NrcLogRecordType::MemoryEvent;
+    record->level = NrcLogLevel::Debug;
+    record->memoryEventType = eventType;
+    record->threadIndex = GetThreadIndex();
+    CopyText(record->text, bufferName);
+
+    EndPush(position);
+    return true;
+}
+
+NrcLogRecord* NrcLogQueue::BeginPush(uint64_t& position)
+{
+    uint64_t writePosition = m_writePosition.load(std::memory_order_relaxed);
+    while (true)
+    {
+        Cell& cell = m_cells[writePosition & m_mask];
+        const int64_t difference = int64_t(cell.sequence.load(std::memory_order_acquire) - writePosition);
+        if (difference == 0)
+        {
+            // Claim the cell, on failure writePosition is reloaded
+            if (m_writePosition.compare_exchange_weak(writePosition, writePosition + 1, std::memory_order_relaxed))
+            {
+                position = writePosition;
+                return &cell.record;
+            }
+        }
+        else if (difference < 0)
+        {
+            // The drain hasn't freed the cell of the previous lap yet
+            m_droppedNum.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        else
+        {
+            writePosition = m_writePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void NrcLogQueue::EndPush(uint64_t position)
+{
+    m_cells[position & m_mask].sequence.store(position + 1, std::memory_order_release);
+}
+
+bool NrcLogQueue::IsRateLimited(uint64_t time)
+{
+    if (m_desc.maxRecordsPerSecond == 0)
+        return false;
+
+    // The thread that moves the window on resets the count, others may be counted in either window
+    uint64_t windowStart = m_windowStart.load(std::memory_order_relaxed);
+    if (time >= windowStart + c_RateLimitWindow && m_windowStart.compare_exchange_strong(windowStart, time, std::memory_order_relaxed))
+        m_windowRecordNum.store(0, std::memory_order_relaxed);
+
+    if (m_windowRecordNum.fetch_add(1, std::memory_order_relaxed) < m_desc.maxRecordsPerSecond)
+        return false;
+
+    m_rateLimitedNum.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+uint64_t NrcLogQueue::GetTime() const
+{
+    return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_startTime).count());
+}
+
+void NrcLogQueue::Flush()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    const uint64_t flushPosition = m_writePosition.load(std::memory_order_acquire);
+    m_flushPosition = std::max(m_flushPosition, flushPosition);
+    m_wakeCondition.notify_one();
+
+    m_drainedCondition.wait(lock, [&]() { return m_readPosition.load(std::memory_order_relaxed) >= flushPosition; });
+}
+
+void NrcLogQueue::DrainThread()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (true)
+    {
+        m_wakeCondition.wait_for(lock, std::chrono::milliseconds(m_desc.drainIntervalMs),
+            [&]() { return m_stop || m_flushPosition > m_readPosition.load(std::memory_order_relaxed); });
+
+        const bool stop = m_stop;
+        if (Drain())
+        {
+            for (NrcLogSink* sink : m_sinks)
+                sink->Flush();
+        }
+        m_drainedCondition.notify_all();
+
+        // Pushes racing with the destruction are lost
+        if (stop)
+            break;
+    }
+}
+
+bool NrcLogQueue::Drain()
+{
+    bool hasWritten = false;
+
+    uint64_t readPosition = m_readPosition.load(std::memory_order_relaxed);
+    while (true)
+    {
+        Cell& cell = m_cells[readPosition & m_mask];
+        if (cell.sequence.load(std::memory_order_acquire) != readPosition + 1)
+            break;
+
+        // Copy out so the cell is free again before the sinks run
+        const NrcLogRecord record = cell.record;
+        cell.sequence.store(readPosition + m_mask + 1, std::memory_order_release);
+        readPosition++;
+        m_readPosition.store(readPosition, std::memory_order_relaxed);
+
+        WriteToSinks(record);
+        m_writtenNum.fetch_add(1, std::memory_order_relaxed);
+        hasWritten = true;
+    }
+
+    const uint64_t droppedNum = GetDroppedNum() + GetRateLimitedNum();
+    if (droppedNum != m_reportedDroppedNum)
+    {
+        NrcLogRecord record = {};
+        record.time = GetTime();
+        record.type = NrcLogRecordType::Message;
+        record.level = NrcLogLevel::Warning;
+        record.threadIndex = GetThreadIndex();
+        snprintf(record.text, sizeof(record.text), "%llu log records dropped (queue full or rate limited)", (unsigned long long)(droppedNum - m_reportedDroppedNum));
+        m_reportedDroppedNum = droppedNum;
+
+        WriteToSinks(record);
+        hasWritten = true;
+    }
+
+    return hasWritten;
+}
+
+void NrcLogQueue::WriteToSinks(const NrcLogRecord& record)
+{
+    for (NrcLogSink* sink : m_sinks)
+        sink->Write(record);
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Carries the log messages and memory events of the NRC SDK callbacks off the calling thread.
+// Records have a fixed size and are copied into a bounded lock free ring with a sequence number per cell, so any number of
+// threads can push without locking or allocating. A background thread drains the ring every few milliseconds and passes
+// the records on to the sinks, which do all of the formatting. Records that find the ring full or exceed the rate limit
+// are dropped and counted, the drain thread reports the count to the sinks.
+
+static const uint32_t c_NrcLogTextSize = 224;
+
+enum class NrcLogRecordType : uint32_t
+{
+    Message,
+    MemoryEvent,
+};
+
+enum class NrcLogLevel : uint32_t
+{
+    Debug,
+    Info,
+    Warning,
+    Error,
+};
+
+enum class NrcMemoryEventType : uint32_t
+{
+    Allocation,
+    Deallocation,
+    MemoryStats,
+};
+
+struct NrcLogRecord
+{
+    uint64_t time; // Nanoseconds since the queue was created
+    uint64_t size; // MemoryEvent
+    NrcLogRecordType type;
+    NrcLogLevel level;
+    NrcMemoryEventType memoryEventType; // MemoryEvent
+    uint32_t threadIndex; // In the order the threads first pushed
+    char text[c_NrcLogTextSize]; // Message or buffer name, truncated and null terminated
+};
+
+// Formats a record as a single line without a line break, truncated to the buffer
+void FormatNrcLogRecord(const NrcLogRecord& record, char* buffer, size_t bufferSize);
+const char* GetNrcLogLevelName(NrcLogLevel level);
+const char* GetNrcMemoryEventName(NrcMemoryEventType eventType);
+
+// Called on the drain thread only
+class NrcLogSink
+{
+public:
+    virtual ~NrcLogSink() = default;
+
+    virtual void Write(const NrcLogRecord& record) = 0;
+
+    // After every drain that wrote records
+    virtual void Flush()
+    {
+    }
+};
+
+// Writes a line of text per record
+class NrcLogFileSink : public NrcLogSink
+{
+public:
+    ~NrcLogFileSink() override;
+
+    bool Open(const std::string& path);
+    void Write(const NrcLogRecord& record) override;
+    void Flush() override;
+
+private:
+    FILE* m_file = nullptr;
+};
+
+// Writes a JSON object per line
+class NrcLogJsonSink : public NrcLogSink
+{
+public:
+    ~NrcLogJsonSink() override;
+
+    bool Open(const std::string& path);
+    void Write(const NrcLogRecord& record) override;
+    void Flush() override;
+
+private:
+    FILE* m_file = nullptr;
+};
+
+struct NrcLogQueueDesc
+{
+    uint32_t capacity = 4096; // Records, rounded up to a power of two
+    uint32_t maxRecordsPerSecond = 10000; // 0 disables the rate limit
+    uint32_t drainIntervalMs = 2;
+};
+
+class NrcLogQueue
+{
+public:
+    explicit NrcLogQueue(const NrcLogQueueDesc& desc = NrcLogQueueDesc());
+
+    // Drains the remaining records
+    ~NrcLogQueue();
+
+    NrcLogQueue(const NrcLogQueue&) = delete;
+    NrcLogQueue& operator=(const NrcLogQueue&) = delete;
+
+    const NrcLogQueueDesc& GetDesc() const
+    {
+        return m_desc;
+    }
+
+    // The sinks are owned by the caller and have to outlive the queue or be removed
+    void AddSink(NrcLogSink* sink);
+    void RemoveSink(NrcLogSink* sink);
+
+    // Thread safe, lock free and never allocate. Return false if the record was dropped
+    bool PushMessage(NrcLogLevel level, const char* message);
+    bool PushMemoryEvent(NrcMemoryEventType eventType, uint64_t size, const char* bufferName);
+
+    // Waits until the records pushed before the call have been written to the sinks
+    void Flush();
+
+    // Ring full
+    uint64_t GetDroppedNum() const
+    {
+        return m_droppedNum.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetRateLimitedNum() const
+    {
+        return m_rateLimitedNum.load(std::memory_order_relaxed);
+    }
+
+    uint64_t GetWrittenNum() const
+    {
+        return m_writtenNum.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct alignas(64) Cell
+    {
+        std::atomic<uint64_t> sequence;
+        NrcLogRecord record;
+    };
+
+    NrcLogRecord* BeginPush(uint64_t& position);
+    void EndPush(uint64_t position);
+    bool IsRateLimited(uint64_t time);
+    uint64_t GetTime() const;
+
+    void DrainThread();
+    bool Drain();
+    void WriteToSinks(const NrcLogRecord& record);
+
+    NrcLogQueueDesc m_desc;
+    std::chrono::steady_clock::time_point m_startTime;
+
+    std::unique_ptr<Cell[]> m_cells;
+    uint64_t m_mask;
+    alignas(64) std::atomic<uint64_t> m_writePosition = 0;
+    alignas(64) std::atomic<uint64_t> m_readPosition = 0;
+
+    // Rate limit over one second windows
+    alignas(64) std::atomic<uint64_t> m_windowStart = 0;
+    std::atomic<uint32_t> m_windowRecordNum = 0;
+
+    std::atomic<uint64_t> m_droppedNum = 0;
+    std::atomic<uint64_t> m_rateLimitedNum = 0;
+    std::atomic<uint64_t> m_writtenNum = 0;
+
+    // Drain thread side
+    std::mutex m_mutex;
+    std::condition_variable m_wakeCondition;
+    std::condition_variable m_drainedCondition;
+    bool m_stop = false;
+    uint64_t m_flushPosition = 0;
+    std::vector<NrcLogSink*> m_sinks;
+    uint64_t m_reportedDroppedNum = 0;
+    std::thread m_thread;
+};
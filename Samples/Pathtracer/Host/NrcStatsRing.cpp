@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "NrcStatsRing.h"
+
+#include <algorithm>
+
+NrcStatsCsvSink::~NrcStatsCsvSink()
+{
+    if (m_file)
+        fclose(m_file);
+}
+
+bool NrcStatsCsvSink::Open(const std::string& path)
+{
+    if (m_file)
+        fclose(m_file);
+
+    m_file = fopen(path.c_str(), "w");
+    if (!m_file)
+        return false;
+
+    fprintf(m_file, "frame,training_loss,memory_size");
+    for (uint32_t counterIndex = 0; counterIndex < c_NrcMaxCounterNum; ++counterIndex)
+        fprintf(m_file, ",counter%u", counterIndex);
+    fprintf(m_file, "\n");
+
+    return true;
+}
+
+void NrcStatsCsvSink::Write(const NrcFrameStats& stats)
+{
+    if (!m_file)
+        return;
+
+    // Frames without a loss leave the column empty
+    fprintf(m_file, "%llu,", (unsigned long long)stats.frameIndex);
+    if (stats.hasTrainingLoss)
+        fprintf(m_file, "%g", stats.trainingLoss);
+    fprintf(m_file, ",%llu", (unsigned long long)stats.memorySize);
+
+    for (uint32_t counterIndex = 0; counterIndex < c_NrcMaxCounterNum; ++counterIndex)
+    {
+        if (counterIndex < stats.counterNum)
+            fprintf(m_file, ",%u", stats.counters[counterIndex]);
+        else
+            fprintf(m_file, ",");
+    }
+    fprintf(m_file, "\n");
+}
+
+NrcStatsRing::NrcStatsRing(const NrcStatsDesc& desc, NrcStatsFence& fence) : m_desc(desc), m_fence(fence)
+{
+    m_desc.frameLatency = std::max(m_desc.frameLatency, 1u);
+    m_desc.historyLength = std::max(m_desc.historyLength, 1u);
+
+    m_slots.resize(m_desc.frameLatency);
+}
+
+uint32_t NrcStatsRing::BeginFrame(uint64_t frameIndex)
+{
+    // Oldest slot first, the GPU finishes them in order
+    for (uint32_t slotOffset = 0; slotOffset < m_desc.frameLatency; ++slotOffset)
+    {
+        const uint32_t slotIndex = uint32_t((m_recordIndex + slotOffset) % m_desc.frameLatency);
+        Slot& slot = m_slots[slotIndex];
+        if (!slot.isPending)
+            continue;
+
+        if (!m_fence.IsSlotComplete(slotIndex))
+            break;
+
+        m_fence.ReadSlot(slotIndex, slot.stats);
+        slot.isPending = false;
+
+        if (m_history.size() >= m_desc.historyLength)
+            m_history.pop_front();
+        m_history.push_back(slot.stats);
+        m_readFrameNum++;
+
+        if (m_sink)
+            m_sink->Write(slot.stats);
+    }
+
+    // The copies of the oldest slot are overwritten whether it has been read or not
+    const uint32_t slotIndex = uint32_t(m_recordIndex % m_desc.frameLatency);
+    Slot& slot = m_slots[slotIndex];
+    if (slot.isPending)
+        m_droppedFrameNum++;
+
+    slot.stats = NrcFrameStats();
+    slot.stats.frameIndex = frameIndex;
+    slot.isPending = false;
+    m_isRecording = true;
+
+    return slotIndex;
+}
+
+void NrcStatsRing::EndFrame()
+{
+    if (!m_isRecording)
+        return;
+
+    m_slots[m_recordIndex % m_desc.frameLatency].isPending = true;
+
+    m_recordIndex++;
+    m_isRecording = false;
+}
+
+void NrcStatsRing::Reset()
+{
+    for (Slot& slot : m_slots)
+        slot.isPending = false;
+
+    m_isRecording = false;
+    m_history.clear();
+}
+
+const NrcFrameStats* NrcStatsRing::GetLastTrainingLoss() const
+{
+    for (auto it = m_history.rbegin(); it != m_history.rend(); ++it)
+    {
+        if (it->hasTrainingLoss)
+            return &*it;
+    }
+
+    return nullptr;
+}
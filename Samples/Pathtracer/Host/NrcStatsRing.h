@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <deque>
+#include <string>
+#include <vector>
+
+// Collects NRC statistics with a few frames of latency, without waiting for the GPU.
+// Every frame copies the GPU values into a slot of a ring, the slot is read once an NrcStatsFence reports it complete.
+// Slots complete in submission order, the oldest slot is reused whether it has been read or not, so a frame whose
+// copies are still pending by then is dropped instead of stalling. Read frames form a time series for the UI and are
+// passed on to an optional NrcStatsSink.
+
+static const uint32_t c_NrcMaxCounterNum = 8;
+
+struct NrcFrameStats
+{
+    uint64_t frameIndex = 0;
+
+    // Training loss of the frame, only evaluated on some frames
+    bool hasTrainingLoss = false;
+    float trainingLoss = 0.0f;
+
+    // Start of the NRC counter buffer (query and training path counts)
+    uint32_t counterNum = 0;
+    uint32_t counters[c_NrcMaxCounterNum] = {};
+
+    // GPU memory of the NRC buffers
+    uint64_t memorySize = 0;
+};
+
+struct NrcStatsDesc
+{
+    // Frames in flight, a slot is reused after this many frames
+    uint32_t frameLatency = 3;
+
+    // Read frames kept in the time series
+    uint32_t historyLength = 256;
+};
+
+class NrcStatsFence
+{
+public:
+    virtual ~NrcStatsFence() = default;
+
+    // True once the GPU finished the copies recorded into the slot, never waits
+    virtual bool IsSlotComplete(uint32_t slotIndex) = 0;
+
+    // Adds the values the GPU wrote into a complete slot to 'stats'
+    virtual void ReadSlot(uint32_t slotIndex, NrcFrameStats& stats) = 0;
+};
+
+class NrcStatsSink
+{
+public:
+    virtual ~NrcStatsSink() = default;
+
+    virtual void Write(const NrcFrameStats& stats) = 0;
+};
+
+// Writes a line of comma separated values per frame
+class NrcStatsCsvSink : public NrcStatsSink
+{
+public:
+    ~NrcStatsCsvSink() override;
+
+    bool Open(const std::string& path);
+    void Write(const NrcFrameStats& stats) override;
+
+private:
+    FILE* m_file = nullptr;
+};
+
+class NrcStatsRing
+{
+public:
+    static const uint32_t c_NoSlot = ~0u;
+
+    NrcStatsRing(const NrcStatsDesc& desc, NrcStatsFence& fence);
+
+    const NrcStatsDesc& GetDesc() const
+    {
+        return m_desc;
+    }
+
+    void SetSink(NrcStatsSink* sink)
+    {
+        m_sink = sink;
+    }
+
+    // Reads the complete slots and returns the slot the frame records its copies into. The CPU side values
+    // of the frame go into GetRecordedStats()
+    uint32_t BeginFrame(uint64_t frameIndex);
+    void EndFrame();
+
+    NrcFrameStats& GetRecordedStats()
+    {
+        return m_slots[m_recordIndex % m_desc.frameLatency].stats;
+    }
+
+    // Forgets the pending slots and the time series, the slots have to be recreated by the caller
+    void Reset();
+
+    // Oldest frame first
+    const std::deque<NrcFrameStats>& GetHistory() const
+    {
+        return m_history;
+    }
+
+    // Last frame with a training loss, null if there is none in the time series
+    const NrcFrameStats* GetLastTrainingLoss() const;
+
+    uint64_t GetReadFrameNum() const
+    {
+        return m_readFrameNum;
+    }
+
+    uint64_t GetDroppedFrameNum() const
+    {
+        return m_droppedFrameNum;
+    }
+
+private:
+    struct Slot
+    {
+        NrcFrameStats stats;
+        bool isPending = false;
+    };
+
+    NrcStatsDesc m_desc;
+    NrcStatsFence& m_fence;
+    NrcStatsSink* m_sink = nullptr;
+
+    std::vector<Slot> m_slots;
+    uint64_t m_recordIndex = 0;
+    bool m_isRecording = false;
+
+    std::deque<NrcFrameStats> m_history;
+    uint64_t m_readFrameNum = 0;
+    uint64_t m_droppedFrameNum = 0;
+};
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "NrcTrainingBudgetController.h"
+
+#include <algorithm>
+#include <cmath>
+
+NrcTrainingBudgetController::NrcTrainingBudgetController(const NrcTrainingBudgetDesc& desc) : m_desc(desc)
+{
+    m_desc.maxIterationNum = std::max(m_desc.maxIterationNum, 1u);
+    m_desc.minEffort = std::clamp(m_desc.minEffort, 0.001f, 1.0f);
+    m_desc.minDimensionScale = std::clamp(m_desc.minDimensionScale, 0.001f, 1.0f);
+    m_desc.targetTime = std::max(m_desc.targetTime, 0.001f);
+
+    Reset();
+}
+
+void NrcTrainingBudgetController::SetTargetTime(float targetTime)
+{
+    m_desc.targetTime = std::max(targetTime, 0.001f);
+}
+
+NrcTrainingBudget NrcTrainingBudgetController::ComputeBudget(float effort) const
+{
+    // Work in units of one iteration over the ideal training dimensions, the fewest iterations that fit come first
+    const float work = effort * m_desc.maxIterationNum;
+
+    NrcTrainingBudget budget;
+    budget.effort = effort;
+    budget.iterationNum = std::clamp(uint32_t(std::ceil(work - 1e-4f)), 1u, m_desc.maxIterationNum);
+    budget.dimensionScale = std::clamp(work / budget.iterationNum, m_desc.minDimensionScale, 1.0f);
+    budget.primarySegmentScale = std::clamp(effort, m_desc.minPrimarySegmentScale, 1.0f);
+
+    return budget;
+}
+
+void NrcTrainingBudgetController::ReportTime(uint64_t sampleIndex, float time)
+{
+    if (m_hasSample && sampleIndex <= m_lastSampleIndex)
+        return;
+
+    m_hasSample = true;
+    m_lastSampleIndex = sampleIndex;
+    m_lastTime = time;
+
+    // Positive with time to spare
+    const float error = (m_desc.targetTime - time) / m_desc.targetTime;
+
+    float deltaEffort = m_desc.integralGain * error;
+    if (m_errorNum >= 1)
+        deltaEffort += m_desc.proportionalGain * (error - m_lastErrors[0]);
+    if (m_errorNum >= 2)
+        deltaEffort += m_desc.derivativeGain * (error - 2.0f * m_lastErrors[0] + m_lastErrors[1]);
+
+    m_lastErrors[1] = m_lastErrors[0];
+    m_lastErrors[0] = error;
+    m_errorNum = std::min(m_errorNum + 1, 2u);
+
+    const float effort = std::clamp(m_budget.effort + deltaEffort, m_desc.minEffort, m_maxEffort);
+    m_budget = ComputeBudget(effort);
+}
+
+void NrcTrainingBudgetController::ReportTrainingLoss(uint64_t frameIndex, float loss)
+{
+    if (m_hasLoss && frameIndex <= m_lastLossFrame)
+        return;
+
+    m_smoothedLoss = m_hasLoss ? m_smoothedLoss + (loss - m_smoothedLoss) * m_desc.lossHistoryWeight : loss;
+    m_hasLoss = true;
+    m_lastLossFrame = frameIndex;
+
+    UpdateMaxEffort();
+    if (m_budget.effort > m_maxEffort)
+        m_budget = ComputeBudget(m_maxEffort);
+}
+
+void NrcTrainingBudgetController::UpdateMaxEffort()
+{
+    m_maxEffort = 1.0f;
+    if (m_desc.lossTarget > 0.0f && m_hasLoss)
+        m_maxEffort = std::clamp(m_smoothedLoss / m_desc.lossTarget, m_desc.minEffort, 1.0f);
+}
+
+void NrcTrainingBudgetController::Reset()
+{
+    m_hasSample = false;
+    m_lastSampleIndex = 0;
+    m_lastTime = 0.0f;
+    m_errorNum = 0;
+    m_lastErrors[0] = m_lastErrors[1] = 0.0f;
+
+    m_hasLoss = false;
+    m_lastLossFrame = 0;
+    m_smoothedLoss = 0.0f;
+    UpdateMaxEffort();
+
+    m_budget = ComputeBudget(std::clamp(m_desc.initialEffort, m_desc.minEffort, 1.0f));
+}
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+// Adjusts the NRC training work to hold the GPU time of the training passes at a target.
+// A single effort value in [minEffort, 1] stands for the fraction of the full training work: the iteration count, the share
+// of the ideal training dimensions and the share of primary segments trained on are derived from it. Every new time sample
+// moves the effort with a PID step on the relative error, in velocity form, so saturation doesn't wind up. Samples are expected
+// to lag the effort they measure by a few frames, the gains are kept low accordingly. With a loss target, the effort is
+// additionally capped while the smoothed training loss is below the target, so a converged cache isn't trained at full cost.
+// The controller only sees the samples passed in, so it can be tuned against a simulated plant.
+
+struct NrcTrainingBudgetDesc
+{
+    float targetTime = 2.0f; // Milliseconds
+
+    // Applied to the error relative to the target, once per time sample
+    float proportionalGain = 0.2f;
+    float integralGain = 0.05f;
+    float derivativeGain = 0.0f;
+
+    float initialEffort = 0.25f;
+    float minEffort = 0.05f;
+
+    uint32_t maxIterationNum = 4;
+    float minDimensionScale = 0.25f; // Of the ideal training pixels
+    float minPrimarySegmentScale = 0.25f; // Of the configured proportion of primary segments
+
+    // 0 ignores the loss, otherwise the effort is capped at the smoothed loss over the target
+    float lossTarget = 0.0f;
+    float lossHistoryWeight = 0.2f;
+};
+
+struct NrcTrainingBudget
+{
+    float effort = 0.0f;
+    uint32_t iterationNum = 1;
+    float dimensionScale = 1.0f; // Of the training pixels, applied to the area
+    float primarySegmentScale = 1.0f;
+};
+
+class NrcTrainingBudgetController
+{
+public:
+    explicit NrcTrainingBudgetController(const NrcTrainingBudgetDesc& desc = NrcTrainingBudgetDesc());
+
+    const NrcTrainingBudgetDesc& GetDesc() const
+    {
+        return m_desc;
+    }
+
+    void SetTargetTime(float targetTime);
+
+    // Time in milliseconds of the training passes. Samples with an index not above the last one are ignored
+    void ReportTime(uint64_t sampleIndex, float time);
+
+    // Training loss evaluated on 'frameIndex', repeated frames are ignored
+    void ReportTrainingLoss(uint64_t frameIndex, float loss);
+
+    // Back to the initial effort, forgets the error history and the loss
+    void Reset();
+
+    const NrcTrainingBudget& GetBudget() const
+    {
+        return m_budget;
+    }
+
+    // Upper bound of the effort from the training loss
+    float GetMaxEffort() const
+    {
+        return m_maxEffort;
+    }
+
+    float GetLastTime() const
+    {
+        return m_lastTime;
+    }
+
+    float GetSmoothedLoss() const
+    {
+        return m_smoothedLoss;
+    }
+
+    // Split of an effort into the training settings
+    NrcTrainingBudget ComputeBudget(float effort) const;
+
+private:
+    void UpdateMaxEffort();
+
+    NrcTrainingBudgetDesc m_desc;
+    NrcTrainingBudget m_budget;
+
+    bool m_hasSample = false;
+    uint64_t m_lastSampleIndex = 0;
+    float m_lastTime = 0.0f;
+    uint32_t m_errorNum = 0;
+    float m_lastErrors[2] = {}; // Previous first
+
+    bool m_hasLoss = false;
+    uint64_t m_lastLossFrame = 0;
+    float m_smoothedLoss = 0.0f;
+    float m_maxEffort = 1.0f;
+};
@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+void ParallelFor(uint32_t num, const std::function<void(uint32_t)>& function, uint32_t maxThreadNum)
+{
+    if (maxThreadNum == 0)
+        maxThreadNum = std::max(std::thread::hardware_concurrency(), 1u);
+
+    const uint32_t threadNum = std::min(maxThreadNum, num);
+
+    std::atomic<uint32_t> nextIndex = 0;
+    auto worker = [&]()
+    {
+        for (uint32_t index = nextIndex++; index < num; index = nextIndex++)
+            function(index);
+    };
+
+    std::vector<std::thread> threads;
+    for (uint32_t threadIndex = 1; threadIndex < threadNum; ++threadIndex)
+        threads.emplace_back(worker);
+
+    worker();
+
+    for (std::thread& thread : threads)
+        thread.join();
+}
@@ -0,0 +1,18 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+// Calls 'function' for every index in [0, num) on the calling thread and up to 'maxThreadNum' - 1 workers, 0 uses all hardware threads.
+// Indices are handed out one at a time, so uneven work is balanced. Returns once all calls have finished
+void ParallelFor(uint32_t num, const std::function<void(uint32_t)>& function, uint32_t maxThreadNum = 0);
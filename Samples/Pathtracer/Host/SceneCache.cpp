@@ -0,0 +1,427 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "SceneCache.h"
+#include "ParallelFor.h"
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else // !_WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // !_WIN32
+
+namespace
+{
+const uint32_t c_Magic = 0x43534352; // "RCSC"
+const uint32_t c_SectionNum = uint32_t(SceneCacheSection::Count);
+
+const uint64_t c_HashOffsetBasis = 0xcbf29ce484222325ull;
+const size_t c_HashReadSize = 1 << 20;
+
+struct CacheHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t flags;
+    uint32_t reserved;
+    uint64_t sectionOffsets[c_SectionNum];
+    uint64_t sectionSizes[c_SectionNum];
+};
+
+// Element sizes of the sections, sections are arrays of whole elements
+const uint64_t c_SectionElementSizes[c_SectionNum] = {
+    sizeof(float) * 3, sizeof(float) * 3, sizeof(float) * 2, sizeof(uint32_t), sizeof(SceneCacheGeometry), sizeof(SceneCacheMesh),
+    sizeof(SceneCacheMaterial), sizeof(SceneCacheInstance), sizeof(SceneCacheLight), sizeof(SceneCacheCamera), sizeof(SceneCacheSource), sizeof(char),
+};
+
+uint64_t AlignOffset(uint64_t offset)
+{
+    return (offset + c_SceneCacheAlignment - 1) / c_SceneCacheAlignment * c_SceneCacheAlignment;
+}
+
+// FNV-1a
+void HashBytes(uint64_t& hash, const void* data, size_t size)
+{
+    const uint8_t* bytes = (const uint8_t*)data;
+    for (size_t i = 0; i < size; ++i)
+    {
+        hash ^= bytes[i];
+        hash *= 0x100000001b3ull;
+    }
+}
+} // namespace
+
+uint32_t SceneCacheData::AddString(const std::string& string)
+{
+    if (string.empty())
+        return c_SceneCacheInvalidString;
+
+    const uint32_t offset = uint32_t(strings.size());
+    strings.insert(strings.end(), string.begin(), string.end());
+    strings.push_back('\0');
+
+    return offset;
+}
+
+void SceneCacheData::AddSource(const std::string& path, const void* contents, size_t size)
+{
+    SceneCacheSource source = {};
+    source.path = AddString(path);
+    source.size = size;
+    source.hash = SceneCacheHash(contents, size);
+    sources.push_back(source);
+}
+
+uint64_t SceneCacheHash(const void* data, size_t size)
+{
+    uint64_t hash = c_HashOffsetBasis;
+    HashBytes(hash, data, size);
+
+    return hash;
+}
+
+bool SceneCacheHashFile(const std::filesystem::path& path, uint64_t& size, uint64_t& hash)
+{
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream)
+        return false;
+
+    std::vector<char> buffer(c_HashReadSize);
+    size = 0;
+    hash = c_HashOffsetBasis;
+    while (stream)
+    {
+        stream.read(buffer.data(), buffer.size());
+        HashBytes(hash, buffer.data(), size_t(stream.gcount()));
+        size += uint64_t(stream.gcount());
+    }
+
+    return stream.eof();
+}
+
+bool SceneCacheWrite(std::ostream& stream, const SceneCacheData& data)
+{
+    const void* sectionData[c_SectionNum] = {
+        data.positions.data(), data.normals.data(), data.texCoords.data(), data.indices.data(), data.geometries.data(),
+        data.meshes.data(), data.materials.data(), data.instances.data(), data.lights.data(), data.cameras.data(), data.sources.data(),
+        data.strings.data(),
+    };
+    const uint64_t sectionSizes[c_SectionNum] = {
+        data.positions.size() * sizeof(float),
+        data.normals.size() * sizeof(float),
+        data.texCoords.size() * sizeof(float),
+        data.indices.size() * sizeof(uint32_t),
+        data.geometries.size() * sizeof(SceneCacheGeometry),
+        data.meshes.size() * sizeof(SceneCacheMesh),
+        data.materials.size() * sizeof(SceneCacheMaterial),
+        data.instances.size() * sizeof(SceneCacheInstance),
+        data.lights.size() * sizeof(SceneCacheLight),
+        data.cameras.size() * sizeof(SceneCacheCamera),
+        data.sources.size() * sizeof(SceneCacheSource),
+        data.strings.size(),
+    };
+
+    CacheHeader header = {};
+    header.magic = c_Magic;
+    header.version = c_SceneCacheVersion;
+    header.flags = data.flags;
+
+    uint64_t offset = sizeof(header);
+    for (uint32_t section = 0; section < c_SectionNum; ++section)
+    {
+        offset = AlignOffset(offset);
+        header.sectionOffsets[section] = offset;
+        header.sectionSizes[section] = sectionSizes[section];
+        offset += sectionSizes[section];
+    }
+
+    stream.write((const char*)&header, sizeof(header));
+
+    const char padding[c_SceneCacheAlignment] = {};
+    offset = sizeof(header);
+    for (uint32_t section = 0; section < c_SectionNum; ++section)
+    {
+        stream.write(padding, header.sectionOffsets[section] - offset);
+        stream.write((const char*)sectionData[section], sectionSizes[section]);
+        offset = header.sectionOffsets[section] + sectionSizes[section];
+    }
+
+    return bool(stream);
+}
+
+bool SceneCacheWriteFile(const std::filesystem::path& path, const SceneCacheData& data)
+{
+    // Written next to the destination first, a failed write keeps the previous cache
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp";
+
+    {
+        std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+        if (!stream || !SceneCacheWrite(stream, data))
+        {
+            stream.close();
+            std::error_code errorCode;
+            std::filesystem::remove(tempPath, errorCode);
+            return false;
+        }
+    }
+
+    std::error_code errorCode;
+    std::filesystem::rename(tempPath, path, errorCode);
+
+    return !errorCode;
+}
+
+SceneCacheReader::~SceneCacheReader()
+{
+    Close();
+}
+
+bool SceneCacheReader::Open(const std::filesystem::path& path)
+{
+    Close();
+
+#if defined(_WIN32)
+    HANDLE fileHandle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        return false;
+    m_fileHandle = fileHandle;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+    {
+        Close();
+        return false;
+    }
+
+    m_mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mappingHandle)
+    {
+        Close();
+        return false;
+    }
+
+    m_mappedData = MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    m_size = size_t(fileSize.QuadPart);
+#else // !_WIN32
+    const int fileDescriptor = open(path.c_str(), O_RDONLY);
+    if (fileDescriptor < 0)
+        return false;
+
+    struct stat fileStat;
+    if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        close(fileDescriptor);
+        return false;
+    }
+
+    m_size = size_t(fileStat.st_size);
+    void* mappedData = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    close(fileDescriptor);
+
+    m_mappedData = (mappedData != MAP_FAILED) ? mappedData : nullptr;
+#endif // !_WIN32
+
+    if (!m_mappedData)
+    {
+        Close();
+        return false;
+    }
+
+    m_data = (const uint8_t*)m_mappedData;
+    if (!Parse())
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+bool SceneCacheReader::Open(const void* data, size_t size)
+{
+    Close();
+
+    m_data = (const uint8_t*)data;
+    m_size = size;
+    if (!m_data || !Parse())
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void SceneCacheReader::Close()
+{
+    Unmap();
+
+    m_data = nullptr;
+    m_size = 0;
+    m_flags = 0;
+    memset(m_sectionOffsets, 0, sizeof(m_sectionOffsets));
+    memset(m_sectionSizes, 0, sizeof(m_sectionSizes));
+}
+
+void SceneCacheReader::Unmap()
+{
+#if defined(_WIN32)
+    if (m_mappedData)
+        UnmapViewOfFile(m_mappedData);
+    if (m_mappingHandle)
+        CloseHandle(m_mappingHandle);
+    if (m_fileHandle)
+        CloseHandle(m_fileHandle);
+    m_mappingHandle = nullptr;
+    m_fileHandle = nullptr;
+#else // !_WIN32
+    if (m_mappedData)
+        munmap(m_mappedData, m_size);
+#endif // !_WIN32
+    m_mappedData = nullptr;
+}
+
+bool SceneCacheReader::IsCurrent(const std::filesystem::path& cacheDirectory) const
+{
+    uint32_t sourceNum;
+    const SceneCacheSource* sources = GetSection<SceneCacheSource>(SceneCacheSection::Sources, sourceNum);
+    if (!m_data || sourceNum == 0)
+        return false;
+
+    // A changed size is found without reading the file, the contents of the others are hashed on all cores
+    for (uint32_t sourceIndex = 0; sourceIndex < sourceNum; ++sourceIndex)
+    {
+        std::error_code errorCode;
+        const uint64_t fileSize = std::filesystem::file_size(cacheDirectory / GetString(sources[sourceIndex].path), errorCode);
+        if (errorCode || fileSize != sources[sourceIndex].size)
+            return false;
+    }
+
+    std::atomic<bool> isCurrent = true;
+    ParallelFor(sourceNum, [&](uint32_t sourceIndex) {
+        uint64_t size, hash;
+        if (!SceneCacheHashFile(cacheDirectory / GetString(sources[sourceIndex].path), size, hash) || size != sources[sourceIndex].size || hash != sources[sourceIndex].hash)
+            isCurrent = false;
+    });
+
+    return isCurrent;
+}
+
+const void* SceneCacheReader::GetSection(SceneCacheSection section, uint64_t& size) const
+{
+    size = m_sectionSizes[uint32_t(section)];
+
+    return m_data ? m_data + m_sectionOffsets[uint32_t(section)] : nullptr;
+}
+
+const char* SceneCacheReader::GetString(uint32_t offset) const
+{
+    const uint32_t stringIndex = uint32_t(SceneCacheSection::Strings);
+    if (offset >= m_sectionSizes[stringIndex])
+        return "";
+
+    return (const char*)m_data + m_sectionOffsets[stringIndex] + offset;
+}
+
+bool SceneCacheReader::Parse()
+{
+    if (m_size < sizeof(CacheHeader))
+        return false;
+
+    CacheHeader header;
+    memcpy(&header, m_data, sizeof(header));
+    if (header.magic != c_Magic || header.version != c_SceneCacheVersion)
+        return false;
+
+    for (uint32_t section = 0; section < c_SectionNum; ++section)
+    {
+        const uint64_t offset = header.sectionOffsets[section];
+        const uint64_t size = header.sectionSizes[section];
+        if (offset % c_SceneCacheAlignment != 0 || offset < sizeof(header) || offset > m_size || size > m_size - offset || size % c_SectionElementSizes[section] != 0)
+            return false;
+
+        m_sectionOffsets[section] = offset;
+        m_sectionSizes[section] = size;
+    }
+    m_flags = header.flags;
+
+    // The tables are trusted by the loader, so every reference is checked once here
+    uint32_t positionNum, normalNum, texCoordNum, indexNum, geometryNum, meshNum, materialNum, instanceNum, lightNum, sourceNum, stringSize;
+    GetSection<float[3]>(SceneCacheSection::Positions, positionNum);
+    GetSection<float[3]>(SceneCacheSection::Normals, normalNum);
+    GetSection<float[2]>(SceneCacheSection::TexCoords, texCoordNum);
+    GetSection<uint32_t>(SceneCacheSection::Indices, indexNum);
+    const SceneCacheGeometry* geometries = GetSection<SceneCacheGeometry>(SceneCacheSection::Geometries, geometryNum);
+    const SceneCacheMesh* meshes = GetSection<SceneCacheMesh>(SceneCacheSection::Meshes, meshNum);
+    GetSection<SceneCacheMaterial>(SceneCacheSection::Materials, materialNum);
+    const SceneCacheInstance* instances = GetSection<SceneCacheInstance>(SceneCacheSection::Instances, instanceNum);
+    const SceneCacheLight* lights = GetSection<SceneCacheLight>(SceneCacheSection::Lights, lightNum);
+    const SceneCacheSource* sources = GetSection<SceneCacheSource>(SceneCacheSection::Sources, sourceNum);
+    const char* strings = GetSection<char>(SceneCacheSection::Strings, stringSize);
+
+    if ((normalNum != 0 && normalNum != positionNum) || (texCoordNum != 0 && texCoordNum != positionNum))
+        return false;
+
+    if (stringSize != 0 && strings[stringSize - 1] != '\0')
+        return false;
+
+    for (uint32_t geometryIndex = 0; geometryIndex < geometryNum; ++geometryIndex)
+    {
+        const SceneCacheGeometry& geometry = geometries[geometryIndex];
+        if (uint64_t(geometry.indexOffset) + geometry.indexCount > indexNum || uint64_t(geometry.vertexOffset) + geometry.vertexCount > positionNum ||
+            geometry.materialIndex >= materialNum)
+            return false;
+    }
+
+    for (uint32_t meshIndex = 0; meshIndex < meshNum; ++meshIndex)
+    {
+        const SceneCacheMesh& mesh = meshes[meshIndex];
+        if (uint64_t(mesh.geometryOffset) + mesh.geometryCount > geometryNum)
+            return false;
+
+        for (uint32_t geometryIndex = mesh.geometryOffset; geometryIndex < mesh.geometryOffset + mesh.geometryCount; ++geometryIndex)
+        {
+            const SceneCacheGeometry& firstGeometry = geometries[mesh.geometryOffset];
+            if (geometries[geometryIndex].indexOffset < firstGeometry.indexOffset || geometries[geometryIndex].vertexOffset < firstGeometry.vertexOffset)
+                return false;
+        }
+    }
+
+    for (uint32_t instanceIndex = 0; instanceIndex < instanceNum; ++instanceIndex)
+    {
+        if (instances[instanceIndex].meshIndex >= meshNum)
+            return false;
+    }
+
+    for (uint32_t lightIndex = 0; lightIndex < lightNum; ++lightIndex)
+    {
+        if (lights[lightIndex].type >= uint32_t(SceneCacheLightType::Count))
+            return false;
+    }
+
+    for (uint32_t sourceIndex = 0; sourceIndex < sourceNum; ++sourceIndex)
+    {
+        if (sources[sourceIndex].path >= stringSize)
+            return false;
+    }
+
+    return true;
+}
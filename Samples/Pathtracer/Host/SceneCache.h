@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// Compiled form of a scene that is loaded without parsing the scene description and its models.
+// Vertex attributes and indices of all meshes are flattened into shared arrays next to the geometry, mesh, material,
+// instance, light and camera tables. Every section starts at a c_SceneCacheAlignment boundary, so a section of a mapped file can be copied
+// into an upload buffer as it is. The file records the size and content hash of every source file it was compiled from,
+// a cache whose sources changed is stale and the scene is loaded from the source files instead.
+
+const uint32_t c_SceneCacheVersion = 3;
+const uint64_t c_SceneCacheAlignment = 256;
+const uint32_t c_SceneCacheInvalidString = ~0u;
+
+enum class SceneCacheSection : uint32_t
+{
+    Positions, // float3
+    Normals, // float3
+    TexCoords, // float2
+    Indices, // uint32_t, relative to the first vertex of the geometry
+    Geometries,
+    Meshes,
+    Materials,
+    Instances,
+    Lights,
+    Cameras,
+    Sources,
+    Strings, // Null terminated strings referenced by their byte offset
+
+    Count
+};
+
+enum SceneCacheFlags : uint32_t
+{
+    // The sources hold content the cache can't represent, e.g. animations, skins or material extensions. The cache
+    // is still written for other tools, the sample loads such scenes from their sources
+    SceneCacheFlags_Partial = 1 << 0,
+};
+
+// Geometries of a mesh don't start before its first geometry in the index and vertex arrays
+struct SceneCacheGeometry
+{
+    uint32_t indexOffset;
+    uint32_t indexCount;
+    uint32_t vertexOffset;
+    uint32_t vertexCount;
+    uint32_t materialIndex;
+};
+
+struct SceneCacheMesh
+{
+    uint32_t name;
+    uint32_t geometryOffset;
+    uint32_t geometryCount;
+
+    // BLAS size hints, triangles and vertices of all geometries
+    uint32_t triangleNum;
+    uint32_t vertexNum;
+};
+
+enum SceneCacheMaterialFlags : uint32_t
+{
+    SceneCacheMaterialFlags_AlphaTested = 1 << 0,
+    SceneCacheMaterialFlags_AlphaBlended = 1 << 1,
+    SceneCacheMaterialFlags_DoubleSided = 1 << 2,
+};
+
+struct SceneCacheMaterial
+{
+    uint32_t name;
+    uint32_t flags;
+    float baseColor[4];
+    float emissiveColor[3];
+    float roughness;
+    float metalness;
+    float alphaCutoff;
+
+    // Texture paths relative to the cache file
+    uint32_t baseColorTexture;
+    uint32_t metalRoughTexture;
+    uint32_t normalTexture;
+    uint32_t emissiveTexture;
+};
+
+struct SceneCacheInstance
+{
+    uint32_t meshIndex;
+    float transform[12]; // Row major 3x4, object to world
+};
+
+enum class SceneCacheLightType : uint32_t
+{
+    Directional,
+    Point,
+    Spot,
+
+    Count
+};
+
+enum SceneCacheLightFlags : uint32_t
+{
+    SceneCacheLightFlags_HasDirection = 1 << 0,
+};
+
+struct SceneCacheLight
+{
+    uint32_t name;
+    uint32_t type;
+    uint32_t flags;
+    float color[3];
+    float intensity; // Irradiance of directional lights
+    float angularSize; // Degrees, directional lights
+    float radius;
+    float range;
+    float innerAngle; // Degrees, spot lights
+    float outerAngle;
+    float direction[3]; // World space, replaces the rotation of the transform with SceneCacheLightFlags_HasDirection
+    float transform[12];
+};
+
+struct SceneCacheCamera
+{
+    uint32_t name;
+    float verticalFov; // Radians
+    float zNear;
+    float transform[12];
+};
+
+struct SceneCacheSource
+{
+    uint32_t path; // Relative to the cache file
+    uint32_t reserved;
+    uint64_t size;
+    uint64_t hash;
+};
+
+// Contents of a cache, assembled by the converter
+struct SceneCacheData
+{
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<float> texCoords;
+    std::vector<uint32_t> indices;
+    std::vector<SceneCacheGeometry> geometries;
+    std::vector<SceneCacheMesh> meshes;
+    std::vector<SceneCacheMaterial> materials;
+    std::vector<SceneCacheInstance> instances;
+    std::vector<SceneCacheLight> lights;
+    std::vector<SceneCacheCamera> cameras;
+    std::vector<SceneCacheSource> sources;
+    std::vector<char> strings;
+    uint32_t flags = 0;
+
+    // Returns the offset to store in the tables, an empty string is c_SceneCacheInvalidString
+    uint32_t AddString(const std::string& string);
+
+    // Records a source file read from 'contents', 'path' is relative to the cache file
+    void AddSource(const std::string& path, const void* contents, size_t size);
+};
+
+// 64-bit FNV-1a hash of the file contents
+uint64_t SceneCacheHash(const void* data, size_t size);
+bool SceneCacheHashFile(const std::filesystem::path& path, uint64_t& size, uint64_t& hash);
+
+bool SceneCacheWrite(std::ostream& stream, const SceneCacheData& data);
+bool SceneCacheWriteFile(const std::filesystem::path& path, const SceneCacheData& data);
+
+class SceneCacheReader
+{
+public:
+    SceneCacheReader() = default;
+    ~SceneCacheReader();
+
+    SceneCacheReader(const SceneCacheReader&) = delete;
+    SceneCacheReader& operator=(const SceneCacheReader&) = delete;
+
+    // Maps the file into memory and validates its tables, whether the sources changed since is checked by IsCurrent()
+    bool Open(const std::filesystem::path& path);
+
+    // Uses a cache already in memory, 'data' has to outlive the reader
+    bool Open(const void* data, size_t size);
+
+    void Close();
+
+    // Reads every source file relative to 'cacheDirectory', false if any of them is missing or its size or content changed
+    bool IsCurrent(const std::filesystem::path& cacheDirectory) const;
+
+    bool IsOpen() const
+    {
+        return m_data != nullptr;
+    }
+
+    // SceneCacheFlags
+    uint32_t GetFlags() const
+    {
+        return m_flags;
+    }
+
+    // Section contents in place, 'size' in bytes
+    const void* GetSection(SceneCacheSection section, uint64_t& size) const;
+
+    template <typename T>
+    const T* GetSection(SceneCacheSection section, uint32_t& num) const
+    {
+        uint64_t size = 0;
+        const void* data = GetSection(section, size);
+        num = uint32_t(size / sizeof(T));
+
+        return (const T*)data;
+    }
+
+    // Returns an empty string for c_SceneCacheInvalidString or an offset outside of the string table
+    const char* GetString(uint32_t offset) const;
+
+private:
+    bool Parse();
+    void Unmap();
+
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+
+    void* m_mappedData = nullptr;
+#if defined(_WIN32)
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#endif // _WIN32
+
+    uint32_t m_flags = 0;
+    uint64_t m_sectionOffsets[uint32_t(SceneCacheSection::Count)] = {};
+    uint64_t m_sectionSizes[uint32_t(SceneCacheSection::Count)] = {};
+};
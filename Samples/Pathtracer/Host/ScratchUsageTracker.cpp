@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "ScratchUsageTracker.h"
+
+#include <algorithm>
+
+ScratchUsageTracker::ScratchUsageTracker(uint64_t alignment) : m_alignment(std::max(alignment, uint64_t(1))), m_chunkSize(m_alignment)
+{
+}
+
+uint64_t ScratchUsageTracker::Align(uint64_t size) const
+{
+    return (size + m_alignment - 1) / m_alignment * m_alignment;
+}
+
+void ScratchUsageTracker::Reset(uint64_t frameSize)
+{
+    m_chunkSize = std::max(Align(frameSize), m_alignment);
+    m_frameSize = 0;
+    m_requestedSize = 0;
+}
+
+void ScratchUsageTracker::Request(uint64_t size)
+{
+    m_requestedSize += Align(size);
+}
+
+bool ScratchUsageTracker::EndFrame()
+{
+    m_frameSize = m_requestedSize;
+    m_requestedSize = 0;
+
+    if (m_frameSize <= m_chunkSize)
+        return false;
+
+    m_chunkSize = m_frameSize;
+
+    return true;
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+// Scratch memory requested by the acceleration structure builds of each frame. NVRHI suballocates build scratch from chunks owned
+// by the command list and recycles a chunk once the GPU has finished the submission that used it. A chunk which holds the requests
+// of the largest frame serves every frame from a single chunk, the command list then keeps about one chunk per frame in flight.
+// Requests are aligned like the suballocations, the chunk size only grows.
+
+class ScratchUsageTracker
+{
+public:
+    explicit ScratchUsageTracker(uint64_t alignment);
+
+    // Drops the history, 'frameSize' is the largest frame expected, e.g. full builds of everything built per frame
+    void Reset(uint64_t frameSize);
+
+    // Adds a build to the current frame
+    void Request(uint64_t size);
+
+    // Closes the current frame, returns true if it didn't fit into the chunk size
+    bool EndFrame();
+
+    uint64_t GetChunkSize() const
+    {
+        return m_chunkSize;
+    }
+
+    // Requested by the last closed frame
+    uint64_t GetFrameSize() const
+    {
+        return m_frameSize;
+    }
+
+private:
+    uint64_t Align(uint64_t size) const;
+
+    uint64_t m_alignment;
+    uint64_t m_chunkSize;
+    uint64_t m_frameSize = 0;
+    uint64_t m_requestedSize = 0;
+};
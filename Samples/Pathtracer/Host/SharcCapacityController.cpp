@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "SharcCapacityController.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace
+{
+// Capacities are kept at powers of two, which also keeps them a multiple of the hash map bucket size
+const uint32_t c_MinCapacity = 32 * 1024;
+const uint32_t c_MaxCapacity = 1u << 30;
+
+uint32_t RoundCapacity(uint64_t entriesNum)
+{
+    entriesNum = std::clamp<uint64_t>(entriesNum, c_MinCapacity, c_MaxCapacity);
+
+    return uint32_t(std::bit_ceil(entriesNum));
+}
+} // namespace
+
+SharcCapacityController::SharcCapacityController(const SharcCapacityControllerDesc& desc) : m_desc(desc)
+{
+    assert(m_desc.shrinkOccupancy < m_desc.targetOccupancy && m_desc.targetOccupancy < m_desc.growOccupancy);
+
+    m_desc.minEntriesNum = RoundCapacity(m_desc.minEntriesNum);
+    m_desc.maxEntriesNum = std::max(RoundCapacity(m_desc.maxEntriesNum), m_desc.minEntriesNum);
+    m_desc.growSampleNum = std::max(m_desc.growSampleNum, 1u);
+    m_desc.shrinkSampleNum = std::max(m_desc.shrinkSampleNum, 1u);
+
+    // Allocation and switch happen on different frames
+    m_desc.rehashFrameNum = std::max(m_desc.rehashFrameNum, 2u);
+
+    m_entriesNum = std::clamp(RoundCapacity(m_desc.initialEntriesNum), m_desc.minEntriesNum, m_desc.maxEntriesNum);
+    m_targetEntriesNum = m_entriesNum;
+    m_entriesNumLimit = m_desc.maxEntriesNum;
+}
+
+void SharcCapacityController::ReportOccupancy(uint64_t frameIndex, uint32_t occupiedEntryNum, uint32_t entriesNum)
+{
+    // Samples captured before the last switch or during a resize don't describe the current table
+    if (entriesNum != m_entriesNum || IsRehashing() || frameIndex < m_cooldownEndFrame)
+        return;
+
+    m_lastOccupiedEntryNum = std::min(occupiedEntryNum, entriesNum);
+    m_lastOccupancy = float(m_lastOccupiedEntryNum) / float(entriesNum);
+    m_hasOccupancy = true;
+
+    if (m_lastOccupancy > m_desc.growOccupancy)
+    {
+        m_aboveSampleNum++;
+        m_belowSampleNum = 0;
+    }
+    else if (m_lastOccupancy < m_desc.shrinkOccupancy)
+    {
+        m_belowSampleNum++;
+        m_aboveSampleNum = 0;
+    }
+    else
+    {
+        m_aboveSampleNum = 0;
+        m_belowSampleNum = 0;
+    }
+}
+
+SharcCapacityAction SharcCapacityController::Update(uint64_t frameIndex)
+{
+    SharcCapacityAction action = SharcCapacityAction::Rehash;
+
+    if (!IsRehashing())
+    {
+        // A lowered budget limit doesn't wait for occupancy samples
+        const bool overLimit = m_entriesNum > m_entriesNumLimit;
+        if (!overLimit && m_aboveSampleNum < m_desc.growSampleNum && m_belowSampleNum < m_desc.shrinkSampleNum)
+            return SharcCapacityAction::None;
+
+        m_aboveSampleNum = 0;
+        m_belowSampleNum = 0;
+
+        const uint32_t targetEntriesNum = overLimit ? m_entriesNumLimit : std::min(ComputeRequiredEntriesNum(m_lastOccupancy), m_entriesNumLimit);
+        if (targetEntriesNum == m_entriesNum)
+            return SharcCapacityAction::None;
+
+        m_targetEntriesNum = targetEntriesNum;
+        m_rehashStep = 0;
+        action = SharcCapacityAction::BeginRehash;
+    }
+
+    const uint32_t sliceSize = (m_entriesNum + m_desc.rehashFrameNum - 1) / m_desc.rehashFrameNum;
+    m_rehashBegin = std::min(m_rehashStep * sliceSize, m_entriesNum);
+    m_rehashEnd = std::min(m_rehashBegin + sliceSize, m_entriesNum);
+    m_rehashStep++;
+
+    if (m_rehashStep == m_desc.rehashFrameNum)
+    {
+        action = SharcCapacityAction::Finish;
+
+        // The application switches at the end of this frame
+        m_entriesNum = m_targetEntriesNum;
+        m_cooldownEndFrame = frameIndex + m_desc.cooldownFrameNum;
+        m_resizeNum++;
+    }
+
+    return action;
+}
+
+void SharcCapacityController::Reset(uint64_t frameIndex)
+{
+    m_targetEntriesNum = m_entriesNum;
+    m_rehashStep = 0;
+    m_rehashBegin = 0;
+    m_rehashEnd = 0;
+    m_aboveSampleNum = 0;
+    m_belowSampleNum = 0;
+    m_cooldownEndFrame = frameIndex + m_desc.cooldownFrameNum;
+}
+
+bool SharcCapacityController::SetEntriesNum(uint64_t frameIndex, uint32_t entriesNum)
+{
+    if (entriesNum != RoundCapacity(entriesNum) || entriesNum < m_desc.minEntriesNum || entriesNum > m_desc.maxEntriesNum)
+        return false;
+
+    m_entriesNum = entriesNum;
+    Reset(frameIndex);
+
+    return true;
+}
+
+void SharcCapacityController::SetEntriesNumLimit(uint32_t entriesNumLimit)
+{
+    m_entriesNumLimit = std::clamp(std::bit_floor(entriesNumLimit), m_desc.minEntriesNum, m_desc.maxEntriesNum);
+}
+
+uint32_t SharcCapacityController::GetRequiredEntriesNum() const
+{
+    if (IsRehashing())
+        return m_targetEntriesNum;
+
+    return m_hasOccupancy ? ComputeRequiredEntriesNum(m_lastOccupancy) : m_entriesNum;
+}
+
+uint32_t SharcCapacityController::ComputeRequiredEntriesNum(float occupancy) const
+{
+    const double requiredEntriesNum = double(occupancy) * double(m_entriesNum) / double(m_desc.targetOccupancy);
+
+    return std::clamp(RoundCapacity(uint64_t(requiredEntriesNum)), m_desc.minEntriesNum, m_desc.maxEntriesNum);
+}
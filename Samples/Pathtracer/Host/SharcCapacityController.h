@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+// Chooses the SHaRC hash map capacity from occupancy samples read back from the GPU.
+// Samples arrive with a few frames of latency and are tagged with the frame and capacity they were captured with.
+// A resize is spread over several frames: the application migrates one range of the old table per frame into the new one
+// and switches over once the last range has been processed. The controller has no knowledge of time other than the
+// frame indices passed in, so it can be driven by a recorded or synthetic occupancy trace.
+
+struct SharcCapacityControllerDesc
+{
+    uint32_t initialEntriesNum = 4 * 1024 * 1024;
+    uint32_t minEntriesNum = 256 * 1024;
+    uint32_t maxEntriesNum = 32 * 1024 * 1024;
+
+    // Hysteresis band, the capacity picked after a resize places occupancy at 'targetOccupancy'
+    float growOccupancy = 0.5f;
+    float shrinkOccupancy = 0.1f;
+    float targetOccupancy = 0.25f;
+
+    // Consecutive samples outside of the band required before resizing, shrinking is deliberately slower
+    uint32_t growSampleNum = 4;
+    uint32_t shrinkSampleNum = 120;
+
+    // Frames after a switch during which samples are ignored and no new resize is started
+    uint32_t cooldownFrameNum = 60;
+
+    // Number of frames the migration of the old table is spread over
+    uint32_t rehashFrameNum = 8;
+};
+
+enum class SharcCapacityAction
+{
+    None,
+    BeginRehash, // Allocate and clear the tables with GetTargetEntriesNum() entries, then migrate GetRehashRange()
+    Rehash,      // Migrate GetRehashRange() of the current table
+    Finish,      // Migrate GetRehashRange() and switch to the new tables
+};
+
+class SharcCapacityController
+{
+public:
+    explicit SharcCapacityController(const SharcCapacityControllerDesc& desc);
+
+    const SharcCapacityControllerDesc& GetDesc() const
+    {
+        return m_desc;
+    }
+
+    // Occupancy sample captured on 'frameIndex' for a table with 'entriesNum' entries
+    void ReportOccupancy(uint64_t frameIndex, uint32_t occupiedEntryNum, uint32_t entriesNum);
+
+    // Called once per frame, returns the work the application has to do for this frame
+    SharcCapacityAction Update(uint64_t frameIndex);
+
+    // Drops an in-flight resize, e.g. after a scene reload cleared the cache
+    void Reset(uint64_t frameIndex);
+
+    // Switches to a capacity chosen by the application, e.g. the one of a loaded snapshot. Returns false if it is out of range
+    bool SetEntriesNum(uint64_t frameIndex, uint32_t entriesNum);
+
+    // Upper bound assigned from a shared memory budget, a larger table is shrunk on the next Update()
+    void SetEntriesNumLimit(uint32_t entriesNumLimit);
+
+    uint32_t GetEntriesNumLimit() const
+    {
+        return m_entriesNumLimit;
+    }
+
+    // Capacity which places the last occupancy sample at the target, ignores the budget limit
+    uint32_t GetRequiredEntriesNum() const;
+
+    uint32_t GetEntriesNum() const
+    {
+        return m_entriesNum;
+    }
+
+    uint32_t GetTargetEntriesNum() const
+    {
+        return m_targetEntriesNum;
+    }
+
+    bool IsRehashing() const
+    {
+        return m_targetEntriesNum != m_entriesNum;
+    }
+
+    // Range of the current table to migrate this frame, [begin, end)
+    void GetRehashRange(uint32_t& begin, uint32_t& end) const
+    {
+        begin = m_rehashBegin;
+        end = m_rehashEnd;
+    }
+
+    float GetLastOccupancy() const
+    {
+        return m_lastOccupancy;
+    }
+
+    uint32_t GetResizeNum() const
+    {
+        return m_resizeNum;
+    }
+
+private:
+    uint32_t ComputeRequiredEntriesNum(float occupancy) const;
+
+    SharcCapacityControllerDesc m_desc;
+
+    uint32_t m_entriesNum = 0;
+    uint32_t m_targetEntriesNum = 0;
+    uint32_t m_entriesNumLimit = 0;
+    uint32_t m_rehashBegin = 0;
+    uint32_t m_rehashEnd = 0;
+    uint32_t m_rehashStep = 0;
+
+    uint64_t m_cooldownEndFrame = 0;
+    uint32_t m_aboveSampleNum = 0;
+    uint32_t m_belowSampleNum = 0;
+    uint32_t m_lastOccupiedEntryNum = 0;
+    float m_lastOccupancy = 0.0f;
+    bool m_hasOccupancy = false;
+    uint32_t m_resizeNum = 0;
+};
@@ -0,0 +1,1128 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "SharcCpu.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <climits>
+#include <cmath>
+
+#if SHARC_CPU_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace SharcCpu
+{
+namespace
+{
+float Dot(const float3& a, const float3& b)
+{
+    return a.x * b.x + a.y * b.y + a.z * b.z;
+}
+
+float Lerp(float a, float b, float t)
+{
+    return a + t * (b - a);
+}
+
+float Saturate(float x)
+{
+    return std::min(std::max(x, 0.0f), 1.0f);
+}
+
+float3 Mul(const float3& a, const float3& b)
+{
+    return { a.x * b.x, a.y * b.y, a.z * b.z };
+}
+
+float3 Mul(const float3& a, float b)
+{
+    return { a.x * b, a.y * b, a.z * b };
+}
+
+// HLSL float to uint conversion, out of range values are clamped instead of being undefined
+uint32_t FloatToUint(float x)
+{
+    if (!(x > 0.0f))
+        return 0;
+    if (x >= 4294967296.0f)
+        return UINT_MAX;
+
+    return uint32_t(x);
+}
+
+int FloatToInt(float x)
+{
+    if (x != x)
+        return 0;
+    if (x <= float(INT_MIN))
+        return INT_MIN;
+    if (x >= 2147483648.0f)
+        return INT_MAX;
+
+    return int(x);
+}
+
+// Wrapping int3 dot product to match the 32-bit shader arithmetic
+int DotWrapped(int x, int y, int z)
+{
+    uint32_t ux = uint32_t(x);
+    uint32_t uy = uint32_t(y);
+    uint32_t uz = uint32_t(z);
+
+    return int(ux * ux + uy * uy + uz * uz);
+}
+
+const float3 c_LuminanceWeights = { 0.213f, 0.715f, 0.072f };
+
+// History read by the update and resolve passes
+uint4 SharcLoadVoxelDataPrev(const SharcParameters& sharcParameters, HashGridIndex cacheIndex)
+{
+    if (sharcParameters.packedVoxelDataBuffer)
+        return SharcUnpackPackedVoxelData(sharcParameters.packedVoxelDataBuffer[cacheIndex]);
+
+    return sharcParameters.voxelDataBufferPrev[cacheIndex];
+}
+
+// Resolved data read by the query pass
+uint4 SharcLoadResolvedVoxelData(const SharcParameters& sharcParameters, HashGridIndex cacheIndex)
+{
+    if (sharcParameters.packedVoxelDataBuffer)
+        return SharcUnpackPackedVoxelData(sharcParameters.packedVoxelDataBuffer[cacheIndex]);
+
+    return sharcParameters.voxelDataBuffer[cacheIndex];
+}
+
+void SharcStoreResolvedVoxelData(const SharcParameters& sharcParameters, HashGridIndex cacheIndex, const uint4& voxelData)
+{
+    if (sharcParameters.packedVoxelDataBuffer)
+        sharcParameters.packedVoxelDataBuffer[cacheIndex] = SharcPackVoxelData(voxelData);
+    else
+        sharcParameters.voxelDataBuffer[cacheIndex] = voxelData;
+}
+
+HashGridKey HashGridPackKey(int x, int y, int z, uint32_t level)
+{
+    return ((uint64_t(uint32_t(x)) & c_HashGridPositionBitMask) << (c_HashGridPositionBitNum * 0))
+         | ((uint64_t(uint32_t(y)) & c_HashGridPositionBitMask) << (c_HashGridPositionBitNum * 1))
+         | ((uint64_t(uint32_t(z)) & c_HashGridPositionBitMask) << (c_HashGridPositionBitNum * 2))
+         | ((uint64_t(level) & c_HashGridLevelBitMask) << (c_HashGridPositionBitNum * 3));
+}
+
+uint32_t HashGridNormalBits(const float3& sampleNormal)
+{
+    return (sampleNormal.x + c_HashGridNormalBias >= 0 ? 0 : 1) + (sampleNormal.y + c_HashGridNormalBias >= 0 ? 0 : 2) + (sampleNormal.z + c_HashGridNormalBias >= 0 ? 0 : 4);
+}
+
+HashGridKey HashGridComputeSpatialHash(const float3& samplePosition, uint32_t gridLevel, float voxelSize, const float3& sampleNormal)
+{
+    int x = FloatToInt(std::floor(samplePosition.x / voxelSize));
+    int y = FloatToInt(std::floor(samplePosition.y / voxelSize));
+    int z = FloatToInt(std::floor(samplePosition.z / voxelSize));
+
+    HashGridKey hashKey = HashGridPackKey(x, y, z, gridLevel);
+    hashKey |= (uint64_t(HashGridNormalBits(sampleNormal)) << (c_HashGridPositionBitNum * 3 + c_HashGridLevelBitNum));
+
+    return hashKey;
+}
+
+// Returns the bucket offset of the first matching key, or 'c_HashGridHashMapBucketSize' on a miss.
+// Mirrors the HashMapFind loop: with compaction the scan stops at the first empty slot
+uint32_t HashMapScanBucket(const HashGridKey* bucket, HashGridKey hashKey, bool allowCompaction, uint32_t& probeNum)
+{
+#if SHARC_CPU_SSE2
+    const __m128i key = _mm_set1_epi64x(int64_t(hashKey));
+    const __m128i zero = _mm_setzero_si128();
+
+    uint32_t matchMask = 0;
+    uint32_t invalidMask = 0;
+    for (uint32_t i = 0; i < c_HashGridHashMapBucketSize; i += 2)
+    {
+        const __m128i entries = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bucket + i));
+
+        // SSE2 has no 64-bit compare, combine the two 32-bit halves instead
+        __m128i match = _mm_cmpeq_epi32(entries, key);
+        match = _mm_and_si128(match, _mm_shuffle_epi32(match, _MM_SHUFFLE(2, 3, 0, 1)));
+        __m128i invalid = _mm_cmpeq_epi32(entries, zero);
+        invalid = _mm_and_si128(invalid, _mm_shuffle_epi32(invalid, _MM_SHUFFLE(2, 3, 0, 1)));
+
+        matchMask |= uint32_t(_mm_movemask_pd(_mm_castsi128_pd(match))) << i;
+        invalidMask |= uint32_t(_mm_movemask_pd(_mm_castsi128_pd(invalid))) << i;
+    }
+
+    const uint32_t firstMatch = matchMask ? uint32_t(std::countr_zero(matchMask)) : c_HashGridHashMapBucketSize;
+    const uint32_t firstInvalid = (invalidMask && allowCompaction) ? uint32_t(std::countr_zero(invalidMask)) : c_HashGridHashMapBucketSize;
+
+    if (firstMatch < firstInvalid)
+    {
+        probeNum = firstMatch + 1;
+        return firstMatch;
+    }
+
+    probeNum = std::min(firstInvalid + 1, c_HashGridHashMapBucketSize);
+    return c_HashGridHashMapBucketSize;
+#else
+    for (uint32_t bucketOffset = 0; bucketOffset < c_HashGridHashMapBucketSize; ++bucketOffset)
+    {
+        const HashGridKey storedHashKey = bucket[bucketOffset];
+        if (storedHashKey == hashKey)
+        {
+            probeNum = bucketOffset + 1;
+            return bucketOffset;
+        }
+        else if (allowCompaction && storedHashKey == c_HashGridInvalidHashKey)
+        {
+            probeNum = bucketOffset + 1;
+            return c_HashGridHashMapBucketSize;
+        }
+    }
+
+    probeNum = c_HashGridHashMapBucketSize;
+    return c_HashGridHashMapBucketSize;
+#endif
+}
+
+void SharcAddVoxelData(const SharcParameters& sharcParameters, HashGridIndex cacheIndex, const float3& sampleValue, float3 sampleWeight, uint32_t sampleData)
+{
+    if (cacheIndex == c_HashGridInvalidCacheIndex)
+        return;
+
+    if (sharcParameters.enableAntiFireflyFilter)
+    {
+        float scalarWeight = Dot(sampleWeight, c_LuminanceWeights);
+        scalarWeight = std::max(scalarWeight, 1.0f);
+
+        const float sampleWeightThreshold = 2.0f;
+
+        if (scalarWeight > sampleWeightThreshold)
+        {
+            const uint4 dataPackedPrev = SharcLoadVoxelDataPrev(sharcParameters, cacheIndex);
+            const uint32_t sampleNumPrev = SharcGetSampleNum(dataPackedPrev.w);
+            const uint32_t sampleConfidenceThreshold = 2;
+            if (sampleNumPrev > c_SharcSampleNumMultiplier * sampleConfidenceThreshold)
+            {
+                const uint32_t accumulatedRadiancePrev[3] = { dataPackedPrev.x, dataPackedPrev.y, dataPackedPrev.z };
+                float luminancePrev = std::max(Dot(SharcResolveAccumulatedRadiance(accumulatedRadiancePrev, sampleNumPrev), c_LuminanceWeights), 1.0f);
+                float luminanceCur = std::max(Dot(Mul(sampleValue, sampleWeight), c_LuminanceWeights), 1.0f);
+                float confidenceScale = Lerp(5.0f, 10.0f, 1.0f / sampleNumPrev);
+                sampleWeight = Mul(sampleWeight, Saturate(confidenceScale * luminancePrev / luminanceCur));
+            }
+            else
+            {
+                scalarWeight = std::pow(scalarWeight, 0.5f);
+                sampleWeight = { sampleWeight.x / scalarWeight, sampleWeight.y / scalarWeight, sampleWeight.z / scalarWeight };
+            }
+        }
+    }
+
+    const float3 scaledValue = Mul(Mul(sampleValue, sampleWeight), c_SharcRadianceScale);
+
+    uint4& voxelData = sharcParameters.voxelDataBuffer[cacheIndex];
+    voxelData.x += FloatToUint(scaledValue.x);
+    voxelData.y += FloatToUint(scaledValue.y);
+    voxelData.z += FloatToUint(scaledValue.z);
+    voxelData.w += sampleData;
+}
+} // namespace
+
+uint32_t HashGridHashJenkins32(uint32_t a)
+{
+    a = (a + 0x7ed55d16) + (a << 12);
+    a = (a ^ 0xc761c23c) ^ (a >> 19);
+    a = (a + 0x165667b1) + (a << 5);
+    a = (a + 0xd3a2646c) ^ (a << 9);
+    a = (a + 0xfd7046c5) + (a << 3);
+    a = (a ^ 0xb55a4f09) ^ (a >> 16);
+
+    return a;
+}
+
+uint32_t HashGridHash32(HashGridKey hashKey)
+{
+    return HashGridHashJenkins32(uint32_t((hashKey >> 0) & 0xFFFFFFFF)) ^ HashGridHashJenkins32(uint32_t((hashKey >> 32) & 0xFFFFFFFF));
+}
+
+uint32_t HashGridGetBaseSlot(uint32_t slot, uint32_t capacity, bool allowCompaction)
+{
+    if (allowCompaction)
+        return (slot / c_HashGridHashMapBucketSize) * c_HashGridHashMapBucketSize;
+
+    return std::min(slot, capacity - c_HashGridHashMapBucketSize);
+}
+
+uint32_t HashGridGetLevel(const float3& samplePosition, const HashGridParameters& gridParameters)
+{
+    const float3 offset = { gridParameters.cameraPosition.x - samplePosition.x, gridParameters.cameraPosition.y - samplePosition.y,
+        gridParameters.cameraPosition.z - samplePosition.z };
+    const float distance2 = Dot(offset, offset);
+    const float level = 0.5f * (std::log(distance2) / std::log(gridParameters.logarithmBase)) + gridParameters.levelBias;
+
+    // std::clamp would propagate NaN, HLSL clamp resolves it to the lower bound
+    return FloatToUint(std::min(std::max(level, 1.0f), float(c_HashGridLevelBitMask)));
+}
+
+float HashGridGetVoxelSize(uint32_t gridLevel, const HashGridParameters& gridParameters)
+{
+    return std::pow(gridParameters.logarithmBase, float(gridLevel)) / (gridParameters.sceneScale * std::pow(gridParameters.logarithmBase, gridParameters.levelBias));
+}
+
+int4 HashGridCalculatePositionLog(float3 samplePosition, const HashGridParameters& gridParameters)
+{
+    samplePosition = { samplePosition.x + c_HashGridPositionBias, samplePosition.y + c_HashGridPositionBias, samplePosition.z + c_HashGridPositionBias };
+
+    const uint32_t gridLevel = HashGridGetLevel(samplePosition, gridParameters);
+    const float voxelSize = HashGridGetVoxelSize(gridLevel, gridParameters);
+
+    int4 gridPosition;
+    gridPosition.x = FloatToInt(std::floor(samplePosition.x / voxelSize));
+    gridPosition.y = FloatToInt(std::floor(samplePosition.y / voxelSize));
+    gridPosition.z = FloatToInt(std::floor(samplePosition.z / voxelSize));
+    gridPosition.w = int(gridLevel);
+
+    return gridPosition;
+}
+
+HashGridKey HashGridComputeSpatialHash(const float3& samplePosition, const float3& sampleNormal, const HashGridParameters& gridParameters)
+{
+    const int4 gridPosition = HashGridCalculatePositionLog(samplePosition, gridParameters);
+
+    HashGridKey hashKey = HashGridPackKey(gridPosition.x, gridPosition.y, gridPosition.z, uint32_t(gridPosition.w));
+    hashKey |= (uint64_t(HashGridNormalBits(sampleNormal)) << (c_HashGridPositionBitNum * 3 + c_HashGridLevelBitNum));
+
+    return hashKey;
+}
+
+bool HashMapInsert(const HashMapData& hashMapData, HashGridKey hashKey, HashGridIndex& cacheIndex)
+{
+    const uint32_t hash = HashGridHash32(hashKey);
+    const uint32_t slot = hash % hashMapData.capacity;
+    const uint32_t baseSlot = HashGridGetBaseSlot(slot, hashMapData.capacity, hashMapData.allowCompaction);
+
+    if (hashMapData.stats)
+        hashMapData.stats->insertNum++;
+
+    for (uint32_t bucketOffset = 0; bucketOffset < c_HashGridHashMapBucketSize; ++bucketOffset)
+    {
+        // InterlockedCompareExchange
+        HashGridKey& storedHashKey = hashMapData.hashEntriesBuffer[baseSlot + bucketOffset];
+        const HashGridKey prevHashKey = storedHashKey;
+        if (prevHashKey == c_HashGridInvalidHashKey)
+            storedHashKey = hashKey;
+
+        if (prevHashKey == c_HashGridInvalidHashKey || prevHashKey == hashKey)
+        {
+            if (hashMapData.stats)
+            {
+                hashMapData.stats->insertProbeNum += bucketOffset + 1;
+                hashMapData.stats->insertNewNum += (prevHashKey == c_HashGridInvalidHashKey) ? 1 : 0;
+            }
+
+            cacheIndex = baseSlot + bucketOffset;
+            return true;
+        }
+    }
+
+    if (hashMapData.stats)
+    {
+        hashMapData.stats->insertProbeNum += c_HashGridHashMapBucketSize;
+        hashMapData.stats->insertFailedNum++;
+    }
+
+    cacheIndex = c_HashGridInvalidCacheIndex;
+    return false;
+}
+
+bool HashMapFind(const HashMapData& hashMapData, HashGridKey hashKey, HashGridIndex& cacheIndex)
+{
+    const uint32_t hash = HashGridHash32(hashKey);
+    const uint32_t slot = hash % hashMapData.capacity;
+    const uint32_t baseSlot = HashGridGetBaseSlot(slot, hashMapData.capacity, hashMapData.allowCompaction);
+
+    uint32_t probeNum = 0;
+    const uint32_t bucketOffset = HashMapScanBucket(hashMapData.hashEntriesBuffer + baseSlot, hashKey, hashMapData.allowCompaction, probeNum);
+    const bool found = bucketOffset < c_HashGridHashMapBucketSize;
+
+    if (hashMapData.stats)
+    {
+        hashMapData.stats->findNum++;
+        hashMapData.stats->findProbeNum += probeNum;
+        hashMapData.stats->findMissNum += found ? 0 : 1;
+    }
+
+    if (found)
+        cacheIndex = baseSlot + bucketOffset;
+
+    return found;
+}
+
+HashGridIndex HashMapInsertEntry(const HashMapData& hashMapData, const float3& samplePosition, const float3& sampleNormal, const HashGridParameters& gridParameters)
+{
+    HashGridIndex cacheIndex = c_HashGridInvalidCacheIndex;
+    const HashGridKey hashKey = HashGridComputeSpatialHash(samplePosition, sampleNormal, gridParameters);
+    HashMapInsert(hashMapData, hashKey, cacheIndex);
+
+    return cacheIndex;
+}
+
+HashGridIndex HashMapFindEntry(const HashMapData& hashMapData, const float3& samplePosition, const float3& sampleNormal, const HashGridParameters& gridParameters)
+{
+    HashGridIndex cacheIndex = c_HashGridInvalidCacheIndex;
+    const HashGridKey hashKey = HashGridComputeSpatialHash(samplePosition, sampleNormal, gridParameters);
+    HashMapFind(hashMapData, hashKey, cacheIndex);
+
+    return cacheIndex;
+}
+
+uint32_t SharcGetSampleNum(uint32_t packedData)
+{
+    return (packedData >> c_SharcSampleNumBitOffset) & c_SharcSampleNumBitMask;
+}
+
+uint32_t SharcGetStaleFrameNum(uint32_t packedData)
+{
+    return (packedData >> c_SharcStaleFrameNumBitOffset) & c_SharcStaleFrameNumBitMask;
+}
+
+uint32_t SharcGetAccumulatedFrameNum(uint32_t packedData)
+{
+    return (packedData >> c_SharcAccumulatedFrameNumBitOffset) & c_SharcAccumulatedFrameNumBitMask;
+}
+
+float3 SharcResolveAccumulatedRadiance(const uint32_t accumulatedRadiance[3], uint32_t accumulatedSampleNum)
+{
+    const float scale = accumulatedSampleNum * c_SharcRadianceScale;
+
+    return { float(accumulatedRadiance[0]) / scale, float(accumulatedRadiance[1]) / scale, float(accumulatedRadiance[2]) / scale };
+}
+
+SharcVoxelData SharcUnpackVoxelData(const uint4& voxelDataPacked)
+{
+    SharcVoxelData voxelData;
+    voxelData.accumulatedRadiance[0] = voxelDataPacked.x;
+    voxelData.accumulatedRadiance[1] = voxelDataPacked.y;
+    voxelData.accumulatedRadiance[2] = voxelDataPacked.z;
+    voxelData.accumulatedSampleNum = SharcGetSampleNum(voxelDataPacked.w);
+    voxelData.staleFrameNum = SharcGetStaleFrameNum(voxelDataPacked.w);
+    voxelData.accumulatedFrameNum = SharcGetAccumulatedFrameNum(voxelDataPacked.w);
+
+    return voxelData;
+}
+
+SharcVoxelData SharcGetVoxelData(const uint4* voxelDataBuffer, HashGridIndex cacheIndex)
+{
+    if (cacheIndex == c_HashGridInvalidCacheIndex)
+        return SharcVoxelData();
+
+    return SharcUnpackVoxelData(voxelDataBuffer[cacheIndex]);
+}
+
+uint32_t SharcPackRGB9E5(const float3& value)
+{
+    const int mantissaBitNum = 9;
+    const int exponentBias = 15;
+
+    // NaN fails the comparison and is flushed to zero
+    auto clampComponent = [](float x) { return (x > 0.0f) ? std::min(x, c_SharcPackedRadianceMax) : 0.0f; };
+    const float r = clampComponent(value.x);
+    const float g = clampComponent(value.y);
+    const float b = clampComponent(value.z);
+    const float maxComponent = std::max(r, std::max(g, b));
+
+    int exponent = std::max(-exponentBias - 1, int(std::floor(std::log2(std::max(maxComponent, 1e-30f))))) + 1 + exponentBias;
+    float scale = std::exp2(float(exponent - exponentBias - mantissaBitNum));
+    if (uint32_t(std::floor(maxComponent / scale + 0.5f)) == (1u << mantissaBitNum))
+    {
+        exponent++;
+        scale *= 2.0f;
+    }
+
+    const uint32_t mantissaR = uint32_t(std::floor(r / scale + 0.5f));
+    const uint32_t mantissaG = uint32_t(std::floor(g / scale + 0.5f));
+    const uint32_t mantissaB = uint32_t(std::floor(b / scale + 0.5f));
+
+    return mantissaR | (mantissaG << 9) | (mantissaB << 18) | (uint32_t(exponent) << 27);
+}
+
+float3 SharcUnpackRGB9E5(uint32_t packedValue)
+{
+    const float scale = std::exp2(float(int(packedValue >> 27) - 15 - 9));
+
+    return { float(packedValue & 0x1FF) * scale, float((packedValue >> 9) & 0x1FF) * scale, float((packedValue >> 18) & 0x1FF) * scale };
+}
+
+SharcPackedVoxelData SharcPackVoxelData(const uint4& voxelData)
+{
+    SharcPackedVoxelData packedVoxelData;
+    packedVoxelData.sampleData = voxelData.w;
+
+    const uint32_t sampleNum = SharcGetSampleNum(voxelData.w);
+    if (sampleNum != 0)
+    {
+        const uint32_t accumulatedRadiance[3] = { voxelData.x, voxelData.y, voxelData.z };
+        packedVoxelData.radiance = SharcPackRGB9E5(SharcResolveAccumulatedRadiance(accumulatedRadiance, sampleNum));
+    }
+
+    return packedVoxelData;
+}
+
+uint4 SharcUnpackPackedVoxelData(const SharcPackedVoxelData& packedVoxelData)
+{
+    // Back to the accumulated integer representation used by the resolve pass
+    const float scale = SharcGetSampleNum(packedVoxelData.sampleData) * c_SharcRadianceScale;
+    const float3 radiance = SharcUnpackRGB9E5(packedVoxelData.radiance);
+
+    return { FloatToUint(radiance.x * scale + 0.5f), FloatToUint(radiance.y * scale + 0.5f), FloatToUint(radiance.z * scale + 0.5f), packedVoxelData.sampleData };
+}
+
+void SharcInit(SharcState& sharcState)
+{
+    sharcState.pathLength = 0;
+}
+
+void SharcUpdateMiss(const SharcParameters& sharcParameters, const SharcState& sharcState, const float3& radiance)
+{
+    float3 sharcRadiance = radiance;
+    for (uint32_t i = 0; i < sharcState.pathLength; ++i)
+    {
+        SharcAddVoxelData(sharcParameters, sharcState.cacheIndices[i], sharcRadiance, sharcState.sampleWeights[i], 0);
+        sharcRadiance = Mul(sharcRadiance, sharcState.sampleWeights[i]);
+    }
+}
+
+bool SharcUpdateHit(const SharcParameters& sharcParameters, SharcState& sharcState, const SharcHitData& sharcHitData, const float3& directLighting, float random)
+{
+    bool continueTracing = true;
+    const HashGridIndex cacheIndex = HashMapInsertEntry(sharcParameters.hashMapData, sharcHitData.positionWorld, sharcHitData.normalWorld, sharcParameters.gridParameters);
+
+    float3 sharcRadiance = directLighting;
+
+    // Cache resampling, HLSL round() resolves ties to even
+    const uint32_t resamplingDepth = uint32_t(std::nearbyint(Lerp(float(c_SharcResamplingDepthMin), float(c_SharcPropagationDepth - 1), random)));
+    if (resamplingDepth <= sharcState.pathLength)
+    {
+        const SharcVoxelData voxelData = (cacheIndex != c_HashGridInvalidCacheIndex) ? SharcUnpackVoxelData(SharcLoadVoxelDataPrev(sharcParameters, cacheIndex)) : SharcVoxelData();
+        if (voxelData.accumulatedSampleNum > c_SharcSampleNumThreshold)
+        {
+            sharcRadiance = SharcResolveAccumulatedRadiance(voxelData.accumulatedRadiance, voxelData.accumulatedSampleNum);
+            continueTracing = false;
+        }
+    }
+
+    if (continueTracing)
+        SharcAddVoxelData(sharcParameters, cacheIndex, directLighting, float3{ 1.0f, 1.0f, 1.0f }, 1);
+
+    for (uint32_t i = 0; i < sharcState.pathLength; ++i)
+    {
+        SharcAddVoxelData(sharcParameters, sharcState.cacheIndices[i], sharcRadiance, sharcState.sampleWeights[i], 0);
+        sharcRadiance = Mul(sharcRadiance, sharcState.sampleWeights[i]);
+    }
+
+    for (uint32_t i = sharcState.pathLength; i > 0; --i)
+    {
+        sharcState.cacheIndices[i] = sharcState.cacheIndices[i - 1];
+        sharcState.sampleWeights[i] = sharcState.sampleWeights[i - 1];
+    }
+
+    sharcState.cacheIndices[0] = cacheIndex;
+    sharcState.pathLength = std::min(sharcState.pathLength + 1, c_SharcPropagationDepth - 1);
+
+    return continueTracing;
+}
+
+void SharcSetThroughput(SharcState& sharcState, const float3& throughput)
+{
+    sharcState.sampleWeights[0] = throughput;
+}
+
+bool SharcGetCachedRadiance(const SharcParameters& sharcParameters, const SharcHitData& sharcHitData, float3& radiance, bool debug)
+{
+    if (debug)
+        radiance = float3();
+
+    const uint32_t sampleThreshold = debug ? 0 : c_SharcSampleNumThreshold;
+
+    const HashGridIndex cacheIndex = HashMapFindEntry(sharcParameters.hashMapData, sharcHitData.positionWorld, sharcHitData.normalWorld, sharcParameters.gridParameters);
+    if (cacheIndex == c_HashGridInvalidCacheIndex)
+        return false;
+
+    const SharcVoxelData voxelData = SharcUnpackVoxelData(SharcLoadResolvedVoxelData(sharcParameters, cacheIndex));
+    if (voxelData.accumulatedSampleNum > sampleThreshold)
+    {
+        radiance = SharcResolveAccumulatedRadiance(voxelData.accumulatedRadiance, voxelData.accumulatedSampleNum);
+        return true;
+    }
+
+    return false;
+}
+
+HashGridKey SharcGetAdjacentLevelHashKey(HashGridKey hashKey, const HashGridParameters& gridParameters, const float3& cameraPositionPrev)
+{
+    const int signBit = 1 << (c_HashGridPositionBitNum - 1);
+    const int signMask = ~((1 << c_HashGridPositionBitNum) - 1);
+
+    int gridPosition[3];
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        gridPosition[i] = int((hashKey >> (c_HashGridPositionBitNum * i)) & c_HashGridPositionBitMask);
+
+        // Fix negative coordinates
+        gridPosition[i] = (gridPosition[i] & signBit) != 0 ? gridPosition[i] | signMask : gridPosition[i];
+    }
+
+    int level = int((hashKey >> (c_HashGridPositionBitNum * 3)) & c_HashGridLevelBitMask);
+
+    const float voxelSize = HashGridGetVoxelSize(uint32_t(level), gridParameters);
+    const int cameraGridPosition[3] = { FloatToInt(std::floor(gridParameters.cameraPosition.x / voxelSize)), FloatToInt(std::floor(gridParameters.cameraPosition.y / voxelSize)),
+        FloatToInt(std::floor(gridParameters.cameraPosition.z / voxelSize)) };
+    const int cameraDistance =
+        DotWrapped(cameraGridPosition[0] - gridPosition[0], cameraGridPosition[1] - gridPosition[1], cameraGridPosition[2] - gridPosition[2]);
+
+    const int cameraGridPositionPrev[3] = { FloatToInt(std::floor(cameraPositionPrev.x / voxelSize)), FloatToInt(std::floor(cameraPositionPrev.y / voxelSize)),
+        FloatToInt(std::floor(cameraPositionPrev.z / voxelSize)) };
+    const int cameraDistancePrev =
+        DotWrapped(cameraGridPositionPrev[0] - gridPosition[0], cameraGridPositionPrev[1] - gridPosition[1], cameraGridPositionPrev[2] - gridPosition[2]);
+
+    if (cameraDistance < cameraDistancePrev)
+    {
+        for (uint32_t i = 0; i < 3; ++i)
+            gridPosition[i] = FloatToInt(std::floor(gridPosition[i] / gridParameters.logarithmBase));
+        level = std::min(level + 1, int(c_HashGridLevelBitMask));
+    }
+    else // this may be inaccurate
+    {
+        for (uint32_t i = 0; i < 3; ++i)
+            gridPosition[i] = FloatToInt(std::floor(gridPosition[i] * gridParameters.logarithmBase));
+        level = std::max(level - 1, 1);
+    }
+
+    HashGridKey modifiedHashGridKey = HashGridPackKey(gridPosition[0], gridPosition[1], gridPosition[2], uint32_t(level));
+    modifiedHashGridKey |= hashKey & (uint64_t(c_HashGridNormalBitMask) << (c_HashGridPositionBitNum * 3 + c_HashGridLevelBitNum));
+
+    return modifiedHashGridKey;
+}
+
+namespace
+{
+// Accumulation, adjacent level blending and normalization part of SharcResolveEntry(), returns false for stale entries
+bool SharcResolveVoxel(uint32_t entryIndex, HashGridKey hashKey, const SharcParameters& sharcParameters, const SharcResolveParameters& resolveParameters, uint4& packedData)
+{
+    const HashMapData& hashMapData = sharcParameters.hashMapData;
+    const float3 cameraOffset = { sharcParameters.gridParameters.cameraPosition.x - resolveParameters.cameraPositionPrev.x,
+        sharcParameters.gridParameters.cameraPosition.y - resolveParameters.cameraPositionPrev.y,
+        sharcParameters.gridParameters.cameraPosition.z - resolveParameters.cameraPositionPrev.z };
+
+    const uint4 voxelDataPackedPrev = SharcLoadVoxelDataPrev(sharcParameters, entryIndex);
+    const uint4 voxelDataPacked = sharcParameters.voxelDataBuffer[entryIndex];
+
+    uint32_t sampleNum = SharcGetSampleNum(voxelDataPacked.w);
+    const uint32_t sampleNumPrev = SharcGetSampleNum(voxelDataPackedPrev.w);
+    uint32_t accumulatedFrameNum = SharcGetAccumulatedFrameNum(voxelDataPackedPrev.w) + 1;
+    uint32_t staleFrameNum = SharcGetStaleFrameNum(voxelDataPackedPrev.w);
+
+    sampleNum *= c_SharcSampleNumMultiplier;
+
+    uint32_t accumulatedRadiance[3] = { voxelDataPacked.x * c_SharcSampleNumMultiplier + voxelDataPackedPrev.x,
+        voxelDataPacked.y * c_SharcSampleNumMultiplier + voxelDataPackedPrev.y, voxelDataPacked.z * c_SharcSampleNumMultiplier + voxelDataPackedPrev.z };
+    uint32_t accumulatedSampleNum = sampleNum + sampleNumPrev;
+
+    // Reproject sample from adjacent level
+    if ((Dot(cameraOffset, cameraOffset) != 0) && (accumulatedFrameNum < resolveParameters.accumulationFrameNum))
+    {
+        const HashGridKey adjacentLevelHashKey = SharcGetAdjacentLevelHashKey(hashKey, sharcParameters.gridParameters, resolveParameters.cameraPositionPrev);
+
+        HashGridIndex cacheIndex = c_HashGridInvalidCacheIndex;
+        if (HashMapFind(hashMapData, adjacentLevelHashKey, cacheIndex))
+        {
+            const uint4 adjacentPackedDataPrev = SharcLoadVoxelDataPrev(sharcParameters, cacheIndex);
+            const uint32_t adjacentSampleNum = SharcGetSampleNum(adjacentPackedDataPrev.w);
+            if (adjacentSampleNum > c_SharcSampleNumThreshold)
+            {
+                const float blendWeight = adjacentSampleNum / float(adjacentSampleNum + accumulatedSampleNum);
+                accumulatedRadiance[0] = FloatToUint(Lerp(float(accumulatedRadiance[0]), float(adjacentPackedDataPrev.x), blendWeight));
+                accumulatedRadiance[1] = FloatToUint(Lerp(float(accumulatedRadiance[1]), float(adjacentPackedDataPrev.y), blendWeight));
+                accumulatedRadiance[2] = FloatToUint(Lerp(float(accumulatedRadiance[2]), float(adjacentPackedDataPrev.z), blendWeight));
+                accumulatedSampleNum = FloatToUint(Lerp(float(accumulatedSampleNum), float(adjacentSampleNum), blendWeight));
+            }
+        }
+    }
+
+    // Clamp internal sample count to help with potential overflow
+    if (accumulatedSampleNum > c_SharcNormalizedSampleNum)
+    {
+        accumulatedSampleNum >>= 1;
+        for (uint32_t& radiance : accumulatedRadiance)
+            radiance >>= 1;
+    }
+
+    const uint32_t accumulationFrameNum = std::clamp(resolveParameters.accumulationFrameNum, c_SharcAccumulatedFrameNumMin, c_SharcAccumulatedFrameNumMax);
+    if (accumulatedFrameNum > accumulationFrameNum)
+    {
+        const float normalizedAccumulatedSampleNum = std::nearbyint(accumulatedSampleNum * float(accumulationFrameNum) / accumulatedFrameNum);
+        const float normalizationScale = normalizedAccumulatedSampleNum / accumulatedSampleNum;
+
+        accumulatedSampleNum = FloatToUint(normalizedAccumulatedSampleNum);
+        for (uint32_t& radiance : accumulatedRadiance)
+            radiance = FloatToUint(radiance * normalizationScale);
+        accumulatedFrameNum = FloatToUint(accumulatedFrameNum * normalizationScale);
+    }
+
+    staleFrameNum = (sampleNum != 0) ? 0 : staleFrameNum + 1;
+
+    uint4& packed = packedData;
+    packed.x = accumulatedRadiance[0];
+    packed.y = accumulatedRadiance[1];
+    packed.z = accumulatedRadiance[2];
+    packed.w = std::min(accumulatedSampleNum, c_SharcSampleNumBitMask);
+    packed.w |= (std::min(accumulatedFrameNum, c_SharcAccumulatedFrameNumBitMask) << c_SharcAccumulatedFrameNumBitOffset);
+    packed.w |= (std::min(staleFrameNum, c_SharcStaleFrameNumBitMask) << c_SharcStaleFrameNumBitOffset);
+
+    const bool isValidElement = staleFrameNum < std::max(resolveParameters.staleFrameNumMax, c_SharcStaleFrameNumMin);
+    if (!isValidElement)
+        packed = uint4();
+
+    return isValidElement;
+}
+} // namespace
+
+void SharcResolveBucket(uint32_t bucketBaseSlot, const SharcParameters& sharcParameters, const SharcResolveParameters& resolveParameters, uint32_t* copyOffsetBuffer)
+{
+    assert(bucketBaseSlot % c_HashGridHashMapBucketSize == 0);
+
+    const HashMapData& hashMapData = sharcParameters.hashMapData;
+    if (bucketBaseSlot >= hashMapData.capacity)
+        return;
+
+    // Lanes with an invalid hash key exit early and don't take part in the wave operations
+    bool isActive[c_HashGridHashMapBucketSize] = {};
+    bool isValidElement[c_HashGridHashMapBucketSize] = {};
+    uint4 packedData[c_HashGridHashMapBucketSize] = {};
+
+    // First pass: every lane computes its resolved data before any lane writes, as within a single wave
+    for (uint32_t lane = 0; lane < c_HashGridHashMapBucketSize; ++lane)
+    {
+        const uint32_t entryIndex = bucketBaseSlot + lane;
+        if (entryIndex >= hashMapData.capacity)
+            break;
+
+        const HashGridKey hashKey = hashMapData.hashEntriesBuffer[entryIndex];
+        if (hashKey == c_HashGridInvalidHashKey)
+            continue;
+
+        isActive[lane] = true;
+        isValidElement[lane] = SharcResolveVoxel(entryIndex, hashKey, sharcParameters, resolveParameters, packedData[lane]);
+    }
+
+    // WaveActiveBallot / WaveActiveCountBits
+    uint32_t validElementMask = 0;
+    for (uint32_t lane = 0; lane < c_HashGridHashMapBucketSize; ++lane)
+        validElementMask |= (isActive[lane] && isValidElement[lane]) ? (1u << lane) : 0;
+    const uint32_t validElementNum = uint32_t(std::popcount(validElementMask));
+
+    // Second pass: compaction, valid elements above 'validElementNum' move into the free slots below it
+    uint32_t movableElementIndex = 0;
+    for (uint32_t lane = 0; lane < c_HashGridHashMapBucketSize; ++lane)
+    {
+        if (!isActive[lane])
+            continue;
+
+        const uint32_t entryIndex = bucketBaseSlot + lane;
+        if (lane >= validElementNum)
+        {
+            uint32_t writeOffset = 0;
+            SharcStoreResolvedVoxelData(sharcParameters, entryIndex, uint4());
+
+            if (isValidElement[lane])
+            {
+                uint32_t emptySlotIndex = 0;
+                while (emptySlotIndex < validElementNum)
+                {
+                    if (((validElementMask >> writeOffset) & 0x1) == 0)
+                    {
+                        if (emptySlotIndex == movableElementIndex)
+                        {
+                            writeOffset += HashGridGetBaseSlot(entryIndex, hashMapData.capacity);
+                            SharcStoreResolvedVoxelData(sharcParameters, writeOffset, packedData[lane]);
+                            break;
+                        }
+                        ++emptySlotIndex;
+                    }
+                    ++writeOffset;
+                }
+
+                // WavePrefixCountBits(isMovableElement)
+                ++movableElementIndex;
+            }
+
+            // Matches the shader, an offset of 0 is reserved and treated as an eviction
+            copyOffsetBuffer[entryIndex] = (writeOffset != 0) ? writeOffset : c_HashGridInvalidCacheIndex;
+
+            if (hashMapData.stats)
+            {
+                hashMapData.stats->movedNum += (writeOffset != 0) ? 1 : 0;
+                hashMapData.stats->evictedNum += (writeOffset != 0) ? 0 : 1;
+            }
+        }
+        else if (isValidElement[lane])
+        {
+            SharcStoreResolvedVoxelData(sharcParameters, entryIndex, packedData[lane]);
+        }
+        else if (hashMapData.stats)
+        {
+            // Stale entries below 'validElementNum' are overwritten by a moved element or left for the next frame
+            hashMapData.stats->evictedNum++;
+        }
+    }
+}
+
+void SharcResolveEntry(uint32_t entryIndex, const SharcParameters& sharcParameters, const SharcResolveParameters& resolveParameters)
+{
+    const HashMapData& hashMapData = sharcParameters.hashMapData;
+    if (entryIndex >= hashMapData.capacity)
+        return;
+
+    const HashGridKey hashKey = hashMapData.hashEntriesBuffer[entryIndex];
+    if (hashKey == c_HashGridInvalidHashKey)
+        return;
+
+    uint4 packedData;
+    if (!SharcResolveVoxel(entryIndex, hashKey, sharcParameters, resolveParameters, packedData))
+    {
+        hashMapData.hashEntriesBuffer[entryIndex] = c_HashGridInvalidHashKey;
+
+        if (hashMapData.stats)
+            hashMapData.stats->evictedNum++;
+    }
+
+    SharcStoreResolvedVoxelData(sharcParameters, entryIndex, packedData);
+}
+
+void SharcCopyHashEntry(uint32_t entryIndex, const HashMapData& hashMapData, uint32_t* copyOffsetBuffer)
+{
+    if (entryIndex >= hashMapData.capacity)
+        return;
+
+    const uint32_t copyOffset = copyOffsetBuffer[entryIndex];
+    if (copyOffset == 0)
+        return;
+
+    if (copyOffset == c_HashGridInvalidCacheIndex)
+    {
+        hashMapData.hashEntriesBuffer[entryIndex] = c_HashGridInvalidHashKey;
+    }
+    else
+    {
+        const HashGridKey hashKey = hashMapData.hashEntriesBuffer[entryIndex];
+        hashMapData.hashEntriesBuffer[entryIndex] = c_HashGridInvalidHashKey;
+        hashMapData.hashEntriesBuffer[copyOffset] = hashKey;
+    }
+
+    copyOffsetBuffer[entryIndex] = 0;
+}
+
+void HashGridHash32Batch(const HashGridKey* hashKeys, uint32_t count, uint32_t* hashes)
+{
+    uint32_t i = 0;
+
+#if SHARC_CPU_SSE2
+    auto jenkins32 = [](__m128i a) {
+        a = _mm_add_epi32(_mm_add_epi32(a, _mm_set1_epi32(0x7ed55d16)), _mm_slli_epi32(a, 12));
+        a = _mm_xor_si128(_mm_xor_si128(a, _mm_set1_epi32(int(0xc761c23c))), _mm_srli_epi32(a, 19));
+        a = _mm_add_epi32(_mm_add_epi32(a, _mm_set1_epi32(0x165667b1)), _mm_slli_epi32(a, 5));
+        a = _mm_xor_si128(_mm_add_epi32(a, _mm_set1_epi32(int(0xd3a2646c))), _mm_slli_epi32(a, 9));
+        a = _mm_add_epi32(_mm_add_epi32(a, _mm_set1_epi32(int(0xfd7046c5))), _mm_slli_epi32(a, 3));
+        a = _mm_xor_si128(_mm_xor_si128(a, _mm_set1_epi32(int(0xb55a4f09))), _mm_srli_epi32(a, 16));
+        return a;
+    };
+
+    for (; i + 4 <= count; i += 4)
+    {
+        const __m128i keys01 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hashKeys + i));
+        const __m128i keys23 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hashKeys + i + 2));
+
+        // De-interleave the low and high halves of four keys
+        const __m128i shuffled01 = _mm_shuffle_epi32(keys01, _MM_SHUFFLE(3, 1, 2, 0));
+        const __m128i shuffled23 = _mm_shuffle_epi32(keys23, _MM_SHUFFLE(3, 1, 2, 0));
+        const __m128i lo = _mm_unpacklo_epi64(shuffled01, shuffled23);
+        const __m128i hi = _mm_unpackhi_epi64(shuffled01, shuffled23);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(hashes + i), _mm_xor_si128(jenkins32(lo), jenkins32(hi)));
+    }
+#endif
+
+    for (; i < count; ++i)
+        hashes[i] = HashGridHash32(hashKeys[i]);
+}
+
+void HashGridComputeSpatialHashBatch(const float3* samplePositions, const float3* sampleNormals, uint32_t count, const HashGridParameters& gridParameters, HashGridKey* hashKeys)
+{
+    // Coherent batches mostly land on a handful of levels, reuse the voxel size instead of calling pow() per sample
+    uint32_t cachedLevel = UINT_MAX;
+    float cachedVoxelSize = 0.0f;
+
+    for (uint32_t i = 0; i < count; ++i)
+    {
+        const float3 samplePosition = { samplePositions[i].x + c_HashGridPositionBias, samplePositions[i].y + c_HashGridPositionBias,
+            samplePositions[i].z + c_HashGridPositionBias };
+
+        const uint32_t gridLevel = HashGridGetLevel(samplePosition, gridParameters);
+        if (gridLevel != cachedLevel)
+        {
+            cachedLevel = gridLevel;
+            cachedVoxelSize = HashGridGetVoxelSize(gridLevel, gridParameters);
+        }
+
+        hashKeys[i] = HashGridComputeSpatialHash(samplePosition, gridLevel, cachedVoxelSize, sampleNormals[i]);
+    }
+}
+
+void HashMapFindBatch(const HashMapData& hashMapData, const HashGridKey* hashKeys, uint32_t count, HashGridIndex* cacheIndices)
+{
+    const uint32_t c_BatchSize = 64;
+    uint32_t hashes[c_BatchSize];
+
+    for (uint32_t batchOffset = 0; batchOffset < count; batchOffset += c_BatchSize)
+    {
+        const uint32_t batchCount = std::min(c_BatchSize, count - batchOffset);
+        HashGridHash32Batch(hashKeys + batchOffset, batchCount, hashes);
+
+        for (uint32_t i = 0; i < batchCount; ++i)
+        {
+            const uint32_t baseSlot = HashGridGetBaseSlot(hashes[i] % hashMapData.capacity, hashMapData.capacity, hashMapData.allowCompaction);
+
+            uint32_t probeNum = 0;
+            const uint32_t bucketOffset = HashMapScanBucket(hashMapData.hashEntriesBuffer + baseSlot, hashKeys[batchOffset + i], hashMapData.allowCompaction, probeNum);
+            const bool found = bucketOffset < c_HashGridHashMapBucketSize;
+
+            cacheIndices[batchOffset + i] = found ? baseSlot + bucketOffset : c_HashGridInvalidCacheIndex;
+
+            if (hashMapData.stats)
+            {
+                hashMapData.stats->findNum++;
+                hashMapData.stats->findProbeNum += probeNum;
+                hashMapData.stats->findMissNum += found ? 0 : 1;
+            }
+        }
+    }
+}
+
+SharcCache::SharcCache(const SharcCacheDesc& desc) : m_desc(desc)
+{
+    // Resolve works on whole buckets
+    m_desc.entriesNum = std::max(m_desc.entriesNum / c_HashGridHashMapBucketSize, 1u) * c_HashGridHashMapBucketSize;
+
+    m_hashEntries.resize(m_desc.entriesNum, c_HashGridInvalidHashKey);
+    m_copyOffsets.resize(m_desc.entriesNum, 0);
+    m_voxelData.resize(m_desc.entriesNum);
+    if (m_desc.packedVoxelData)
+        m_packedVoxelData.resize(m_desc.entriesNum);
+    else
+        m_voxelDataPrev.resize(m_desc.entriesNum);
+
+    if (m_desc.enableLiveEntryList)
+    {
+        m_liveEntries.resize(m_desc.entriesNum);
+        m_liveEntriesNext.resize(m_desc.entriesNum);
+        m_liveEntryMask.resize((m_desc.entriesNum + 31) / 32, 0);
+    }
+}
+
+void SharcCache::Clear()
+{
+    std::fill(m_hashEntries.begin(), m_hashEntries.end(), c_HashGridInvalidHashKey);
+    std::fill(m_copyOffsets.begin(), m_copyOffsets.end(), 0);
+    std::fill(m_voxelData.begin(), m_voxelData.end(), uint4());
+    std::fill(m_voxelDataPrev.begin(), m_voxelDataPrev.end(), uint4());
+    std::fill(m_packedVoxelData.begin(), m_packedVoxelData.end(), SharcPackedVoxelData());
+
+    std::fill(m_liveEntryMask.begin(), m_liveEntryMask.end(), 0);
+    m_liveEntryNum = 0;
+    m_liveEntryNumNext = 0;
+}
+
+void SharcCache::SetCameraPosition(const float3& cameraPosition)
+{
+    m_cameraPositionPrev = m_hasCameraPosition ? m_cameraPosition : cameraPosition;
+    m_cameraPosition = cameraPosition;
+    m_hasCameraPosition = true;
+}
+
+void SharcCache::BeginFrame()
+{
+    // Packed history is resolved in place
+    if (!m_desc.packedVoxelData)
+        std::swap(m_voxelData, m_voxelDataPrev);
+
+    // The live entry list compaction resets the slots it visits instead
+    if (!m_desc.enableLiveEntryList)
+        std::fill(m_voxelData.begin(), m_voxelData.end(), uint4());
+
+    // The list written by the previous compaction becomes the current one
+    std::swap(m_liveEntries, m_liveEntriesNext);
+    std::swap(m_liveEntryNum, m_liveEntryNumNext);
+}
+
+SharcParameters SharcCache::GetParameters()
+{
+    SharcParameters sharcParameters;
+    sharcParameters.gridParameters.cameraPosition = m_cameraPosition;
+    sharcParameters.gridParameters.sceneScale = m_desc.sceneScale;
+    sharcParameters.gridParameters.logarithmBase = m_desc.logarithmBase;
+    sharcParameters.gridParameters.levelBias = m_desc.levelBias;
+
+    sharcParameters.hashMapData.capacity = m_desc.entriesNum;
+    sharcParameters.hashMapData.hashEntriesBuffer = m_hashEntries.data();
+    sharcParameters.hashMapData.stats = &m_stats;
+    sharcParameters.hashMapData.allowCompaction = !m_desc.enableLiveEntryList;
+
+    sharcParameters.enableAntiFireflyFilter = m_desc.enableAntiFireflyFilter;
+    sharcParameters.voxelDataBuffer = m_voxelData.data();
+    sharcParameters.voxelDataBufferPrev = m_desc.packedVoxelData ? nullptr : m_voxelDataPrev.data();
+    sharcParameters.packedVoxelDataBuffer = m_desc.packedVoxelData ? m_packedVoxelData.data() : nullptr;
+
+    return sharcParameters;
+}
+
+void SharcCache::Resolve()
+{
+    const SharcParameters sharcParameters = GetParameters();
+
+    SharcResolveParameters resolveParameters;
+    resolveParameters.cameraPositionPrev = m_cameraPositionPrev;
+    resolveParameters.accumulationFrameNum = m_desc.accumulationFrameNum;
+    resolveParameters.staleFrameNumMax = m_desc.staleFrameNum;
+    resolveParameters.enableAntiFireflyFilter = m_desc.enableAntiFireflyFilter;
+
+    const uint32_t groupSize = 256; // LINEAR_BLOCK_SIZE
+    m_dispatchStats.frameNum++;
+
+    if (!m_desc.enableLiveEntryList)
+    {
+        const uint64_t threadNum = uint64_t((m_desc.entriesNum + groupSize - 1) / groupSize) * groupSize;
+        m_dispatchStats.resolveThreadNum += threadNum;
+        m_dispatchStats.compactionThreadNum += threadNum;
+        m_dispatchStats.liveEntryNum += GetOccupiedEntryNum();
+
+        // sharcResolve
+        for (uint32_t bucketBaseSlot = 0; bucketBaseSlot < m_desc.entriesNum; bucketBaseSlot += c_HashGridHashMapBucketSize)
+            SharcResolveBucket(bucketBaseSlot, sharcParameters, resolveParameters, m_copyOffsets.data());
+
+        // sharcCompaction
+        for (uint32_t entryIndex = 0; entryIndex < m_desc.entriesNum; ++entryIndex)
+            SharcCopyHashEntry(entryIndex, sharcParameters.hashMapData, m_copyOffsets.data());
+
+        return;
+    }
+
+    // sharcPrepareIndirect
+    const uint32_t liveEntryNum = std::min(m_liveEntryNum, m_desc.entriesNum);
+    const uint64_t threadNum = uint64_t((liveEntryNum + groupSize - 1) / groupSize) * groupSize;
+    m_dispatchStats.resolveThreadNum += threadNum;
+    m_dispatchStats.compactionThreadNum += threadNum;
+    m_dispatchStats.liveEntryNum += liveEntryNum;
+    m_liveEntryNumNext = 0;
+
+    // sharcResolve
+    for (uint32_t i = 0; i < liveEntryNum; ++i)
+        SharcResolveEntry(m_liveEntries[i], sharcParameters, resolveParameters);
+
+    // sharcCompaction, listed entries cover every slot written since the last reset of the buffer accumulated into on the next frame
+    std::vector<uint4>& nextAccumulationBuffer = m_desc.packedVoxelData ? m_voxelData : m_voxelDataPrev;
+    for (uint32_t i = 0; i < liveEntryNum; ++i)
+    {
+        const uint32_t entryIndex = m_liveEntries[i];
+        nextAccumulationBuffer[entryIndex] = uint4();
+
+        if (m_hashEntries[entryIndex] != c_HashGridInvalidHashKey)
+            m_liveEntriesNext[m_liveEntryNumNext++] = entryIndex;
+        else
+            m_liveEntryMask[entryIndex >> 5] &= ~(1u << (entryIndex & 31));
+    }
+}
+
+bool SharcCache::UpdateHit(const SharcParameters& sharcParameters, SharcState& sharcState, const SharcHitData& hitData, const float3& directLighting, float random)
+{
+    const bool continueTracing = SharcUpdateHit(sharcParameters, sharcState, hitData, directLighting, random);
+
+    // SharcLiveEntryAppend()
+    const HashGridIndex cacheIndex = sharcState.cacheIndices[0];
+    if (m_desc.enableLiveEntryList && cacheIndex != c_HashGridInvalidCacheIndex)
+    {
+        uint32_t& mask = m_liveEntryMask[cacheIndex >> 5];
+        const uint32_t maskBit = 1u << (cacheIndex & 31);
+        if ((mask & maskBit) == 0)
+        {
+            mask |= maskBit;
+            m_liveEntries[m_liveEntryNum++] = cacheIndex;
+        }
+    }
+
+    return continueTracing;
+}
+
+bool SharcCache::GetCachedRadiance(const SharcHitData& hitData, float3& radiance) const
+{
+    const SharcParameters sharcParameters = const_cast<SharcCache*>(this)->GetParameters();
+
+    return SharcGetCachedRadiance(sharcParameters, hitData, radiance, false);
+}
+
+uint32_t SharcCache::GetCachedRadianceBatch(const SharcHitData* hitData, uint32_t count, float3* radiance, uint8_t* isValid) const
+{
+    const SharcParameters sharcParameters = const_cast<SharcCache*>(this)->GetParameters();
+
+    const uint32_t c_BatchSize = 64;
+    float3 positions[c_BatchSize];
+    float3 normals[c_BatchSize];
+    HashGridKey hashKeys[c_BatchSize];
+    HashGridIndex cacheIndices[c_BatchSize];
+
+    uint32_t validNum = 0;
+    for (uint32_t batchOffset = 0; batchOffset < count; batchOffset += c_BatchSize)
+    {
+        const uint32_t batchCount = std::min(c_BatchSize, count - batchOffset);
+        for (uint32_t i = 0; i < batchCount; ++i)
+        {
+            positions[i] = hitData[batchOffset + i].positionWorld;
+            normals[i] = hitData[batchOffset + i].normalWorld;
+        }
+
+        HashGridComputeSpatialHashBatch(positions, normals, batchCount, sharcParameters.gridParameters, hashKeys);
+        HashMapFindBatch(sharcParameters.hashMapData, hashKeys, batchCount, cacheIndices);
+
+        for (uint32_t i = 0; i < batchCount; ++i)
+        {
+            const HashGridIndex cacheIndex = cacheIndices[i];
+            const SharcVoxelData voxelData =
+                (cacheIndex != c_HashGridInvalidCacheIndex) ? SharcUnpackVoxelData(SharcLoadResolvedVoxelData(sharcParameters, cacheIndex)) : SharcVoxelData();
+            const bool valid = voxelData.accumulatedSampleNum > c_SharcSampleNumThreshold;
+            if (valid)
+                radiance[batchOffset + i] = SharcResolveAccumulatedRadiance(voxelData.accumulatedRadiance, voxelData.accumulatedSampleNum);
+
+            isValid[batchOffset + i] = valid ? 1 : 0;
+            validNum += valid ? 1 : 0;
+        }
+    }
+
+    return validNum;
+}
+
+uint32_t SharcCache::GetOccupiedEntryNum() const
+{
+    return uint32_t(std::count_if(m_hashEntries.begin(), m_hashEntries.end(), [](HashGridKey hashKey) { return hashKey != c_HashGridInvalidHashKey; }));
+}
+
+uint64_t SharcCache::GetMemorySize() const
+{
+    return m_hashEntries.size() * sizeof(HashGridKey) + m_copyOffsets.size() * sizeof(uint32_t) + m_voxelData.size() * sizeof(uint4) +
+        m_voxelDataPrev.size() * sizeof(uint4) + m_packedVoxelData.size() * sizeof(SharcPackedVoxelData);
+}
+} // namespace SharcCpu
@@ -0,0 +1,349 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// CPU reference implementation of the SHaRC hash grid and radiance cache.
+// Mirrors HashGridCommon.h and SharcCommon.h in the configuration used by the path tracer sample:
+// 64-bit atomics, bucketed hash map with compaction, adjacent level blending and deferred hash compaction.
+// Function names match the shader side so results can be compared entry by entry.
+// Hash compaction can be disabled per hash map to model SHARC_ENABLE_LIVE_ENTRY_LIST (HASH_GRID_ALLOW_COMPACTION 0).
+// SharcParameters::packedVoxelDataBuffer selects the packed history encoding (SHARC_PACKED_VOXEL_DATA), which only exists in this model.
+// The model is single-threaded, atomics are emulated with plain read-modify-write operations.
+
+#ifndef SHARC_CPU_ENABLE_SIMD
+#define SHARC_CPU_ENABLE_SIMD 1
+#endif
+
+#if SHARC_CPU_ENABLE_SIMD && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SHARC_CPU_SSE2 1
+#else
+#define SHARC_CPU_SSE2 0
+#endif
+
+namespace SharcCpu
+{
+struct float3
+{
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+};
+
+struct int4
+{
+    int x = 0;
+    int y = 0;
+    int z = 0;
+    int w = 0;
+};
+
+struct uint4
+{
+    uint32_t x = 0;
+    uint32_t y = 0;
+    uint32_t z = 0;
+    uint32_t w = 0;
+};
+
+using HashGridKey = uint64_t;
+using HashGridIndex = uint32_t;
+
+// HashGridCommon.h
+constexpr uint32_t c_HashGridPositionBitNum = 17;
+constexpr uint32_t c_HashGridPositionBitMask = (1u << c_HashGridPositionBitNum) - 1;
+constexpr uint32_t c_HashGridLevelBitNum = 10;
+constexpr uint32_t c_HashGridLevelBitMask = (1u << c_HashGridLevelBitNum) - 1;
+constexpr uint32_t c_HashGridNormalBitNum = 3;
+constexpr uint32_t c_HashGridNormalBitMask = (1u << c_HashGridNormalBitNum) - 1;
+constexpr uint32_t c_HashGridHashMapBucketSize = 32;
+constexpr HashGridKey c_HashGridInvalidHashKey = 0;
+constexpr HashGridIndex c_HashGridInvalidCacheIndex = 0xFFFFFFFF;
+constexpr float c_HashGridPositionBias = 1e-4f;
+constexpr float c_HashGridNormalBias = 1e-3f;
+
+// SharcCommon.h
+constexpr uint32_t c_SharcSampleNumBitNum = 18;
+constexpr uint32_t c_SharcSampleNumBitOffset = 0;
+constexpr uint32_t c_SharcSampleNumBitMask = (1u << c_SharcSampleNumBitNum) - 1;
+constexpr uint32_t c_SharcAccumulatedFrameNumBitNum = 6;
+constexpr uint32_t c_SharcAccumulatedFrameNumBitOffset = c_SharcSampleNumBitNum;
+constexpr uint32_t c_SharcAccumulatedFrameNumBitMask = (1u << c_SharcAccumulatedFrameNumBitNum) - 1;
+constexpr uint32_t c_SharcStaleFrameNumBitNum = 8;
+constexpr uint32_t c_SharcStaleFrameNumBitOffset = c_SharcSampleNumBitNum + c_SharcAccumulatedFrameNumBitNum;
+constexpr uint32_t c_SharcStaleFrameNumBitMask = (1u << c_SharcStaleFrameNumBitNum) - 1;
+constexpr float c_SharcGridLogarithmBase = 2.0f; // SHARC_GRID_LOGARITHM_BASE
+constexpr float c_SharcGridLevelBias = 0.0f;      // SHARC_GRID_LEVEL_BIAS
+constexpr uint32_t c_SharcNormalizedSampleNum = 1u << (c_SharcSampleNumBitNum - 1);
+constexpr uint32_t c_SharcAccumulatedFrameNumMin = 1;
+constexpr uint32_t c_SharcAccumulatedFrameNumMax = c_SharcAccumulatedFrameNumBitMask;
+constexpr uint32_t c_SharcSampleNumMultiplier = 16;
+constexpr uint32_t c_SharcSampleNumThreshold = 0;
+constexpr uint32_t c_SharcPropagationDepth = 4;
+constexpr uint32_t c_SharcResamplingDepthMin = 1;
+constexpr float c_SharcRadianceScale = 1e3f;
+constexpr uint32_t c_SharcStaleFrameNumMin = 8;
+
+struct HashGridParameters
+{
+    float3 cameraPosition;
+    float logarithmBase = c_SharcGridLogarithmBase;
+    float sceneScale = 50.0f;
+    float levelBias = c_SharcGridLevelBias;
+};
+
+// Optional counters for benchmarking the hash map behaviour
+struct HashMapStats
+{
+    uint64_t insertNum = 0;
+    uint64_t insertNewNum = 0;
+    uint64_t insertFailedNum = 0;
+    uint64_t insertProbeNum = 0;
+    uint64_t findNum = 0;
+    uint64_t findMissNum = 0;
+    uint64_t findProbeNum = 0;
+    uint64_t evictedNum = 0;
+    uint64_t movedNum = 0;
+};
+
+struct HashMapData
+{
+    uint32_t capacity = 0;
+    HashGridKey* hashEntriesBuffer = nullptr;
+    HashMapStats* stats = nullptr;
+    bool allowCompaction = true; // HASH_GRID_ALLOW_COMPACTION
+};
+
+// Packed encoding of resolved voxel data (SHARC_PACKED_VOXEL_DATA), 64 instead of 128 bits per entry.
+// Average radiance is stored as RGB9E5, the sample, accumulated frame and stale frame counters keep the layout of uint4::w.
+// Per component radiance error is about 1/512 of the largest component, values are clamped to c_SharcPackedRadianceMax
+struct SharcPackedVoxelData
+{
+    uint32_t radiance = 0;
+    uint32_t sampleData = 0;
+};
+
+constexpr float c_SharcPackedRadianceMax = 65408.0f;
+
+struct SharcParameters
+{
+    HashGridParameters gridParameters;
+    HashMapData hashMapData;
+    bool enableAntiFireflyFilter = true;
+
+    uint4* voxelDataBuffer = nullptr;
+    uint4* voxelDataBufferPrev = nullptr;
+
+    // If set, holds the resolved data and replaces 'voxelDataBufferPrev' as history, 'voxelDataBuffer' only accumulates new samples
+    SharcPackedVoxelData* packedVoxelDataBuffer = nullptr;
+};
+
+struct SharcState
+{
+    HashGridIndex cacheIndices[c_SharcPropagationDepth];
+    float3 sampleWeights[c_SharcPropagationDepth];
+    uint32_t pathLength = 0;
+};
+
+struct SharcHitData
+{
+    float3 positionWorld;
+    float3 normalWorld;
+};
+
+struct SharcVoxelData
+{
+    uint32_t accumulatedRadiance[3] = {};
+    uint32_t accumulatedSampleNum = 0;
+    uint32_t accumulatedFrameNum = 0;
+    uint32_t staleFrameNum = 0;
+};
+
+struct SharcResolveParameters
+{
+    float3 cameraPositionPrev;
+    uint32_t accumulationFrameNum = 10;
+    uint32_t staleFrameNumMax = 64;
+    bool enableAntiFireflyFilter = true;
+};
+
+// Hash grid
+uint32_t HashGridHashJenkins32(uint32_t a);
+uint32_t HashGridHash32(HashGridKey hashKey);
+uint32_t HashGridGetBaseSlot(uint32_t slot, uint32_t capacity, bool allowCompaction = true);
+uint32_t HashGridGetLevel(const float3& samplePosition, const HashGridParameters& gridParameters);
+float HashGridGetVoxelSize(uint32_t gridLevel, const HashGridParameters& gridParameters);
+int4 HashGridCalculatePositionLog(float3 samplePosition, const HashGridParameters& gridParameters);
+HashGridKey HashGridComputeSpatialHash(const float3& samplePosition, const float3& sampleNormal, const HashGridParameters& gridParameters);
+
+// Hash map
+bool HashMapInsert(const HashMapData& hashMapData, HashGridKey hashKey, HashGridIndex& cacheIndex);
+bool HashMapFind(const HashMapData& hashMapData, HashGridKey hashKey, HashGridIndex& cacheIndex);
+HashGridIndex HashMapInsertEntry(const HashMapData& hashMapData, const float3& samplePosition, const float3& sampleNormal, const HashGridParameters& gridParameters);
+HashGridIndex HashMapFindEntry(const HashMapData& hashMapData, const float3& samplePosition, const float3& sampleNormal, const HashGridParameters& gridParameters);
+
+// Radiance cache
+uint32_t SharcGetSampleNum(uint32_t packedData);
+uint32_t SharcGetStaleFrameNum(uint32_t packedData);
+uint32_t SharcGetAccumulatedFrameNum(uint32_t packedData);
+float3 SharcResolveAccumulatedRadiance(const uint32_t accumulatedRadiance[3], uint32_t accumulatedSampleNum);
+SharcVoxelData SharcUnpackVoxelData(const uint4& voxelDataPacked);
+uint32_t SharcPackRGB9E5(const float3& value);
+float3 SharcUnpackRGB9E5(uint32_t packedValue);
+SharcPackedVoxelData SharcPackVoxelData(const uint4& voxelData);
+uint4 SharcUnpackPackedVoxelData(const SharcPackedVoxelData& packedVoxelData);
+SharcVoxelData SharcGetVoxelData(const uint4* voxelDataBuffer, HashGridIndex cacheIndex);
+
+void SharcInit(SharcState& sharcState);
+void SharcUpdateMiss(const SharcParameters& sharcParameters, const SharcState& sharcState, const float3& radiance);
+bool SharcUpdateHit(const SharcParameters& sharcParameters, SharcState& sharcState, const SharcHitData& sharcHitData, const float3& directLighting, float random);
+void SharcSetThroughput(SharcState& sharcState, const float3& throughput);
+bool SharcGetCachedRadiance(const SharcParameters& sharcParameters, const SharcHitData& sharcHitData, float3& radiance, bool debug);
+
+HashGridKey SharcGetAdjacentLevelHashKey(HashGridKey hashKey, const HashGridParameters& gridParameters, const float3& cameraPositionPrev);
+
+// Emulates one wave of 'sharcResolve' over the hash map bucket starting at 'bucketBaseSlot'.
+// The shader relies on wave intrinsics for in-bucket compaction, so a bucket is the smallest unit that can be resolved
+void SharcResolveBucket(uint32_t bucketBaseSlot, const SharcParameters& sharcParameters, const SharcResolveParameters& resolveParameters, uint32_t* copyOffsetBuffer);
+void SharcCopyHashEntry(uint32_t entryIndex, const HashMapData& hashMapData, uint32_t* copyOffsetBuffer);
+
+// 'sharcResolve' without hash compaction, stale entries are evicted in place
+void SharcResolveEntry(uint32_t entryIndex, const SharcParameters& sharcParameters, const SharcResolveParameters& resolveParameters);
+
+// SIMD batch entry points, results are identical to the scalar functions above
+void HashGridHash32Batch(const HashGridKey* hashKeys, uint32_t count, uint32_t* hashes);
+void HashGridComputeSpatialHashBatch(const float3* samplePositions, const float3* sampleNormals, uint32_t count, const HashGridParameters& gridParameters, HashGridKey* hashKeys);
+void HashMapFindBatch(const HashMapData& hashMapData, const HashGridKey* hashKeys, uint32_t count, HashGridIndex* cacheIndices);
+
+struct SharcCacheDesc
+{
+    uint32_t entriesNum = 4 * 1024 * 1024; // Pathtracer::m_sharcEntriesNum
+    float sceneScale = 50.0f;              // UIData::sharcSceneScale
+    float logarithmBase = c_SharcGridLogarithmBase;
+    float levelBias = c_SharcGridLevelBias;
+    uint32_t accumulationFrameNum = 10; // UIData::sharcAccumulationFrameNum
+    uint32_t staleFrameNum = 64;        // UIData::sharcStaleFrameFrameNum
+    bool enableAntiFireflyFilter = true;
+    bool enableLiveEntryList = false; // SHARC_ENABLE_LIVE_ENTRY_LIST
+    bool packedVoxelData = false;     // SHARC_PACKED_VOXEL_DATA
+};
+
+// Threads launched by the resolve and compaction passes, accumulated over frames
+struct SharcDispatchStats
+{
+    uint64_t frameNum = 0;
+    uint64_t resolveThreadNum = 0;
+    uint64_t compactionThreadNum = 0;
+    uint64_t liveEntryNum = 0;
+};
+
+// Owns the four SHaRC buffers and drives them in the same order as Pathtracer::Render
+class SharcCache
+{
+public:
+    explicit SharcCache(const SharcCacheDesc& desc);
+
+    const SharcCacheDesc& GetDesc() const
+    {
+        return m_desc;
+    }
+
+    // Equivalent of 'sharcEnableClear' or a scene reload
+    void Clear();
+
+    // Mirrors the camera history kept for 'sharcCameraPosition' and 'sharcCameraPositionPrev'
+    void SetCameraPosition(const float3& cameraPosition);
+
+    // Swaps the voxel data buffers and clears the one accumulated into, with the live entry list the clear is done by Resolve()
+    void BeginFrame();
+
+    // Parameters to use for the update and query passes of the current frame
+    SharcParameters GetParameters();
+
+    // SharcUpdateHit() followed by the live entry list append done in the update pass
+    bool UpdateHit(const SharcParameters& sharcParameters, SharcState& sharcState, const SharcHitData& hitData, const float3& directLighting, float random);
+
+    // Runs the resolve and compaction passes, over the whole capacity or over the live entry list
+    void Resolve();
+
+    bool GetCachedRadiance(const SharcHitData& hitData, float3& radiance) const;
+    uint32_t GetCachedRadianceBatch(const SharcHitData* hitData, uint32_t count, float3* radiance, uint8_t* isValid) const;
+
+    uint32_t GetOccupiedEntryNum() const;
+
+    HashMapStats& GetStats()
+    {
+        return m_stats;
+    }
+
+    const SharcDispatchStats& GetDispatchStats() const
+    {
+        return m_dispatchStats;
+    }
+
+    void ResetStats()
+    {
+        m_stats = HashMapStats();
+        m_dispatchStats = SharcDispatchStats();
+    }
+
+    uint32_t GetLiveEntryNum() const
+    {
+        return m_liveEntryNum;
+    }
+
+    const std::vector<HashGridKey>& GetHashEntries() const
+    {
+        return m_hashEntries;
+    }
+
+    const std::vector<uint4>& GetVoxelData() const
+    {
+        return m_voxelData;
+    }
+
+    const std::vector<uint4>& GetVoxelDataPrev() const
+    {
+        return m_voxelDataPrev;
+    }
+
+    const std::vector<SharcPackedVoxelData>& GetPackedVoxelData() const
+    {
+        return m_packedVoxelData;
+    }
+
+    // Size of the hash entries, copy offset and voxel data buffers
+    uint64_t GetMemorySize() const;
+
+private:
+    SharcCacheDesc m_desc;
+    float3 m_cameraPosition;
+    float3 m_cameraPositionPrev;
+    bool m_hasCameraPosition = false;
+
+    std::vector<HashGridKey> m_hashEntries;
+    std::vector<uint32_t> m_copyOffsets;
+    std::vector<uint4> m_voxelData;
+    std::vector<uint4> m_voxelDataPrev;
+    std::vector<SharcPackedVoxelData> m_packedVoxelData;
+
+    std::vector<uint32_t> m_liveEntries;
+    std::vector<uint32_t> m_liveEntriesNext;
+    std::vector<uint32_t> m_liveEntryMask;
+    uint32_t m_liveEntryNum = 0;
+    uint32_t m_liveEntryNumNext = 0;
+
+    mutable HashMapStats m_stats;
+    SharcDispatchStats m_dispatchStats;
+};
+} // namespace SharcCpu
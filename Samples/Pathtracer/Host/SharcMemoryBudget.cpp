@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "SharcMemoryBudget.h"
+
+#include <algorithm>
+#include <bit>
+
+namespace
+{
+const float c_MinWeight = 1e-3f;
+
+// Doubles capacities in order of weighted capacity while they stay within 'capacity(i)' and the budget
+template <typename CapacityFunc>
+void Grow(uint64_t budgetByteSize, uint32_t entryByteSize, const SharcBudgetRequest* requests, uint32_t requestNum, uint32_t* entriesLimits, uint64_t& byteSize,
+    CapacityFunc capacity)
+{
+    while (true)
+    {
+        uint32_t bestIndex = requestNum;
+        float bestKey = 0.0f;
+
+        for (uint32_t i = 0; i < requestNum; ++i)
+        {
+            if (uint64_t(entriesLimits[i]) * 2 > capacity(i))
+                continue;
+
+            const uint64_t growByteSize = uint64_t(entriesLimits[i]) * entryByteSize;
+            if (byteSize + growByteSize > budgetByteSize)
+                continue;
+
+            const float key = float(entriesLimits[i]) / std::max(requests[i].weight, c_MinWeight);
+            if (bestIndex == requestNum || key < bestKey)
+            {
+                bestIndex = i;
+                bestKey = key;
+            }
+        }
+
+        if (bestIndex == requestNum)
+            break;
+
+        byteSize += uint64_t(entriesLimits[bestIndex]) * entryByteSize;
+        entriesLimits[bestIndex] *= 2;
+    }
+}
+} // namespace
+
+uint64_t SharcAllocateMemoryBudget(uint64_t budgetByteSize, uint32_t entryByteSize, const SharcBudgetRequest* requests, uint32_t requestNum, uint32_t* entriesLimits)
+{
+    uint64_t byteSize = 0;
+    for (uint32_t i = 0; i < requestNum; ++i)
+    {
+        entriesLimits[i] = std::bit_ceil(std::max(requests[i].minEntriesNum, 1u));
+        byteSize += uint64_t(entriesLimits[i]) * entryByteSize;
+    }
+
+    auto maxCapacity = [requests](uint32_t i) { return uint64_t(std::bit_floor(std::max(requests[i].maxEntriesNum, 1u))); };
+    auto requiredCapacity = [requests, maxCapacity](uint32_t i) { return std::min(std::bit_ceil(uint64_t(requests[i].requiredEntriesNum)), maxCapacity(i)); };
+
+    Grow(budgetByteSize, entryByteSize, requests, requestNum, entriesLimits, byteSize, requiredCapacity);
+    Grow(budgetByteSize, entryByteSize, requests, requestNum, entriesLimits, byteSize, maxCapacity);
+
+    return byteSize;
+}
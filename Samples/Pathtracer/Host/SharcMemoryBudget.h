@@ -0,0 +1,31 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+// Splits a memory budget shared by several SHaRC instances into per-instance capacity limits.
+// Capacities are powers of two, budget is handed out by doubling the instance with the smallest capacity relative to its weight.
+// The first pass covers the capacity each instance currently requires, the second one spreads what is left as headroom up to
+// the instance maximum. Every instance keeps its minimum capacity, even if the minimums alone don't fit into the budget.
+
+struct SharcBudgetRequest
+{
+    uint32_t requiredEntriesNum = 0;
+    uint32_t minEntriesNum = 0;
+    uint32_t maxEntriesNum = 0;
+
+    // Share of the budget relative to other instances
+    float weight = 1.0f;
+};
+
+// Writes 'requestNum' capacity limits to 'entriesLimits', returns the number of bytes they add up to
+uint64_t SharcAllocateMemoryBudget(uint64_t budgetByteSize, uint32_t entryByteSize, const SharcBudgetRequest* requests, uint32_t requestNum, uint32_t* entriesLimits);
@@ -0,0 +1,417 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "SharcSnapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <vector>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else // !_WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // !_WIN32
+
+using namespace SharcCpu;
+
+namespace
+{
+const uint32_t c_Magic = 0x4e534853; // "SHSN"
+const uint32_t c_SceneNameSizeMax = 216;
+const uint32_t c_PayloadAlignment = 16;
+
+struct SnapshotHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entriesNum;
+    uint32_t chunkEntryNum;
+    uint32_t chunkNum;
+    uint32_t voxelDataStride;
+    float sceneScale;
+    float logarithmBase;
+    float levelBias;
+    uint32_t sceneNameSize;
+    char sceneName[c_SceneNameSizeMax];
+};
+static_assert(sizeof(SnapshotHeader) == 256);
+
+struct SnapshotChunk
+{
+    uint64_t hashEntriesOffset;
+    uint64_t voxelDataOffset;
+    uint32_t hashEntriesSize; // Encoded sizes in bytes
+    uint32_t voxelDataSize;
+    uint32_t liveEntryNum;
+    uint32_t pad0;
+};
+static_assert(sizeof(SnapshotChunk) == 32);
+
+// Zero run length encoding of 32-bit words: pairs of (zero word count, literal word count) followed by the literal words.
+// A literal run ends at the first pair of zero words, isolated zeros are cheaper to keep as literals
+void EncodeZeroRuns(const uint32_t* words, size_t wordNum, std::vector<uint32_t>& encoded)
+{
+    encoded.clear();
+
+    size_t index = 0;
+    while (index < wordNum)
+    {
+        const size_t zeroBegin = index;
+        while (index < wordNum && words[index] == 0)
+            index++;
+
+        const size_t literalBegin = index;
+        while (index < wordNum && !(words[index] == 0 && (index + 1 == wordNum || words[index + 1] == 0)))
+            index++;
+
+        encoded.push_back(uint32_t(literalBegin - zeroBegin));
+        encoded.push_back(uint32_t(index - literalBegin));
+        encoded.insert(encoded.end(), words + literalBegin, words + index);
+    }
+}
+
+bool DecodeZeroRuns(const uint8_t* data, size_t size, uint32_t* words, size_t wordNum)
+{
+    if (size % sizeof(uint32_t) != 0)
+        return false;
+
+    const size_t encodedNum = size / sizeof(uint32_t);
+    size_t readIndex = 0;
+    size_t writeIndex = 0;
+    while (readIndex < encodedNum)
+    {
+        if (encodedNum - readIndex < 2)
+            return false;
+
+        uint32_t runs[2];
+        memcpy(runs, data + readIndex * sizeof(uint32_t), sizeof(runs));
+        readIndex += 2;
+
+        const size_t zeroNum = runs[0];
+        const size_t literalNum = runs[1];
+        if (zeroNum > wordNum - writeIndex || literalNum > wordNum - writeIndex - zeroNum || literalNum > encodedNum - readIndex)
+            return false;
+
+        memset(words + writeIndex, 0, zeroNum * sizeof(uint32_t));
+        writeIndex += zeroNum;
+
+        memcpy(words + writeIndex, data + readIndex * sizeof(uint32_t), literalNum * sizeof(uint32_t));
+        writeIndex += literalNum;
+        readIndex += literalNum;
+    }
+
+    return writeIndex == wordNum;
+}
+
+uint64_t AlignOffset(uint64_t offset)
+{
+    return (offset + c_PayloadAlignment - 1) & ~uint64_t(c_PayloadAlignment - 1);
+}
+} // namespace
+
+bool SharcSnapshotIsCompatible(const SharcSnapshotDesc& snapshotDesc, const SharcSnapshotDesc& desc)
+{
+    return snapshotDesc.sceneName == desc.sceneName && snapshotDesc.sceneScale == desc.sceneScale && snapshotDesc.logarithmBase == desc.logarithmBase &&
+        snapshotDesc.levelBias == desc.levelBias;
+}
+
+bool SharcSnapshotWrite(std::ostream& stream, const SharcSnapshotDesc& desc, const HashGridKey* hashEntries, const uint4* voxelData, uint32_t chunkEntryNum)
+{
+    if (desc.entriesNum == 0 || chunkEntryNum == 0 || desc.sceneName.size() > c_SceneNameSizeMax)
+        return false;
+
+    SnapshotHeader header = {};
+    header.magic = c_Magic;
+    header.version = c_SharcSnapshotVersion;
+    header.entriesNum = desc.entriesNum;
+    header.chunkEntryNum = chunkEntryNum;
+    header.chunkNum = (desc.entriesNum + chunkEntryNum - 1) / chunkEntryNum;
+    header.voxelDataStride = sizeof(uint4);
+    header.sceneScale = desc.sceneScale;
+    header.logarithmBase = desc.logarithmBase;
+    header.levelBias = desc.levelBias;
+    header.sceneNameSize = uint32_t(desc.sceneName.size());
+    memcpy(header.sceneName, desc.sceneName.data(), desc.sceneName.size());
+
+    const std::streampos basePosition = stream.tellp();
+
+    // The chunk table is written once all payload sizes are known
+    std::vector<SnapshotChunk> chunks(header.chunkNum);
+    stream.write((const char*)&header, sizeof(header));
+    stream.write((const char*)chunks.data(), chunks.size() * sizeof(SnapshotChunk));
+
+    uint64_t offset = sizeof(header) + chunks.size() * sizeof(SnapshotChunk);
+    std::vector<uint4> chunkVoxelData;
+    std::vector<uint32_t> encoded;
+    const char padding[c_PayloadAlignment] = {};
+
+    auto writePayload = [&](uint64_t& payloadOffset, uint32_t& payloadSize) {
+        const uint64_t alignedOffset = AlignOffset(offset);
+        stream.write(padding, alignedOffset - offset);
+        stream.write((const char*)encoded.data(), encoded.size() * sizeof(uint32_t));
+
+        payloadOffset = alignedOffset;
+        payloadSize = uint32_t(encoded.size() * sizeof(uint32_t));
+        offset = alignedOffset + payloadSize;
+    };
+
+    for (uint32_t chunkIndex = 0; chunkIndex < header.chunkNum; ++chunkIndex)
+    {
+        const uint32_t begin = chunkIndex * chunkEntryNum;
+        const uint32_t count = std::min(chunkEntryNum, desc.entriesNum - begin);
+        SnapshotChunk& chunk = chunks[chunkIndex];
+
+        EncodeZeroRuns((const uint32_t*)(hashEntries + begin), count * sizeof(HashGridKey) / sizeof(uint32_t), encoded);
+        writePayload(chunk.hashEntriesOffset, chunk.hashEntriesSize);
+
+        // Drop data left behind by evicted entries, it would only break up the zero runs
+        chunkVoxelData.assign(voxelData + begin, voxelData + begin + count);
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (hashEntries[begin + i] == c_HashGridInvalidHashKey)
+                chunkVoxelData[i] = uint4();
+            else
+                chunk.liveEntryNum++;
+        }
+
+        EncodeZeroRuns((const uint32_t*)chunkVoxelData.data(), count * sizeof(uint4) / sizeof(uint32_t), encoded);
+        writePayload(chunk.voxelDataOffset, chunk.voxelDataSize);
+    }
+
+    const std::streampos endPosition = stream.tellp();
+    stream.seekp(basePosition + std::streamoff(sizeof(header)));
+    stream.write((const char*)chunks.data(), chunks.size() * sizeof(SnapshotChunk));
+    stream.seekp(endPosition);
+
+    return bool(stream);
+}
+
+bool SharcSnapshotWriteFile(const std::filesystem::path& path, const SharcSnapshotDesc& desc, const HashGridKey* hashEntries, const uint4* voxelData, uint32_t chunkEntryNum)
+{
+    // Written next to the destination first, a failed write keeps the previous snapshot
+    std::filesystem::path tempPath = path;
+    tempPath += ".tmp";
+
+    {
+        std::ofstream stream(tempPath, std::ios::binary | std::ios::trunc);
+        if (!stream || !SharcSnapshotWrite(stream, desc, hashEntries, voxelData, chunkEntryNum))
+        {
+            stream.close();
+            std::error_code errorCode;
+            std::filesystem::remove(tempPath, errorCode);
+            return false;
+        }
+    }
+
+    std::error_code errorCode;
+    std::filesystem::rename(tempPath, path, errorCode);
+
+    return !errorCode;
+}
+
+SharcSnapshotReader::~SharcSnapshotReader()
+{
+    Close();
+}
+
+bool SharcSnapshotReader::Open(const std::filesystem::path& path)
+{
+    Close();
+
+#if defined(_WIN32)
+    HANDLE fileHandle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+        return false;
+    m_fileHandle = fileHandle;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+    {
+        Close();
+        return false;
+    }
+
+    m_mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!m_mappingHandle)
+    {
+        Close();
+        return false;
+    }
+
+    m_mappedData = MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    m_size = size_t(fileSize.QuadPart);
+#else // !_WIN32
+    const int fileDescriptor = open(path.c_str(), O_RDONLY);
+    if (fileDescriptor < 0)
+        return false;
+
+    struct stat fileStat;
+    if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        close(fileDescriptor);
+        return false;
+    }
+
+    m_size = size_t(fileStat.st_size);
+    void* mappedData = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    close(fileDescriptor);
+
+    m_mappedData = (mappedData != MAP_FAILED) ? mappedData : nullptr;
+#endif // !_WIN32
+
+    if (!m_mappedData)
+    {
+        Close();
+        return false;
+    }
+
+    m_data = (const uint8_t*)m_mappedData;
+    if (!Parse())
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+bool SharcSnapshotReader::Open(const void* data, size_t size)
+{
+    Close();
+
+    m_data = (const uint8_t*)data;
+    m_size = size;
+    if (!m_data || !Parse())
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void SharcSnapshotReader::Close()
+{
+    Unmap();
+
+    m_data = nullptr;
+    m_size = 0;
+    m_desc = SharcSnapshotDesc();
+    m_chunkEntryNum = 0;
+    m_chunkNum = 0;
+    m_chunkTable = nullptr;
+}
+
+void SharcSnapshotReader::Unmap()
+{
+#if defined(_WIN32)
+    if (m_mappedData)
+        UnmapViewOfFile(m_mappedData);
+    if (m_mappingHandle)
+        CloseHandle(m_mappingHandle);
+    if (m_fileHandle)
+        CloseHandle(m_fileHandle);
+    m_mappingHandle = nullptr;
+    m_fileHandle = nullptr;
+#else // !_WIN32
+    if (m_mappedData)
+        munmap(m_mappedData, m_size);
+#endif // !_WIN32
+    m_mappedData = nullptr;
+}
+
+bool SharcSnapshotReader::Parse()
+{
+    if (m_size < sizeof(SnapshotHeader))
+        return false;
+
+    SnapshotHeader header;
+    memcpy(&header, m_data, sizeof(header));
+
+    if (header.magic != c_Magic || header.version != c_SharcSnapshotVersion || header.voxelDataStride != sizeof(uint4))
+        return false;
+
+    if (header.entriesNum == 0 || header.chunkEntryNum == 0 || header.sceneNameSize > c_SceneNameSizeMax)
+        return false;
+
+    if (header.chunkNum != (header.entriesNum + header.chunkEntryNum - 1) / header.chunkEntryNum)
+        return false;
+
+    if (m_size - sizeof(SnapshotHeader) < uint64_t(header.chunkNum) * sizeof(SnapshotChunk))
+        return false;
+
+    m_chunkTable = m_data + sizeof(SnapshotHeader);
+    m_chunkEntryNum = header.chunkEntryNum;
+    m_chunkNum = header.chunkNum;
+
+    m_desc.sceneName.assign(header.sceneName, header.sceneNameSize);
+    m_desc.sceneScale = header.sceneScale;
+    m_desc.logarithmBase = header.logarithmBase;
+    m_desc.levelBias = header.levelBias;
+    m_desc.entriesNum = header.entriesNum;
+
+    // Payloads are validated up front, reading a chunk only has to decode it
+    for (uint32_t chunkIndex = 0; chunkIndex < m_chunkNum; ++chunkIndex)
+    {
+        SnapshotChunk chunk;
+        memcpy(&chunk, m_chunkTable + chunkIndex * sizeof(SnapshotChunk), sizeof(chunk));
+
+        if (chunk.hashEntriesOffset > m_size || chunk.hashEntriesSize > m_size - chunk.hashEntriesOffset)
+            return false;
+        if (chunk.voxelDataOffset > m_size || chunk.voxelDataSize > m_size - chunk.voxelDataOffset)
+            return false;
+        if (chunk.liveEntryNum > m_chunkEntryNum)
+            return false;
+    }
+
+    return true;
+}
+
+void SharcSnapshotReader::GetChunkRange(uint32_t chunkIndex, uint32_t& begin, uint32_t& count) const
+{
+    begin = std::min(chunkIndex * m_chunkEntryNum, m_desc.entriesNum);
+    count = std::min(m_chunkEntryNum, m_desc.entriesNum - begin);
+}
+
+uint32_t SharcSnapshotReader::GetChunkLiveEntryNum(uint32_t chunkIndex) const
+{
+    if (chunkIndex >= m_chunkNum)
+        return 0;
+
+    SnapshotChunk chunk;
+    memcpy(&chunk, m_chunkTable + chunkIndex * sizeof(SnapshotChunk), sizeof(chunk));
+
+    return chunk.liveEntryNum;
+}
+
+bool SharcSnapshotReader::ReadChunk(uint32_t chunkIndex, HashGridKey* hashEntries, uint4* voxelData) const
+{
+    if (chunkIndex >= m_chunkNum)
+        return false;
+
+    SnapshotChunk chunk;
+    memcpy(&chunk, m_chunkTable + chunkIndex * sizeof(SnapshotChunk), sizeof(chunk));
+
+    uint32_t begin, count;
+    GetChunkRange(chunkIndex, begin, count);
+
+    if (!DecodeZeroRuns(m_data + chunk.hashEntriesOffset, chunk.hashEntriesSize, (uint32_t*)hashEntries, count * sizeof(HashGridKey) / sizeof(uint32_t)))
+        return false;
+
+    return DecodeZeroRuns(m_data + chunk.voxelDataOffset, chunk.voxelDataSize, (uint32_t*)voxelData, count * sizeof(uint4) / sizeof(uint32_t));
+}
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include "SharcCpu.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iosfwd>
+#include <string>
+
+// On-disk snapshot of the SHaRC hash entries and resolved voxel data.
+// The file starts with a fixed size header and a chunk table, each chunk covers a contiguous range of entries and
+// stores hash keys and voxel data as separate payloads. Payloads are compressed with a zero run length encoding of
+// 32-bit words, which suits the sparsely occupied tables, and can be decoded independently straight from a mapped file.
+// Voxel data of entries with an invalid hash key is not preserved.
+
+const uint32_t c_SharcSnapshotVersion = 1;
+const uint32_t c_SharcSnapshotChunkEntryNum = 64 * 1024;
+
+struct SharcSnapshotDesc
+{
+    std::string sceneName;
+    float sceneScale = 50.0f;
+    float logarithmBase = SharcCpu::c_SharcGridLogarithmBase;
+    float levelBias = SharcCpu::c_SharcGridLevelBias;
+    uint32_t entriesNum = 0;
+};
+
+// Returns true if hash keys stored with 'snapshotDesc' are valid for 'desc', the capacity is not compared
+bool SharcSnapshotIsCompatible(const SharcSnapshotDesc& snapshotDesc, const SharcSnapshotDesc& desc);
+
+// Buffers hold 'desc.entriesNum' elements
+bool SharcSnapshotWrite(std::ostream& stream, const SharcSnapshotDesc& desc, const SharcCpu::HashGridKey* hashEntries, const SharcCpu::uint4* voxelData,
+    uint32_t chunkEntryNum = c_SharcSnapshotChunkEntryNum);
+bool SharcSnapshotWriteFile(const std::filesystem::path& path, const SharcSnapshotDesc& desc, const SharcCpu::HashGridKey* hashEntries, const SharcCpu::uint4* voxelData,
+    uint32_t chunkEntryNum = c_SharcSnapshotChunkEntryNum);
+
+class SharcSnapshotReader
+{
+public:
+    SharcSnapshotReader() = default;
+    ~SharcSnapshotReader();
+
+    SharcSnapshotReader(const SharcSnapshotReader&) = delete;
+    SharcSnapshotReader& operator=(const SharcSnapshotReader&) = delete;
+
+    // Maps the file into memory, chunks are paged in when they are read
+    bool Open(const std::filesystem::path& path);
+
+    // Uses a snapshot already in memory, 'data' has to outlive the reader
+    bool Open(const void* data, size_t size);
+
+    void Close();
+
+    bool IsOpen() const
+    {
+        return m_data != nullptr;
+    }
+
+    const SharcSnapshotDesc& GetDesc() const
+    {
+        return m_desc;
+    }
+
+    uint32_t GetChunkNum() const
+    {
+        return m_chunkNum;
+    }
+
+    uint32_t GetChunkEntryNum() const
+    {
+        return m_chunkEntryNum;
+    }
+
+    // Range of entries covered by a chunk, [begin, begin + count)
+    void GetChunkRange(uint32_t chunkIndex, uint32_t& begin, uint32_t& count) const;
+
+    // Number of entries with a valid hash key in a chunk
+    uint32_t GetChunkLiveEntryNum(uint32_t chunkIndex) const;
+
+    // Decodes a chunk into buffers with GetChunkRange() 'count' elements, returns false on corrupted data
+    bool ReadChunk(uint32_t chunkIndex, SharcCpu::HashGridKey* hashEntries, SharcCpu::uint4* voxelData) const;
+
+private:
+    bool Parse();
+    void Unmap();
+
+    const uint8_t* m_data = nullptr;
+    size_t m_size = 0;
+
+    void* m_mappedData = nullptr;
+#if defined(_WIN32)
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#endif // _WIN32
+
+    SharcSnapshotDesc m_desc;
+    uint32_t m_chunkEntryNum = 0;
+    uint32_t m_chunkNum = 0;
+    const uint8_t* m_chunkTable = nullptr;
+};
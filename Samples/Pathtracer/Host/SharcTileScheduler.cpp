@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "SharcTileScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+
+SharcTileScheduler::SharcTileScheduler(const SharcTileSchedulerDesc& desc) : m_desc(desc)
+{
+    m_desc.tileSize = std::max(m_desc.tileSize, 1u);
+    m_desc.uniformFraction = std::clamp(m_desc.uniformFraction, 0.0f, 1.0f);
+    m_desc.missHistoryWeight = std::clamp(m_desc.missHistoryWeight, 0.0f, 1.0f);
+}
+
+void SharcTileScheduler::Resize(uint32_t width, uint32_t height)
+{
+    m_width = width;
+    m_height = height;
+    m_tileNumX = (width + m_desc.tileSize - 1) / m_desc.tileSize;
+    m_tileNumY = (height + m_desc.tileSize - 1) / m_desc.tileSize;
+    m_missNum.assign(GetTileNum(), 0.0f);
+
+    Reset();
+}
+
+void SharcTileScheduler::Reset()
+{
+    std::fill(m_missNum.begin(), m_missNum.end(), 0.0f);
+    m_hasHistory = false;
+    m_missRate = 0.0f;
+}
+
+void SharcTileScheduler::ReportTileStats(const SharcTileStats* tileStats)
+{
+    // The first sample replaces the empty history
+    const float weight = m_hasHistory ? m_desc.missHistoryWeight : 1.0f;
+
+    uint64_t lookupNum = 0;
+    uint64_t missNum = 0;
+    for (uint32_t tileIndex = 0; tileIndex < GetTileNum(); ++tileIndex)
+    {
+        m_missNum[tileIndex] += (float(tileStats[tileIndex].missNum) - m_missNum[tileIndex]) * weight;
+
+        lookupNum += tileStats[tileIndex].lookupNum;
+        missNum += std::min(tileStats[tileIndex].missNum, tileStats[tileIndex].lookupNum);
+    }
+
+    m_hasHistory = true;
+    m_missRate = lookupNum ? float(double(missNum) / double(lookupNum)) : 0.0f;
+}
+
+void SharcTileScheduler::Schedule(uint32_t rayNum, uint32_t* rayOffsets) const
+{
+    const uint32_t tileNum = GetTileNum();
+
+    double missNumSum = 0.0;
+    for (uint32_t tileIndex = 0; tileIndex < tileNum; ++tileIndex)
+        missNumSum += m_missNum[tileIndex];
+
+    // Everything is spread by area until the query pass reports misses
+    const double uniformFraction = missNumSum > 0.0 ? double(m_desc.uniformFraction) : 1.0;
+    const double areaScale = uniformFraction / (double(m_width) * double(m_height));
+    const double missScale = missNumSum > 0.0 ? (1.0 - uniformFraction) / missNumSum : 0.0;
+
+    // Rounding the running sum keeps every tile within one ray of its share and the total exact
+    double weightSum = 0.0;
+    for (uint32_t tileIndex = 0; tileIndex < tileNum; ++tileIndex)
+    {
+        rayOffsets[tileIndex] = std::min(uint32_t(std::floor(weightSum * rayNum + 0.5)), rayNum);
+
+        const uint32_t tileX = tileIndex % m_tileNumX;
+        const uint32_t tileY = tileIndex / m_tileNumX;
+        const uint32_t tileWidth = std::min(m_desc.tileSize, m_width - tileX * m_desc.tileSize);
+        const uint32_t tileHeight = std::min(m_desc.tileSize, m_height - tileY * m_desc.tileSize);
+
+        weightSum += double(tileWidth) * double(tileHeight) * areaScale + double(m_missNum[tileIndex]) * missScale;
+    }
+
+    rayOffsets[tileNum] = rayNum;
+}
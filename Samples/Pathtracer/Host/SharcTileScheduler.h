@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Distributes SHaRC update rays between screen tiles.
+// The query pass counts cache lookups and misses per tile, the counts arrive a few frames later and are smoothed over time.
+// A fixed fraction of the rays is spread by tile area so every tile keeps being refreshed, the rest follows the smoothed miss count,
+// which steers updates towards regions the cache doesn't cover yet, e.g. after a camera cut. The schedule is a prefix sum of
+// per-tile ray counts, the update pass finds the tile of a ray with a binary search and places it inside the tile with a stratified sequence.
+
+// Per-tile counters written by the query pass, matches the GPU layout
+struct SharcTileStats
+{
+    uint32_t lookupNum;
+    uint32_t missNum;
+};
+
+struct SharcTileSchedulerDesc
+{
+    uint32_t tileSize = 16;
+
+    // Fraction of the rays distributed by tile area
+    float uniformFraction = 0.25f;
+
+    // Weight of a new sample in the smoothed miss count
+    float missHistoryWeight = 0.5f;
+};
+
+class SharcTileScheduler
+{
+public:
+    explicit SharcTileScheduler(const SharcTileSchedulerDesc& desc);
+
+    const SharcTileSchedulerDesc& GetDesc() const
+    {
+        return m_desc;
+    }
+
+    // Changes the tile grid and drops the miss history
+    void Resize(uint32_t width, uint32_t height);
+
+    // Drops the miss history, the schedule falls back to the uniform distribution
+    void Reset();
+
+    // Counters of one query frame, GetTileNum() elements
+    void ReportTileStats(const SharcTileStats* tileStats);
+
+    // Writes GetTileNum() + 1 offsets, rays [rayOffsets[i], rayOffsets[i + 1]) belong to tile i
+    void Schedule(uint32_t rayNum, uint32_t* rayOffsets) const;
+
+    uint32_t GetTileNumX() const
+    {
+        return m_tileNumX;
+    }
+
+    uint32_t GetTileNumY() const
+    {
+        return m_tileNumY;
+    }
+
+    uint32_t GetTileNum() const
+    {
+        return m_tileNumX * m_tileNumY;
+    }
+
+    // Miss rate of the last reported frame over all tiles
+    float GetMissRate() const
+    {
+        return m_missRate;
+    }
+
+private:
+    SharcTileSchedulerDesc m_desc;
+
+    uint32_t m_width = 0;
+    uint32_t m_height = 0;
+    uint32_t m_tileNumX = 0;
+    uint32_t m_tileNumY = 0;
+
+    std::vector<float> m_missNum;
+    bool m_hasHistory = false;
+    float m_missRate = 0.0f;
+};
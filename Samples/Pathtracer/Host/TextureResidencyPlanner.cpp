@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "TextureResidencyPlanner.h"
+
+#include <algorithm>
+
+TextureResidencyPlanner::TextureResidencyPlanner(const TextureResidencyDesc& desc) : m_desc(desc)
+{
+}
+
+void TextureResidencyPlanner::SetBudgetSize(uint64_t budgetSize)
+{
+    m_desc.budgetSize = budgetSize;
+}
+
+uint32_t TextureResidencyPlanner::AddTexture(const uint64_t* mipSizes, uint32_t mipNum, uint32_t maxTailMip, uint32_t residentMip)
+{
+    const uint32_t textureIndex = uint32_t(m_textures.size());
+
+    Texture texture = {};
+    texture.firstMipSize = uint32_t(m_mipSizes.size());
+    texture.mipNum = std::max(mipNum, 1u);
+    texture.residentMip = std::min(residentMip, texture.mipNum - 1);
+    texture.requestedMip = c_NoRequest;
+    m_mipSizes.insert(m_mipSizes.end(), mipSizes, mipSizes + mipNum);
+    m_mipSizes.resize(texture.firstMipSize + texture.mipNum, 0);
+    m_textures.push_back(texture);
+
+    // The tail grows towards finer mips while it fits
+    uint32_t tailMip = texture.mipNum - 1;
+    while (tailMip > 0 && GetSize(textureIndex, tailMip - 1) <= m_desc.tailSize)
+        tailMip--;
+
+    m_textures.back().tailMip = std::min(tailMip, maxTailMip);
+    m_residentSize += GetSize(textureIndex, texture.residentMip);
+
+    return textureIndex;
+}
+
+void TextureResidencyPlanner::Clear()
+{
+    m_mipSizes.clear();
+    m_textures.clear();
+    m_residentSize = 0;
+}
+
+void TextureResidencyPlanner::RequestMip(uint32_t textureIndex, uint32_t mip, uint64_t frameIndex)
+{
+    Texture& texture = m_textures[textureIndex];
+    if (texture.requestedMip == c_NoRequest || texture.requestFrameIndex != frameIndex)
+        texture.requestedMip = mip;
+    else
+        texture.requestedMip = std::min(texture.requestedMip, mip);
+
+    texture.requestFrameIndex = frameIndex;
+}
+
+void TextureResidencyPlanner::SetResidentMip(uint32_t textureIndex, uint32_t residentMip)
+{
+    Texture& texture = m_textures[textureIndex];
+    m_residentSize -= GetSize(textureIndex, texture.residentMip);
+    m_residentSize += GetSize(textureIndex, residentMip);
+    texture.residentMip = residentMip;
+}
+
+uint64_t TextureResidencyPlanner::GetSize(uint32_t textureIndex, uint32_t mip) const
+{
+    const Texture& texture = m_textures[textureIndex];
+
+    uint64_t size = 0;
+    for (uint32_t i = mip; i < texture.mipNum; ++i)
+        size += m_mipSizes[texture.firstMipSize + i];
+
+    return size;
+}
+
+void TextureResidencyPlanner::Update(uint64_t frameIndex, std::vector<TextureResidencyChange>& changes)
+{
+    changes.clear();
+    m_steps.clear();
+    m_targetMips.resize(m_textures.size());
+
+    // Tails are resident even if they alone exceed the budget
+    uint64_t freeSize = m_desc.budgetSize;
+    for (uint32_t textureIndex = 0; textureIndex < uint32_t(m_textures.size()); ++textureIndex)
+    {
+        const Texture& texture = m_textures[textureIndex];
+        freeSize -= std::min(freeSize, GetSize(textureIndex, texture.tailMip));
+        m_targetMips[textureIndex] = texture.tailMip;
+
+        const bool isRequested = (texture.requestedMip != c_NoRequest) && (frameIndex < texture.requestFrameIndex + m_desc.requestLifetime);
+        const uint32_t requestedMip = isRequested ? std::min(texture.requestedMip, texture.tailMip) : texture.tailMip;
+
+        for (uint32_t mip = texture.tailMip; mip-- > requestedMip;)
+            m_steps.push_back({ texture.requestFrameIndex, textureIndex, mip, true });
+
+        for (uint32_t mip = requestedMip; mip-- > texture.residentMip;)
+            m_steps.push_back({ texture.requestFrameIndex, textureIndex, mip, false });
+    }
+
+    std::sort(m_steps.begin(), m_steps.end(), [](const Step& a, const Step& b) {
+        if (a.isRequested != b.isRequested)
+            return a.isRequested;
+
+        // Requested mips go coarsest first, mips that are only cached in order of their last request
+        if (a.isRequested && a.mip != b.mip)
+            return a.mip > b.mip;
+        if (a.requestFrameIndex != b.requestFrameIndex)
+            return a.requestFrameIndex > b.requestFrameIndex;
+        if (a.mip != b.mip)
+            return a.mip > b.mip;
+
+        return a.textureIndex < b.textureIndex;
+    });
+
+    uint64_t streamInSize = 0;
+    for (const Step& step : m_steps)
+    {
+        // Mips are granted in order, once one doesn't fit the finer ones of the texture are skipped
+        uint32_t& targetMip = m_targetMips[step.textureIndex];
+        if (step.mip + 1 != targetMip)
+            continue;
+
+        const Texture& texture = m_textures[step.textureIndex];
+        const uint64_t mipSize = m_mipSizes[texture.firstMipSize + step.mip];
+        if (mipSize > freeSize)
+            continue;
+
+        // The first mip streamed in goes through even if it is larger than the limit
+        if (step.mip < texture.residentMip)
+        {
+            if (streamInSize != 0 && streamInSize + mipSize > m_desc.maxStreamInSize)
+                continue;
+
+            streamInSize += mipSize;
+        }
+
+        freeSize -= mipSize;
+        targetMip = step.mip;
+    }
+
+    for (uint32_t textureIndex = 0; textureIndex < uint32_t(m_textures.size()); ++textureIndex)
+    {
+        const uint32_t targetMip = m_targetMips[textureIndex];
+        if (targetMip == m_textures[textureIndex].residentMip)
+            continue;
+
+        SetResidentMip(textureIndex, targetMip);
+        changes.push_back({ textureIndex, targetMip });
+    }
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Decides which mip levels of streamed textures are kept in video memory under a budget.
+// A texture keeps a contiguous range of mips, from its resident mip down to the coarsest one. The mip tail that fits into
+// 'tailSize' bytes is always resident. The renderer reports the finest mip it sampled, a request holds for 'requestLifetime'
+// frames. Requested mips are granted coarsest first across all textures, ties go to the most recently requested texture.
+// Budget that is left keeps mips that are resident but no longer requested, the least recently requested ones go first.
+// Streaming in is limited to 'maxStreamInSize' bytes per update, evictions take effect at once to make room.
+
+struct TextureResidencyDesc
+{
+    uint64_t budgetSize = 512ull << 20;
+    uint64_t maxStreamInSize = 32ull << 20;
+    uint64_t tailSize = 64ull << 10;
+    uint32_t requestLifetime = 60;
+};
+
+struct TextureResidencyChange
+{
+    uint32_t textureIndex;
+    uint32_t residentMip; // Finest mip the texture keeps from now on
+};
+
+class TextureResidencyPlanner
+{
+public:
+    static const uint32_t c_NoRequest = ~0u;
+
+    explicit TextureResidencyPlanner(const TextureResidencyDesc& desc);
+
+    const TextureResidencyDesc& GetDesc() const
+    {
+        return m_desc;
+    }
+
+    void SetBudgetSize(uint64_t budgetSize);
+
+    // 'mipSizes' holds the byte size of every mip, finest first. The tail starts at 'maxTailMip' at the latest, for formats
+    // that can't start at a finer mip. Returns the index of the texture, it starts out with 'residentMip' resident
+    uint32_t AddTexture(const uint64_t* mipSizes, uint32_t mipNum, uint32_t maxTailMip, uint32_t residentMip);
+    void Clear();
+
+    // Finest mip the renderer sampled in frame 'frameIndex', requests of the same frame combine
+    void RequestMip(uint32_t textureIndex, uint32_t mip, uint64_t frameIndex);
+
+    // Writes the textures whose resident mip changes to 'changes' and takes the new residency over,
+    // the caller applies the changes before the next update
+    void Update(uint64_t frameIndex, std::vector<TextureResidencyChange>& changes);
+
+    // Takes back a change the caller couldn't apply
+    void SetResidentMip(uint32_t textureIndex, uint32_t residentMip);
+
+    uint32_t GetTextureNum() const
+    {
+        return uint32_t(m_textures.size());
+    }
+
+    uint32_t GetResidentMip(uint32_t textureIndex) const
+    {
+        return m_textures[textureIndex].residentMip;
+    }
+
+    uint32_t GetTailMip(uint32_t textureIndex) const
+    {
+        return m_textures[textureIndex].tailMip;
+    }
+
+    uint64_t GetResidentSize() const
+    {
+        return m_residentSize;
+    }
+
+    // Size of the mips from 'mip' down to the coarsest one
+    uint64_t GetSize(uint32_t textureIndex, uint32_t mip) const;
+
+private:
+    struct Texture
+    {
+        uint32_t firstMipSize; // Index into 'm_mipSizes'
+        uint32_t mipNum;
+        uint32_t tailMip;
+        uint32_t residentMip;
+        uint32_t requestedMip;
+        uint64_t requestFrameIndex;
+    };
+
+    // Mip 'mip' of a texture, 'isRequested' steps come first
+    struct Step
+    {
+        uint64_t requestFrameIndex;
+        uint32_t textureIndex;
+        uint32_t mip;
+        bool isRequested;
+    };
+
+    TextureResidencyDesc m_desc;
+
+    std::vector<uint64_t> m_mipSizes;
+    std::vector<Texture> m_textures;
+    uint64_t m_residentSize = 0;
+
+    // Scratch of Update()
+    std::vector<Step> m_steps;
+    std::vector<uint32_t> m_targetMips;
+};
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "TlasInstanceTable.h"
+
+#include <algorithm>
+#include <cstring>
+
+TlasInstanceTable::TlasInstanceTable(const TlasInstanceTableDesc& desc) : m_desc(desc)
+{
+    m_desc.rangeMergeDistance = std::max(m_desc.rangeMergeDistance, 1u);
+}
+
+void TlasInstanceTable::Reset(uint32_t instanceNum)
+{
+    m_blasIds.assign(instanceNum, 0);
+    m_transforms.assign(size_t(instanceNum) * 12, 0.0f);
+    m_isDirty.assign(instanceNum, 0);
+    m_dirtyInstances.clear();
+    m_dirtyRanges.clear();
+
+    m_isBuildRequired = true;
+    m_refitNum = 0;
+}
+
+bool TlasInstanceTable::SetInstanceBlas(uint32_t instanceIndex, uint64_t blasId)
+{
+    if (m_blasIds[instanceIndex] == blasId)
+        return false;
+
+    m_blasIds[instanceIndex] = blasId;
+    m_isBuildRequired = true;
+    MarkDirty(instanceIndex);
+
+    return true;
+}
+
+bool TlasInstanceTable::SetInstanceTransform(uint32_t instanceIndex, const float transform[12])
+{
+    float* storedTransform = &m_transforms[size_t(instanceIndex) * 12];
+    if (memcmp(storedTransform, transform, sizeof(float) * 12) == 0)
+        return false;
+
+    memcpy(storedTransform, transform, sizeof(float) * 12);
+    MarkDirty(instanceIndex);
+
+    return true;
+}
+
+void TlasInstanceTable::MarkDirty(uint32_t instanceIndex)
+{
+    if (m_isDirty[instanceIndex])
+        return;
+
+    m_isDirty[instanceIndex] = 1;
+    m_dirtyInstances.push_back(instanceIndex);
+}
+
+TlasBuildAction TlasInstanceTable::Update()
+{
+    m_dirtyRanges.clear();
+
+    std::sort(m_dirtyInstances.begin(), m_dirtyInstances.end());
+    for (uint32_t instanceIndex : m_dirtyInstances)
+    {
+        if (!m_dirtyRanges.empty() && instanceIndex - m_dirtyRanges.back().end < m_desc.rangeMergeDistance)
+            m_dirtyRanges.back().end = instanceIndex + 1;
+        else
+            m_dirtyRanges.push_back({ instanceIndex, instanceIndex + 1 });
+
+        m_isDirty[instanceIndex] = 0;
+    }
+
+    const bool hasChanges = !m_dirtyInstances.empty();
+    m_dirtyInstances.clear();
+
+    if (m_isBuildRequired || (hasChanges && m_refitNum >= m_desc.maxRefitNum))
+    {
+        m_isBuildRequired = false;
+        m_refitNum = 0;
+
+        return TlasBuildAction::Build;
+    }
+
+    if (!hasChanges)
+        return TlasBuildAction::None;
+
+    m_refitNum++;
+
+    return TlasBuildAction::Refit;
+}
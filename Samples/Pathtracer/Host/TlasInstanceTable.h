@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Tracks the instances of a top level acceleration structure between frames.
+// The application keeps a persistent instance buffer on the GPU and reports the BLAS and the transform of every instance
+// it may have changed. The table keeps the reported state, collects the instances that differ into ranges to upload and
+// decides whether the TLAS has to be built, can be refit or can be left alone. A different BLAS or instance count requires
+// a full build, moved instances are refit until 'maxRefitNum' consecutive refits, after which a build restores the quality.
+
+struct TlasInstanceTableDesc
+{
+    uint32_t maxRefitNum = 128;
+
+    // Dirty instances closer than this are uploaded as one range
+    uint32_t rangeMergeDistance = 16;
+};
+
+enum class TlasBuildAction
+{
+    None,
+    Refit,
+    Build,
+};
+
+// Instances [begin, end) to upload
+struct TlasInstanceRange
+{
+    uint32_t begin;
+    uint32_t end;
+};
+
+class TlasInstanceTable
+{
+public:
+    explicit TlasInstanceTable(const TlasInstanceTableDesc& desc);
+
+    const TlasInstanceTableDesc& GetDesc() const
+    {
+        return m_desc;
+    }
+
+    // Drops all instances, every instance has to be reported before the next Update() which builds the TLAS
+    void Reset(uint32_t instanceNum);
+
+    uint32_t GetInstanceNum() const
+    {
+        return uint32_t(m_blasIds.size());
+    }
+
+    // True until the next Update() after Reset() or a BLAS change
+    bool IsBuildRequired() const
+    {
+        return m_isBuildRequired;
+    }
+
+    // 'blasId' identifies the BLAS, e.g. its device address. Return true if the instance changed
+    bool SetInstanceBlas(uint32_t instanceIndex, uint64_t blasId);
+    bool SetInstanceTransform(uint32_t instanceIndex, const float transform[12]);
+
+    // The BLAS of the instance was rebuilt in place, its bounds changed
+    void MarkDirty(uint32_t instanceIndex);
+
+    // Called once per frame after all instances were reported, GetDirtyRanges() lists the instances to upload
+    TlasBuildAction Update();
+
+    const std::vector<TlasInstanceRange>& GetDirtyRanges() const
+    {
+        return m_dirtyRanges;
+    }
+
+private:
+    TlasInstanceTableDesc m_desc;
+
+    std::vector<uint64_t> m_blasIds;
+    std::vector<float> m_transforms;
+
+    std::vector<uint8_t> m_isDirty;
+    std::vector<uint32_t> m_dirtyInstances;
+    std::vector<TlasInstanceRange> m_dirtyRanges;
+
+    bool m_isBuildRequired = true;
+    uint32_t m_refitNum = 0;
+};
@@ -17,6 +17,14 @@
 // Does not affect local lights shading
 #define ENABLE_SPECULAR_LOBE 1
 
+// SHaRC resolve and compaction run over the list of live cache entries using indirect dispatches.
+// Wave based hash compaction relies on bucket aligned lanes and is disabled in this mode
+#define SHARC_ENABLE_LIVE_ENTRY_LIST 1
+#define SHARC_LIVE_ENTRY_COUNTER_SIZE 4 // Live entry count followed by the indirect dispatch arguments
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+#define HASH_GRID_ALLOW_COMPACTION 0
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
+
 #if ENABLE_NRC
 #define NRC_RW_STRUCTURED_BUFFER(T) RWStructuredBuffer<T>
 #include "NRCStructures.h"
@@ -24,6 +32,18 @@
 
 #define MAX_LIGHTS 8
 
+// Primary hit of the SHaRC query pass, seeds an update ray of the next frame
+struct SharcPrimaryHit
+{
+    float3 rayOrigin;
+    float hitDistance;
+    float3 rayDirection;
+    uint instanceID;
+    uint primitiveIndex;
+    uint geometryIndex;
+    float2 barycentrics;
+};
+
 struct LightingConstants
 {
     float4 skyColor;
@@ -38,6 +58,21 @@ struct LightingConstants
     float sharcSceneScale;
     float sharcRoughnessThreshold;
 
+    int sharcRehashEntriesNum; // Capacity of the table entries are migrated to
+    int sharcRehashBegin;
+    int sharcRehashEnd;
+    int pad0;
+
+    int sharcTileSize; // Update ray schedule, see SharcTileSchedule.h
+    int sharcTileNumX;
+    int sharcTileNum;
+    int sharcEnableTileSchedule;
+
+    int sharcEnablePrimaryHitReuse; // Update rays start from the primary hits of the previous query pass
+    int sharcPrimaryHitsValid;
+    int sharcPrimaryHitNumX;
+    int sharcPrimaryHitNumY;
+
     float4 sharcCameraPosition;
     float4 sharcCameraPositionPrev;
 
@@ -29,7 +29,7 @@
 #include <donut/core/log.h>
 
 #include <string>
-#include <mutex>
+#include <cstring>
 #include "../../donut/nvrhi/src/vulkan/vulkan-backend.h"
 
 using namespace donut::math;
@@ -48,72 +48,122 @@ static const D3D12_HEAP_PROPERTIES g_defaultHeapProperties = { D3D12_HEAP_TYPE_D
 static const D3D12_HEAP_PROPERTIES g_readbackHeapProperties = { D3D12_HEAP_TYPE_READBACK, D3D12_CPU_PAGE_PROPERTY_UNKNOWN, D3D12_MEMORY_POOL_UNKNOWN, 0, 0 };
 
 
-static const bool g_enableSDKMemoryAllocation = true;
-static const bool g_useCustomCPUMemoryAllocator = false;
+// Application buffers can be sized for a capacity and kept across configurations, the SDK reallocates its own on every change
+static const bool g_enableSDKMemoryAllocation = false;
+static const bool g_useCustomCPUMemoryAllocator = true;
 
-// Utility
-static void NrcLoggerCallback(const char* message, nrc::LogLevel logLevel)
+// The SDK callbacks carry no user data, so the allocator is shared by the integrations
+NrcCpuAllocator& GetNrcCpuAllocator()
+{
+    static NrcCpuAllocator allocator;
+    return allocator;
+}
+
+// Formats on the drain thread of the log queue, memory events and debug messages only go out in debug builds
+class NrcDebugOutputSink : public NrcLogSink
 {
+public:
+    void Write(const NrcLogRecord& record) override
+    {
+#if !_DEBUG
+        if (record.type == NrcLogRecordType::MemoryEvent || record.level == NrcLogLevel::Debug)
+            return;
+#endif
 
-    static std::mutex loggerMutex;
+        char line[c_NrcLogTextSize + 128] = "NRC SDK: ";
+        const size_t prefixLength = strlen(line);
+        FormatNrcLogRecord(record, line + prefixLength, sizeof(line) - prefixLength - 1);
+        strcat(line, "\n");
+        OutputDebugStringA(line);
+    }
+};
 
-    // Make the logging thread-safe
-    loggerMutex.lock();
+NrcLogQueue& GetNrcLogQueue()
+{
+    // The queue drains into the sink on destruction, so it goes first
+    static struct LogPipeline
     {
-        const int kMinLogLevel = (int)nrc::LogLevel::Info;
-        if (((int)logLevel >= kMinLogLevel) || (logLevel == nrc::LogLevel::Error))
+        NrcDebugOutputSink debugOutputSink;
+        NrcLogQueue queue;
+
+        LogPipeline()
         {
-            std::wstring wstr = NrcUtils::StringToWstring(message);
-            OutputDebugString(wstr.c_str());
-#if 0
-            if (logLevel == nrc::LogLevel::Error)
-            {
-                // Halt on NRC error
-                NrcUtils::Validate(E_FAIL, LPWSTR(wstr.c_str()));
-            }
-#endif
+            queue.AddSink(&debugOutputSink);
         }
+    } pipeline;
+
+    return pipeline.queue;
+}
+
+// Utility
+static void NrcLoggerCallback(const char* message, nrc::LogLevel logLevel)
+{
+    // Called on the SDK threads, queues the message without locking or allocating
+    NrcLogLevel level;
+    switch (logLevel)
+    {
+    case nrc::LogLevel::Debug:
+        level = NrcLogLevel::Debug;
+        break;
+    case nrc::LogLevel::Warning:
+        level = NrcLogLevel::Warning;
+        break;
+    case nrc::LogLevel::Error:
+        level = NrcLogLevel::Error;
+        break;
+    default:
+        level = NrcLogLevel::Info;
+        break;
     }
-    loggerMutex.unlock();
+
+    const int kMinLogLevel = (int)nrc::LogLevel::Info;
+    if (((int)logLevel >= kMinLogLevel) || (logLevel == nrc::LogLevel::Error))
+        GetNrcLogQueue().PushMessage(level, message);
 }
 
 static void NrcMemoryEventsCallback(nrc::MemoryEventType eventType, size_t size, const char* bufferName)
 {
+    NrcLogQueue& logQueue = GetNrcLogQueue();
 
-    static std::mutex loggerMutex;
-
-    loggerMutex.lock();
+    switch (eventType)
     {
-        std::string message = "NRC SDK Memory Stats: ";
+    case nrc::MemoryEventType::Allocation:
+        logQueue.PushMemoryEvent(NrcMemoryEventType::Allocation, size, bufferName);
+        break;
+    case nrc::MemoryEventType::Deallocation:
+        logQueue.PushMemoryEvent(NrcMemoryEventType::Deallocation, size, bufferName);
+        break;
+    case nrc::MemoryEventType::MemoryStats:
+    {
+        logQueue.PushMemoryEvent(NrcMemoryEventType::MemoryStats, size, nullptr);
 
-        switch (eventType)
+        // CPU side, where the allocations of the SDK were served from. Formatted on the stack
+        const NrcCpuAllocator& allocator = GetNrcCpuAllocator();
+        char message[c_NrcLogTextSize];
+        for (uint32_t tagIndex = 0; tagIndex < uint32_t(NrcAllocationTag::Count); ++tagIndex)
         {
-        case nrc::MemoryEventType::Allocation:
-            message += std::to_string(size) + " bytes allocated (" + bufferName + ")\n";
-            break;
-        case nrc::MemoryEventType::Deallocation:
-            message += std::to_string(size) + " bytes deallocated (" + bufferName + ")\n";
-            break;
-        case nrc::MemoryEventType::MemoryStats:
-            message += std::to_string(size) + " bytes currently allocated in total\n";
-            break;
+            const NrcAllocationTag tag = NrcAllocationTag(tagIndex);
+            const NrcAllocationTagStats stats = allocator.GetTagStats(tag);
+            snprintf(message, sizeof(message), "CPU %s: %llu allocations, %llu bytes, %llu bytes peak", NrcCpuAllocator::GetTagName(tag),
+                (unsigned long long)stats.liveAllocationNum, (unsigned long long)stats.liveSize, (unsigned long long)stats.peakSize);
+            logQueue.PushMessage(NrcLogLevel::Debug, message);
         }
 
-#if _DEBUG
-        OutputDebugStringA(message.c_str());
-#endif
+        snprintf(message, sizeof(message), "CPU reserved: %llu bytes", (unsigned long long)allocator.GetReservedSize());
+        logQueue.PushMessage(NrcLogLevel::Debug, message);
+        break;
+    }
     }
-    loggerMutex.unlock();
 }
 
 static void* NrcCustomAllocatorCallback(const size_t bytes)
 {
-    return (void*)new char[bytes];
+    return GetNrcCpuAllocator().Allocate(bytes);
 }
 
 static void NrcCustomDeallocatorCallback(void* pointer, const size_t bytes)
 {
-    delete[] pointer;
+    GetNrcCpuAllocator().Deallocate(pointer, bytes);
 }
 
 static void FillBufferDescs(nvrhi::BufferDesc* bufferDescs, nrc::BuffersAllocationInfo const& buffersAllocationInfo)
@@ -142,6 +192,18 @@ static void FillBufferDescs(nvrhi::BufferDesc* bufferDescs, nrc::BuffersAllocati
     }
 }
 
+static bool HasBufferSizes(nvrhi::BufferDesc const* bufferDescs, NrcBufferHandles const& nrcBufferHandles)
+{
+    for (uint i = 0; i < (uint)nrc::BufferIdx::Count; ++i)
+    {
+        const nvrhi::IBuffer* buffer = nrcBufferHandles[(nrc::BufferIdx)i];
+        if (bufferDescs[i].byteSize > 0 ? (!buffer || buffer->getDesc().byteSize != bufferDescs[i].byteSize) : (buffer != nullptr))
+            return false;
+    }
+
+    return true;
+}
+
 static void CreateResources(nvrhi::BufferDesc const* bufferDescs, NrcBufferHandles& m_nrcBufferHandles, nvrhi::IDevice* device)
 {
     // Create NVRHI buffers
@@ -235,14 +297,16 @@ public:
         m_initialized = false;
     }
 
-    void Configure(const nrc::ContextSettings& contextSettings)
+    bool Configure(const nrc::ContextSettings& contextSettings, const nrc::ContextSettings& capacitySettings)
     {
         nrc::Status status;
+        bool buffersCreated = false;
 
         // Configuration has changed
         m_contextSettings = contextSettings;
 
-        nrc::d3d12::Context::GetBuffersAllocationInfo(contextSettings, m_buffersAllocation);
+        // The SDK allocates for the settings themselves
+        nrc::d3d12::Context::GetBuffersAllocationInfo(g_enableSDKMemoryAllocation ? contextSettings : capacitySettings, m_buffersAllocation);
         nvrhi::BufferDesc bufferDescs[(int)nrc::BufferIdx::Count];
         FillBufferDescs(bufferDescs, m_buffersAllocation);
 
@@ -251,6 +315,7 @@ public:
             // NRC library manages memory in this case.
             // Pass it the new configuration
             status = m_nrcContext->Configure(contextSettings);
+            buffersCreated = true;
 
             // The NRC SDK is managing buffer allocations, so we need to pull those native buffers into NVRHI
             nrc::d3d12::Buffers const& buffers = *(m_nrcContext->GetBuffers());
@@ -266,27 +331,36 @@ public:
         }
         else
         {
-            // Create NVRHI buffers
-            CreateResources(bufferDescs, m_bufferHandles, m_device);
-
-            // Pass the buffers to NRC
-            for (uint i = 0; i < (uint)nrc::BufferIdx::Count; ++i)
+            // The buffers of the capacity are kept while the settings change within it
+            if (!HasBufferSizes(bufferDescs, m_bufferHandles))
             {
-                const nrc::BufferIdx bufferIdx = (nrc::BufferIdx)i;
-                m_buffers[bufferIdx].resource = reinterpret_cast<ID3D12Resource*>(m_bufferHandles[bufferIdx]->getNativeObject(nvrhi::ObjectTypes::D3D12_Resource).pointer);
-                m_buffers[bufferIdx].allocatedSize = bufferDescs[i].byteSize;
+                // Create NVRHI buffers
+                CreateResources(bufferDescs, m_bufferHandles, m_device);
+                buffersCreated = true;
+
+                // Pass the buffers to NRC
+                for (uint i = 0; i < (uint)nrc::BufferIdx::Count; ++i)
+                {
+                    const nrc::BufferIdx bufferIdx = (nrc::BufferIdx)i;
+                    m_buffers[bufferIdx].resource = reinterpret_cast<ID3D12Resource*>(m_bufferHandles[bufferIdx]->getNativeObject(nvrhi::ObjectTypes::D3D12_Resource).pointer);
+                    m_buffers[bufferIdx].allocatedSize = bufferDescs[i].byteSize;
+                }
             }
             status = m_nrcContext->Configure(contextSettings, &m_buffers);
         }
 
         if (status != nrc::Status::OK)
             NrcUtils::Validate(E_FAIL, LPWSTR(L"NRC Configure step failed."));
+
+        return buffersCreated;
     }
 
     void BeginFrame(nvrhi::ICommandList* cmdList, const nrc::FrameSettings& frameSettings)
     {
         nrc::Status status;
 
+        GetNrcCpuAllocator().BeginFrame();
+
         ID3D12GraphicsCommandList4* nativeCmdList = reinterpret_cast<ID3D12GraphicsCommandList4*>(cmdList->getNativeObject(nvrhi::ObjectTypes::D3D12_GraphicsCommandList).pointer);
         if (nativeCmdList)
         {
@@ -333,6 +407,8 @@ public:
             if (status != nrc::Status::OK)
                 NrcUtils::Validate(E_FAIL, LPWSTR(L"NRC EndFrame call failed."));
         }
+
+        GetNrcCpuAllocator().EndFrame();
     }
 
     size_t GetCurrentMemoryConsumption() const
@@ -425,14 +501,16 @@ public:
         m_initialized = false;
     }
 
-    void Configure(const nrc::ContextSettings& contextSettings)
+    bool Configure(const nrc::ContextSettings& contextSettings, const nrc::ContextSettings& capacitySettings)
     {
         nrc::Status status;
+        bool buffersCreated = false;
 
         // Configuration has changed
         m_contextSettings = contextSettings;
 
-        nrc::vulkan::Context::GetBuffersAllocationInfo(contextSettings, m_buffersAllocation);
+        // The SDK allocates for the settings themselves
+        nrc::vulkan::Context::GetBuffersAllocationInfo(g_enableSDKMemoryAllocation ? contextSettings : capacitySettings, m_buffersAllocation);
         nvrhi::BufferDesc bufferDescs[(int)nrc::BufferIdx::Count];
         FillBufferDescs(bufferDescs, m_buffersAllocation);
 
@@ -441,6 +519,7 @@ public:
             // NRC library manages memory in this case.
             // Pass it the new configuration
             status = m_nrcContext->Configure(contextSettings);
+            buffersCreated = true;
 
             // The NRC SDK is managing buffer allocations, so we need to pull those native buffers into NVRHI
             nrc::vulkan::Buffers const& buffers = *(m_nrcContext->GetBuffers());
@@ -456,31 +535,40 @@ public:
         }
         else
         {
-            // Create NVRHI buffers
-            CreateResources(bufferDescs, m_bufferHandles, m_device);
-
-            // Pass the buffers to NRC
-            for (uint i = 0; i < (uint)nrc::BufferIdx::Count; ++i)
+            // The buffers of the capacity are kept while the settings change within it
+            if (!HasBufferSizes(bufferDescs, m_bufferHandles))
             {
-                const nrc::BufferIdx bufferIdx = (nrc::BufferIdx)i;
-                m_buffers[bufferIdx].resource = reinterpret_cast<VkBuffer>(m_bufferHandles[bufferIdx]->getNativeObject(nvrhi::ObjectTypes::VK_Buffer).pointer);
-                m_buffers[bufferIdx].allocatedSize = bufferDescs[i].byteSize;
-                m_buffers[bufferIdx].allocatedOffset = 0;
-
-                auto addressInfo = vk::BufferDeviceAddressInfo().setBuffer(m_buffers[bufferIdx].resource);
-
-                VkDevice nativeDevice = m_device->getNativeObject(nvrhi::ObjectTypes::VK_Device);
-                m_buffers[bufferIdx].deviceAddress = vk::Device(nativeDevice).getBufferAddress(addressInfo);
+                // Create NVRHI buffers
+                CreateResources(bufferDescs, m_bufferHandles, m_device);
+                buffersCreated = true;
+
+                // Pass the buffers to NRC
+                for (uint i = 0; i < (uint)nrc::BufferIdx::Count; ++i)
+                {
+                    const nrc::BufferIdx bufferIdx = (nrc::BufferIdx)i;
+                    m_buffers[bufferIdx].resource = reinterpret_cast<VkBuffer>(m_bufferHandles[bufferIdx]->getNativeObject(nvrhi::ObjectTypes::VK_Buffer).pointer);
+                    m_buffers[bufferIdx].allocatedSize = bufferDescs[i].byteSize;
+                    m_buffers[bufferIdx].allocatedOffset = 0;
+
+                    auto addressInfo = vk::BufferDeviceAddressInfo().setBuffer(m_buffers[bufferIdx].resource);
+
+                    VkDevice nativeDevice = m_device->getNativeObject(nvrhi::ObjectTypes::VK_Device);
+                    m_buffers[bufferIdx].deviceAddress = vk::Device(nativeDevice).getBufferAddress(addressInfo);
+                }
             }
             status = m_nrcContext->Configure(contextSettings, &m_buffers);
         }
 
         if (status != nrc::Status::OK)
             NrcUtils::Validate(E_FAIL, LPWSTR(L"NRC Configure step failed."));
+
+        return buffersCreated;
     }
 
     void BeginFrame(nvrhi::ICommandList* cmdList, const nrc::FrameSettings& frameSettings)
     {
+        GetNrcCpuAllocator().BeginFrame();
+
         VkCommandBuffer cmdBuffer = cmdList->getNativeObject(nvrhi::ObjectTypes::VK_CommandBuffer);
         if (cmdBuffer)
         {
@@ -499,6 +587,8 @@ public:
             if (status != nrc::Status::OK)
                 NrcUtils::Validate(E_FAIL, LPWSTR(L"NRC EndFrame call failed."));
         }
+
+        GetNrcCpuAllocator().EndFrame();
     }
 
     float QueryAndTrain(nvrhi::ICommandList* cmdList, bool calculateTrainingLoss)
@@ -14,6 +14,9 @@
 #include <NrcCommon.h>
 #include <memory>
 
+#include "NrcCpuAllocator.h"
+#include "NrcLogQueue.h"
+
 // NVRHI handles to NRC Buffers
 struct NrcBufferHandles
 {
@@ -37,7 +40,9 @@ public:
 
     virtual void Shutdown() = 0;
 
-    virtual void Configure(const nrc::ContextSettings& contextSettings) = 0;
+    // The buffers are sized for 'capacitySettings', which have to cover 'contextSettings'. They are only recreated when
+    // the capacity changes, returns true if they were
+    virtual bool Configure(const nrc::ContextSettings& contextSettings, const nrc::ContextSettings& capacitySettings) = 0;
 
     virtual void BeginFrame(nvrhi::ICommandList* cmdList, const nrc::FrameSettings& frameSettings) = 0;
 
@@ -68,3 +73,9 @@ protected:
 };
 
 std::unique_ptr<NrcIntegration> CreateNrcIntegration(nvrhi::GraphicsAPI);
+
+// Serves the CPU allocations of the NRC SDK
+NrcCpuAllocator& GetNrcCpuAllocator();
+
+// Receives the log messages and memory events of the NRC SDK, writes them to the debug output
+NrcLogQueue& GetNrcLogQueue();
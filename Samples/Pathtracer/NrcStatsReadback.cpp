@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "NrcStatsReadback.h"
+
+#include <algorithm>
+#include <cstring>
+
+NrcStatsReadback::NrcStatsReadback(nvrhi::IDevice* device, const NrcStatsDesc& desc) : m_device(device), m_ring(desc, *this)
+{
+    m_slots.resize(m_ring.GetDesc().frameLatency);
+
+    nvrhi::BufferDesc bufferDesc;
+    bufferDesc.byteSize = c_NrcMaxCounterNum * sizeof(uint32_t);
+    bufferDesc.cpuAccess = nvrhi::CpuAccessMode::Read;
+    bufferDesc.debugName = "NrcCountersReadback";
+    for (Slot& slot : m_slots)
+    {
+        slot.buffer = device->createBuffer(bufferDesc);
+        slot.eventQuery = device->createEventQuery();
+    }
+}
+
+void NrcStatsReadback::BeginFrame(uint64_t frameIndex)
+{
+    m_slotIndex = m_ring.BeginFrame(frameIndex);
+    m_slots[m_slotIndex].counterNum = 0;
+}
+
+void NrcStatsReadback::RecordCounters(nvrhi::ICommandList* commandList, nvrhi::IBuffer* counterBuffer)
+{
+    if (m_slotIndex == NrcStatsRing::c_NoSlot || !counterBuffer)
+        return;
+
+    Slot& slot = m_slots[m_slotIndex];
+    slot.counterNum = uint32_t(std::min<uint64_t>(counterBuffer->getDesc().byteSize / sizeof(uint32_t), c_NrcMaxCounterNum));
+
+    // NRC records its passes on the native command list, the counters have to be back in the state it left them in
+    commandList->setBufferState(counterBuffer, nvrhi::ResourceStates::CopySource);
+    commandList->setBufferState(slot.buffer, nvrhi::ResourceStates::CopyDest);
+    commandList->commitBarriers();
+
+    commandList->copyBuffer(slot.buffer, 0, counterBuffer, 0, slot.counterNum * sizeof(uint32_t));
+
+    commandList->setBufferState(counterBuffer, nvrhi::ResourceStates::UnorderedAccess);
+    commandList->commitBarriers();
+}
+
+void NrcStatsReadback::SetTrainingLoss(float trainingLoss)
+{
+    if (m_slotIndex == NrcStatsRing::c_NoSlot)
+        return;
+
+    NrcFrameStats& stats = m_ring.GetRecordedStats();
+    stats.hasTrainingLoss = true;
+    stats.trainingLoss = trainingLoss;
+}
+
+void NrcStatsReadback::SetMemorySize(uint64_t memorySize)
+{
+    if (m_slotIndex == NrcStatsRing::c_NoSlot)
+        return;
+
+    m_ring.GetRecordedStats().memorySize = memorySize;
+}
+
+void NrcStatsReadback::EndFrame()
+{
+    if (m_slotIndex == NrcStatsRing::c_NoSlot)
+        return;
+
+    // Signaled once the GPU is done with everything submitted so far, the copy included
+    m_device->resetEventQuery(m_slots[m_slotIndex].eventQuery);
+    m_device->setEventQuery(m_slots[m_slotIndex].eventQuery, nvrhi::CommandQueue::Graphics);
+
+    m_ring.EndFrame();
+    m_slotIndex = NrcStatsRing::c_NoSlot;
+}
+
+bool NrcStatsReadback::IsSlotComplete(uint32_t slotIndex)
+{
+    return m_device->pollEventQuery(m_slots[slotIndex].eventQuery);
+}
+
+void NrcStatsReadback::ReadSlot(uint32_t slotIndex, NrcFrameStats& stats)
+{
+    Slot& slot = m_slots[slotIndex];
+    if (slot.counterNum == 0)
+        return;
+
+    // The GPU is done with the slot, mapping doesn't wait
+    const uint32_t* counters = (const uint32_t*)m_device->mapBuffer(slot.buffer, nvrhi::CpuAccessMode::Read);
+    if (!counters)
+        return;
+
+    memcpy(stats.counters, counters, slot.counterNum * sizeof(uint32_t));
+    stats.counterNum = slot.counterNum;
+
+    m_device->unmapBuffer(slot.buffer);
+}
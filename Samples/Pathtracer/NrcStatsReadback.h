@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <nvrhi/nvrhi.h>
+
+#include "NrcStatsRing.h"
+
+#include <vector>
+
+// NrcStatsRing backed by a readback buffer and an event query per frame in flight
+class NrcStatsReadback : private NrcStatsFence
+{
+public:
+    NrcStatsReadback(nvrhi::IDevice* device, const NrcStatsDesc& desc);
+
+    const NrcStatsRing& GetRing() const
+    {
+        return m_ring;
+    }
+
+    void SetSink(NrcStatsSink* sink)
+    {
+        m_ring.SetSink(sink);
+    }
+
+    void BeginFrame(uint64_t frameIndex);
+
+    // Copies the start of the NRC counter buffer, once the NRC passes of the frame are recorded
+    void RecordCounters(nvrhi::ICommandList* commandList, nvrhi::IBuffer* counterBuffer);
+    void SetTrainingLoss(float trainingLoss);
+    void SetMemorySize(uint64_t memorySize);
+
+    // Once the command list of the frame has been executed
+    void EndFrame();
+
+private:
+    struct Slot
+    {
+        nvrhi::BufferHandle buffer;
+        nvrhi::EventQueryHandle eventQuery;
+        uint32_t counterNum = 0;
+    };
+
+    bool IsSlotComplete(uint32_t slotIndex) override;
+    void ReadSlot(uint32_t slotIndex, NrcFrameStats& stats) override;
+
+    nvrhi::DeviceHandle m_device;
+    std::vector<Slot> m_slots;
+    uint32_t m_slotIndex = NrcStatsRing::c_NoSlot;
+
+    NrcStatsRing m_ring;
+};
@@ -12,6 +12,7 @@
 
 static_assert(NRD_VERSION_MAJOR >= 4 && NRD_VERSION_MINOR >= 0, "Unsupported NRD version!");
 
+#include "GpuProfiler.h"
 #include "RenderTargets.h"
 #include <nvrhi/utils.h>
 #include <donut/core/math/math.h>
@@ -335,7 +336,8 @@ void NrdIntegration::RunDenoiserPasses(nvrhi::ICommandList* commandList,
                                        bool useDisocclusionThresholdAlternateMix,
                                        bool enableValidation,
                                        const void* methodSettings,
-                                       bool reset)
+                                       bool reset,
+                                       GpuProfiler* profiler)
 {
     if (methodSettings)
         nrd::SetDenoiserSettings(*m_instance, m_identifier, methodSettings);
@@ -385,8 +387,13 @@ void NrdIntegration::RunDenoiserPasses(nvrhi::ICommandList* commandList,
     {
         const nrd::DispatchDesc& dispatchDesc = dispatchDescs[dispatchIndex];
 
+        uint32_t timerIndex = FrameProfiler::c_InvalidTimer;
         if (dispatchDesc.name)
+        {
             commandList->beginMarker(dispatchDesc.name);
+            if (profiler)
+                timerIndex = profiler->BeginScope(commandList, dispatchDesc.name);
+        }
 
         assert(m_constantBuffer);
         commandList->writeBuffer(m_constantBuffer, dispatchDesc.constantBufferData, dispatchDesc.constantBufferDataSize);
@@ -476,6 +483,10 @@ void NrdIntegration::RunDenoiserPasses(nvrhi::ICommandList* commandList,
         commandList->dispatch(dispatchDesc.gridWidth, dispatchDesc.gridHeight);
 
         if (dispatchDesc.name)
+        {
+            if (profiler)
+                profiler->EndScope(commandList, timerIndex);
             commandList->endMarker();
+        }
     }
 }
\ No newline at end of file
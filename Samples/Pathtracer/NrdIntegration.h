@@ -14,6 +14,7 @@
 #include <nvrhi/nvrhi.h>
 #include <donut/engine/BindingCache.h>
 
+class GpuProfiler;
 class RenderTargets;
 
 namespace donut::engine
@@ -42,7 +43,8 @@ public:
                            bool useDisocclusionThresholdAlternateMix,
                            bool enableValidation,
                            const void* methodSettings,
-                           bool reset);
+                           bool reset,
+                           GpuProfiler* profiler);
 
     const nrd::Denoiser GetDenoiser() const
     {
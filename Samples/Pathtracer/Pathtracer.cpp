@@ -22,6 +22,8 @@
 #include <donut/app/imgui_renderer.h>
 #include <donut/engine/TextureCache.h>
 
+#include <chrono>
+
 #include "Pathtracer.h"
 
 using namespace donut;
@@ -40,6 +42,10 @@ using namespace donut::engine;
 
 #include "LightingCb.h"
 #include "GlobalCb.h"
+#include "AccelStructBuildSizes.h"
+#include "BlasBuildBatcher.h"
+#include "CachedScene.h"
+#include "ParallelFor.h"
 
 #if ENABLE_NRD
 #include "NrdConfig.h"
@@ -68,11 +74,36 @@ extern "C"
 
 static const char* g_WindowTitle = "Pathtracer";
 
+// Scratch suballocations of acceleration structure builds
+static const uint64_t c_ScratchAlignment = 256;
+static const uint64_t c_BlasScratchMinPoolSize = 32ull * 1024 * 1024;
+static const uint32_t c_BlasBatchesInFlight = 2;
+
+// Refit count of a skinned BLAS that hasn't been built yet
+static const uint32_t c_SkinnedBlasNotBuilt = ~0u;
+
+// Upper bound of the scene bindless table, the descriptor table manager grows it as textures are loaded
+static const uint32_t c_BindlessMaxCapacity = 1u << 16;
+
+// Register space of the streamed texture table
+static const uint32_t c_StreamedTextureSpace = DescriptorSetIDs::StreamedTextures;
+
 static uint32_t DivideRoundUp(uint32_t x, uint32_t divisor)
 {
     return (x + divisor - 1) / divisor;
 }
 
+// Waits for a background task if it is still pending, returns the seconds spent waiting
+static double WaitForCreation(std::future<void>& creation)
+{
+    if (!creation.valid())
+        return 0.0;
+
+    const auto startTime = std::chrono::steady_clock::now();
+    creation.get();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+}
+
 void InjectFeatures(VkDeviceCreateInfo& info)
 {
     static vk::PhysicalDeviceFeatures2 deviceFeatures;
@@ -114,14 +145,37 @@ Pathtracer::Pathtracer(DeviceManager* deviceManager, UIData& ui, nvrhi::Graphics
 
 Pathtracer::~Pathtracer()
 {
+    if (m_computePipelineCreation.valid())
+        m_computePipelineCreation.wait();
+
+    for (auto& pipelineCreations : m_pipelineCreation)
+    {
+        for (std::future<void>& pipelineCreation : pipelineCreations)
+        {
+            if (pipelineCreation.valid())
+                pipelineCreation.wait();
+        }
+    }
+
 #if ENABLE_NRC
     m_nrc->Shutdown();
+
+    // The log queue outlives the sample
+    NrcLogQueue& nrcLogQueue = GetNrcLogQueue();
+    nrcLogQueue.Flush();
+    nrcLogQueue.RemoveSink(m_nrcLogFileSink.get());
+    nrcLogQueue.RemoveSink(m_nrcLogJsonSink.get());
 #endif // ENABLE_NRC
 }
 
 bool Pathtracer::Init(int argc, const char* const* argv)
 {
     char* sceneName = nullptr;
+#if ENABLE_NRC
+    const char* nrcStatsFileName = nullptr;
+    const char* nrcLogFileName = nullptr;
+    const char* nrcLogJsonFileName = nullptr;
+#endif // ENABLE_NRC
     for (int n = 1; n < argc; n++)
     {
         const char* arg = argv[n];
@@ -135,6 +189,12 @@ bool Pathtracer::Init(int argc, const char* const* argv)
 #if ENABLE_NRC
         else if (!strcmp(arg, "-nrc"))
             m_ui.techSelection = TechSelection::Nrc;
+        else if (!strcmp(arg, "-nrcstats"))
+            nrcStatsFileName = argv[n + 1];
+        else if (!strcmp(arg, "-nrclog"))
+            nrcLogFileName = argv[n + 1];
+        else if (!strcmp(arg, "-nrclogjson"))
+            nrcLogJsonFileName = argv[n + 1];
 #endif // ENABLE_NRC
 #if ENABLE_SHARC
         else if (!strcmp(arg, "-sharc"))
@@ -190,28 +250,74 @@ bool Pathtracer::Init(int argc, const char* const* argv)
     m_CommonPasses = std::make_shared<engine::CommonRenderPasses>(GetDevice(), m_shaderFactory);
     m_bindingCache = std::make_unique<engine::BindingCache>(GetDevice());
 
+    // Timer queries are read once the frames in flight have finished, a shorter ring would drop every frame
+    FrameProfilerDesc frameProfilerDesc;
+    frameProfilerDesc.frameLatency = GetDeviceManager()->GetDeviceParams().maxFramesInFlight + 1;
+    m_gpuProfiler = std::make_unique<GpuProfiler>(GetDevice(), frameProfilerDesc);
+
 #if ENABLE_NRC
     m_nrc = CreateNrcIntegration(m_api);
+
+    // The statistics trail the frames in flight, every read frame can also go to a CSV file
+    NrcStatsDesc nrcStatsDesc;
+    nrcStatsDesc.frameLatency = GetDeviceManager()->GetDeviceParams().maxFramesInFlight + 1;
+    m_nrcStats = std::make_unique<NrcStatsReadback>(GetDevice(), nrcStatsDesc);
+    if (nrcStatsFileName)
+    {
+        m_nrcStatsSink = std::make_unique<NrcStatsCsvSink>();
+        if (m_nrcStatsSink->Open(nrcStatsFileName))
+            m_nrcStats->SetSink(m_nrcStatsSink.get());
+        else
+            log::warning("Failed to open NRC statistics file '%s'", nrcStatsFileName);
+    }
+
+    // The SDK messages and memory events always go to the debug output, and optionally to text and JSON lines files
+    if (nrcLogFileName)
+    {
+        m_nrcLogFileSink = std::make_unique<NrcLogFileSink>();
+        if (m_nrcLogFileSink->Open(nrcLogFileName))
+            GetNrcLogQueue().AddSink(m_nrcLogFileSink.get());
+        else
+            log::warning("Failed to open NRC log file '%s'", nrcLogFileName);
+    }
+
+    if (nrcLogJsonFileName)
+    {
+        m_nrcLogJsonSink = std::make_unique<NrcLogJsonSink>();
+        if (m_nrcLogJsonSink->Open(nrcLogJsonFileName))
+            GetNrcLogQueue().AddSink(m_nrcLogJsonSink.get());
+        else
+            log::warning("Failed to open NRC log file '%s'", nrcLogJsonFileName);
+    }
 #endif // ENABLE_NRC
 
     nvrhi::BindlessLayoutDesc bindlessLayoutDesc;
     bindlessLayoutDesc.visibility = nvrhi::ShaderType::All;
     bindlessLayoutDesc.firstSlot = 0;
-    bindlessLayoutDesc.maxCapacity = 1024;
+    bindlessLayoutDesc.maxCapacity = c_BindlessMaxCapacity;
     bindlessLayoutDesc.registerSpaces = { nvrhi::BindingLayoutItem::RawBuffer_SRV(1), nvrhi::BindingLayoutItem::Texture_SRV(2) };
 
     m_bindlessLayout = GetDevice()->createBindlessLayout(bindlessLayoutDesc);
     m_descriptorTable = std::make_shared<engine::DescriptorTableManager>(GetDevice(), m_bindlessLayout);
     m_TextureCache = std::make_shared<engine::TextureCache>(GetDevice(), m_nativeFileSystem, m_descriptorTable);
 
-    SetAsynchronousLoadingEnabled(false);
+    TextureResidencyDesc textureResidencyDesc;
+    textureResidencyDesc.budgetSize = uint64_t(m_ui.textureBudgetMB) << 20;
+    m_textureStreamer = std::make_unique<TextureStreamer>(GetDevice(), textureResidencyDesc, c_StreamedTextureSpace,
+                                                          GetDeviceManager()->GetDeviceParams().maxFramesInFlight + 1);
+
+    // The scene loads on a worker thread, Render() finishes the load once it is in
+    SetAsynchronousLoadingEnabled(true);
     SetCurrentSceneName(sceneFileName.string());
-    m_scene->FinishedLoading(GetFrameIndex());
 
     m_camera.SetMoveSpeed(3.f);
 
-    m_constantBuffer =
-        GetDevice()->createBuffer(nvrhi::utils::CreateVolatileConstantBufferDesc(sizeof(LightingConstants), "LightingConstants", engine::c_MaxRenderPassConstantBufferVersions));
+    // SHaRC instances rewrite the lighting constants before their passes
+    uint32_t lightingConstantBufferVersions = engine::c_MaxRenderPassConstantBufferVersions;
+#if ENABLE_SHARC
+    lightingConstantBufferVersions *= m_sharcMaxInstanceNum + 1;
+#endif // ENABLE_SHARC
+    m_constantBuffer = GetDevice()->createBuffer(nvrhi::utils::CreateVolatileConstantBufferDesc(sizeof(LightingConstants), "LightingConstants", lightingConstantBufferVersions));
 
     m_debugBuffer =
         GetDevice()->createBuffer(nvrhi::utils::CreateVolatileConstantBufferDesc(sizeof(GlobalConstants), "GlobalConstants", engine::c_MaxRenderPassConstantBufferVersions));
@@ -240,6 +346,13 @@ bool Pathtracer::Init(int argc, const char* const* argv)
         nvrhi::BindingLayoutItem::StructuredBuffer_SRV(3), // materials
         nvrhi::BindingLayoutItem::Sampler(0),
         nvrhi::BindingLayoutItem::Texture_UAV(0), // path tracer output
+        nvrhi::BindingLayoutItem::StructuredBuffer_UAV(3), // texture feedback
+        nvrhi::BindingLayoutItem::StructuredBuffer_SRV(5), // texture streaming slots
+#if ENABLE_SHARC
+        nvrhi::BindingLayoutItem::StructuredBuffer_UAV(1), // SHaRC tile stats
+        nvrhi::BindingLayoutItem::StructuredBuffer_UAV(2), // SHaRC primary hits
+        nvrhi::BindingLayoutItem::StructuredBuffer_SRV(4), // SHaRC tile ray offsets
+#endif // ENABLE_SHARC
     };
     m_globalBindingLayout = GetDevice()->createBindingLayout(bindingLayoutDesc);
 
@@ -272,8 +385,28 @@ bool Pathtracer::Init(int argc, const char* const* argv)
         nvrhi::BindingLayoutItem::StructuredBuffer_UAV(1),
         nvrhi::BindingLayoutItem::StructuredBuffer_UAV(2),
         nvrhi::BindingLayoutItem::StructuredBuffer_UAV(3),
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+        nvrhi::BindingLayoutItem::StructuredBuffer_UAV(4), // LiveEntries
+        nvrhi::BindingLayoutItem::StructuredBuffer_UAV(5), // LiveEntriesNext
+        nvrhi::BindingLayoutItem::StructuredBuffer_UAV(6), // LiveEntryMask
+        nvrhi::BindingLayoutItem::StructuredBuffer_UAV(7), // LiveCounter
+        nvrhi::BindingLayoutItem::StructuredBuffer_UAV(8), // LiveCounterNext
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
     };
     m_sharcBindingLayout = GetDevice()->createBindingLayout(bindingLayoutDesc);
+
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+    // Compute only, the bindless space is free
+    bindingLayoutDesc.registerSpace = DescriptorSetIDs::Bindless;
+    bindingLayoutDesc.bindings = {
+        nvrhi::BindingLayoutItem::StructuredBuffer_UAV(0), // HashEntries
+        nvrhi::BindingLayoutItem::StructuredBuffer_UAV(1), // VoxelData
+        nvrhi::BindingLayoutItem::StructuredBuffer_UAV(2), // LiveEntries
+        nvrhi::BindingLayoutItem::StructuredBuffer_UAV(3), // LiveEntryMask
+        nvrhi::BindingLayoutItem::StructuredBuffer_UAV(4), // LiveCounter
+    };
+    m_sharcRehashBindingLayout = GetDevice()->createBindingLayout(bindingLayoutDesc);
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
 #endif // ENABLE_SHARC
 
     if (!CreateRayTracingPipelines())
@@ -282,82 +415,34 @@ bool Pathtracer::Init(int argc, const char* const* argv)
         // Prepare resources for the SHARC copy and resolve compute passes
 #if ENABLE_SHARC
     {
-        m_sharcEntriesNum = 4 * 1024 * 1024;
+        UpdateSharcInstances();
+
+        m_sharcTileScheduler = std::make_unique<SharcTileScheduler>(SharcTileSchedulerDesc());
 
-        // Buffers
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+        // Counters can't be used as indirect arguments while bound as UAVs, arguments are copied into a separate buffer
         nvrhi::BufferDesc bufferDesc;
-        bufferDesc.isConstantBuffer = false;
-        bufferDesc.isVolatile = false;
-        bufferDesc.canHaveUAVs = true;
-        bufferDesc.cpuAccess = nvrhi::CpuAccessMode::None;
+        bufferDesc.byteSize = 3 * sizeof(uint32_t);
+        bufferDesc.isDrawIndirectArgs = true;
         bufferDesc.keepInitialState = true;
-        bufferDesc.initialState = nvrhi::ResourceStates::UnorderedAccess;
-
-        bufferDesc.byteSize = m_sharcEntriesNum * sizeof(uint64_t);
-        bufferDesc.structStride = sizeof(uint64_t);
-        bufferDesc.debugName = "m_sharcHashEntriesBuffer";
-        m_sharcHashEntriesBuffer = GetDevice()->createBuffer(bufferDesc);
-
-        bufferDesc.byteSize = m_sharcEntriesNum * sizeof(uint32_t);
-        bufferDesc.structStride = sizeof(uint32_t);
-        bufferDesc.debugName = "m_sharcCopyOffsetBuffer";
-        m_sharcCopyOffsetBuffer = GetDevice()->createBuffer(bufferDesc);
-
-        bufferDesc.byteSize = m_sharcEntriesNum * sizeof(float4);
-        bufferDesc.structStride = 4 * sizeof(uint32_t);
-        bufferDesc.canHaveRawViews = true;
-
-        bufferDesc.debugName = "m_sharcVoxelDataBuffer";
-        m_sharcVoxelDataBuffer = GetDevice()->createBuffer(bufferDesc);
-
-        bufferDesc.debugName = "m_sharcVoxelDataBufferPrev";
-        m_sharcVoxelDataBufferPrev = GetDevice()->createBuffer(bufferDesc);
-
-        nvrhi::BindingSetDesc bindingSetDesc;
-        bindingSetDesc.bindings = {
-            nvrhi::BindingSetItem::StructuredBuffer_UAV(0, m_sharcHashEntriesBuffer),
-            nvrhi::BindingSetItem::StructuredBuffer_UAV(1, m_sharcCopyOffsetBuffer),
-            nvrhi::BindingSetItem::StructuredBuffer_UAV(2, m_sharcVoxelDataBuffer),
-            nvrhi::BindingSetItem::StructuredBuffer_UAV(3, m_sharcVoxelDataBufferPrev),
-        };
-        m_sharcBindingSet = GetDevice()->createBindingSet(bindingSetDesc, m_sharcBindingLayout);
-
-        bindingSetDesc.bindings = {
-            nvrhi::BindingSetItem::StructuredBuffer_UAV(0, m_sharcHashEntriesBuffer),
-            nvrhi::BindingSetItem::StructuredBuffer_UAV(1, m_sharcCopyOffsetBuffer),
-            nvrhi::BindingSetItem::StructuredBuffer_UAV(2, m_sharcVoxelDataBufferPrev),
-            nvrhi::BindingSetItem::StructuredBuffer_UAV(3, m_sharcVoxelDataBuffer),
-        };
-        m_sharcBindingSetSwapped = GetDevice()->createBindingSet(bindingSetDesc, m_sharcBindingLayout);
-
-        {
-            nvrhi::ComputePipelineDesc pipelineDesc;
-            if (m_api == nvrhi::GraphicsAPI::D3D12)
-                pipelineDesc.bindingLayouts = { m_globalBindingLayout, m_sharcBindingLayout };
-            else
-                pipelineDesc.bindingLayouts = { m_globalBindingLayout, m_dummyLayouts[1], m_dummyLayouts[2], m_sharcBindingLayout };
-
-            m_sharcResolveCS = m_shaderFactory->CreateShader("app/SharcResolve.hlsl", "sharcResolve", nullptr, nvrhi::ShaderType::Compute);
-            pipelineDesc.CS = m_sharcResolveCS;
-            m_sharcResolvePSO = GetDevice()->createComputePipeline(pipelineDesc);
-
-            m_sharcHashCopyCS = m_shaderFactory->CreateShader("app/SharcResolve.hlsl", "sharcCompaction", nullptr, nvrhi::ShaderType::Compute);
-            pipelineDesc.CS = m_sharcHashCopyCS;
-            m_sharcHashCopyPSO = GetDevice()->createComputePipeline(pipelineDesc);
-        }
+        bufferDesc.initialState = nvrhi::ResourceStates::IndirectArgument;
+        bufferDesc.debugName = "m_sharcIndirectArgsBuffer";
+        m_sharcIndirectArgsBuffer = GetDevice()->createBuffer(bufferDesc);
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
+
+        m_sharcResolveCS = m_shaderFactory->CreateShader("app/SharcResolve.hlsl", "sharcResolve", nullptr, nvrhi::ShaderType::Compute);
+        m_sharcHashCopyCS = m_shaderFactory->CreateShader("app/SharcResolve.hlsl", "sharcCompaction", nullptr, nvrhi::ShaderType::Compute);
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+        m_sharcPrepareIndirectCS = m_shaderFactory->CreateShader("app/SharcResolve.hlsl", "sharcPrepareIndirect", nullptr, nvrhi::ShaderType::Compute);
+        m_sharcRehashCS = m_shaderFactory->CreateShader("app/SharcResolve.hlsl", "sharcRehash", nullptr, nvrhi::ShaderType::Compute);
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
     }
 #endif // ENABLE_SHARC
 
 #if ENABLE_NRD
     std::vector<ShaderMacro> denoiseMacros = { ShaderMacro("NRD_NORMAL_ENCODING", "2"), ShaderMacro("NRD_ROUGHNESS_ENCODING", "1") };
 
-    {
-        m_denoiserReblurPackCS = m_shaderFactory->CreateShader("app/Denoiser.hlsl", "reblurPackData", &denoiseMacros, nvrhi::ShaderType::Compute);
-        nvrhi::ComputePipelineDesc pipelineDesc;
-        pipelineDesc.bindingLayouts = { m_globalBindingLayout, m_denoiserBindingLayout };
-        pipelineDesc.CS = m_denoiserReblurPackCS;
-        m_denoiserReblurPackPSO = GetDevice()->createComputePipeline(pipelineDesc);
-    }
+    m_denoiserReblurPackCS = m_shaderFactory->CreateShader("app/Denoiser.hlsl", "reblurPackData", &denoiseMacros, nvrhi::ShaderType::Compute);
 
 #if ENABLE_NRC
     {
@@ -365,22 +450,15 @@ bool Pathtracer::Init(int argc, const char* const* argv)
         denoiseMacrosNRC.push_back((ShaderMacro("ENABLE_NRC", "1")));
 
         m_denoiserReblurPack_NRC_CS = m_shaderFactory->CreateShader("app/Denoiser.hlsl", "reblurPackData", &denoiseMacrosNRC, nvrhi::ShaderType::Compute);
-        nvrhi::ComputePipelineDesc pipelineDesc;
-        pipelineDesc.bindingLayouts = { m_globalBindingLayout, m_denoiserBindingLayout };
-        pipelineDesc.CS = m_denoiserReblurPack_NRC_CS;
-        m_denoiserReblurPack_NRC_PSO = GetDevice()->createComputePipeline(pipelineDesc);
     }
 #endif // ENABLE_NRC
 
-    {
-        m_denoiserResolveCS = m_shaderFactory->CreateShader("app/Denoiser.hlsl", "resolve", &denoiseMacros, nvrhi::ShaderType::Compute);
-        nvrhi::ComputePipelineDesc pipelineDesc;
-        pipelineDesc.bindingLayouts = { m_globalBindingLayout, m_denoiserBindingLayout };
-        pipelineDesc.CS = m_denoiserResolveCS;
-        m_denoiserResolvePSO = GetDevice()->createComputePipeline(pipelineDesc);
-    }
+    m_denoiserResolveCS = m_shaderFactory->CreateShader("app/Denoiser.hlsl", "resolve", &denoiseMacros, nvrhi::ShaderType::Compute);
 #endif // ENABLE_NRD
 
+    // The compute pipelines are created next to the ray tracing pipelines while the scene loads, Render() waits for them
+    m_computePipelineCreation = std::async(std::launch::async, [this]() { CreateComputePipelines(); });
+
     // Create the tonemapping pass
     {
         nvrhi::BindingLayoutDesc bindingLayoutDesc;
@@ -401,60 +479,188 @@ bool Pathtracer::Init(int argc, const char* const* argv)
     return true;
 }
 
-bool Pathtracer::CreateRayTracingPipelines()
+void Pathtracer::CreateComputePipelines()
 {
-    // Reset macros
-    for (uint i = 0; i < PipelineType::Count; ++i)
-        m_pipelineMacros[i].clear();
+#if ENABLE_SHARC
+    {
+        nvrhi::ComputePipelineDesc pipelineDesc;
+        if (m_api == nvrhi::GraphicsAPI::D3D12)
+            pipelineDesc.bindingLayouts = { m_globalBindingLayout, m_sharcBindingLayout };
+        else
+            pipelineDesc.bindingLayouts = { m_globalBindingLayout, m_dummyLayouts[1], m_dummyLayouts[2], m_sharcBindingLayout };
+
+        pipelineDesc.CS = m_sharcResolveCS;
+        m_sharcResolvePSO = GetDevice()->createComputePipeline(pipelineDesc);
+
+        pipelineDesc.CS = m_sharcHashCopyCS;
+        m_sharcHashCopyPSO = GetDevice()->createComputePipeline(pipelineDesc);
+
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+        pipelineDesc.CS = m_sharcPrepareIndirectCS;
+        m_sharcPrepareIndirectPSO = GetDevice()->createComputePipeline(pipelineDesc);
+
+        pipelineDesc.bindingLayouts.push_back(m_sharcRehashBindingLayout);
+        pipelineDesc.CS = m_sharcRehashCS;
+        m_sharcRehashPSO = GetDevice()->createComputePipeline(pipelineDesc);
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
+    }
+#endif // ENABLE_SHARC
 
-        // Select the current macros
 #if ENABLE_NRD
-    char const* enableDenoiserStr = (m_ui.denoiserSelection == DenoiserSelection::Nrd) ? "1" : "0";
+    nvrhi::ComputePipelineDesc pipelineDesc;
+    pipelineDesc.bindingLayouts = { m_globalBindingLayout, m_denoiserBindingLayout };
+
+    pipelineDesc.CS = m_denoiserReblurPackCS;
+    m_denoiserReblurPackPSO = GetDevice()->createComputePipeline(pipelineDesc);
+
+#if ENABLE_NRC
+    pipelineDesc.CS = m_denoiserReblurPack_NRC_CS;
+    m_denoiserReblurPack_NRC_PSO = GetDevice()->createComputePipeline(pipelineDesc);
+#endif // ENABLE_NRC
+
+    pipelineDesc.CS = m_denoiserResolveCS;
+    m_denoiserResolvePSO = GetDevice()->createComputePipeline(pipelineDesc);
+#endif // ENABLE_NRD
+}
+
+bool Pathtracer::CreateRayTracingPipelines()
+{
+    // The passes writing the denoiser inputs are compiled with and without them, see shaders.cfg
+#if ENABLE_NRD
+    const uint32_t denoiserPermutationNum = 2;
 #else // !ENABLE_NRD
-    char const* enableDenoiserStr = "0";
+    const uint32_t denoiserPermutationNum = 1;
 #endif // !ENABLE_NRD
 
-    m_pipelineMacros[PipelineType::DefaultPathTracing].push_back(ShaderMacro("REFERENCE", "1"));
-    m_pipelineMacros[PipelineType::DefaultPathTracing].push_back(ShaderMacro("ENABLE_NRD", enableDenoiserStr));
+    auto addPermutations = [this, denoiserPermutationNum](PipelineType pipelineType, const char* passDefine, bool writesDenoiserInputs) {
+        for (uint32_t denoiserIndex = 0; denoiserIndex < (writesDenoiserInputs ? denoiserPermutationNum : 1); ++denoiserIndex)
+        {
+            m_pipelineMacros[pipelineType][denoiserIndex] = { ShaderMacro(passDefine, "1") };
+            if (writesDenoiserInputs)
+                m_pipelineMacros[pipelineType][denoiserIndex].push_back(ShaderMacro("ENABLE_NRD", denoiserIndex ? "1" : "0"));
+        }
+    };
+
+    addPermutations(PipelineType::DefaultPathTracing, "REFERENCE", true);
 
 #if ENABLE_NRC
-    m_pipelineMacros[PipelineType::NRC_Update].push_back(ShaderMacro("NRC_UPDATE", "1"));
-    m_pipelineMacros[PipelineType::NRC_Query].push_back(ShaderMacro("NRC_QUERY", "1"));
-    m_pipelineMacros[PipelineType::NRC_Query].push_back(ShaderMacro("ENABLE_NRD", enableDenoiserStr));
+    addPermutations(PipelineType::NRC_Update, "NRC_UPDATE", false);
+    addPermutations(PipelineType::NRC_Query, "NRC_QUERY", true);
 #endif // ENABLE_NRC
 
 #if ENABLE_SHARC
-    m_pipelineMacros[PipelineType::Sharc_Update].push_back(ShaderMacro("SHARC_UPDATE", "1"));
-
-    m_pipelineMacros[PipelineType::Sharc_Query].push_back(ShaderMacro("SHARC_QUERY", "1"));
-    m_pipelineMacros[PipelineType::Sharc_Query].push_back(ShaderMacro("ENABLE_NRD", enableDenoiserStr));
+    addPermutations(PipelineType::Sharc_Update, "SHARC_UPDATE", false);
+    addPermutations(PipelineType::Sharc_Query, "SHARC_QUERY", true);
 #endif // ENABLE_SHARC
 
-    // Create the RT pipelines
+    // Shader libraries are loaded here, the shader factory isn't thread safe
     for (uint32_t i = 0; i < PipelineType::Count; ++i)
     {
-        if (!CreateRayTracingPipeline(*m_shaderFactory, m_pipelinePermutations[i], m_pipelineMacros[i]))
-            return false;
+        for (uint32_t denoiserIndex = 0; denoiserIndex < 2; ++denoiserIndex)
+        {
+            if (m_pipelineMacros[i][denoiserIndex].empty())
+                continue;
+
+            if (!LoadRayTracingShaderLibrary(*m_shaderFactory, m_pipelinePermutations[i][denoiserIndex], m_pipelineMacros[i][denoiserIndex]))
+                return false;
+        }
+    }
+
+    // Creating the pipelines compiles the shaders for the GPU, which takes long, so every permutation is created on its own thread.
+    // Switching passes or the denoiser later only picks another permutation
+    for (uint32_t i = 0; i < PipelineType::Count; ++i)
+    {
+        for (uint32_t denoiserIndex = 0; denoiserIndex < 2; ++denoiserIndex)
+        {
+            if (m_pipelineMacros[i][denoiserIndex].empty())
+                continue;
+
+            m_pipelineCreation[i][denoiserIndex] = std::async(std::launch::async, [this, i, denoiserIndex]() {
+                CreateRayTracingPipeline(m_pipelinePermutations[i][denoiserIndex], m_pipelineMacros[i][denoiserIndex]);
+            });
+        }
     }
 
     return true;
 }
 
+const Pathtracer::PipelinePermutation& Pathtracer::GetPipelinePermutation(PipelineType pipelineType, bool enableDenoiser)
+{
+    const uint32_t denoiserIndex = (enableDenoiser && !m_pipelineMacros[pipelineType][1].empty()) ? 1 : 0;
+
+    // Only waits if the permutation is needed before its background creation finished
+    m_pipelineWaitTime += WaitForCreation(m_pipelineCreation[pipelineType][denoiserIndex]);
+
+    return m_pipelinePermutations[pipelineType][denoiserIndex];
+}
+
 #if ENABLE_NRC
 NrcIntegration* Pathtracer::GetNrcInstance() const
 {
     return m_nrc.get();
 }
+
+const NrcStatsReadback& Pathtracer::GetNrcStats() const
+{
+    return *m_nrcStats;
+}
+
+const NrcCapacityPolicy& Pathtracer::GetNrcCapacityPolicy() const
+{
+    return m_nrcCapacityPolicy;
+}
+
+const NrcTrainingBudgetController& Pathtracer::GetNrcTrainingBudget() const
+{
+    return m_nrcTrainingBudget;
+}
+
+void Pathtracer::UpdateNrcTrainingBudget()
+{
+    if (!m_ui.nrcEnableTrainingBudget)
+    {
+        // Starts over from the initial effort once enabled
+        m_nrcTrainingBudget.Reset();
+        return;
+    }
+
+    m_nrcTrainingBudget.SetTargetTime(m_ui.nrcTrainingBudgetMs);
+
+    // The profiler times trail the frames in flight and are smoothed, a new sample comes with every read frame
+    const FrameProfiler& frameProfiler = m_gpuProfiler->GetFrameProfiler();
+    if (frameProfiler.GetResolvedFrameNum() > 0)
+    {
+        double trainingTime = 0.0;
+        for (const FrameProfilerScope& scope : frameProfiler.GetScopes())
+        {
+            if (scope.name == "NrcUpdatePathtracingPass" || scope.name == "NrcQueryPropagateTrain")
+                trainingTime += scope.gpuTime;
+        }
+        m_nrcTrainingBudget.ReportTime(frameProfiler.GetResolvedFrameNum(), float(trainingTime * 1000.0));
+    }
+
+    if (const NrcFrameStats* lossStats = m_nrcStats->GetRing().GetLastTrainingLoss())
+        m_nrcTrainingBudget.ReportTrainingLoss(lossStats->frameIndex, lossStats->trainingLoss);
+}
 #endif
 
+#if ENABLE_SHARC
+const std::vector<std::unique_ptr<SharcInstance>>& Pathtracer::GetSharcInstances() const
+{
+    return m_sharcInstances;
+}
+#endif // ENABLE_SHARC
+
 bool Pathtracer::LoadScene(std::shared_ptr<vfs::IFileSystem> fs, const std::filesystem::path& sceneFileName)
 {
-    engine::Scene* scene = new engine::Scene(GetDevice(), *m_shaderFactory, fs, m_TextureCache, m_descriptorTable, nullptr);
+    // A scene cache compiled by SceneCacheConverter skips parsing the scene description and its models, a cache that is
+    // missing, partial or older than its sources falls back to them
+    auto scene = std::make_unique<CachedScene>(GetDevice(), *m_shaderFactory, fs, m_TextureCache, m_descriptorTable);
 
-    if (scene->Load(sceneFileName))
+    if (scene->LoadCache(GetSceneCachePath(sceneFileName)) || scene->Load(sceneFileName))
     {
         m_sceneReloaded = true;
-        m_scene = std::unique_ptr<engine::Scene>(scene);
+        m_scene = std::move(scene);
         return true;
     }
 
@@ -465,12 +671,16 @@ void Pathtracer::SceneLoaded()
 {
     ApplicationBase::SceneLoaded();
 
+    log::info("Loaded scene '%s' in %.2f s", m_currentSceneName.c_str(), GetSceneLoadingTime());
+
     m_scene->FinishedLoading(GetFrameIndex());
 
     m_resetAccumulation = true;
     m_accumulatedFrameCount = 1;
     m_rebuildAS = true;
 
+    m_textureStreamer->AddTextures(*m_scene->GetSceneGraph());
+
     // Look for an existing sunlight
     for (auto light : m_scene->GetSceneGraph()->GetLights())
     {
@@ -520,6 +730,10 @@ void Pathtracer::SceneLoaded()
     m_sunLight->angularSize = 0.8f;
     m_sunLight->irradiance = 20.f;
     m_sunLight->SetDirection(dm::double3(-0.049f, -0.87f, 0.48f));
+
+#if ENABLE_SHARC
+    OpenSharcSnapshots();
+#endif // ENABLE_SHARC
 }
 
 void Pathtracer::SceneUnloading()
@@ -529,6 +743,7 @@ void Pathtracer::SceneUnloading()
     m_shaderFactory->ClearCache();
 
     m_bindingCache->Clear();
+    m_textureStreamer->Clear();
     m_sunLight = nullptr;
     m_headLight = nullptr;
     m_ui.selectedMaterial = nullptr;
@@ -562,6 +777,7 @@ void Pathtracer::SetCurrentSceneName(const std::string& sceneName)
         return;
 
     m_currentSceneName = sceneName;
+    m_sceneLoadingStartTime = std::chrono::steady_clock::now();
 
     BeginLoadingScene(m_nativeFileSystem, m_currentSceneName);
 
@@ -571,6 +787,11 @@ void Pathtracer::SetCurrentSceneName(const std::string& sceneName)
 #endif // ENABLE_NRC
 }
 
+double Pathtracer::GetSceneLoadingTime() const
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - m_sceneLoadingStartTime).count();
+}
+
 void Pathtracer::CopyActiveCameraToFirstPerson()
 {
     if (m_ui.activeSceneCamera)
@@ -623,7 +844,7 @@ void Pathtracer::Animate(float fElapsedTimeSeconds)
 {
     m_camera.Animate(fElapsedTimeSeconds);
 
-    if (IsSceneLoaded() && m_enableAnimations)
+    if (IsSceneLoaded() && !IsSceneLoading() && m_enableAnimations)
     {
         m_wallclockTime += fElapsedTimeSeconds;
         float offset = 0;
@@ -641,13 +862,16 @@ void Pathtracer::Animate(float fElapsedTimeSeconds)
     GetDeviceManager()->SetInformativeWindowTitle(g_WindowTitle);
 }
 
-bool Pathtracer::CreateRayTracingPipeline(engine::ShaderFactory& shaderFactory, PipelinePermutation& pipelinePermutation, std::vector<engine::ShaderMacro>& pipelineMacros)
+bool Pathtracer::LoadRayTracingShaderLibrary(engine::ShaderFactory& shaderFactory, PipelinePermutation& pipelinePermutation, std::vector<engine::ShaderMacro>& pipelineMacros)
 {
-    nvrhi::ShaderLibraryHandle shaderLibrary = shaderFactory.CreateShaderLibrary("app/Pathtracer.hlsl", &pipelineMacros);
-    if (!shaderLibrary)
-        return false;
+    pipelinePermutation.shaderLibrary = shaderFactory.CreateShaderLibrary("app/Pathtracer.hlsl", &pipelineMacros);
+
+    return pipelinePermutation.shaderLibrary != nullptr;
+}
 
-    pipelinePermutation.shaderLibrary = shaderLibrary;
+void Pathtracer::CreateRayTracingPipeline(PipelinePermutation& pipelinePermutation, const std::vector<engine::ShaderMacro>& pipelineMacros)
+{
+    nvrhi::IShaderLibrary* shaderLibrary = pipelinePermutation.shaderLibrary;
 
     auto macroDefined = [pipelineMacros](std::string inputToken) {
         auto it = std::find_if(pipelineMacros.begin(), pipelineMacros.end(), [&inputToken](const engine::ShaderMacro& macro) {
@@ -665,6 +889,7 @@ bool Pathtracer::CreateRayTracingPipeline(engine::ShaderFactory& shaderFactory,
 
     pipelineDesc.globalBindingLayouts[DescriptorSetIDs::Globals] = m_globalBindingLayout;
     pipelineDesc.globalBindingLayouts[DescriptorSetIDs::Bindless] = m_bindlessLayout;
+    pipelineDesc.globalBindingLayouts[DescriptorSetIDs::StreamedTextures] = m_textureStreamer->GetBindlessLayout();
 
     pipelineDesc.shaders = { { "", shaderLibrary->getShader("RayGen", nvrhi::ShaderType::RayGeneration), nullptr },
                              { "", shaderLibrary->getShader("Miss", nvrhi::ShaderType::Miss), nullptr },
@@ -709,8 +934,6 @@ bool Pathtracer::CreateRayTracingPipeline(engine::ShaderFactory& shaderFactory,
     pipelinePermutation.shaderTable->addHitGroup("HitGroupShadow");
     pipelinePermutation.shaderTable->addMissShader("Miss");
     pipelinePermutation.shaderTable->addMissShader("ShadowMiss");
-
-    return true;
 }
 
 void Pathtracer::GetMeshBlasDesc(engine::MeshInfo& mesh, nvrhi::rt::AccelStructDesc& blasDesc, bool skipTransmissiveMaterials) const
@@ -738,80 +961,638 @@ void Pathtracer::GetMeshBlasDesc(engine::MeshInfo& mesh, nvrhi::rt::AccelStructD
         blasDesc.bottomLevelGeometries.push_back(geometryDesc);
     }
 
+    // Skinned meshes are built once and refit while their pose changes
     if (mesh.skinPrototype)
-        blasDesc.buildFlags = nvrhi::rt::AccelStructBuildFlags::PreferFastTrace;
+        blasDesc.buildFlags = nvrhi::rt::AccelStructBuildFlags::PreferFastTrace | nvrhi::rt::AccelStructBuildFlags::AllowUpdate;
     else
         blasDesc.buildFlags = nvrhi::rt::AccelStructBuildFlags::PreferFastTrace | nvrhi::rt::AccelStructBuildFlags::AllowCompaction;
 }
 
-void Pathtracer::CreateAccelStructs(nvrhi::ICommandList* commandList)
+void Pathtracer::CreateAccelStructs()
 {
+    const auto startTime = std::chrono::steady_clock::now();
+
+    std::vector<std::shared_ptr<engine::MeshInfo>> meshes;
     for (const auto& mesh : m_scene->GetSceneGraph()->GetMeshes())
     {
-        if (mesh->buffers->hasAttribute(engine::VertexAttribute::JointWeights))
+        if (!mesh->buffers->hasAttribute(engine::VertexAttribute::JointWeights))
+            meshes.push_back(mesh);
+    }
+
+    // Descriptors only read the meshes and are filled on all cores, together with the scratch sizes reported by the driver
+    std::vector<nvrhi::rt::AccelStructDesc> blasDescs(meshes.size());
+    std::vector<AccelStructBuildSizes> blasSizes(meshes.size());
+    ParallelFor(uint32_t(meshes.size()), [&](uint32_t meshIndex) {
+        GetMeshBlasDesc(*meshes[meshIndex], blasDescs[meshIndex], !m_ui.enableTransmission);
+        blasSizes[meshIndex] = GetAccelStructBuildSizes(GetDevice(), blasDescs[meshIndex]);
+    });
+
+    // Skinned meshes are built every frame in BuildTLAS()
+    std::vector<uint32_t> buildMeshIndices;
+    std::vector<uint64_t> scratchSizes;
+    for (uint32_t meshIndex = 0; meshIndex < meshes.size(); ++meshIndex)
+    {
+        meshes[meshIndex]->accelStruct = GetDevice()->createAccelStruct(blasDescs[meshIndex]);
+        if (meshes[meshIndex]->skinPrototype)
             continue;
 
-        nvrhi::rt::AccelStructDesc blasDesc;
-        GetMeshBlasDesc(*mesh, blasDesc, !m_ui.enableTransmission);
+        buildMeshIndices.push_back(meshIndex);
+        scratchSizes.push_back(blasSizes[meshIndex].buildScratchSize);
+    }
+
+    // The scratch pool holds the largest build, smaller builds are packed into it largest first. NVRHI suballocates each batch
+    // from one scratch chunk of the pool size, the memory limit stays at its default so a build is never dropped
+    uint64_t scratchPoolSize = c_BlasScratchMinPoolSize;
+    for (uint64_t scratchSize : scratchSizes)
+        scratchPoolSize = std::max(scratchPoolSize, (scratchSize + c_ScratchAlignment - 1) / c_ScratchAlignment * c_ScratchAlignment);
 
-        nvrhi::rt::AccelStructHandle accelStruct = GetDevice()->createAccelStruct(blasDesc);
+    const std::vector<BlasBuildBatch> batches = BatchBlasBuilds(scratchSizes.data(), uint32_t(scratchSizes.size()), scratchPoolSize, c_ScratchAlignment);
 
-        if (!mesh->skinPrototype)
-            nvrhi::utils::BuildBottomLevelAccelStruct(commandList, accelStruct, blasDesc);
+    nvrhi::CommandListParameters commandListParameters;
+    commandListParameters.scratchChunkSize = scratchPoolSize;
+    nvrhi::CommandListHandle commandList = GetDevice()->createCommandList(commandListParameters);
 
-        mesh->accelStruct = accelStruct;
+    // Batches are submitted back to back, a chunk is handed to a new batch once the GPU has finished the batch that used it.
+    // Waiting for the batch submitted 'c_BlasBatchesInFlight' batches earlier bounds the scratch memory to as many chunks
+    nvrhi::EventQueryHandle batchQueries[c_BlasBatchesInFlight];
+    for (uint32_t batchIndex = 0; batchIndex < batches.size(); ++batchIndex)
+    {
+        nvrhi::EventQueryHandle& batchQuery = batchQueries[batchIndex % c_BlasBatchesInFlight];
+        if (batchQuery)
+        {
+            GetDevice()->waitEventQuery(batchQuery);
+            GetDevice()->resetEventQuery(batchQuery);
+        }
+        else
+            batchQuery = GetDevice()->createEventQuery();
+
+        commandList->open();
+
+        for (const BlasBuild& build : batches[batchIndex].builds)
+        {
+            const uint32_t meshIndex = buildMeshIndices[build.index];
+            nvrhi::utils::BuildBottomLevelAccelStruct(commandList, meshes[meshIndex]->accelStruct, blasDescs[meshIndex]);
+        }
+
+        commandList->close();
+        GetDevice()->executeCommandList(commandList);
+        GetDevice()->setEventQuery(batchQuery, nvrhi::CommandQueue::Graphics);
     }
 
+    // Compaction sizes are read back once all builds have finished, every BLAS tagged for compaction is then compacted in one go
+    GetDevice()->waitForIdle();
+    commandList->open();
+    commandList->compactBottomLevelAccelStructs();
+    commandList->close();
+    GetDevice()->executeCommandList(commandList);
+
+    const double buildTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    log::info("Built %zu BLAS in %zu batches, %.1f ms", buildMeshIndices.size(), batches.size(), buildTime * 1e3);
+
+    const uint32_t instanceNum = uint32_t(m_scene->GetSceneGraph()->GetMeshInstances().size());
+
     nvrhi::rt::AccelStructDesc tlasDesc;
     tlasDesc.isTopLevel = true;
-    tlasDesc.topLevelMaxInstances = m_scene->GetSceneGraph()->GetMeshInstances().size();
+    tlasDesc.topLevelMaxInstances = instanceNum;
+    tlasDesc.buildFlags = nvrhi::rt::AccelStructBuildFlags::PreferFastTrace | nvrhi::rt::AccelStructBuildFlags::AllowUpdate;
     m_topLevelAS = GetDevice()->createAccelStruct(tlasDesc);
+
+    nvrhi::BufferDesc bufferDesc;
+    bufferDesc.byteSize = std::max(instanceNum, 1u) * sizeof(nvrhi::rt::InstanceDesc);
+    bufferDesc.isAccelStructBuildInput = true;
+    bufferDesc.keepInitialState = true;
+    bufferDesc.initialState = nvrhi::ResourceStates::AccelStructBuildInput;
+    bufferDesc.debugName = "TlasInstances";
+    m_tlasInstanceBuffer = GetDevice()->createBuffer(bufferDesc);
+
+    m_tlasInstances.assign(instanceNum, nvrhi::rt::InstanceDesc());
+    m_tlasInstanceTable.Reset(instanceNum);
+    m_tlasSizes = GetAccelStructBuildSizes(GetDevice(), tlasDesc);
+
+    const auto& skinnedInstances = m_scene->GetSceneGraph()->GetSkinnedMeshInstances();
+    m_skinnedBlasStates.assign(skinnedInstances.size(), SkinnedBlasState());
+
+    // The largest frame fully builds every skinned BLAS and the TLAS, which sizes the scratch chunks of the frame command list
+    m_accelStructScratch.Reset(0);
+    for (uint32_t skinnedIndex = 0; skinnedIndex < skinnedInstances.size(); ++skinnedIndex)
+    {
+        nvrhi::rt::AccelStructDesc blasDesc;
+        GetMeshBlasDesc(*skinnedInstances[skinnedIndex]->GetMesh(), blasDesc, !m_ui.enableTransmission);
+        UpdateSkinnedBlasState(skinnedIndex, blasDesc);
+        m_accelStructScratch.Request(m_skinnedBlasStates[skinnedIndex].sizes.buildScratchSize);
+    }
+    m_accelStructScratch.Request(m_tlasSizes.buildScratchSize);
+    m_accelStructScratch.EndFrame();
 }
 
-void Pathtracer::BuildTLAS(nvrhi::ICommandList* commandList, uint32_t frameIndex) const
+void Pathtracer::UpdateSkinnedBlasState(uint32_t skinnedIndex, const nvrhi::rt::AccelStructDesc& blasDesc)
 {
+    SkinnedBlasState& state = m_skinnedBlasStates[skinnedIndex];
+
+    std::vector<nvrhi::rt::GeometryFlags> geometryFlags(blasDesc.bottomLevelGeometries.size());
+    for (size_t geometryIndex = 0; geometryIndex < geometryFlags.size(); ++geometryIndex)
+        geometryFlags[geometryIndex] = blasDesc.bottomLevelGeometries[geometryIndex].flags;
+
+    if (state.buildFlags == blasDesc.buildFlags && state.geometryFlags == geometryFlags)
+        return;
+
+    // A refit keeps the flags of the last full build, so the next build of the BLAS is a full build with the new flags.
+    // The BLAS created in CreateAccelStructs() is only replaced if the new flags need more memory
+    const AccelStructBuildSizes sizes = GetAccelStructBuildSizes(GetDevice(), blasDesc);
+    if (state.sizes.resultSize != 0 && sizes.resultSize > state.sizes.resultSize)
     {
-        ScopedMarker scopedMarker(commandList, "Skinned BLAS Updates");
+        const auto& mesh = m_scene->GetSceneGraph()->GetSkinnedMeshInstances()[skinnedIndex]->GetMesh();
+        mesh->accelStruct = GetDevice()->createAccelStruct(blasDesc);
+    }
+
+    state.refitNum = c_SkinnedBlasNotBuilt;
+    state.buildFlags = blasDesc.buildFlags;
+    state.geometryFlags = std::move(geometryFlags);
+    state.sizes = sizes;
+}
+
+void Pathtracer::BuildTLAS(nvrhi::ICommandList* commandList, uint32_t frameIndex)
+{
+    // Skinned meshes whose BLAS is updated this frame, the TLAS instances referencing them are refit
+    std::vector<const engine::MeshInfo*> updatedSkinnedMeshes;
+
+    {
+        ScopedMarker scopedMarker(commandList, "Skinned BLAS Updates", m_gpuProfiler.get());
+
+        // Skinning only runs on meshes whose pose changed, the BLAS of the others stay valid
+        // BLAS whose build or geometry flags changed, e.g. by toggling transmission, are fully built even if their pose didn't change
+        const auto& skinnedInstances = m_scene->GetSceneGraph()->GetSkinnedMeshInstances();
+        std::vector<nvrhi::rt::AccelStructDesc> blasDescs(skinnedInstances.size());
+        std::vector<uint32_t> skinnedIndices;
+        for (uint32_t skinnedIndex = 0; skinnedIndex < skinnedInstances.size(); ++skinnedIndex)
+        {
+            GetMeshBlasDesc(*skinnedInstances[skinnedIndex]->GetMesh(), blasDescs[skinnedIndex], !m_ui.enableTransmission);
+            UpdateSkinnedBlasState(skinnedIndex, blasDescs[skinnedIndex]);
+
+            if (m_skinnedBlasStates[skinnedIndex].refitNum == c_SkinnedBlasNotBuilt || skinnedInstances[skinnedIndex]->GetLastUpdateFrameIndex() >= frameIndex)
+                skinnedIndices.push_back(skinnedIndex);
+        }
 
         // Transition all the buffers to their necessary states before building the BLAS'es to allow BLAS batching
-        for (const auto& skinnedInstance : m_scene->GetSceneGraph()->GetSkinnedMeshInstances())
+        for (uint32_t skinnedIndex : skinnedIndices)
         {
+            const auto& skinnedInstance = skinnedInstances[skinnedIndex];
             commandList->setAccelStructState(skinnedInstance->GetMesh()->accelStruct, nvrhi::ResourceStates::AccelStructWrite);
             commandList->setBufferState(skinnedInstance->GetMesh()->buffers->vertexBuffer, nvrhi::ResourceStates::AccelStructBuildInput);
         }
         commandList->commitBarriers();
 
-        // Build BLAS instances
-        for (const auto& skinnedInstance : m_scene->GetSceneGraph()->GetSkinnedMeshInstances())
+        // Refit BLAS instances, a full build every 'skinnedBlasRebuildInterval' updates bounds the loss of BVH quality
+        const uint32_t rebuildInterval = uint32_t(std::max(m_ui.skinnedBlasRebuildInterval, 1));
+        for (uint32_t skinnedIndex : skinnedIndices)
         {
-            nvrhi::rt::AccelStructDesc blasDesc;
-            GetMeshBlasDesc(*skinnedInstance->GetMesh(), blasDesc, !m_ui.enableTransmission);
+            const auto& skinnedInstance = skinnedInstances[skinnedIndex];
+            SkinnedBlasState& state = m_skinnedBlasStates[skinnedIndex];
+            nvrhi::rt::AccelStructDesc& blasDesc = blasDescs[skinnedIndex];
+
+            if (state.refitNum != c_SkinnedBlasNotBuilt && state.refitNum + 1 < rebuildInterval)
+            {
+                blasDesc.buildFlags = blasDesc.buildFlags | nvrhi::rt::AccelStructBuildFlags::PerformUpdate;
+                state.refitNum++;
+                m_accelStructScratch.Request(state.sizes.updateScratchSize);
+            }
+            else
+            {
+                state.refitNum = 0;
+                m_accelStructScratch.Request(state.sizes.buildScratchSize);
+            }
 
             nvrhi::utils::BuildBottomLevelAccelStruct(commandList, skinnedInstance->GetMesh()->accelStruct, blasDesc);
+
+            updatedSkinnedMeshes.push_back(skinnedInstance->GetMesh().get());
         }
     }
 
-    std::vector<nvrhi::rt::InstanceDesc> instances;
-    for (const auto& instance : m_scene->GetSceneGraph()->GetMeshInstances())
+    // Compact acceleration structures that are tagged for compaction and have finished executing the original build
+    commandList->compactBottomLevelAccelStructs();
+
+    // Compaction moves a BLAS, so their addresses are checked every frame. Transforms only change while animations run
+    const auto& meshInstances = m_scene->GetSceneGraph()->GetMeshInstances();
+    const bool updateTransforms = m_enableAnimations || m_tlasInstanceTable.IsBuildRequired();
+    for (uint32_t instanceIndex = 0; instanceIndex < meshInstances.size(); ++instanceIndex)
     {
-        nvrhi::rt::InstanceDesc instanceDesc;
-        instanceDesc.bottomLevelAS = instance->GetMesh()->accelStruct;
-        instanceDesc.instanceMask = 1;
-        instanceDesc.instanceID = instance->GetInstanceIndex();
+        const auto& instance = meshInstances[instanceIndex];
+        nvrhi::rt::InstanceDesc& instanceDesc = m_tlasInstances[instanceIndex];
 
-        auto node = instance->GetNode();
-        dm::affineToColumnMajor(node->GetLocalToWorldTransformFloat(), instanceDesc.transform);
+        const nvrhi::rt::AccelStructHandle& accelStruct = instance->GetMesh()->accelStruct;
+        if (m_tlasInstanceTable.SetInstanceBlas(instanceIndex, accelStruct->getDeviceAddress()))
+        {
+            instanceDesc.blasDeviceAddress = accelStruct->getDeviceAddress();
+            instanceDesc.instanceMask = 1;
+            instanceDesc.instanceID = instance->GetInstanceIndex();
+        }
 
-        instances.push_back(instanceDesc);
+        if (updateTransforms)
+        {
+            nvrhi::rt::AffineTransform transform;
+            dm::affineToColumnMajor(instance->GetNode()->GetLocalToWorldTransformFloat(), transform);
+            if (m_tlasInstanceTable.SetInstanceTransform(instanceIndex, transform))
+                memcpy(instanceDesc.transform, transform, sizeof(transform));
+        }
+
+        // Skinned BLAS are updated in place
+        if (instance->GetMesh()->skinPrototype &&
+            std::find(updatedSkinnedMeshes.begin(), updatedSkinnedMeshes.end(), instance->GetMesh().get()) != updatedSkinnedMeshes.end())
+            m_tlasInstanceTable.MarkDirty(instanceIndex);
     }
 
-    // Compact acceleration structures that are tagged for compaction and have finished executing the original build
-    commandList->compactBottomLevelAccelStructs();
+    const TlasBuildAction buildAction = m_tlasInstanceTable.Update();
+    if (buildAction == TlasBuildAction::Refit)
+        m_accelStructScratch.Request(m_tlasSizes.updateScratchSize);
+    else if (buildAction != TlasBuildAction::None)
+        m_accelStructScratch.Request(m_tlasSizes.buildScratchSize);
+
+    // A frame larger than the chunk is still served by NVRHI from a dedicated chunk, the command list is recreated with larger
+    // chunks on the next frame
+    m_accelStructScratch.EndFrame();
+
+    if (buildAction == TlasBuildAction::None)
+        return;
+
+    ScopedMarker scopedMarker(commandList, "TLAS Update", m_gpuProfiler.get());
+
+    for (const TlasInstanceRange& range : m_tlasInstanceTable.GetDirtyRanges())
+    {
+        commandList->writeBuffer(m_tlasInstanceBuffer, &m_tlasInstances[range.begin], (range.end - range.begin) * sizeof(nvrhi::rt::InstanceDesc),
+                                 range.begin * sizeof(nvrhi::rt::InstanceDesc));
+
+        // BLAS are referenced by address, their builds have to finish before the TLAS reads them
+        for (uint32_t instanceIndex = range.begin; instanceIndex < range.end; ++instanceIndex)
+            commandList->setAccelStructState(meshInstances[instanceIndex]->GetMesh()->accelStruct, nvrhi::ResourceStates::AccelStructBuildBlas);
+    }
+
+    nvrhi::rt::AccelStructBuildFlags buildFlags = m_topLevelAS->getDesc().buildFlags;
+    if (buildAction == TlasBuildAction::Refit)
+        buildFlags = buildFlags | nvrhi::rt::AccelStructBuildFlags::PerformUpdate;
 
-    ScopedMarker scopedMarker(commandList, "TLAS Update");
-    commandList->buildTopLevelAccelStruct(m_topLevelAS, instances.data(), instances.size());
+    commandList->buildTopLevelAccelStructFromBuffer(m_topLevelAS, m_tlasInstanceBuffer, 0, m_tlasInstances.size(), buildFlags);
 }
 
+#if ENABLE_SHARC
+void Pathtracer::UpdateSharcInstances()
+{
+    const uint32_t instanceNum = m_ui.sharcCoarseInstance ? 2 : 1;
+
+    // Buffers of a removed instance are released once the GPU is done with them
+    while (m_sharcInstances.size() > instanceNum)
+        m_sharcInstances.pop_back();
+
+    while (m_sharcInstances.size() < instanceNum)
+    {
+        SharcInstanceDesc desc;
+        if (m_sharcInstances.empty())
+        {
+            desc.name = "Default";
+            desc.capacityControllerDesc.initialEntriesNum = 4 * 1024 * 1024;
+        }
+        else
+        {
+            desc.name = "Coarse";
+            desc.capacityControllerDesc.initialEntriesNum = 1024 * 1024;
+            desc.budgetWeight = 0.25f;
+        }
+
+        m_sharcInstances.push_back(std::make_unique<SharcInstance>(GetDevice(), m_sharcBindingLayout, m_sharcRehashBindingLayout, desc));
+    }
+
+    m_ui.sharcQueryInstance = std::min(m_ui.sharcQueryInstance, int(m_sharcInstances.size()) - 1);
+
+    for (uint32_t instanceIndex = 0; instanceIndex < m_sharcInstances.size(); ++instanceIndex)
+    {
+        SharcInstanceParameters parameters;
+        parameters.sceneScale = m_ui.sharcSceneScale;
+        parameters.roughnessThreshold = m_ui.sharcRoughnessThreshold;
+        parameters.downscaleFactor = m_ui.sharcDownscaleFactor;
+        parameters.accumulationFrameNum = m_ui.sharcAccumulationFrameNum;
+        parameters.staleFrameNum = m_ui.sharcStaleFrameFrameNum;
+        parameters.enableAntifirefly = m_ui.sharcEnableAntiFireflyFilter;
+        // Reused hits come from the live camera and fix the update rays to the query pixels, the tile schedule is skipped
+        parameters.enablePrimaryHitReuse = m_ui.sharcReusePrimaryHits && m_ui.sharcUpdateViewCamera && instanceIndex == uint32_t(m_ui.sharcQueryInstance);
+        parameters.enableTileSchedule = m_ui.sharcTileSchedule && !parameters.enablePrimaryHitReuse && instanceIndex == uint32_t(m_ui.sharcQueryInstance);
+
+        // Coarse cache, larger voxels cover distant geometry with fewer entries and fewer update rays
+        if (instanceIndex > 0)
+        {
+            parameters.sceneScale *= 0.25f;
+            parameters.downscaleFactor *= 2;
+        }
+
+        m_sharcInstances[instanceIndex]->SetParameters(parameters);
+    }
+}
+
+void Pathtracer::UpdateSharcCapacity()
+{
+    const bool enableResize = m_ui.techSelection == TechSelection::Sharc && m_ui.sharcEnableUpdate && m_ui.sharcEnableResolve && m_ui.sharcAdaptiveCapacity &&
+                              !m_ui.sharcEnableClear && !m_sceneReloaded;
+
+    // Limits follow what the instances currently require, a lowered limit shrinks the instance over the next frames
+    const uint32_t instanceNum = uint32_t(m_sharcInstances.size());
+    SharcBudgetRequest requests[m_sharcMaxInstanceNum];
+    uint32_t entriesLimits[m_sharcMaxInstanceNum] = {};
+    for (uint32_t instanceIndex = 0; instanceIndex < instanceNum; ++instanceIndex)
+    {
+        const SharcInstance& instance = *m_sharcInstances[instanceIndex];
+        const SharcCapacityController& capacityController = instance.GetCapacityController();
+
+        requests[instanceIndex].requiredEntriesNum = capacityController.GetRequiredEntriesNum();
+        requests[instanceIndex].minEntriesNum = capacityController.GetDesc().minEntriesNum;
+        requests[instanceIndex].maxEntriesNum = capacityController.GetDesc().maxEntriesNum;
+        requests[instanceIndex].weight = instance.GetDesc().budgetWeight;
+    }
+
+    const uint64_t budgetByteSize = uint64_t(m_ui.sharcMemoryBudget) * 1024 * 1024;
+    SharcAllocateMemoryBudget(budgetByteSize, SharcInstance::GetEntryByteSize(), requests, instanceNum, entriesLimits);
+
+    for (uint32_t instanceIndex = 0; instanceIndex < instanceNum; ++instanceIndex)
+        m_sharcInstances[instanceIndex]->UpdateCapacity(m_commandList, GetFrameIndex(), enableResize, entriesLimits[instanceIndex]);
+}
+
+void Pathtracer::RenderSharcInstance(SharcInstance& instance, bool clear, LightingConstants& constants, nvrhi::rt::State& state, uint32_t width, uint32_t height)
+{
+    ScopedMarker scopedMarker(m_commandList, instance.GetDesc().name.c_str(), m_gpuProfiler.get());
+
+    // Passes of an instance only read its own constants
+    instance.FillConstants(constants);
+    m_commandList->writeBuffer(m_constantBuffer, &constants, sizeof(constants));
+
+    if (clear)
+        instance.Clear(m_commandList);
+
+    if (m_ui.sharcEnableResolve)
+    {
+        instance.Swap();
+#if !SHARC_ENABLE_LIVE_ENTRY_LIST
+        // With the live entry list the compaction pass resets the slots it visited
+        m_commandList->clearBufferUInt(instance.GetVoxelDataBuffer(), 0);
+#endif // !SHARC_ENABLE_LIVE_ENTRY_LIST
+    }
+
+    // SHARC update
+    {
+        // Update never uses denoiser; set to dummy.
+        state.bindings[DescriptorSetIDs::Denoiser] = m_dummyBindingSets[DescriptorSetIDs::Denoiser];
+        state.bindings[DescriptorSetIDs::Sharc] = instance.GetBindingSet();
+
+        state.shaderTable = GetPipelinePermutation(PipelineType::Sharc_Update, false).shaderTable;
+        m_commandList->setRayTracingState(state);
+
+        nvrhi::rt::DispatchRaysArguments args;
+        args.width = width / instance.GetParameters().downscaleFactor;
+        args.height = height / instance.GetParameters().downscaleFactor;
+
+        ScopedMarker scopedMarker(m_commandList, "SharcUpdate", m_gpuProfiler.get());
+        m_commandList->dispatchRays(args);
+    }
+
+    if (!m_ui.sharcEnableResolve)
+        return;
+
+    nvrhi::ComputeState computeState;
+    // Unified Binding
+    if (m_api == nvrhi::GraphicsAPI::D3D12)
+        computeState.bindings = { m_globalBindingSet, instance.GetBindingSet() };
+    else
+        computeState.bindings = { m_globalBindingSet, m_dummyBindingSets[1], m_dummyBindingSets[2], instance.GetBindingSet() };
+
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+    // Both passes run over the live entry list, thread count follows occupancy instead of capacity
+    {
+        computeState.pipeline = m_sharcPrepareIndirectPSO;
+        m_commandList->setComputeState(computeState);
+
+        ScopedMarker scopedMarker(m_commandList, "SharcPrepareIndirect", m_gpuProfiler.get());
+        m_commandList->dispatch(1, 1);
+        m_commandList->copyBuffer(m_sharcIndirectArgsBuffer, 0, instance.GetLiveCounterBuffer(), sizeof(uint32_t), 3 * sizeof(uint32_t));
+    }
+
+    computeState.indirectParams = m_sharcIndirectArgsBuffer;
+
+    // SHARC resolve
+    {
+        computeState.pipeline = m_sharcResolvePSO;
+        m_commandList->setComputeState(computeState);
+
+        ScopedMarker scopedMarker(m_commandList, "SharcResolve", m_gpuProfiler.get());
+        m_commandList->dispatchIndirect(0);
+    }
+
+    // SHARC compaction
+    {
+        computeState.pipeline = m_sharcHashCopyPSO;
+        m_commandList->setComputeState(computeState);
+
+        ScopedMarker scopedMarker(m_commandList, "SharcCompaction", m_gpuProfiler.get());
+        m_commandList->dispatchIndirect(0);
+    }
+
+    instance.ReadbackOccupancy(m_commandList, GetFrameIndex());
+
+    // SHARC rehash, migrates a range of the resolved entries into the resized table
+    if (instance.GetCapacityAction() != SharcCapacityAction::None)
+    {
+        uint32_t rehashBegin, rehashEnd;
+        instance.GetCapacityController().GetRehashRange(rehashBegin, rehashEnd);
+
+        computeState.indirectParams = nullptr;
+        computeState.bindings.push_back(instance.GetRehashBindingSet());
+        computeState.pipeline = m_sharcRehashPSO;
+        m_commandList->setComputeState(computeState);
+
+        const uint groupSize = 256;
+        ScopedMarker scopedMarker(m_commandList, "SharcRehash", m_gpuProfiler.get());
+        m_commandList->dispatch(DivideRoundUp(rehashEnd - rehashBegin, groupSize), 1);
+    }
+#else // !SHARC_ENABLE_LIVE_ENTRY_LIST
+    // SHARC resolve
+    {
+        computeState.pipeline = m_sharcResolvePSO;
+        m_commandList->setComputeState(computeState);
+
+        const uint groupSize = 256;
+        const dm::uint2 dispatchSize = { DivideRoundUp(instance.GetEntriesNum(), groupSize), 1 };
+
+        ScopedMarker scopedMarker(m_commandList, "SharcResolve", m_gpuProfiler.get());
+        m_commandList->dispatch(dispatchSize.x, dispatchSize.y);
+    }
+
+    // SHARC compaction
+    {
+        computeState.pipeline = m_sharcHashCopyPSO;
+        m_commandList->setComputeState(computeState);
+
+        const uint groupSize = 256;
+        const dm::uint2 dispatchSize = { DivideRoundUp(instance.GetEntriesNum(), groupSize), 1 };
+        ScopedMarker scopedMarker(m_commandList, "SharcCompaction", m_gpuProfiler.get());
+        m_commandList->dispatch(dispatchSize.x, dispatchSize.y);
+    }
+#endif // !SHARC_ENABLE_LIVE_ENTRY_LIST
+}
+
+void Pathtracer::CreateSharcTileSchedule(uint32_t width, uint32_t height)
+{
+    m_sharcTileScheduler->Resize(width, height);
+
+    const uint32_t tileNum = m_sharcTileScheduler->GetTileNum();
+    m_sharcTileRayOffsets.resize(tileNum + 1);
+
+    nvrhi::BufferDesc bufferDesc;
+    bufferDesc.byteSize = tileNum * sizeof(SharcTileStats);
+    bufferDesc.structStride = sizeof(uint32_t);
+    bufferDesc.canHaveUAVs = true;
+    bufferDesc.keepInitialState = true;
+    bufferDesc.initialState = nvrhi::ResourceStates::UnorderedAccess;
+    bufferDesc.debugName = "SharcTileStats";
+    m_sharcTileStatsBuffer = GetDevice()->createBuffer(bufferDesc);
+
+    bufferDesc.byteSize = (tileNum + 1) * sizeof(uint32_t);
+    bufferDesc.canHaveUAVs = false;
+    bufferDesc.initialState = nvrhi::ResourceStates::ShaderResource;
+    bufferDesc.debugName = "SharcTileRayOffsets";
+    m_sharcTileRayOffsetsBuffer = GetDevice()->createBuffer(bufferDesc);
+
+    bufferDesc = nvrhi::BufferDesc();
+    bufferDesc.byteSize = tileNum * sizeof(SharcTileStats);
+    bufferDesc.cpuAccess = nvrhi::CpuAccessMode::Read;
+    bufferDesc.debugName = "SharcTileStatsReadback";
+    for (SharcTileStatsReadback& readback : m_sharcTileStatsReadbacks)
+    {
+        readback.buffer = GetDevice()->createBuffer(bufferDesc);
+        readback.pending = false;
+    }
+}
+
+void Pathtracer::UpdateSharcTileSchedule(LightingConstants& constants, uint32_t width, uint32_t height)
+{
+    // Pick up the counters written into this slot 'm_sharcReadbackLatency' frames ago
+    SharcTileStatsReadback& readback = m_sharcTileStatsReadbacks[GetFrameIndex() % m_sharcReadbackLatency];
+    if (readback.pending)
+    {
+        const SharcTileStats* tileStats = (const SharcTileStats*)GetDevice()->mapBuffer(readback.buffer, nvrhi::CpuAccessMode::Read);
+        if (tileStats)
+        {
+            if (m_ui.sharcTileSchedule)
+                m_sharcTileScheduler->ReportTileStats(tileStats);
+            GetDevice()->unmapBuffer(readback.buffer);
+        }
+        readback.pending = false;
+    }
+
+    if (!m_ui.sharcTileSchedule || m_ui.sharcEnableClear || m_sceneReloaded)
+        m_sharcTileScheduler->Reset();
+
+    if (!m_ui.sharcTileSchedule)
+        return;
+
+    // Same ray count as the regular update dispatch of the instance the schedule is built for
+    const int downscaleFactor = m_sharcInstances[m_ui.sharcQueryInstance]->GetParameters().downscaleFactor;
+    const uint32_t rayNum = (width / downscaleFactor) * (height / downscaleFactor);
+    m_sharcTileScheduler->Schedule(rayNum, m_sharcTileRayOffsets.data());
+
+    m_commandList->writeBuffer(m_sharcTileRayOffsetsBuffer, m_sharcTileRayOffsets.data(), m_sharcTileRayOffsets.size() * sizeof(uint32_t));
+    m_commandList->clearBufferUInt(m_sharcTileStatsBuffer, 0);
+
+    constants.sharcTileSize = m_sharcTileScheduler->GetDesc().tileSize;
+    constants.sharcTileNumX = m_sharcTileScheduler->GetTileNumX();
+    constants.sharcTileNum = m_sharcTileScheduler->GetTileNum();
+}
+
+void Pathtracer::CreateSharcPrimaryHits(uint32_t width, uint32_t height)
+{
+    // One hit per update ray of the smallest downscale factor, larger factors use a part of the buffer
+    const uint32_t downscaleFactor = m_ui.sharcDownscaleFactor;
+
+    nvrhi::BufferDesc bufferDesc;
+    bufferDesc.byteSize = std::max((width / downscaleFactor) * (height / downscaleFactor), 1u) * sizeof(SharcPrimaryHit);
+    bufferDesc.structStride = sizeof(SharcPrimaryHit);
+    bufferDesc.canHaveUAVs = true;
+    bufferDesc.keepInitialState = true;
+    bufferDesc.initialState = nvrhi::ResourceStates::UnorderedAccess;
+    bufferDesc.debugName = "SharcPrimaryHits";
+    m_sharcPrimaryHitsBuffer = GetDevice()->createBuffer(bufferDesc);
+
+    m_sharcPrimaryHitsValid = false;
+}
+
+void Pathtracer::UpdateSharcPrimaryHits(LightingConstants& constants, uint32_t width, uint32_t height)
+{
+    const SharcInstance& queryInstance = *m_sharcInstances[m_ui.sharcQueryInstance];
+    const bool enablePrimaryHitReuse = queryInstance.GetParameters().enablePrimaryHitReuse;
+    const uint32_t hitNumX = width / queryInstance.GetParameters().downscaleFactor;
+    const uint32_t hitNumY = height / queryInstance.GetParameters().downscaleFactor;
+
+    // Hits of the previous frame match the update dispatch only if they were laid out for the same grid of the same scene
+    const bool isValid = m_sharcPrimaryHitsValid && hitNumX == m_sharcPrimaryHitNumX && hitNumY == m_sharcPrimaryHitNumY && !m_sceneReloaded;
+
+    constants.sharcPrimaryHitsValid = enablePrimaryHitReuse && isValid;
+    constants.sharcPrimaryHitNumX = hitNumX;
+    constants.sharcPrimaryHitNumY = hitNumY;
+
+    // Written by the query pass of this frame
+    m_sharcPrimaryHitsValid = enablePrimaryHitReuse;
+    m_sharcPrimaryHitNumX = hitNumX;
+    m_sharcPrimaryHitNumY = hitNumY;
+}
+
+SharcSnapshotDesc Pathtracer::GetSharcSnapshotDesc(const SharcInstance& instance) const
+{
+    // Grid parameters are compile time constants shared with the shaders
+    SharcSnapshotDesc desc;
+    desc.sceneName = std::filesystem::path(m_currentSceneName).filename().string();
+    desc.sceneScale = instance.GetParameters().sceneScale;
+    desc.entriesNum = instance.GetEntriesNum();
+
+    return desc;
+}
+
+std::filesystem::path Pathtracer::GetSharcSnapshotPath(const SharcInstance& instance) const
+{
+    // The default instance keeps the plain name
+    if (&instance == m_sharcInstances.front().get())
+        return std::filesystem::path(m_currentSceneName + ".sharc");
+
+    return std::filesystem::path(m_currentSceneName + "." + instance.GetDesc().name + ".sharc");
+}
+
+void Pathtracer::OpenSharcSnapshots()
+{
+    for (const std::unique_ptr<SharcInstance>& instance : m_sharcInstances)
+    {
+        instance->SetSnapshot(nullptr);
+
+        const std::filesystem::path path = GetSharcSnapshotPath(*instance);
+        if (!m_ui.sharcLoadSnapshot || !std::filesystem::exists(path))
+            continue;
+
+        std::unique_ptr<SharcSnapshotReader> snapshot = std::make_unique<SharcSnapshotReader>();
+        if (!snapshot->Open(path))
+        {
+            log::warning("Failed to open SHaRC snapshot '%s'", path.string().c_str());
+            continue;
+        }
+
+        instance->SetSnapshot(std::move(snapshot));
+    }
+}
+
+void Pathtracer::SaveSharcSnapshots()
+{
+    for (const std::unique_ptr<SharcInstance>& instance : m_sharcInstances)
+    {
+        const std::filesystem::path path = GetSharcSnapshotPath(*instance);
+        if (instance->SaveSnapshot(m_commandList, path, GetSharcSnapshotDesc(*instance)))
+            log::info("Saved SHaRC snapshot '%s'", path.string().c_str());
+        else
+            log::warning("Failed to save SHaRC snapshot '%s'", path.string().c_str());
+    }
+}
+#endif // ENABLE_SHARC
+
 void Pathtracer::BackBufferResizing()
 {
     m_accumulationBuffer = nullptr;
@@ -833,16 +1614,65 @@ void Pathtracer::Render(nvrhi::IFramebuffer* framebuffer)
     nvrhi::IDevice* device = GetDevice();
     const auto& fbInfo = framebuffer->getFramebufferInfo();
 
+    // The window stays responsive while the loading thread runs, the UI draws the progress over a cleared frame. Nothing is
+    // path traced until the whole scene has arrived and its acceleration structures are built in one pass by SceneLoaded()
+    if (IsSceneLoading())
+    {
+        if (!IsSceneLoaded())
+        {
+            m_commandList->open();
+            nvrhi::utils::ClearColorAttachment(m_commandList, framebuffer, 0, nvrhi::Color(0.0f));
+            m_commandList->close();
+            device->executeCommandList(m_commandList);
+
+            return;
+        }
+
+        m_SceneLoadingThread->join();
+        m_SceneLoadingThread = nullptr;
+
+        SceneLoaded();
+    }
+
     m_scene->RefreshSceneGraph(GetFrameIndex());
 
+    m_pipelineWaitTime += WaitForCreation(m_computePipelineCreation);
+
+    // Scratch memory of the per-frame acceleration structure builds comes from chunks sized for the largest frame, the command
+    // list recycles them as frames finish. The memory limit stays at the NVRHI default so a build is never dropped
+    if (m_commandListScratchSize != m_accelStructScratch.GetChunkSize())
+    {
+        nvrhi::CommandListParameters commandListParameters;
+        commandListParameters.scratchChunkSize = m_accelStructScratch.GetChunkSize();
+        m_commandList = device->createCommandList(commandListParameters);
+        m_commandListScratchSize = m_accelStructScratch.GetChunkSize();
+    }
+
     m_commandList->open();
 
+    m_gpuProfiler->BeginFrame();
+    const uint32_t frameTimer = m_gpuProfiler->BeginScope(m_commandList, "Frame");
+
+    // Streamed textures follow the feedback of an earlier frame, the buffers grow with the scene bindless table
+    m_textureStreamer->SetBudgetSize(uint64_t(m_ui.textureBudgetMB) << 20);
+    if (m_textureStreamer->BeginFrame(m_commandList, GetFrameIndex(), m_descriptorTable->GetDescriptorTable()->getCapacity(), m_ui.enableTextureStreaming))
+        m_pathTracerOutputBuffer = nullptr;
+
+#if ENABLE_SHARC
+    // A smaller downscale factor needs more primary hits than the buffer holds
+    if (m_sharcPrimaryHitsBuffer && m_sharcPrimaryHitsBuffer->getDesc().byteSize < (fbInfo.width / m_ui.sharcDownscaleFactor) * (fbInfo.height / m_ui.sharcDownscaleFactor) * sizeof(SharcPrimaryHit))
+        m_pathTracerOutputBuffer = nullptr;
+#endif // ENABLE_SHARC
+
     if (!m_pathTracerOutputBuffer || m_rebuildAS)
     {
         device->waitForIdle();
 
+        // Cached binding sets reference the resources replaced below
+        m_bindingCache->Clear();
+
         if (m_rebuildAS)
-            CreateAccelStructs(m_commandList);
+            CreateAccelStructs();
 
         nvrhi::TextureDesc desc;
         desc.width = fbInfo.width;
@@ -854,7 +1684,11 @@ void Pathtracer::Render(nvrhi::IFramebuffer* framebuffer)
         desc.debugName = "PathTracerOutput";
         m_pathTracerOutputBuffer = device->createTexture(desc);
 
-        // TODO: create this binding set if something changes, like the scene
+#if ENABLE_SHARC
+        CreateSharcTileSchedule(fbInfo.width, fbInfo.height);
+        CreateSharcPrimaryHits(fbInfo.width, fbInfo.height);
+#endif // ENABLE_SHARC
+
         nvrhi::BindingSetDesc bindingSetDesc;
         bindingSetDesc.bindings = {
             nvrhi::BindingSetItem::ConstantBuffer(0, m_constantBuffer),
@@ -865,9 +1699,16 @@ void Pathtracer::Render(nvrhi::IFramebuffer* framebuffer)
             nvrhi::BindingSetItem::StructuredBuffer_SRV(3, m_scene->GetMaterialBuffer()),
             nvrhi::BindingSetItem::Sampler(0, m_CommonPasses->m_AnisotropicWrapSampler),
             nvrhi::BindingSetItem::Texture_UAV(0, m_pathTracerOutputBuffer),
+            nvrhi::BindingSetItem::StructuredBuffer_UAV(3, m_textureStreamer->GetFeedbackBuffer()),
+            nvrhi::BindingSetItem::StructuredBuffer_SRV(5, m_textureStreamer->GetSlotBuffer()),
+#if ENABLE_SHARC
+            nvrhi::BindingSetItem::StructuredBuffer_UAV(1, m_sharcTileStatsBuffer),
+            nvrhi::BindingSetItem::StructuredBuffer_UAV(2, m_sharcPrimaryHitsBuffer),
+            nvrhi::BindingSetItem::StructuredBuffer_SRV(4, m_sharcTileRayOffsetsBuffer),
+#endif // ENABLE_SHARC
         };
 
-        m_globalBindingSet = device->createBindingSet(bindingSetDesc, m_globalBindingLayout);
+        m_globalBindingSet = m_bindingCache->GetOrCreateBindingSet(bindingSetDesc, m_globalBindingLayout);
     }
     m_rebuildAS = false;
 
@@ -946,39 +1787,72 @@ void Pathtracer::Render(nvrhi::IFramebuffer* framebuffer)
         nrcContextSettings.smallestResolvableFeatureSize = 0.01f;
         // nrcContextSettings.collectAccurateLoss = false;
 
-        if (nrcContextSettings != m_nrcContextSettings)
+        // The buffers are sized for a capacity with headroom, most changes only reconfigure NRC with the buffers it has
+        NrcCapacity nrcRequest;
+        nrcRequest.width = nrcContextSettings.frameDimensions.x;
+        nrcRequest.height = nrcContextSettings.frameDimensions.y;
+        nrcRequest.samplesPerPixel = nrcContextSettings.samplesPerPixel;
+        nrcRequest.maxPathVertices = nrcContextSettings.maxPathVertices;
+        const NrcCapacityAction nrcCapacityAction = m_nrcCapacityPolicy.Update(GetFrameIndex(), nrcRequest);
+
+        if (nrcContextSettings != m_nrcContextSettings || nrcCapacityAction == NrcCapacityAction::Reallocate)
         {
+            const NrcCapacity& nrcCapacity = m_nrcCapacityPolicy.GetCapacity();
+            nrc::ContextSettings nrcCapacitySettings = nrcContextSettings;
+            nrcCapacitySettings.frameDimensions = { nrcCapacity.width, nrcCapacity.height };
+            nrcCapacitySettings.trainingDimensions = nrc::ComputeIdealTrainingDimensions(nrcCapacitySettings.frameDimensions, 0);
+            nrcCapacitySettings.samplesPerPixel = nrcCapacity.samplesPerPixel;
+            nrcCapacitySettings.maxPathVertices = nrcCapacity.maxPathVertices;
+
             // The context settings have changed, so we need to re-configure NRC
-            m_nrc->Configure(nrcContextSettings);
+            const bool nrcBuffersCreated = m_nrc->Configure(nrcContextSettings, nrcCapacitySettings);
             m_nrcContextSettings = nrcContextSettings;
 
-            // Create NVRHI binding set
-            nvrhi::BindingSetDesc bindingSetDesc;
-            bindingSetDesc.bindings = {
-                nvrhi::BindingSetItem::StructuredBuffer_UAV(0, m_nrc->m_bufferHandles[nrc::BufferIdx::QueryPathInfo]),
-                nvrhi::BindingSetItem::StructuredBuffer_UAV(1, m_nrc->m_bufferHandles[nrc::BufferIdx::TrainingPathInfo]),
-                nvrhi::BindingSetItem::StructuredBuffer_UAV(2, m_nrc->m_bufferHandles[nrc::BufferIdx::TrainingPathVertices]),
-                nvrhi::BindingSetItem::StructuredBuffer_UAV(3, m_nrc->m_bufferHandles[nrc::BufferIdx::QueryRadianceParams]),
-                nvrhi::BindingSetItem::StructuredBuffer_UAV(4, m_nrc->m_bufferHandles[nrc::BufferIdx::Counter]),
-                nvrhi::BindingSetItem::StructuredBuffer_UAV(5, m_nrc->m_bufferHandles[nrc::BufferIdx::DebugTrainingPathInfo]),
-            };
-            m_nrcBindingSet = device->createBindingSet(bindingSetDesc, m_nrcBindingLayout);
+            if (nrcBuffersCreated || !m_nrcBindingSet)
+            {
+                // Create NVRHI binding set. Not from the binding cache, which would keep the replaced NRC buffers alive
+                nvrhi::BindingSetDesc bindingSetDesc;
+                bindingSetDesc.bindings = {
+                    nvrhi::BindingSetItem::StructuredBuffer_UAV(0, m_nrc->m_bufferHandles[nrc::BufferIdx::QueryPathInfo]),
+                    nvrhi::BindingSetItem::StructuredBuffer_UAV(1, m_nrc->m_bufferHandles[nrc::BufferIdx::TrainingPathInfo]),
+                    nvrhi::BindingSetItem::StructuredBuffer_UAV(2, m_nrc->m_bufferHandles[nrc::BufferIdx::TrainingPathVertices]),
+                    nvrhi::BindingSetItem::StructuredBuffer_UAV(3, m_nrc->m_bufferHandles[nrc::BufferIdx::QueryRadianceParams]),
+                    nvrhi::BindingSetItem::StructuredBuffer_UAV(4, m_nrc->m_bufferHandles[nrc::BufferIdx::Counter]),
+                    nvrhi::BindingSetItem::StructuredBuffer_UAV(5, m_nrc->m_bufferHandles[nrc::BufferIdx::DebugTrainingPathInfo]),
+                };
+                m_nrcBindingSet = GetDevice()->createBindingSet(bindingSetDesc, m_nrcBindingLayout);
+            }
         }
 
+        // The training budget scales the training work set in the UI
+        UpdateNrcTrainingBudget();
+        NrcTrainingBudget nrcTrainingBudget;
+        if (m_ui.nrcEnableTrainingBudget)
+            nrcTrainingBudget = m_nrcTrainingBudget.GetBudget();
+        else
+            nrcTrainingBudget.iterationNum = m_ui.nrcNumTrainingIterations;
+
         // Settings expected to change frequently that do not require instance reset
         nrc::FrameSettings nrcPerFrameSettings;
         nrcPerFrameSettings.maxExpectedAverageRadianceValue = m_ui.nrcMaxAverageRadiance;
         nrcPerFrameSettings.terminationHeuristicThreshold = m_ui.nrcTerminationHeuristicThreshold;
         nrcPerFrameSettings.trainingTerminationHeuristicThreshold = m_ui.nrcTerminationHeuristicThreshold;
-        nrcPerFrameSettings.numTrainingIterations = m_ui.nrcNumTrainingIterations;
+        nrcPerFrameSettings.numTrainingIterations = nrcTrainingBudget.iterationNum;
         nrcPerFrameSettings.resolveMode = m_ui.nrcResolveMode;
         nrcPerFrameSettings.trainTheCache = m_ui.nrcTrainCache;
-        nrcPerFrameSettings.proportionPrimarySegmentsToTrainOn = m_ui.nrcProportionPrimarySegmentsToTrainOn;
+        nrcPerFrameSettings.proportionPrimarySegmentsToTrainOn = m_ui.nrcProportionPrimarySegmentsToTrainOn * nrcTrainingBudget.primarySegmentScale;
         nrcPerFrameSettings.proportionTertiaryPlusSegmentsToTrainOn = m_ui.nrcProportionTertiaryPlusSegmentsToTrainOn;
         nrcPerFrameSettings.proportionUnbiasedToSelfTrain = m_ui.nrcProportionUnbiasedToSelfTrain;
         nrcPerFrameSettings.proportionUnbiased = m_ui.nrcProportionUnbiased;
         nrcPerFrameSettings.selfTrainingAttenuation = m_ui.nrcSelfTrainingAttenuation;
         nrcPerFrameSettings.usedTrainingDimensions = nrc::ComputeIdealTrainingDimensions(nrcContextSettings.frameDimensions, nrcPerFrameSettings.numTrainingIterations);
+        if (nrcTrainingBudget.dimensionScale < 1.0f)
+        {
+            // The scale applies to the area, the aspect ratio is kept
+            const float axisScale = sqrtf(nrcTrainingBudget.dimensionScale);
+            nrcPerFrameSettings.usedTrainingDimensions.x = std::max(uint32_t(nrcPerFrameSettings.usedTrainingDimensions.x * axisScale), 1u);
+            nrcPerFrameSettings.usedTrainingDimensions.y = std::max(uint32_t(nrcPerFrameSettings.usedTrainingDimensions.y * axisScale), 1u);
+        }
         m_nrcUsedTrainingWidth = nrcPerFrameSettings.usedTrainingDimensions.x;
         m_nrcUsedTrainingHeight = nrcPerFrameSettings.usedTrainingDimensions.y;
 
@@ -990,35 +1864,40 @@ void Pathtracer::Render(nvrhi::IFramebuffer* framebuffer)
     constants.sharcRoughnessThreshold = 0.0f;
 
 #if ENABLE_SHARC
-    if (m_ui.techSelection == TechSelection::Sharc)
-    {
-        static float3 sharcCameraPosition = m_view.GetViewOrigin();
-        static float3 sharcCameraPositionPrev = m_view.GetViewOrigin();
+    UpdateSharcInstances();
 
-        constants.sharcEntriesNum = m_sharcEntriesNum;
-        constants.sharcDownscaleFactor = m_ui.sharcDownscaleFactor;
-        constants.sharcSceneScale = m_ui.sharcSceneScale;
-        constants.sharcRoughnessThreshold = m_ui.sharcRoughnessThreshold;
-        constants.sharcCameraPositionPrev.xyz() = sharcCameraPositionPrev;
-        constants.sharcCameraPosition.xyz() = sharcCameraPosition;
-        constants.sharcAccumulationFrameNum = m_ui.sharcAccumulationFrameNum;
-        constants.sharcStaleFrameNum = m_ui.sharcStaleFrameFrameNum;
-        constants.sharcEnableAntifirefly = m_ui.sharcEnableAntiFireflyFilter;
-
-        if (m_ui.sharcEnableUpdate && m_ui.sharcUpdateViewCamera)
+    // An uploaded snapshot replaces the whole cache state, large snapshots take a few frames
+    bool sharcSnapshotUploaded[m_sharcMaxInstanceNum] = {};
+    for (uint32_t instanceIndex = 0; instanceIndex < m_sharcInstances.size(); ++instanceIndex)
+    {
+        SharcInstance& instance = *m_sharcInstances[instanceIndex];
+        if (instance.HasSnapshot() && m_ui.techSelection == TechSelection::Sharc && m_ui.sharcEnableUpdate)
         {
-            sharcCameraPositionPrev = sharcCameraPosition;
-            sharcCameraPosition = m_view.GetViewOrigin();
+            ScopedMarker scopedMarker(m_commandList, "SharcSnapshotUpload", m_gpuProfiler.get());
+            sharcSnapshotUploaded[instanceIndex] = instance.UploadSnapshot(m_commandList, GetFrameIndex(), GetSharcSnapshotDesc(instance));
         }
     }
+
+    UpdateSharcCapacity();
+
+    SharcInstance& sharcQueryInstance = *m_sharcInstances[m_ui.sharcQueryInstance];
+
+    if (m_ui.techSelection == TechSelection::Sharc)
+    {
+        sharcQueryInstance.FillConstants(constants);
+        UpdateSharcTileSchedule(constants, fbInfo.width, fbInfo.height);
+        UpdateSharcPrimaryHits(constants, fbInfo.width, fbInfo.height);
+    }
+    else
+    {
+        m_sharcPrimaryHitsValid = false;
+    }
 #endif // ENABLE_SHARC
 
     static bool enableNrd = false;
     bool skipDenoiser = m_ui.ptDebugOutput != PTDebugOutputType::None;
 #if ENABLE_NRD
     bool resetDenoiser = enableNrd != (m_ui.denoiserSelection == DenoiserSelection::Nrd);
-    if (resetDenoiser && !skipDenoiser)
-        CreateRayTracingPipelines();
 
     if ((m_ui.denoiserSelection == DenoiserSelection::Nrd) && !m_nrd)
     {
@@ -1073,6 +1952,7 @@ void Pathtracer::Render(nvrhi::IFramebuffer* framebuffer)
     globalConstants.enableBackFaceCull = m_ui.enableBackFaceCull;
     globalConstants.bouncesMax = m_ui.bouncesMax;
     globalConstants.frameIndex = m_frameIndex++;
+    globalConstants.enableTextureFeedback = m_ui.enableTextureStreaming;
     globalConstants.enableAccumulation = (m_ui.denoiserSelection == DenoiserSelection::Accumulation);
     globalConstants.accumulatedFramesMax = m_resetAccumulation ? 1 : m_ui.accumulatedFramesMax;
     globalConstants.recipAccumulatedFrames = (m_ui.denoiserSelection == DenoiserSelection::Accumulation) ? (1.0f / (float)m_accumulatedFrameCount) : 1.0f;
@@ -1126,6 +2006,7 @@ void Pathtracer::Render(nvrhi::IFramebuffer* framebuffer)
 
     state.bindings[DescriptorSetIDs::Globals] = m_globalBindingSet;
     state.bindings[DescriptorSetIDs::Bindless] = (m_descriptorTable->GetDescriptorTable());
+    state.bindings[DescriptorSetIDs::StreamedTextures] = m_textureStreamer->GetDescriptorTable();
 
 #if ENABLE_NRD
     if (enableNrd)
@@ -1142,9 +2023,10 @@ void Pathtracer::Render(nvrhi::IFramebuffer* framebuffer)
 #if ENABLE_NRC
     if (m_ui.techSelection == TechSelection::Nrc)
     {
-        ScopedMarker scopedMarker(m_commandList, "Nrc");
+        ScopedMarker scopedMarker(m_commandList, "Nrc", m_gpuProfiler.get());
 
         runReferencePathTracer = false;
+        m_nrcStats->BeginFrame(GetFrameIndex());
 
         assert(m_nrcBindingSet);
         state.bindings[DescriptorSetIDs::Nrc] = m_nrcBindingSet;
@@ -1153,11 +2035,11 @@ void Pathtracer::Render(nvrhi::IFramebuffer* framebuffer)
             // ScopedMarker scopedMarker(m_commandList, "NrcUpdateAndQueryRT");
 
             // NRC query pathtracing pass
-            ScopedMarker scopedMarker(m_commandList, "NrcQueryPathtracingPass");
+            ScopedMarker scopedMarker(m_commandList, "NrcQueryPathtracingPass", m_gpuProfiler.get());
             if (m_denoiserBindingSet && enableNrd)
                 state.bindings[DescriptorSetIDs::Denoiser] = m_denoiserBindingSet;
 
-            state.shaderTable = m_pipelinePermutations[PipelineType::NRC_Query].shaderTable;
+            state.shaderTable = GetPipelinePermutation(PipelineType::NRC_Query, enableNrd).shaderTable;
             m_commandList->setRayTracingState(state);
             args.width = fbInfo.width;
             args.height = fbInfo.height;
@@ -1171,10 +2053,10 @@ void Pathtracer::Render(nvrhi::IFramebuffer* framebuffer)
             // NRC update pathtracing pass
             if (m_ui.nrcTrainCache)
             {
-                ScopedMarker scopedMarker(m_commandList, "NrcUpdatePathtracingPass");
+                ScopedMarker scopedMarker(m_commandList, "NrcUpdatePathtracingPass", m_gpuProfiler.get());
 
                 state.bindings[DescriptorSetIDs::Denoiser] = m_dummyBindingSets[DescriptorSetIDs::Denoiser];
-                state.shaderTable = m_pipelinePermutations[PipelineType::NRC_Update].shaderTable;
+                state.shaderTable = GetPipelinePermutation(PipelineType::NRC_Update, false).shaderTable;
                 m_commandList->setRayTracingState(state);
                 args.width = m_nrcUsedTrainingWidth;
                 args.height = m_nrcUsedTrainingHeight;
@@ -1184,15 +2066,23 @@ void Pathtracer::Render(nvrhi::IFramebuffer* framebuffer)
         }
 
         {
-            ScopedMarker scopedMarker(m_commandList, "NrcQueryPropagateTrain");
-            m_nrc->QueryAndTrain(m_commandList, m_ui.nrcCalculateTrainingLoss);
+            ScopedMarker scopedMarker(m_commandList, "NrcQueryPropagateTrain", m_gpuProfiler.get());
+
+            // The SDK waits for the GPU to return the loss, it is only evaluated every few frames
+            const bool calculateTrainingLoss = m_ui.nrcCalculateTrainingLoss && (GetFrameIndex() % m_ui.nrcTrainingLossInterval == 0);
+            const float trainingLoss = m_nrc->QueryAndTrain(m_commandList, calculateTrainingLoss);
+            if (calculateTrainingLoss)
+                m_nrcStats->SetTrainingLoss(trainingLoss);
         }
 
         if (m_ui.ptDebugOutput == PTDebugOutputType::None)
         {
-            ScopedMarker scopedMarker(m_commandList, "NrcResolve");
+            ScopedMarker scopedMarker(m_commandList, "NrcResolve", m_gpuProfiler.get());
             m_nrc->Resolve(m_commandList, m_pathTracerOutputBuffer);
         }
+
+        m_nrcStats->RecordCounters(m_commandList, m_nrc->m_bufferHandles[nrc::BufferIdx::Counter]);
+        m_nrcStats->SetMemorySize(m_nrc->GetCurrentMemoryConsumption());
     }
 
     // Reset heap
@@ -1202,114 +2092,84 @@ void Pathtracer::Render(nvrhi::IFramebuffer* framebuffer)
 #if ENABLE_SHARC
     if (m_ui.techSelection == TechSelection::Sharc)
     {
-        ScopedMarker scopedMarker(m_commandList, "Sharc");
+        ScopedMarker scopedMarker(m_commandList, "Sharc", m_gpuProfiler.get());
 
         runReferencePathTracer = false;
 
-        state.bindings[DescriptorSetIDs::Sharc] = m_sharcBindingSet;
-
+        // All instances are updated in this command list, constants are rewritten for each of them
         if (m_ui.sharcEnableUpdate)
         {
-            if (m_ui.sharcEnableClear || m_sceneReloaded)
+            for (uint32_t instanceIndex = 0; instanceIndex < m_sharcInstances.size(); ++instanceIndex)
             {
-                m_commandList->clearBufferUInt(m_sharcHashEntriesBuffer, m_sharcInvalidEntry);
-                m_commandList->clearBufferUInt(m_sharcCopyOffsetBuffer, 0);
-                m_commandList->clearBufferUInt(m_sharcVoxelDataBuffer, 0);
-                m_commandList->clearBufferUInt(m_sharcVoxelDataBufferPrev, 0);
-            }
+                SharcInstance& instance = *m_sharcInstances[instanceIndex];
 
-            if (m_ui.sharcEnableResolve)
-            {
-                std::swap(m_sharcVoxelDataBuffer, m_sharcVoxelDataBufferPrev);
-                std::swap(m_sharcBindingSet, m_sharcBindingSetSwapped);
+                // Entries of a partially uploaded snapshot would collide with the ones inserted by the update
+                if (instance.IsSnapshotUploading())
+                    continue;
 
-                m_commandList->clearBufferUInt(m_sharcVoxelDataBuffer, 0);
-            }
+                const bool clear = ((m_ui.sharcEnableClear || m_sceneReloaded) && !sharcSnapshotUploaded[instanceIndex]) || instance.IsClearRequired();
 
-            // SHARC update
-            {
-                // Update never uses denoiser; set to dummy.
-                state.bindings[DescriptorSetIDs::Denoiser] = m_dummyBindingSets[DescriptorSetIDs::Denoiser];
-                state.bindings[DescriptorSetIDs::Sharc] = m_sharcBindingSet;
-
-                state.shaderTable = m_pipelinePermutations[PipelineType::Sharc_Update].shaderTable;
-                m_commandList->setRayTracingState(state);
-
-                nvrhi::rt::DispatchRaysArguments args;
-                args.width = fbInfo.width / m_ui.sharcDownscaleFactor;
-                args.height = fbInfo.height / m_ui.sharcDownscaleFactor;
-
-                ScopedMarker scopedMarker(m_commandList, "SharcUpdate");
-                m_commandList->dispatchRays(args);
+                RenderSharcInstance(instance, clear, constants, state, fbInfo.width, fbInfo.height);
             }
 
-            if (m_ui.sharcEnableResolve)
-            {
-                nvrhi::ComputeState computeState;
-                // Unified Binding
-                if (m_api == nvrhi::GraphicsAPI::D3D12)
-                    computeState.bindings = { m_globalBindingSet, m_sharcBindingSet };
-                else
-                    computeState.bindings = { m_globalBindingSet, m_dummyBindingSets[1], m_dummyBindingSets[2], m_sharcBindingSet };
-
-                // SHARC resolve
-                {
-                    computeState.pipeline = m_sharcResolvePSO;
-                    m_commandList->setComputeState(computeState);
-
-                    const uint groupSize = 256;
-                    const dm::uint2 dispatchSize = { DivideRoundUp(m_sharcEntriesNum, groupSize), 1 };
-
-                    ScopedMarker scopedMarker(m_commandList, "SharcResolve");
-                    m_commandList->dispatch(dispatchSize.x, dispatchSize.y);
-                }
-
-                // SHARC compaction
-                {
-                    computeState.pipeline = m_sharcHashCopyPSO;
-                    m_commandList->setComputeState(computeState);
-
-                    const uint groupSize = 256;
-                    const dm::uint2 dispatchSize = { DivideRoundUp(m_sharcEntriesNum, groupSize), 1 };
-                    ScopedMarker scopedMarker(m_commandList, "SharcCompaction");
-                    m_commandList->dispatch(dispatchSize.x, dispatchSize.y);
-                }
-            }
+            sharcQueryInstance.FillConstants(constants);
+            m_commandList->writeBuffer(m_constantBuffer, &constants, sizeof(constants));
         }
 
+        state.bindings[DescriptorSetIDs::Sharc] = sharcQueryInstance.GetBindingSet();
+
         // Unified Binding
         if (m_denoiserBindingSet && enableNrd)
             state.bindings[DescriptorSetIDs::Denoiser] = m_denoiserBindingSet;
 
         // SHARC query
         {
-            state.shaderTable = m_pipelinePermutations[PipelineType::Sharc_Query].shaderTable;
+            state.shaderTable = GetPipelinePermutation(PipelineType::Sharc_Query, enableNrd).shaderTable;
             m_commandList->setRayTracingState(state);
 
             nvrhi::rt::DispatchRaysArguments args;
             args.width = fbInfo.width;
             args.height = fbInfo.height;
-            ScopedMarker scopedMarker(m_commandList, "SharcQuery");
+            ScopedMarker scopedMarker(m_commandList, "SharcQuery", m_gpuProfiler.get());
             m_commandList->dispatchRays(args);
         }
+
+        // Tile counters of this query are consumed by the schedule a few frames later
+        if (m_ui.sharcTileSchedule)
+        {
+            SharcTileStatsReadback& readback = m_sharcTileStatsReadbacks[GetFrameIndex() % m_sharcReadbackLatency];
+            m_commandList->copyBuffer(readback.buffer, 0, m_sharcTileStatsBuffer, 0, readback.buffer->getDesc().byteSize);
+            readback.pending = true;
+        }
+
+        // Resized tables take over on the next frame, the camera history advances after the query as well
+        for (const std::unique_ptr<SharcInstance>& instance : m_sharcInstances)
+        {
+            instance->FinishRehash();
+
+            if (m_ui.sharcEnableUpdate && m_ui.sharcUpdateViewCamera)
+                instance->UpdateCamera(m_view.GetViewOrigin());
+        }
     }
 #endif // ENABLE_SHARC
 
     if (runReferencePathTracer)
     {
-        state.shaderTable = m_pipelinePermutations[PipelineType::DefaultPathTracing].shaderTable;
+        state.shaderTable = GetPipelinePermutation(PipelineType::DefaultPathTracing, enableNrd).shaderTable;
         m_commandList->setRayTracingState(state);
 
         nvrhi::rt::DispatchRaysArguments args;
         args.width = fbInfo.width;
         args.height = fbInfo.height;
-        ScopedMarker scopedMarker(m_commandList, "ReferencePathTracer");
+        ScopedMarker scopedMarker(m_commandList, "ReferencePathTracer", m_gpuProfiler.get());
         m_commandList->dispatchRays(args);
     }
 
 #if ENABLE_NRD
     if (enableNrd)
     {
+        ScopedMarker scopedMarker(m_commandList, "Denoiser", m_gpuProfiler.get());
+
         // Denoiser data packing
         {
             nvrhi::ComputeState computeState;
@@ -1323,7 +2183,7 @@ void Pathtracer::Render(nvrhi::IFramebuffer* framebuffer)
         }
 
         nrd::ReblurSettings reblurSettings = NrdConfig::GetDefaultREBLURSettings();
-        m_nrd->RunDenoiserPasses(m_commandList, *m_renderTargets, 0, m_view, m_viewPrevious, GetFrameIndex(), 0.01f, 0.05f, false, false, &reblurSettings, resetDenoiser);
+        m_nrd->RunDenoiserPasses(m_commandList, *m_renderTargets, 0, m_view, m_viewPrevious, GetFrameIndex(), 0.01f, 0.05f, false, false, &reblurSettings, resetDenoiser, m_gpuProfiler.get());
 
         // Denoiser resolve
         {
@@ -1341,6 +2201,8 @@ void Pathtracer::Render(nvrhi::IFramebuffer* framebuffer)
 
     // Accumulation and tonemapping
     {
+        ScopedMarker scopedMarker(m_commandList, "Tonemapping", m_gpuProfiler.get());
+
         if (!m_accumulationBuffer)
         {
             nvrhi::TextureDesc desc;
@@ -1373,7 +2235,8 @@ void Pathtracer::Render(nvrhi::IFramebuffer* framebuffer)
         bindingSetDesc.bindings = { nvrhi::BindingSetItem::ConstantBuffer(0, m_debugBuffer), nvrhi::BindingSetItem::Texture_UAV(0, m_pathTracerOutputBuffer),
                                     nvrhi::BindingSetItem::Texture_UAV(1, m_accumulationBuffer) };
 
-        m_tonemappingBindingSet = device->createBindingSet(bindingSetDesc, m_tonemappingBindingLayout);
+        // Only created again after a resize, the cache returns the same set every other frame
+        m_tonemappingBindingSet = m_bindingCache->GetOrCreateBindingSet(bindingSetDesc, m_tonemappingBindingLayout);
 
         nvrhi::GraphicsState state;
         state.pipeline = m_tonemappingPSO;
@@ -1389,12 +2252,43 @@ void Pathtracer::Render(nvrhi::IFramebuffer* framebuffer)
         m_commandList->draw(args);
     }
 
+    m_textureStreamer->EndFrame(m_commandList);
+
+    m_gpuProfiler->EndScope(m_commandList, frameTimer);
+
     m_commandList->close();
     device->executeCommandList(m_commandList);
 
+    m_gpuProfiler->EndFrame();
+
+    // Resolved timings trail the submitted frame by a few frames
+    if (m_ui.logProfiler && GetFrameIndex() % 300 == 0)
+    {
+        for (const FrameProfilerScope& scope : m_gpuProfiler->GetFrameProfiler().GetScopes())
+            log::info("%*s%s: %.3f ms GPU, %.3f ms CPU", scope.depth * 2, "", scope.name.c_str(), scope.gpuTime * 1e3, scope.cpuTime * 1e3);
+    }
+
+#if ENABLE_SHARC
+    // The frame has been submitted, its resolved voxel data matches the hash entries
+    if (m_ui.sharcSaveSnapshot)
+    {
+        m_ui.sharcSaveSnapshot = false;
+        if (m_ui.techSelection == TechSelection::Sharc)
+            SaveSharcSnapshots();
+    }
+#endif // ENABLE_SHARC
+
     m_resetAccumulation = false;
     m_sceneReloaded = false;
 
+    // Cold start time, the wait shows how much of it pipeline creation on the background threads didn't hide
+    if (!m_firstFrameLogged)
+    {
+        m_firstFrameLogged = true;
+        const double startupTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_startupTime).count();
+        log::info("First frame after %.2f s, %.1f ms of it waiting for pipeline creation", startupTime, m_pipelineWaitTime * 1e3);
+    }
+
 #if ENABLE_NRC
     if (m_ui.techSelection == TechSelection::Nrc)
     {
@@ -1402,10 +2296,22 @@ void Pathtracer::Render(nvrhi::IFramebuffer* framebuffer)
             m_nrc->EndFrame(device->getNativeQueue(nvrhi::ObjectTypes::D3D12_CommandQueue, nvrhi::CommandQueue::Graphics));
         else if (m_api == nvrhi::GraphicsAPI::VULKAN)
             m_nrc->EndFrame(device->getNativeQueue(nvrhi::ObjectTypes::VK_Queue, nvrhi::CommandQueue::Graphics));
+
+        m_nrcStats->EndFrame();
     }
 #endif // ENABLE_NRC
 }
 
+const GpuProfiler& Pathtracer::GetGpuProfiler() const
+{
+    return *m_gpuProfiler;
+}
+
+const TextureStreamer& Pathtracer::GetTextureStreamer() const
+{
+    return *m_textureStreamer;
+}
+
 std::shared_ptr<donut::engine::ShaderFactory> Pathtracer::GetShaderFactory()
 {
     return m_shaderFactory;
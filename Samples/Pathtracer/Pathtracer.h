@@ -18,7 +18,15 @@
 #include <donut/engine/Scene.h>
 #include <donut/engine/View.h>
 
+#include <chrono>
+#include <future>
+
+#include "AccelStructBuildSizes.h"
+#include "GpuProfiler.h"
 #include "PathtracerUi.h"
+#include "ScratchUsageTracker.h"
+#include "TextureStreamer.h"
+#include "TlasInstanceTable.h"
 
 // Unified Binding
 struct DescriptorSetIDs
@@ -30,31 +38,28 @@ struct DescriptorSetIDs
         Nrc,
         Sharc,
         Bindless,
+        StreamedTextures,
         COUNT
     };
 };
 
+#if ENABLE_NRC
+#include "NrcCapacityPolicy.h"
+#include "NrcStatsReadback.h"
+#include "NrcTrainingBudgetController.h"
+#endif // ENABLE_NRC
+
+#if ENABLE_SHARC
+#include "SharcInstance.h"
+#include "SharcMemoryBudget.h"
+#include "SharcTileScheduler.h"
+#endif // ENABLE_SHARC
+
 #if ENABLE_NRD
 #include "RenderTargets.h"
 #include "NrdIntegration.h"
 #endif // ENABLE_NRD
 
-class ScopedMarker
-{
-public:
-    ScopedMarker(nvrhi::ICommandList* commandList, const char* name) : m_commandList(commandList)
-    {
-        m_commandList->beginMarker(name);
-    }
-    ~ScopedMarker()
-    {
-        m_commandList->endMarker();
-    }
-
-private:
-    nvrhi::ICommandList* m_commandList;
-};
-
 class Pathtracer : public donut::app::ApplicationBase
 {
 public:
@@ -81,6 +86,7 @@ public:
     std::string GetCurrentSceneName() const;
     void SetPreferredSceneName(const std::string& sceneName);
     void SetCurrentSceneName(const std::string& sceneName);
+    double GetSceneLoadingTime() const;
 
     void CopyActiveCameraToFirstPerson();
 
@@ -94,21 +100,33 @@ public:
     bool MouseButtonUpdate(int button, int action, int mods) override;
     bool MouseScrollUpdate(double xoffset, double yoffset) override;
 
-    bool CreateRayTracingPipeline(donut::engine::ShaderFactory& shaderFactory, PipelinePermutation& pipelinePermutation, std::vector<donut::engine::ShaderMacro>& pipelineMacros);
+    bool LoadRayTracingShaderLibrary(donut::engine::ShaderFactory& shaderFactory, PipelinePermutation& pipelinePermutation, std::vector<donut::engine::ShaderMacro>& pipelineMacros);
+    void CreateRayTracingPipeline(PipelinePermutation& pipelinePermutation, const std::vector<donut::engine::ShaderMacro>& pipelineMacros);
     bool CreateRayTracingPipelines();
+    void CreateComputePipelines();
 
 #if ENABLE_NRC
     NrcIntegration* GetNrcInstance() const;
+    const NrcStatsReadback& GetNrcStats() const;
+    const NrcCapacityPolicy& GetNrcCapacityPolicy() const;
+    const NrcTrainingBudgetController& GetNrcTrainingBudget() const;
 #endif
 
+#if ENABLE_SHARC
+    const std::vector<std::unique_ptr<SharcInstance>>& GetSharcInstances() const;
+#endif // ENABLE_SHARC
+
     void GetMeshBlasDesc(donut::engine::MeshInfo& mesh, nvrhi::rt::AccelStructDesc& blasDesc, bool skipTransmissiveMaterials) const;
-    void CreateAccelStructs(nvrhi::ICommandList* commandList);
-    void BuildTLAS(nvrhi::ICommandList* commandList, uint32_t frameIndex) const;
+    void CreateAccelStructs();
+    void UpdateSkinnedBlasState(uint32_t skinnedIndex, const nvrhi::rt::AccelStructDesc& blasDesc);
+    void BuildTLAS(nvrhi::ICommandList* commandList, uint32_t frameIndex);
 
     void BackBufferResizing() override;
 
     void Render(nvrhi::IFramebuffer* framebuffer) override;
 
+    const GpuProfiler& GetGpuProfiler() const;
+    const TextureStreamer& GetTextureStreamer() const;
     std::shared_ptr<donut::engine::ShaderFactory> GetShaderFactory();
     std::shared_ptr<donut::vfs::IFileSystem> GetRootFS() const;
 
@@ -139,8 +157,19 @@ private:
         Count
     };
 
-    std::vector<donut::engine::ShaderMacro> m_pipelineMacros[PipelineType::Count];
-    PipelinePermutation m_pipelinePermutations[PipelineType::Count];
+    // Every pipeline type without and with the denoiser outputs, the pipelines are created on background threads at startup
+    std::vector<donut::engine::ShaderMacro> m_pipelineMacros[PipelineType::Count][2];
+    PipelinePermutation m_pipelinePermutations[PipelineType::Count][2];
+    std::future<void> m_pipelineCreation[PipelineType::Count][2];
+
+    const PipelinePermutation& GetPipelinePermutation(PipelineType pipelineType, bool enableDenoiser);
+
+    std::future<void> m_computePipelineCreation;
+
+    // Cold start to first frame, logged with the time the main thread waited for the pipelines
+    std::chrono::steady_clock::time_point m_startupTime = std::chrono::steady_clock::now();
+    double m_pipelineWaitTime = 0.0;
+    bool m_firstFrameLogged = false;
 
     nvrhi::CommandListHandle m_commandList;
     nvrhi::BindingLayoutHandle m_globalBindingLayout;
@@ -153,6 +182,28 @@ private:
     nvrhi::ShaderHandle m_tonemappingPS;
 
     nvrhi::rt::AccelStructHandle m_topLevelAS;
+
+    // Persistent TLAS instances, only changed instances are uploaded and moved instances are refit
+    TlasInstanceTable m_tlasInstanceTable = TlasInstanceTable(TlasInstanceTableDesc());
+    std::vector<nvrhi::rt::InstanceDesc> m_tlasInstances;
+    nvrhi::BufferHandle m_tlasInstanceBuffer;
+
+    // Skinned BLAS built with other build flags or opaque geometry flags than the current ones can't be refit
+    struct SkinnedBlasState
+    {
+        uint32_t refitNum = 0;
+        nvrhi::rt::AccelStructBuildFlags buildFlags = nvrhi::rt::AccelStructBuildFlags::None;
+        std::vector<nvrhi::rt::GeometryFlags> geometryFlags;
+        AccelStructBuildSizes sizes;
+    };
+
+    // Refits since the last full build and driver reported sizes of every skinned BLAS
+    std::vector<SkinnedBlasState> m_skinnedBlasStates;
+    AccelStructBuildSizes m_tlasSizes;
+
+    // Scratch memory requested by the per-frame acceleration structure builds, sizes the scratch chunks of the command list
+    ScratchUsageTracker m_accelStructScratch = ScratchUsageTracker(256);
+    uint64_t m_commandListScratchSize = 0;
     bool m_rebuildAS = true;
     int m_cameraIndex = -1;
 
@@ -164,6 +215,7 @@ private:
 
     std::vector<std::string> m_sceneFilesAvailable;
     std::string m_currentSceneName;
+    std::chrono::steady_clock::time_point m_sceneLoadingStartTime;
     std::shared_ptr<donut::engine::Scene> m_scene;
 
     nvrhi::TextureHandle m_accumulationBuffer;
@@ -177,6 +229,8 @@ private:
     std::shared_ptr<donut::engine::PointLight> m_headLight;
 
     std::unique_ptr<donut::engine::BindingCache> m_bindingCache;
+    std::unique_ptr<GpuProfiler> m_gpuProfiler;
+    std::unique_ptr<TextureStreamer> m_textureStreamer;
 
     bool m_enableAnimations = false;
     float m_wallclockTime = 0.0f;
@@ -194,28 +248,77 @@ private:
 #if ENABLE_NRC
     std::unique_ptr<NrcIntegration> m_nrc;
     nrc::ContextSettings m_nrcContextSettings;
+    NrcCapacityPolicy m_nrcCapacityPolicy;
     int m_nrcUsedTrainingWidth = 0;
     int m_nrcUsedTrainingHeight = 0;
     nrc::BuffersAllocationInfo m_nrcBuffersAllocation;
     nvrhi::BindingLayoutHandle m_nrcBindingLayout;
     nvrhi::BindingSetHandle m_nrcBindingSet;
+    std::unique_ptr<NrcStatsReadback> m_nrcStats;
+    std::unique_ptr<NrcStatsCsvSink> m_nrcStatsSink;
+    NrcTrainingBudgetController m_nrcTrainingBudget;
+    std::unique_ptr<NrcLogFileSink> m_nrcLogFileSink;
+    std::unique_ptr<NrcLogJsonSink> m_nrcLogJsonSink;
+#endif // ENABLE_NRC
+
+#if ENABLE_NRC
+    void UpdateNrcTrainingBudget();
 #endif // ENABLE_NRC
 
 #if ENABLE_SHARC
-    static const uint32_t m_sharcInvalidEntry = 0;
-    uint32_t m_sharcEntriesNum = 0;
-    nvrhi::BufferHandle m_sharcHashEntriesBuffer;
-    nvrhi::BufferHandle m_sharcCopyOffsetBuffer;
-    nvrhi::BufferHandle m_sharcVoxelDataBuffer;
-    nvrhi::BufferHandle m_sharcVoxelDataBufferPrev;
+    void UpdateSharcInstances();
+    void UpdateSharcCapacity();
+    void RenderSharcInstance(SharcInstance& instance, bool clear, LightingConstants& constants, nvrhi::rt::State& state, uint32_t width, uint32_t height);
+
+    void CreateSharcTileSchedule(uint32_t width, uint32_t height);
+    void UpdateSharcTileSchedule(LightingConstants& constants, uint32_t width, uint32_t height);
+    void CreateSharcPrimaryHits(uint32_t width, uint32_t height);
+    void UpdateSharcPrimaryHits(LightingConstants& constants, uint32_t width, uint32_t height);
+
+    SharcSnapshotDesc GetSharcSnapshotDesc(const SharcInstance& instance) const;
+    std::filesystem::path GetSharcSnapshotPath(const SharcInstance& instance) const;
+    void OpenSharcSnapshots();
+    void SaveSharcSnapshots();
+
+    // Independent caches updated in one command list, the first one is the default cache
+    static const uint32_t m_sharcMaxInstanceNum = 4;
+    std::vector<std::unique_ptr<SharcInstance>> m_sharcInstances;
 
     nvrhi::BindingLayoutHandle m_sharcBindingLayout;
-    nvrhi::BindingSetHandle m_sharcBindingSet;
-    nvrhi::BindingSetHandle m_sharcBindingSetSwapped;
     nvrhi::ShaderHandle m_sharcResolveCS;
     nvrhi::ComputePipelineHandle m_sharcResolvePSO;
     nvrhi::ShaderHandle m_sharcHashCopyCS;
     nvrhi::ComputePipelineHandle m_sharcHashCopyPSO;
+
+    // Live entry list, used with SHARC_ENABLE_LIVE_ENTRY_LIST
+    nvrhi::BufferHandle m_sharcIndirectArgsBuffer;
+    nvrhi::ShaderHandle m_sharcPrepareIndirectCS;
+    nvrhi::ComputePipelineHandle m_sharcPrepareIndirectPSO;
+
+    // Update ray schedule, tile counters of the query pass are read back with a few frames of latency
+    struct SharcTileStatsReadback
+    {
+        nvrhi::BufferHandle buffer;
+        bool pending = false;
+    };
+
+    static const uint32_t m_sharcReadbackLatency = 3;
+    std::unique_ptr<SharcTileScheduler> m_sharcTileScheduler;
+    std::vector<uint32_t> m_sharcTileRayOffsets;
+    nvrhi::BufferHandle m_sharcTileStatsBuffer;
+    nvrhi::BufferHandle m_sharcTileRayOffsetsBuffer;
+    SharcTileStatsReadback m_sharcTileStatsReadbacks[m_sharcReadbackLatency];
+
+    // Primary hits written by the query pass and consumed by the update pass of the next frame
+    nvrhi::BufferHandle m_sharcPrimaryHitsBuffer;
+    bool m_sharcPrimaryHitsValid = false;
+    uint32_t m_sharcPrimaryHitNumX = 0;
+    uint32_t m_sharcPrimaryHitNumY = 0;
+
+    // Adaptive capacity, requires the live entry list
+    nvrhi::BindingLayoutHandle m_sharcRehashBindingLayout;
+    nvrhi::ShaderHandle m_sharcRehashCS;
+    nvrhi::ComputePipelineHandle m_sharcRehashPSO;
 #endif // ENABLE_SHARC
 
 #if ENABLE_NRD
@@ -27,6 +27,8 @@
 #include "PathtracerUtils.h"
 
 #include "SharcCommon.h"
+#include "SharcLiveEntries.h"
+#include "SharcTileSchedule.h"
 
 #define BOUNCES_MIN                     3
 #define RIS_CANDIDATES_LIGHTS           8 // Number of candidates used for resampling of analytical lights
@@ -62,11 +64,15 @@ StructuredBuffer<GeometryData>                  t_GeometryData
 StructuredBuffer<MaterialConstants>             t_MaterialConstants                     : register(t3, space0);
 
 RWTexture2D<float4>                             u_Output                                : register(u0, space0);
+RWStructuredBuffer<SharcPrimaryHit>             u_SharcPrimaryHits                      : register(u2, space0);
+RWStructuredBuffer<uint>                        u_TextureFeedback                       : register(u3, space0); // Finest mip needed per scene texture
+StructuredBuffer<TextureStreamingSlot>          t_TextureStreamingSlots                 : register(t5, space0);
 SamplerState                                    s_MaterialSampler                       : register(s0, space0);
 
 // reg, dset
 VK_BINDING(0, 4) ByteAddressBuffer               t_BindlessBuffers[]                     : register(t0, space1);
 VK_BINDING(1, 4) Texture2D                       t_BindlessTextures[]                    : register(t0, space2);
+VK_BINDING(0, 5) Texture2D                       t_StreamedTextures[]                    : register(t0, space5);
 
 #if ENABLE_NRD
 RWTexture2D<float4>             u_OutputDiffuseHitDistance                              : register(u0, space1);
@@ -94,6 +100,20 @@ RWStructuredBuffer<uint>        u_HashCopyOffsetBuffer          : register(u1, s
 RWStructuredBuffer<uint4>       u_SharcVoxelDataBuffer          : register(u2, space3);
 RWStructuredBuffer<uint4>       u_SharcVoxelDataBufferPrev      : register(u3, space3);
 
+// The query pass keeps the primary hit of one pixel in every downscaleFactor x downscaleFactor block,
+// the pixel changes every frame. The update pass of the next frame starts its paths from these hits
+bool SharcGetPrimaryHitIndex(uint2 pixel, uint frameIndex, out uint hitIndex)
+{
+    const uint downscaleFactor = g_Lighting.sharcDownscaleFactor;
+    const uint2 block = pixel / downscaleFactor;
+    hitIndex = block.y * g_Lighting.sharcPrimaryHitNumX + block.x;
+
+    uint rngState = InitRNG(uint2(0, 0), uint2(1, 1), frameIndex);
+    const uint2 offset = min(uint2(float2(Rand(rngState), Rand(rngState)) * downscaleFactor), downscaleFactor - 1);
+
+    return all(pixel - block * downscaleFactor == offset) && all(block < uint2(g_Lighting.sharcPrimaryHitNumX, g_Lighting.sharcPrimaryHitNumY));
+}
+
 RayDesc GeneratePinholeCameraRay(float2 normalisedDeviceCoordinate, float4x4 viewToWorld, float4x4 viewToClip)
 {
     // Set up the ray
@@ -324,7 +344,8 @@ void AnyHit(inout RayPayload payload : SV_RayPayload, in Attributes attrib : SV_
 {
     GeometrySample geometry = getGeometryFromHit(InstanceID(), PrimitiveIndex(), GeometryIndex(), attrib.uv, GeomAttr_TexCoord, t_InstanceData, t_GeometryData, t_MaterialConstants);
 
-    MaterialSample material = SampleGeometryMaterial(geometry, 0, 0, 0, MatAttr_All, s_MaterialSampler, t_BindlessTextures);
+    MaterialSample material = SampleGeometryMaterial(geometry, 0, 0, 0, TEXTURE_FEEDBACK_DISABLED, MatAttr_All, s_MaterialSampler, t_BindlessTextures,
+        t_StreamedTextures, t_TextureStreamingSlots, u_TextureFeedback);
 
     switch (geometry.material.domain)
     {
@@ -360,7 +381,8 @@ void AnyHitShadow(inout ShadowRayPayload payload : SV_RayPayload, in Attributes
 {
     GeometrySample geometry = getGeometryFromHit(InstanceID(), PrimitiveIndex(), GeometryIndex(), attrib.uv, GeomAttr_TexCoord, t_InstanceData, t_GeometryData, t_MaterialConstants);
 
-    MaterialSample material = SampleGeometryMaterial(geometry, 0, 0, 0, MatAttr_All, s_MaterialSampler, t_BindlessTextures);
+    MaterialSample material = SampleGeometryMaterial(geometry, 0, 0, 0, TEXTURE_FEEDBACK_DISABLED, MatAttr_All, s_MaterialSampler, t_BindlessTextures,
+        t_StreamedTextures, t_TextureStreamingSlots, u_TextureFeedback);
 
     switch (geometry.material.domain)
     {
@@ -511,10 +533,28 @@ void PathTraceRays()
 
         float2 pixel = float2(launchIndex);
         pixel += (g_Global.enableJitter || isUpdatePass) ? float2(Rand(rngState), Rand(rngState)) : 0.5f.xx;
-        RayDesc ray = GeneratePinholeCameraRay(pixel / launchDimensions,
+        float2 pixelNum = launchDimensions;
+
+#if SHARC_UPDATE
+        // Update rays are distributed over full resolution tiles by the miss rate of the query pass
+        if (g_Lighting.sharcEnableTileSchedule)
+        {
+            pixelNum = g_Lighting.updatePassView.viewportSize;
+            pixel = SharcTileSchedulePixel(launchIndex.y * launchDimensions.x + launchIndex.x, pixelNum,
+                g_Lighting.sharcTileSize, g_Lighting.sharcTileNumX, g_Lighting.sharcTileNum, g_Global.frameIndex);
+        }
+#endif // SHARC_UPDATE
+
+        RayDesc ray = GeneratePinholeCameraRay(pixel / pixelNum,
             isUpdatePass ? g_Lighting.updatePassView.matViewToWorld : g_Lighting.view.matViewToWorld,
             isUpdatePass ? g_Lighting.updatePassView.matViewToClip : g_Lighting.view.matViewToClip);
 
+        // Ray cone of the pixel for the texture mip feedback, written by a rotating subset of the pixels to keep the atomics cheap
+        const float4x4 viewToClip = isUpdatePass ? g_Lighting.updatePassView.matViewToClip : g_Lighting.view.matViewToClip;
+        const float pixelSpreadAngle = atan(2.0f / (viewToClip[1][1] * pixelNum.y));
+        const bool writeTextureFeedback = g_Global.enableTextureFeedback && (sampleIndex == 0) && ((launchIndex.x + launchIndex.y * 4 + g_Global.frameIndex) % 16 == 0);
+        float pathLength = 0.0f;
+
         float3 sampleRadiance = float3(0.0f, 0.0f, 0.0f);
         float3 throughput = float3(1.0f, 1.0f, 1.0f);
 
@@ -523,6 +563,7 @@ void PathTraceRays()
         float hitDistance = 0.0f; // Used by denoiser
 
         bool internalRay = false;
+        bool sharcLookupDone = false;
 
         RayPayload payload;
         payload.hitDistance = -1.0f;
@@ -540,8 +581,41 @@ void PathTraceRays()
             rayFlags &= (~RAY_FLAG_CULL_BACK_FACING_TRIANGLES);
 #endif // DISABLE_BACK_FACE_CULLING
 
+#if SHARC_UPDATE
+            // The first segment was traced by the query pass of the previous frame
+            if (bounce == 0 && g_Lighting.sharcEnablePrimaryHitReuse && g_Lighting.sharcPrimaryHitsValid)
+            {
+                const SharcPrimaryHit primaryHit = u_SharcPrimaryHits[launchIndex.y * launchDimensions.x + launchIndex.x];
+                ray.Origin = primaryHit.rayOrigin;
+                ray.Direction = primaryHit.rayDirection;
+
+                payload.hitDistance = primaryHit.hitDistance;
+                payload.instanceID = primaryHit.instanceID;
+                payload.primitiveIndex = primaryHit.primitiveIndex;
+                payload.geometryIndex = primaryHit.geometryIndex;
+                payload.barycentrics = primaryHit.barycentrics;
+            }
+            else
+#endif // SHARC_UPDATE
             TraceRay(SceneBVH, rayFlags, 0xFF, 0, 0, 0, ray, payload);
 
+#if SHARC_QUERY
+            uint primaryHitIndex;
+            if (bounce == 0 && sampleIndex == 0 && g_Lighting.sharcEnablePrimaryHitReuse && SharcGetPrimaryHitIndex(launchIndex, g_Global.frameIndex, primaryHitIndex))
+            {
+                SharcPrimaryHit primaryHit;
+                primaryHit.rayOrigin = ray.Origin;
+                primaryHit.hitDistance = payload.hitDistance;
+                primaryHit.rayDirection = ray.Direction;
+                primaryHit.instanceID = payload.instanceID;
+                primaryHit.primitiveIndex = payload.primitiveIndex;
+                primaryHit.geometryIndex = payload.geometryIndex;
+                primaryHit.barycentrics = payload.barycentrics;
+
+                u_SharcPrimaryHits[primaryHitIndex] = primaryHit;
+            }
+#endif // SHARC_QUERY
+
 #if SHARC_UPDATE
             // When updating SHaRC, we're only interested in one path segment at a time
             // (SHaRC handles the propagation of radiance along the path)
@@ -572,7 +646,13 @@ void PathTraceRays()
             }
 
             GeometrySample geometry = getGeometryFromHit(payload.instanceID, payload.primitiveIndex, payload.geometryIndex, payload.barycentrics, GeomAttr_All, t_InstanceData, t_GeometryData, t_MaterialConstants);
-            MaterialSample material = SampleGeometryMaterial(geometry, 0, 0, 0, MatAttr_All, s_MaterialSampler, t_BindlessTextures);
+
+            // The cone keeps the pixel spread along the whole path, it ignores the curvature of the surfaces it bounced off
+            pathLength += payload.hitDistance;
+            const float feedbackLodBase = writeTextureFeedback ? GetRayConeLodBase(geometry, ray.Direction, pathLength * pixelSpreadAngle) : TEXTURE_FEEDBACK_DISABLED;
+
+            MaterialSample material = SampleGeometryMaterial(geometry, 0, 0, 0, feedbackLodBase, MatAttr_All, s_MaterialSampler, t_BindlessTextures,
+                t_StreamedTextures, t_TextureStreamingSlots, u_TextureFeedback);
             material.emissiveColor = g_Global.enableEmissives ? material.emissiveColor : 0;
 
             if (material.hasMetalRoughParams)
@@ -638,7 +718,14 @@ void PathTraceRays()
                 isValidHit &= footrprint > voxelSize;
 
                 float3 sharcRadiance;
-                if (isValidHit && SharcGetCachedRadiance(sharcParameters, sharcHitData, sharcRadiance, false))
+                const bool isCached = isValidHit && SharcGetCachedRadiance(sharcParameters, sharcHitData, sharcRadiance, false);
+
+                // First lookup of the path feeds the update ray schedule
+                if (isValidHit && !sharcLookupDone && g_Lighting.sharcEnableTileSchedule && sampleIndex == 0)
+                    SharcTileStatsAdd(launchIndex, g_Lighting.sharcTileSize, g_Lighting.sharcTileNumX, !isCached);
+                sharcLookupDone |= isValidHit;
+
+                if (isCached)
                 {
                     sampleRadiance += sharcRadiance * throughput;
 
@@ -707,7 +794,14 @@ void PathTraceRays()
             if (nrcProgressState == NrcProgressState::TerminateAfterDirectLighting)
                 break;
 
-            if (!SharcUpdateHit(sharcParameters, sharcState, sharcHitData, sampleRadiance, Rand(rngState)))
+            const bool continueTracing = SharcUpdateHit(sharcParameters, sharcState, sharcHitData, sampleRadiance, Rand(rngState));
+
+#if SHARC_UPDATE && SHARC_ENABLE_LIVE_ENTRY_LIST
+            // SharcUpdateHit() stores the index of the inserted entry first
+            SharcLiveEntryAppend(sharcState.cacheIndices[0]);
+#endif // SHARC_UPDATE && SHARC_ENABLE_LIVE_ENTRY_LIST
+
+            if (!continueTracing)
                 break;
 
             // Russian roulette
@@ -869,7 +963,8 @@ void PathTraceRays()
 
             if (g_Global.debugOutputMode == 1 /* DiffuseReflectance */)
             {
-                MaterialSample material = SampleGeometryMaterial(geometry, 0, 0, 0, MatAttr_All, s_MaterialSampler, t_BindlessTextures);
+                MaterialSample material = SampleGeometryMaterial(geometry, 0, 0, 0, TEXTURE_FEEDBACK_DISABLED, MatAttr_All, s_MaterialSampler, t_BindlessTextures,
+                    t_StreamedTextures, t_TextureStreamingSlots, u_TextureFeedback);
                 debugColor = material.diffuseAlbedo;
             }
             else if (g_Global.debugOutputMode == 2 /* WorldSpaceNormals */)
@@ -894,7 +989,8 @@ void PathTraceRays()
             }
             else if (g_Global.debugOutputMode == 7 /* Emissives */)
             {
-                MaterialSample material = SampleGeometryMaterial(geometry, 0, 0, 0, MatAttr_All, s_MaterialSampler, t_BindlessTextures);
+                MaterialSample material = SampleGeometryMaterial(geometry, 0, 0, 0, TEXTURE_FEEDBACK_DISABLED, MatAttr_All, s_MaterialSampler, t_BindlessTextures,
+                    t_StreamedTextures, t_TextureStreamingSlots, u_TextureFeedback);
                 debugColor = material.emissiveColor;
             }
             else if (g_Global.debugOutputMode == 8 /* Heat map */)
@@ -75,9 +75,9 @@ void PathtracerUI::buildUI(void)
 
         char messageBuffer[256];
         const auto& stats = Scene::GetLoadingStats();
-        snprintf(messageBuffer, std::size(messageBuffer), "Loading scene %s, please wait...\nObjects: %d/%d, Textures: %d/%d", m_app.GetCurrentSceneName().c_str(),
+        snprintf(messageBuffer, std::size(messageBuffer), "Loading scene %s, please wait...\nObjects: %d/%d, Textures: %d/%d, %.1f s", m_app.GetCurrentSceneName().c_str(),
                  stats.ObjectsLoaded.load(), stats.ObjectsTotal.load(), m_app.GetTextureCache()->GetNumberOfLoadedTextures(),
-                 m_app.GetTextureCache()->GetNumberOfRequestedTextures());
+                 m_app.GetTextureCache()->GetNumberOfRequestedTextures(), m_app.GetSceneLoadingTime());
 
         DrawScreenCenteredText(messageBuffer);
 
@@ -142,6 +142,16 @@ void PathtracerUI::buildUI(void)
                 else
                     m_app.DisableAnimations();
             }
+
+            // Skinned BLAS are refit between full builds, 1 builds them every frame
+            ImGui::SliderInt("Skinned BLAS Rebuild Interval", &m_ui.skinnedBlasRebuildInterval, 1, 256);
+
+            // Streamed textures keep the mips the path tracer asked for within the budget, the rest of the mips stay in system memory
+            updateAccum |= ImGui::Checkbox("Texture Streaming", &m_ui.enableTextureStreaming);
+            ImGui::SliderInt("Texture Budget (MB)", &m_ui.textureBudgetMB, 64, 8192);
+
+            const TextureResidencyPlanner& texturePlanner = m_app.GetTextureStreamer().GetPlanner();
+            ImGui::Text("Streamed textures: %u, %.1f MB resident", texturePlanner.GetTextureNum(), texturePlanner.GetResidentSize() / (1024.0 * 1024.0));
         }
         ImGui::Indent(-12.0f);
     }
@@ -233,12 +243,82 @@ void PathtracerUI::buildUI(void)
             updateAccum |= ImGui::SliderFloat("Self-Training Attenuation", &m_ui.nrcSelfTrainingAttenuation, 0.0f, 1.0f, "%.3f");
             updateAccum |= ImGui::SliderFloat("Heuristic Threshold", &m_ui.nrcTerminationHeuristicThreshold, 0.0f, 0.25f, "%.3f");
             updateAccum |= ImGui::SliderInt("Num Training Iterations", &m_ui.nrcNumTrainingIterations, 1, 4);
+
+            // Overrides the training iterations, and scales the training dimensions and primary segments
+            ImGui::Checkbox("Training Budget", &m_ui.nrcEnableTrainingBudget);
+            ImGui::SameLine();
+            ImGui::SliderFloat("Budget (ms)", &m_ui.nrcTrainingBudgetMs, 0.1f, 10.0f, "%.2f");
+            if (m_ui.nrcEnableTrainingBudget)
+            {
+                const NrcTrainingBudgetController& trainingBudget = m_app.GetNrcTrainingBudget();
+                const NrcTrainingBudget& budget = trainingBudget.GetBudget();
+                ImGui::Text("Training %.2f ms, effort %.2f (max %.2f)", trainingBudget.GetLastTime(), budget.effort, trainingBudget.GetMaxEffort());
+                ImGui::Text("%u iterations, %.0f%% dimensions, %.0f%% primary segments", budget.iterationNum, budget.dimensionScale * 100.0f, budget.primarySegmentScale * 100.0f);
+            }
             updateAccum |= ImGui::SliderFloat("Primary segments to train on", &m_ui.nrcProportionPrimarySegmentsToTrainOn, 0.0f, 1.0f, "%.2f");
             updateAccum |= ImGui::SliderFloat("Tertiary+ segments to train on", &m_ui.nrcProportionTertiaryPlusSegmentsToTrainOn, 0.0f, 1.0f, "%.2f");
             updateAccum |= ImGui::SliderFloat("Proportion unbiased", &m_ui.nrcProportionUnbiased, 0.0f, 1.0f, "%.2f");
             updateAccum |= ImGui::SliderFloat("Unbiased self-training", &m_ui.nrcProportionUnbiasedToSelfTrain, 0.0f, 1.0f, "%.2f");
             updateAccum |= ImGui::SliderFloat("Max Average Radiance Value", &m_ui.nrcMaxAverageRadiance, 0.001f, 1000.0f);
             updateAccum |= ImGui::Combo("Resolve Mode", (int*)&m_ui.nrcResolveMode, nrc::GetImGuiResolveModeComboString());
+
+            ImGui::Checkbox("Training Loss (stalls)", &m_ui.nrcCalculateTrainingLoss);
+            ImGui::SameLine();
+            ImGui::SliderInt("Loss Interval", &m_ui.nrcTrainingLossInterval, 1, 240);
+
+            // Read back a few frames late, the values belong to the frame shown in the label
+            const NrcStatsRing& statsRing = m_app.GetNrcStats().GetRing();
+            const std::deque<NrcFrameStats>& statsHistory = statsRing.GetHistory();
+            if (!statsHistory.empty())
+            {
+                const NrcFrameStats& stats = statsHistory.back();
+                ImGui::Text("Frame %llu: %.1f MB", (unsigned long long)stats.frameIndex, stats.memorySize / (1024.0 * 1024.0));
+
+                std::string counters = "Counters:";
+                for (uint32_t counterIndex = 0; counterIndex < stats.counterNum; ++counterIndex)
+                    counters += " " + std::to_string(stats.counters[counterIndex]);
+                ImGui::TextUnformatted(counters.c_str());
+            }
+
+            std::vector<float> trainingLosses;
+            for (const NrcFrameStats& stats : statsHistory)
+            {
+                if (stats.hasTrainingLoss)
+                    trainingLosses.push_back(stats.trainingLoss);
+            }
+
+            if (!trainingLosses.empty())
+            {
+                const std::string lossText = "Loss " + std::to_string(trainingLosses.back());
+                ImGui::PlotLines("##TrainingLoss", trainingLosses.data(), int(trainingLosses.size()), 0, lossText.c_str(), 0.0f, FLT_MAX, ImVec2(0.0f, 60.0f));
+            }
+
+            ImGui::Text("Stats frames read: %llu, dropped: %llu", (unsigned long long)statsRing.GetReadFrameNum(), (unsigned long long)statsRing.GetDroppedFrameNum());
+
+            // Settings within the capacity reconfigure NRC without recreating its buffers
+            const NrcCapacityPolicy& capacityPolicy = m_app.GetNrcCapacityPolicy();
+            const NrcCapacity& capacity = capacityPolicy.GetCapacity();
+            ImGui::Text("Buffer capacity: %ux%u, %u spp, %u vertices", capacity.width, capacity.height, capacity.samplesPerPixel, capacity.maxPathVertices);
+            ImGui::Text("Reallocations: %u, reconfigurations: %u", capacityPolicy.GetReallocationNum(), capacityPolicy.GetReconfigurationNum());
+
+            // Takes effect for new allocations, the existing ones are returned where they came from
+            NrcCpuAllocator& cpuAllocator = GetNrcCpuAllocator();
+            int cpuAllocatorMode = int(cpuAllocator.GetMode());
+            if (ImGui::Combo("CPU Allocator", &cpuAllocatorMode, "System\0Pools\0Pools + Frame Arena\0\0"))
+                cpuAllocator.SetMode(NrcAllocatorMode(cpuAllocatorMode));
+
+            for (uint32_t tagIndex = 0; tagIndex < uint32_t(NrcAllocationTag::Count); ++tagIndex)
+            {
+                const NrcAllocationTag tag = NrcAllocationTag(tagIndex);
+                const NrcAllocationTagStats stats = cpuAllocator.GetTagStats(tag);
+                ImGui::Text("%s: %llu live, %.1f KB, peak %.1f KB", NrcCpuAllocator::GetTagName(tag), (unsigned long long)stats.liveAllocationNum, stats.liveSize / 1024.0,
+                    stats.peakSize / 1024.0);
+            }
+            ImGui::Text("CPU reserved: %.1f MB", cpuAllocator.GetReservedSize() / (1024.0 * 1024.0));
+
+            const NrcLogQueue& logQueue = GetNrcLogQueue();
+            ImGui::Text("Log records written: %llu, dropped: %llu", (unsigned long long)logQueue.GetWrittenNum(),
+                (unsigned long long)(logQueue.GetDroppedNum() + logQueue.GetRateLimitedNum()));
         }
         ImGui::Indent(-12.0f);
     }
@@ -262,6 +342,24 @@ void PathtracerUI::buildUI(void)
             updateAccum |= ImGui::SliderInt("Downscale Factor", &m_ui.sharcDownscaleFactor, 1, 10);
             updateAccum |= ImGui::SliderFloat("Scene Scale", &m_ui.sharcSceneScale, 5.0f, 100.0f);
             updateAccum |= ImGui::SliderFloat("Rougness Threshold", &m_ui.sharcRoughnessThreshold, 0.0f, 1.0f);
+            ImGui::Checkbox("Adaptive Capacity", &m_ui.sharcAdaptiveCapacity);
+            updateAccum |= ImGui::Checkbox("Update Tile Schedule", &m_ui.sharcTileSchedule);
+            updateAccum |= ImGui::Checkbox("Reuse Query Primary Hits", &m_ui.sharcReusePrimaryHits);
+            ImGui::Checkbox("Load Snapshot On Scene Load", &m_ui.sharcLoadSnapshot);
+            if (ImGui::Button("Save Snapshot"))
+                m_ui.sharcSaveSnapshot = true;
+            updateAccum |= ImGui::Checkbox("Coarse Instance", &m_ui.sharcCoarseInstance);
+            if (m_ui.sharcCoarseInstance)
+                updateAccum |= ImGui::SliderInt("Query Instance", &m_ui.sharcQueryInstance, 0, 1);
+            ImGui::SliderInt("Memory Budget (MB)", &m_ui.sharcMemoryBudget, 64, 4096);
+            for (const std::unique_ptr<SharcInstance>& instance : m_app.GetSharcInstances())
+            {
+                const SharcCapacityController& capacityController = instance->GetCapacityController();
+                ImGui::Text("%s: %u entries (%.1f%% occupied), %.1f MB", instance->GetDesc().name.c_str(), instance->GetEntriesNum(),
+                            capacityController.GetLastOccupancy() * 100.0f, instance->GetMemorySize() / (1024.0f * 1024.0f));
+                if (capacityController.IsRehashing())
+                    ImGui::Text("Resizing to %u entries", capacityController.GetTargetEntriesNum());
+            }
         }
         ImGui::Indent(-12.0f);
     }
@@ -327,6 +425,26 @@ void PathtracerUI::buildUI(void)
             ImGui::Indent(-12.0f);
         }
     }
+
+    // Profiler
+    {
+        ImGui::Separator();
+        if (ImGui::CollapsingHeader("Profiler:"))
+        {
+            ImGui::Indent(12.0f);
+
+            ImGui::Checkbox("Log Pass Times", &m_ui.logProfiler);
+
+            const FrameProfiler& frameProfiler = m_app.GetGpuProfiler().GetFrameProfiler();
+            for (const FrameProfilerScope& scope : frameProfiler.GetScopes())
+                ImGui::Text("%*s%s: %.3f ms GPU, %.3f ms CPU", scope.depth * 2, "", scope.name.c_str(), scope.gpuTime * 1e3, scope.cpuTime * 1e3);
+
+            if (frameProfiler.GetDroppedFrameNum())
+                ImGui::Text("Frames dropped: %llu", (unsigned long long)frameProfiler.GetDroppedFrameNum());
+
+            ImGui::Indent(-12.0f);
+        }
+    }
     ImGui::End();
 
     if (updateAccum)
@@ -74,6 +74,9 @@ struct UIData
     int bouncesMax = 8;
     int accumulatedFrames = 1;
     int accumulatedFramesMax = 128;
+    int skinnedBlasRebuildInterval = 16;
+    bool enableTextureStreaming = false; // Textures are uploaded in full before streaming can take mips out
+    int textureBudgetMB = 512;
     float exposureAdjustment = 0.0f;
     float roughnessMin = 0.0f;
     float roughnessMax = 1.0f;
@@ -92,6 +95,7 @@ struct UIData
     int samplesPerPixel = 1;
     int targetLight = 0;
     bool enableTonemapping = true;
+    bool logProfiler = false;
 
     TechSelection techSelection = TechSelection::None;
     DenoiserSelection denoiserSelection = DenoiserSelection::Accumulation;
@@ -106,7 +110,8 @@ struct UIData
     bool nrcIncludeDirectIllumination = true;
     bool nrcTrainCache = true;
     int nrcMaxTrainingBounces = 8;
-    bool nrcCalculateTrainingLoss = false;
+    bool nrcCalculateTrainingLoss = false; // Off by default, QueryAndTrain waits for the GPU to return the loss
+    int nrcTrainingLossInterval = 30; // Frames, every loss evaluation waits for the GPU
     float nrcMaxAverageRadiance = 1.0f;
     NrcResolveMode nrcResolveMode = NrcResolveMode::AddQueryResultToOutput;
     // TODO: Following settings will not be exposed
@@ -123,6 +128,10 @@ struct UIData
     bool nrcSkipDeltaVertices = false;
     float nrcTerminationHeuristicThreshold = 0.01f;
     int nrcNumTrainingIterations = 1;
+
+    // Adjusts the training iterations, dimensions and primary segments to hold the training passes at the budget
+    bool nrcEnableTrainingBudget = false;
+    float nrcTrainingBudgetMs = 2.0f;
 #endif // ENABLE_NRC
 
 #if ENABLE_SHARC
@@ -132,6 +141,14 @@ struct UIData
     bool sharcEnableAntiFireflyFilter = true;
     bool sharcUpdateViewCamera = true;
     bool sharcEnableDebug = false;
+    bool sharcAdaptiveCapacity = true;
+    bool sharcLoadSnapshot = true;
+    bool sharcSaveSnapshot = false;
+    bool sharcTileSchedule = true;
+    bool sharcReusePrimaryHits = false;
+    bool sharcCoarseInstance = false;
+    int sharcQueryInstance = 0;
+    int sharcMemoryBudget = 2048; // MB, shared by all instances
     int sharcDownscaleFactor = 5;
     float sharcSceneScale = 50.0f;
     int sharcAccumulationFrameNum = 10;
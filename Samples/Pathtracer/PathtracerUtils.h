@@ -232,64 +232,128 @@ enum MaterialAttributes
     MatAttr_All = 0x1F
 };
 
+// Matches TextureStreamer::Slot, one per scene texture
+struct TextureStreamingSlot
+{
+    uint descriptorIndex; // Into the streamed textures, TEXTURE_NOT_STREAMED for the scene texture
+    uint residentMip; // Mip of the full chain that is mip 0 of the streamed texture
+};
+
+#define TEXTURE_NOT_STREAMED 0xFFFFFFFF
+
+// Pass as the feedback LOD base to skip the mip feedback
+#define TEXTURE_FEEDBACK_DISABLED FLT_MAX
+
+// Texture LOD of a ray cone hit without the texture size term, log2(sqrt(width * height)) of the texture is added per texture.
+// Based on "Texture Level of Detail Strategies for Real-Time Ray Tracing" (Akenine-Moller et al.)
+float GetRayConeLodBase(GeometrySample gs, float3 rayDirection, float coneWidth)
+{
+    const float3 edge0 = mul(gs.instance.transform, float4(gs.vertexPositions[1] - gs.vertexPositions[0], 0.0f)).xyz;
+    const float3 edge1 = mul(gs.instance.transform, float4(gs.vertexPositions[2] - gs.vertexPositions[0], 0.0f)).xyz;
+    const float worldArea = length(cross(edge0, edge1));
+
+    const float2 texcoordEdge0 = gs.vertexTexcoords[1] - gs.vertexTexcoords[0];
+    const float2 texcoordEdge1 = gs.vertexTexcoords[2] - gs.vertexTexcoords[0];
+    const float texcoordArea = abs(texcoordEdge0.x * texcoordEdge1.y - texcoordEdge0.y * texcoordEdge1.x);
+
+    const float cosine = abs(dot(rayDirection, gs.flatNormal));
+    if (worldArea <= 0.0f || texcoordArea <= 0.0f || coneWidth <= 0.0f || cosine <= 0.0f)
+        return TEXTURE_FEEDBACK_DISABLED;
+
+    return 0.5f * log2(texcoordArea / worldArea) + log2(coneWidth) - log2(cosine);
+}
+
+float4 SampleMaterialTexture(Texture2D materialTexture, SamplerState materialSampler, float2 texcoord, float2 texGrad_x, float2 texGrad_y, float mipLevel, uint residentMip)
+{
+    // The streamed texture starts at the resident mip, gradients already select its mips
+    if (mipLevel >= 0)
+        return materialTexture.SampleLevel(materialSampler, texcoord, max(mipLevel - residentMip, 0.0f));
+    else
+        return materialTexture.SampleGrad(materialSampler, texcoord, texGrad_x, texGrad_y);
+}
+
+float4 SampleMaterialTexture(int textureIndex,
+                             float2 texcoord,
+                             float2 texGrad_x,
+                             float2 texGrad_y,
+                             float mipLevel,
+                             float feedbackLodBase,
+                             SamplerState materialSampler,
+                             Texture2D bindlessTextures[],
+                             Texture2D streamedTextures[],
+                             StructuredBuffer<TextureStreamingSlot> streamingSlots,
+                             RWStructuredBuffer<uint> textureFeedback)
+{
+    const TextureStreamingSlot slot = streamingSlots[textureIndex];
+
+    float4 value;
+    uint width, height;
+    if (slot.descriptorIndex != TEXTURE_NOT_STREAMED)
+    {
+        Texture2D streamedTexture = streamedTextures[NonUniformResourceIndex(slot.descriptorIndex)];
+        value = SampleMaterialTexture(streamedTexture, materialSampler, texcoord, texGrad_x, texGrad_y, mipLevel, slot.residentMip);
+        streamedTexture.GetDimensions(width, height);
+    }
+    else
+    {
+        Texture2D sceneTexture = bindlessTextures[NonUniformResourceIndex(textureIndex)];
+        value = SampleMaterialTexture(sceneTexture, materialSampler, texcoord, texGrad_x, texGrad_y, mipLevel, 0);
+        sceneTexture.GetDimensions(width, height);
+    }
+
+    // Finest mip the hit needs, the streamer keeps it resident if the budget allows
+    if (feedbackLodBase != TEXTURE_FEEDBACK_DISABLED)
+    {
+        const float textureSize = float(width << slot.residentMip) * float(height << slot.residentMip);
+        const float lod = clamp(feedbackLodBase + 0.5f * log2(textureSize), 0.0f, 31.0f);
+        InterlockedMin(textureFeedback[textureIndex], uint(lod));
+    }
+
+    return value;
+}
+
 MaterialSample SampleGeometryMaterial(GeometrySample gs,
                                       float2 texGrad_x,
                                       float2 texGrad_y,
                                       float mipLevel, // <-- Use a compile time constant for mipLevel, < 0 for aniso filtering
+                                      float feedbackLodBase, // <-- GetRayConeLodBase(), TEXTURE_FEEDBACK_DISABLED to skip the mip feedback
                                       MaterialAttributes attributes,
                                       SamplerState materialSampler,
-                                      Texture2D bindlessTextures[])
+                                      Texture2D bindlessTextures[],
+                                      Texture2D streamedTextures[],
+                                      StructuredBuffer<TextureStreamingSlot> streamingSlots,
+                                      RWStructuredBuffer<uint> textureFeedback)
 {
     MaterialTextureSample textures = DefaultMaterialTextures();
 
     if ((attributes & MatAttr_BaseColor) && (gs.material.baseOrDiffuseTextureIndex >= 0) && (gs.material.flags & MaterialFlags_UseBaseOrDiffuseTexture) != 0)
     {
-        Texture2D diffuseTexture = bindlessTextures[NonUniformResourceIndex(gs.material.baseOrDiffuseTextureIndex)];
-
-        if (mipLevel >= 0)
-            textures.baseOrDiffuse = diffuseTexture.SampleLevel(materialSampler, gs.texcoord, mipLevel);
-        else
-            textures.baseOrDiffuse = diffuseTexture.SampleGrad(materialSampler, gs.texcoord, texGrad_x, texGrad_y);
+        textures.baseOrDiffuse = SampleMaterialTexture(gs.material.baseOrDiffuseTextureIndex, gs.texcoord, texGrad_x, texGrad_y, mipLevel, feedbackLodBase,
+            materialSampler, bindlessTextures, streamedTextures, streamingSlots, textureFeedback);
     }
 
     if ((attributes & MatAttr_Emissive) && (gs.material.emissiveTextureIndex >= 0) && (gs.material.flags & MaterialFlags_UseEmissiveTexture) != 0)
     {
-        Texture2D emissiveTexture = bindlessTextures[NonUniformResourceIndex(gs.material.emissiveTextureIndex)];
-
-        if (mipLevel >= 0)
-            textures.emissive = emissiveTexture.SampleLevel(materialSampler, gs.texcoord, mipLevel);
-        else
-            textures.emissive = emissiveTexture.SampleGrad(materialSampler, gs.texcoord, texGrad_x, texGrad_y);
+        textures.emissive = SampleMaterialTexture(gs.material.emissiveTextureIndex, gs.texcoord, texGrad_x, texGrad_y, mipLevel, feedbackLodBase,
+            materialSampler, bindlessTextures, streamedTextures, streamingSlots, textureFeedback);
     }
 
     if ((attributes & MatAttr_Normal) && (gs.material.normalTextureIndex >= 0) && (gs.material.flags & MaterialFlags_UseNormalTexture) != 0)
     {
-        Texture2D normalsTexture = bindlessTextures[NonUniformResourceIndex(gs.material.normalTextureIndex)];
-
-        if (mipLevel >= 0)
-            textures.normal = normalsTexture.SampleLevel(materialSampler, gs.texcoord, mipLevel);
-        else
-            textures.normal = normalsTexture.SampleGrad(materialSampler, gs.texcoord, texGrad_x, texGrad_y);
+        textures.normal = SampleMaterialTexture(gs.material.normalTextureIndex, gs.texcoord, texGrad_x, texGrad_y, mipLevel, feedbackLodBase,
+            materialSampler, bindlessTextures, streamedTextures, streamingSlots, textureFeedback);
     }
 
     if ((attributes & MatAttr_MetalRough) && (gs.material.metalRoughOrSpecularTextureIndex >= 0) && (gs.material.flags & MaterialFlags_UseMetalRoughOrSpecularTexture) != 0)
     {
-        Texture2D specularTexture = bindlessTextures[NonUniformResourceIndex(gs.material.metalRoughOrSpecularTextureIndex)];
-
-        if (mipLevel >= 0)
-            textures.metalRoughOrSpecular = specularTexture.SampleLevel(materialSampler, gs.texcoord, mipLevel);
-        else
-            textures.metalRoughOrSpecular = specularTexture.SampleGrad(materialSampler, gs.texcoord, texGrad_x, texGrad_y);
+        textures.metalRoughOrSpecular = SampleMaterialTexture(gs.material.metalRoughOrSpecularTextureIndex, gs.texcoord, texGrad_x, texGrad_y, mipLevel, feedbackLodBase,
+            materialSampler, bindlessTextures, streamedTextures, streamingSlots, textureFeedback);
     }
 
     if ((attributes & MatAttr_Transmission) && (gs.material.transmissionTextureIndex >= 0) && (gs.material.flags & MaterialFlags_UseTransmissionTexture) != 0)
     {
-        Texture2D transmissionTexture = bindlessTextures[NonUniformResourceIndex(gs.material.transmissionTextureIndex)];
-
-        if (mipLevel >= 0)
-            textures.transmission = transmissionTexture.SampleLevel(materialSampler, gs.texcoord, mipLevel);
-        else
-            textures.transmission = transmissionTexture.SampleGrad(materialSampler, gs.texcoord, texGrad_x, texGrad_y);
+        textures.transmission = SampleMaterialTexture(gs.material.transmissionTextureIndex, gs.texcoord, texGrad_x, texGrad_y, mipLevel, feedbackLodBase,
+            materialSampler, bindlessTextures, streamedTextures, streamingSlots, textureFeedback);
     }
 
     return EvaluateSceneMaterial(gs.geometryNormal, gs.tangent, gs.material, textures);
@@ -0,0 +1,437 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "SharcInstance.h"
+
+#include <donut/core/log.h>
+
+#include <algorithm>
+#include <vector>
+
+using namespace donut;
+using namespace donut::math;
+
+#include "LightingCb.h"
+
+SharcInstance::SharcInstance(nvrhi::IDevice* device, nvrhi::IBindingLayout* bindingLayout, nvrhi::IBindingLayout* rehashBindingLayout, const SharcInstanceDesc& desc)
+    : m_device(device)
+    , m_bindingLayout(bindingLayout)
+    , m_rehashBindingLayout(rehashBindingLayout)
+    , m_desc(desc)
+    , m_capacityController(desc.capacityControllerDesc)
+{
+    CreateBuffers(m_capacityController.GetEntriesNum(), m_buffers);
+
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+    nvrhi::BufferDesc bufferDesc;
+    bufferDesc.byteSize = sizeof(uint32_t);
+    bufferDesc.cpuAccess = nvrhi::CpuAccessMode::Read;
+    bufferDesc.debugName = "SharcOccupancyReadback";
+    for (OccupancyReadback& readback : m_occupancyReadbacks)
+        readback.buffer = m_device->createBuffer(bufferDesc);
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
+}
+
+uint32_t SharcInstance::GetEntryByteSize()
+{
+    // Hash key, copy offset and two voxel data slots
+    uint32_t entryByteSize = sizeof(uint64_t) + sizeof(uint32_t) + 2 * 4 * sizeof(uint32_t);
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+    // Two live entry lists, the mask bit is rounded up to a byte
+    entryByteSize += 2 * sizeof(uint32_t) + 1;
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
+
+    return entryByteSize;
+}
+
+uint64_t SharcInstance::GetMemorySize() const
+{
+    return (uint64_t(m_buffers.entriesNum) + m_rehashTarget.entriesNum) * GetEntryByteSize();
+}
+
+void SharcInstance::CreateBuffers(uint32_t entriesNum, Buffers& buffers)
+{
+    buffers.entriesNum = entriesNum;
+
+    // Buffers
+    nvrhi::BufferDesc bufferDesc;
+    bufferDesc.isConstantBuffer = false;
+    bufferDesc.isVolatile = false;
+    bufferDesc.canHaveUAVs = true;
+    bufferDesc.cpuAccess = nvrhi::CpuAccessMode::None;
+    bufferDesc.keepInitialState = true;
+    bufferDesc.initialState = nvrhi::ResourceStates::UnorderedAccess;
+
+    bufferDesc.byteSize = entriesNum * sizeof(uint64_t);
+    bufferDesc.structStride = sizeof(uint64_t);
+    bufferDesc.debugName = "SharcHashEntriesBuffer";
+    buffers.hashEntriesBuffer = m_device->createBuffer(bufferDesc);
+
+    bufferDesc.byteSize = entriesNum * sizeof(uint32_t);
+    bufferDesc.structStride = sizeof(uint32_t);
+    bufferDesc.debugName = "SharcCopyOffsetBuffer";
+    buffers.copyOffsetBuffer = m_device->createBuffer(bufferDesc);
+
+    bufferDesc.byteSize = entriesNum * sizeof(float4);
+    bufferDesc.structStride = 4 * sizeof(uint32_t);
+    bufferDesc.canHaveRawViews = true;
+
+    bufferDesc.debugName = "SharcVoxelDataBuffer";
+    buffers.voxelDataBuffer = m_device->createBuffer(bufferDesc);
+
+    bufferDesc.debugName = "SharcVoxelDataBufferPrev";
+    buffers.voxelDataBufferPrev = m_device->createBuffer(bufferDesc);
+
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+    bufferDesc.canHaveRawViews = false;
+
+    bufferDesc.byteSize = entriesNum * sizeof(uint32_t);
+    bufferDesc.structStride = sizeof(uint32_t);
+    bufferDesc.debugName = "SharcLiveEntriesBuffer";
+    buffers.liveEntriesBuffer = m_device->createBuffer(bufferDesc);
+
+    bufferDesc.debugName = "SharcLiveEntriesBufferNext";
+    buffers.liveEntriesBufferNext = m_device->createBuffer(bufferDesc);
+
+    bufferDesc.byteSize = (entriesNum + 31) / 32 * sizeof(uint32_t);
+    bufferDesc.debugName = "SharcLiveEntryMaskBuffer";
+    buffers.liveEntryMaskBuffer = m_device->createBuffer(bufferDesc);
+
+    bufferDesc.byteSize = SHARC_LIVE_ENTRY_COUNTER_SIZE * sizeof(uint32_t);
+    bufferDesc.debugName = "SharcLiveCounterBuffer";
+    buffers.liveCounterBuffer = m_device->createBuffer(bufferDesc);
+
+    bufferDesc.debugName = "SharcLiveCounterBufferNext";
+    buffers.liveCounterBufferNext = m_device->createBuffer(bufferDesc);
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
+
+    nvrhi::BindingSetDesc bindingSetDesc;
+    bindingSetDesc.bindings = {
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(0, buffers.hashEntriesBuffer),
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(1, buffers.copyOffsetBuffer),
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(2, buffers.voxelDataBuffer),
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(3, buffers.voxelDataBufferPrev),
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(4, buffers.liveEntriesBuffer),
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(5, buffers.liveEntriesBufferNext),
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(6, buffers.liveEntryMaskBuffer),
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(7, buffers.liveCounterBuffer),
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(8, buffers.liveCounterBufferNext),
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
+    };
+    buffers.bindingSet = m_device->createBindingSet(bindingSetDesc, m_bindingLayout);
+
+    bindingSetDesc.bindings = {
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(0, buffers.hashEntriesBuffer),
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(1, buffers.copyOffsetBuffer),
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(2, buffers.voxelDataBufferPrev),
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(3, buffers.voxelDataBuffer),
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(4, buffers.liveEntriesBufferNext),
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(5, buffers.liveEntriesBuffer),
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(6, buffers.liveEntryMaskBuffer),
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(7, buffers.liveCounterBufferNext),
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(8, buffers.liveCounterBuffer),
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
+    };
+    buffers.bindingSetSwapped = m_device->createBindingSet(bindingSetDesc, m_bindingLayout);
+
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+    // Target of an incremental rehash, migrated entries go to the lists used after the next swap
+    bindingSetDesc.bindings = {
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(0, buffers.hashEntriesBuffer),
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(1, buffers.voxelDataBuffer),
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(2, buffers.liveEntriesBufferNext),
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(3, buffers.liveEntryMaskBuffer),
+        nvrhi::BindingSetItem::StructuredBuffer_UAV(4, buffers.liveCounterBufferNext),
+    };
+    buffers.rehashBindingSet = m_device->createBindingSet(bindingSetDesc, m_rehashBindingLayout);
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
+}
+
+void SharcInstance::ClearBuffers(nvrhi::ICommandList* commandList, const Buffers& buffers)
+{
+    commandList->clearBufferUInt(buffers.hashEntriesBuffer, m_invalidEntry);
+    commandList->clearBufferUInt(buffers.copyOffsetBuffer, 0);
+    commandList->clearBufferUInt(buffers.voxelDataBuffer, 0);
+    commandList->clearBufferUInt(buffers.voxelDataBufferPrev, 0);
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+    commandList->clearBufferUInt(buffers.liveEntryMaskBuffer, 0);
+    commandList->clearBufferUInt(buffers.liveCounterBuffer, 0);
+    commandList->clearBufferUInt(buffers.liveCounterBufferNext, 0);
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
+}
+
+void SharcInstance::Clear(nvrhi::ICommandList* commandList)
+{
+    ClearBuffers(commandList, m_buffers);
+    m_clearRequired = false;
+}
+
+void SharcInstance::Swap()
+{
+    std::swap(m_buffers.voxelDataBuffer, m_buffers.voxelDataBufferPrev);
+    std::swap(m_buffers.bindingSet, m_buffers.bindingSetSwapped);
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+    std::swap(m_buffers.liveEntriesBuffer, m_buffers.liveEntriesBufferNext);
+    std::swap(m_buffers.liveCounterBuffer, m_buffers.liveCounterBufferNext);
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
+}
+
+SharcCapacityAction SharcInstance::UpdateCapacity(nvrhi::ICommandList* commandList, uint64_t frameIndex, bool enableResize, uint32_t entriesNumLimit)
+{
+    m_capacityAction = SharcCapacityAction::None;
+
+    // Snapshot upload owns the table until the last chunk is in
+    if (IsSnapshotUploading())
+        enableResize = false;
+
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+    // Pick up the sample written into this slot 'm_readbackLatency' frames ago
+    OccupancyReadback& readback = m_occupancyReadbacks[frameIndex % m_readbackLatency];
+    if (readback.pending)
+    {
+        const uint32_t* occupiedEntryNum = (const uint32_t*)m_device->mapBuffer(readback.buffer, nvrhi::CpuAccessMode::Read);
+        if (occupiedEntryNum)
+        {
+            if (enableResize)
+                m_capacityController.ReportOccupancy(readback.frameIndex, *occupiedEntryNum, readback.entriesNum);
+            m_device->unmapBuffer(readback.buffer);
+        }
+        readback.pending = false;
+    }
+
+    // Cleared or disabled cache, a partially migrated table is dropped
+    if (!enableResize)
+    {
+        if (m_capacityController.IsRehashing())
+            m_rehashTarget = Buffers();
+        m_capacityController.Reset(frameIndex);
+
+        return m_capacityAction;
+    }
+
+    m_capacityController.SetEntriesNumLimit(entriesNumLimit);
+    m_capacityAction = m_capacityController.Update(frameIndex);
+    if (m_capacityAction == SharcCapacityAction::BeginRehash)
+    {
+        CreateBuffers(m_capacityController.GetTargetEntriesNum(), m_rehashTarget);
+        ClearBuffers(commandList, m_rehashTarget);
+    }
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
+
+    return m_capacityAction;
+}
+
+void SharcInstance::ReadbackOccupancy(nvrhi::ICommandList* commandList, uint64_t frameIndex)
+{
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+    // Live entry count after eviction, consumed a few frames later by the capacity controller
+    OccupancyReadback& readback = m_occupancyReadbacks[frameIndex % m_readbackLatency];
+    commandList->copyBuffer(readback.buffer, 0, m_buffers.liveCounterBufferNext, 0, sizeof(uint32_t));
+    readback.frameIndex = frameIndex;
+    readback.entriesNum = m_buffers.entriesNum;
+    readback.pending = true;
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
+}
+
+void SharcInstance::FinishRehash()
+{
+    if (m_capacityAction != SharcCapacityAction::Finish)
+        return;
+
+    m_buffers = m_rehashTarget;
+    m_rehashTarget = Buffers();
+    m_capacityAction = SharcCapacityAction::None;
+}
+
+void SharcInstance::UpdateCamera(const float3& cameraPosition)
+{
+    if (!m_cameraValid)
+    {
+        m_cameraPosition = cameraPosition;
+        m_cameraValid = true;
+    }
+
+    m_cameraPositionPrev = m_cameraPosition;
+    m_cameraPosition = cameraPosition;
+}
+
+void SharcInstance::FillConstants(LightingConstants& constants) const
+{
+    constants.sharcEntriesNum = m_buffers.entriesNum;
+    constants.sharcDownscaleFactor = m_parameters.downscaleFactor;
+    constants.sharcSceneScale = m_parameters.sceneScale;
+    constants.sharcRoughnessThreshold = m_parameters.roughnessThreshold;
+    constants.sharcCameraPositionPrev.xyz() = m_cameraPositionPrev;
+    constants.sharcCameraPosition.xyz() = m_cameraPosition;
+    constants.sharcAccumulationFrameNum = m_parameters.accumulationFrameNum;
+    constants.sharcStaleFrameNum = m_parameters.staleFrameNum;
+    constants.sharcEnableAntifirefly = m_parameters.enableAntifirefly;
+    constants.sharcEnableTileSchedule = m_parameters.enableTileSchedule;
+    constants.sharcEnablePrimaryHitReuse = m_parameters.enablePrimaryHitReuse;
+
+    constants.sharcRehashEntriesNum = 0;
+    constants.sharcRehashBegin = 0;
+    constants.sharcRehashEnd = 0;
+
+    if (m_capacityAction != SharcCapacityAction::None)
+    {
+        uint32_t rehashBegin, rehashEnd;
+        m_capacityController.GetRehashRange(rehashBegin, rehashEnd);
+
+        constants.sharcRehashEntriesNum = m_rehashTarget.entriesNum;
+        constants.sharcRehashBegin = rehashBegin;
+        constants.sharcRehashEnd = rehashEnd;
+    }
+}
+
+void SharcInstance::SetSnapshot(std::unique_ptr<SharcSnapshotReader> snapshot)
+{
+    if (IsSnapshotUploading())
+        m_clearRequired = true;
+
+    m_snapshot = std::move(snapshot);
+    m_snapshotChunkIndex = 0;
+    m_snapshotLiveEntryNum = 0;
+    m_snapshotLiveEntryMask.clear();
+}
+
+bool SharcInstance::UploadSnapshot(nvrhi::ICommandList* commandList, uint64_t frameIndex, const SharcSnapshotDesc& desc)
+{
+    const uint32_t entriesNum = m_snapshot->GetDesc().entriesNum;
+
+    if (m_snapshotChunkIndex == 0)
+    {
+        // Checked on upload, scene scale can change between scene load and the first SHaRC frame
+        if (!SharcSnapshotIsCompatible(m_snapshot->GetDesc(), desc))
+        {
+            log::info("SHaRC snapshot doesn't match the current scene or grid settings of instance '%s', ignored", m_desc.name.c_str());
+            m_snapshot = nullptr;
+            return false;
+        }
+
+        if (!m_capacityController.SetEntriesNum(frameIndex, entriesNum))
+        {
+            log::warning("SHaRC snapshot capacity %u is not supported, ignored", entriesNum);
+            m_snapshot = nullptr;
+            return false;
+        }
+
+        m_rehashTarget = Buffers();
+        m_capacityAction = SharcCapacityAction::None;
+        if (entriesNum != m_buffers.entriesNum)
+            CreateBuffers(entriesNum, m_buffers);
+
+        // Entries of the chunks which aren't uploaded yet read as empty. The table is uploaded as the resolved data of
+        // the previous frame, the next swap makes it the history of the first update
+        ClearBuffers(commandList, m_buffers);
+
+        m_snapshotLiveEntryNum = 0;
+        m_snapshotLiveEntryMask.assign((entriesNum + 31) / 32, 0);
+    }
+
+    std::vector<SharcCpu::HashGridKey> hashEntries(m_snapshot->GetChunkEntryNum());
+    std::vector<SharcCpu::uint4> voxelData(m_snapshot->GetChunkEntryNum());
+    std::vector<uint32_t> liveEntries;
+
+    // Chunks are decoded one at a time from the mapped file and streamed through the upload heap, a few of them per frame
+    const uint32_t chunkEnd = std::min(m_snapshotChunkIndex + m_snapshotUploadChunkNum, m_snapshot->GetChunkNum());
+    for (; m_snapshotChunkIndex < chunkEnd; ++m_snapshotChunkIndex)
+    {
+        uint32_t begin, count;
+        m_snapshot->GetChunkRange(m_snapshotChunkIndex, begin, count);
+
+        if (!m_snapshot->ReadChunk(m_snapshotChunkIndex, hashEntries.data(), voxelData.data()))
+        {
+            log::warning("SHaRC snapshot is corrupted, cache cleared");
+            SetSnapshot(nullptr);
+            Clear(commandList);
+            return true;
+        }
+
+        commandList->writeBuffer(m_buffers.hashEntriesBuffer, hashEntries.data(), count * sizeof(uint64_t), begin * sizeof(uint64_t));
+        commandList->writeBuffer(m_buffers.voxelDataBuffer, voxelData.data(), count * sizeof(SharcCpu::uint4), begin * sizeof(SharcCpu::uint4));
+
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+        // Entries land in the list which becomes current on the next swap, nothing reads it before the counter is written
+        liveEntries.clear();
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (hashEntries[i] == SharcCpu::c_HashGridInvalidHashKey)
+                continue;
+
+            const uint32_t entryIndex = begin + i;
+            liveEntries.push_back(entryIndex);
+            m_snapshotLiveEntryMask[entryIndex >> 5] |= 1u << (entryIndex & 31);
+        }
+
+        if (!liveEntries.empty())
+            commandList->writeBuffer(m_buffers.liveEntriesBufferNext, liveEntries.data(), liveEntries.size() * sizeof(uint32_t), m_snapshotLiveEntryNum * sizeof(uint32_t));
+        m_snapshotLiveEntryNum += uint32_t(liveEntries.size());
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
+    }
+
+    if (m_snapshotChunkIndex < m_snapshot->GetChunkNum())
+        return false;
+
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+    const uint32_t liveCounter[SHARC_LIVE_ENTRY_COUNTER_SIZE] = { m_snapshotLiveEntryNum };
+    commandList->writeBuffer(m_buffers.liveEntryMaskBuffer, m_snapshotLiveEntryMask.data(), m_snapshotLiveEntryMask.size() * sizeof(uint32_t));
+    commandList->writeBuffer(m_buffers.liveCounterBufferNext, liveCounter, sizeof(liveCounter));
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
+
+    SetSnapshot(nullptr);
+    m_clearRequired = false;
+
+    return true;
+}
+
+bool SharcInstance::SaveSnapshot(nvrhi::ICommandList* commandList, const std::filesystem::path& path, const SharcSnapshotDesc& desc)
+{
+    // A partially uploaded table isn't worth saving
+    if (IsSnapshotUploading())
+    {
+        log::warning("SHaRC snapshot of instance '%s' is still being uploaded, not saved", m_desc.name.c_str());
+        return false;
+    }
+
+    // A pending snapshot keeps the file mapped
+    SetSnapshot(nullptr);
+
+    nvrhi::BufferDesc bufferDesc;
+    bufferDesc.cpuAccess = nvrhi::CpuAccessMode::Read;
+    bufferDesc.byteSize = m_buffers.entriesNum * sizeof(uint64_t);
+    bufferDesc.debugName = "SharcSnapshotHashEntries";
+    nvrhi::BufferHandle hashEntriesReadback = m_device->createBuffer(bufferDesc);
+
+    bufferDesc.byteSize = m_buffers.entriesNum * sizeof(SharcCpu::uint4);
+    bufferDesc.debugName = "SharcSnapshotVoxelData";
+    nvrhi::BufferHandle voxelDataReadback = m_device->createBuffer(bufferDesc);
+
+    commandList->open();
+    commandList->copyBuffer(hashEntriesReadback, 0, m_buffers.hashEntriesBuffer, 0, hashEntriesReadback->getDesc().byteSize);
+    commandList->copyBuffer(voxelDataReadback, 0, m_buffers.voxelDataBuffer, 0, voxelDataReadback->getDesc().byteSize);
+    commandList->close();
+    m_device->executeCommandList(commandList);
+    m_device->waitForIdle();
+
+    const void* hashEntries = m_device->mapBuffer(hashEntriesReadback, nvrhi::CpuAccessMode::Read);
+    const void* voxelData = m_device->mapBuffer(voxelDataReadback, nvrhi::CpuAccessMode::Read);
+
+    const bool result = hashEntries && voxelData && SharcSnapshotWriteFile(path, desc, (const SharcCpu::HashGridKey*)hashEntries, (const SharcCpu::uint4*)voxelData);
+
+    if (hashEntries)
+        m_device->unmapBuffer(hashEntriesReadback);
+    if (voxelData)
+        m_device->unmapBuffer(voxelDataReadback);
+
+    return result;
+}
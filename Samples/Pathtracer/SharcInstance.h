@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <donut/core/math/math.h>
+#include <nvrhi/nvrhi.h>
+
+#include "SharcCapacityController.h"
+#include "SharcSnapshot.h"
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct LightingConstants;
+
+struct SharcInstanceDesc
+{
+    std::string name;
+    SharcCapacityControllerDesc capacityControllerDesc;
+
+    // Share of the memory budget relative to other instances
+    float budgetWeight = 1.0f;
+};
+
+// Set by the application every frame
+struct SharcInstanceParameters
+{
+    float sceneScale = 50.0f;
+    float roughnessThreshold = 0.4f;
+    int downscaleFactor = 5;
+    int accumulationFrameNum = 10;
+    int staleFrameNum = 64;
+    bool enableAntifirefly = true;
+
+    // Update rays follow the tile schedule built from the query pass of this instance
+    bool enableTileSchedule = false;
+
+    // Update rays start from the primary hits of the previous query pass of this instance
+    bool enablePrimaryHitReuse = false;
+};
+
+// One SHaRC cache with its hash map buffers, binding sets, capacity controller and camera history.
+// Instances don't share any state, several of them can be updated in one command list as long as each one
+// is dispatched with the constants written by its FillConstants()
+class SharcInstance
+{
+public:
+    SharcInstance(nvrhi::IDevice* device, nvrhi::IBindingLayout* bindingLayout, nvrhi::IBindingLayout* rehashBindingLayout, const SharcInstanceDesc& desc);
+
+    const SharcInstanceDesc& GetDesc() const
+    {
+        return m_desc;
+    }
+
+    const SharcInstanceParameters& GetParameters() const
+    {
+        return m_parameters;
+    }
+
+    void SetParameters(const SharcInstanceParameters& parameters)
+    {
+        m_parameters = parameters;
+    }
+
+    uint32_t GetEntriesNum() const
+    {
+        return m_buffers.entriesNum;
+    }
+
+    const SharcCapacityController& GetCapacityController() const
+    {
+        return m_capacityController;
+    }
+
+    SharcCapacityAction GetCapacityAction() const
+    {
+        return m_capacityAction;
+    }
+
+    nvrhi::IBindingSet* GetBindingSet() const
+    {
+        return m_buffers.bindingSet;
+    }
+
+    // Binding set of the table entries are migrated to, valid while the capacity action isn't None
+    nvrhi::IBindingSet* GetRehashBindingSet() const
+    {
+        return m_rehashTarget.rehashBindingSet;
+    }
+
+    nvrhi::IBuffer* GetVoxelDataBuffer() const
+    {
+        return m_buffers.voxelDataBuffer;
+    }
+
+    nvrhi::IBuffer* GetLiveCounterBuffer() const
+    {
+        return m_buffers.liveCounterBuffer;
+    }
+
+    // Approximate size of all buffers of one entry
+    static uint32_t GetEntryByteSize();
+
+    // Includes the table being migrated to during a resize
+    uint64_t GetMemorySize() const;
+
+    // Buffers of a new instance hold no valid data until the first clear or snapshot upload
+    bool IsClearRequired() const
+    {
+        return m_clearRequired;
+    }
+
+    void Clear(nvrhi::ICommandList* commandList);
+
+    // Resolved data of the previous frame becomes the history of this one
+    void Swap();
+
+    // Consumes the occupancy sample of an earlier frame and advances the capacity controller, a disabled resize drops a partially migrated table
+    SharcCapacityAction UpdateCapacity(nvrhi::ICommandList* commandList, uint64_t frameIndex, bool enableResize, uint32_t entriesNumLimit);
+
+    // Captures the live entry count after compaction
+    void ReadbackOccupancy(nvrhi::ICommandList* commandList, uint64_t frameIndex);
+
+    // The resized table takes over on the next frame, old buffers are released once the GPU is done with them
+    void FinishRehash();
+
+    void UpdateCamera(const donut::math::float3& cameraPosition);
+
+    void FillConstants(LightingConstants& constants) const;
+
+    // Snapshot opened on scene load, uploaded over the first frames the instance is updated. Replacing a snapshot
+    // which is partially uploaded leaves the cache to be cleared
+    void SetSnapshot(std::unique_ptr<SharcSnapshotReader> snapshot);
+
+    bool HasSnapshot() const
+    {
+        return m_snapshot != nullptr;
+    }
+
+    // Some chunks are uploaded but the table isn't complete, the instance must not be updated or resolved until it is
+    bool IsSnapshotUploading() const
+    {
+        return m_snapshotChunkIndex > 0;
+    }
+
+    // Uploads the next 'm_snapshotUploadChunkNum' chunks, 'desc' describes the current scene and parameters.
+    // Returns true on the frame the cache state has been replaced, the live entry list is published with the last chunk
+    bool UploadSnapshot(nvrhi::ICommandList* commandList, uint64_t frameIndex, const SharcSnapshotDesc& desc);
+
+    // Waits for the GPU, 'commandList' has to be closed
+    bool SaveSnapshot(nvrhi::ICommandList* commandList, const std::filesystem::path& path, const SharcSnapshotDesc& desc);
+
+private:
+    // Buffers and binding sets of one hash map, a second set is created while the capacity changes
+    struct Buffers
+    {
+        uint32_t entriesNum = 0;
+        nvrhi::BufferHandle hashEntriesBuffer;
+        nvrhi::BufferHandle copyOffsetBuffer;
+        nvrhi::BufferHandle voxelDataBuffer;
+        nvrhi::BufferHandle voxelDataBufferPrev;
+        nvrhi::BufferHandle liveEntriesBuffer;
+        nvrhi::BufferHandle liveEntriesBufferNext;
+        nvrhi::BufferHandle liveEntryMaskBuffer;
+        nvrhi::BufferHandle liveCounterBuffer;
+        nvrhi::BufferHandle liveCounterBufferNext;
+        nvrhi::BindingSetHandle bindingSet;
+        nvrhi::BindingSetHandle bindingSetSwapped;
+        nvrhi::BindingSetHandle rehashBindingSet;
+    };
+
+    struct OccupancyReadback
+    {
+        nvrhi::BufferHandle buffer;
+        uint64_t frameIndex = 0;
+        uint32_t entriesNum = 0;
+        bool pending = false;
+    };
+
+    void CreateBuffers(uint32_t entriesNum, Buffers& buffers);
+    void ClearBuffers(nvrhi::ICommandList* commandList, const Buffers& buffers);
+
+    static const uint32_t m_invalidEntry = 0;
+    static const uint32_t m_readbackLatency = 3;
+    static const uint32_t m_snapshotUploadChunkNum = 4;
+
+    nvrhi::DeviceHandle m_device;
+    nvrhi::BindingLayoutHandle m_bindingLayout;
+    nvrhi::BindingLayoutHandle m_rehashBindingLayout;
+
+    SharcInstanceDesc m_desc;
+    SharcInstanceParameters m_parameters;
+
+    Buffers m_buffers;
+    Buffers m_rehashTarget;
+
+    bool m_clearRequired = true;
+
+    SharcCapacityController m_capacityController;
+    SharcCapacityAction m_capacityAction = SharcCapacityAction::None;
+    OccupancyReadback m_occupancyReadbacks[m_readbackLatency];
+
+    bool m_cameraValid = false;
+    donut::math::float3 m_cameraPosition = donut::math::float3(0.0f);
+    donut::math::float3 m_cameraPositionPrev = donut::math::float3(0.0f);
+
+    std::unique_ptr<SharcSnapshotReader> m_snapshot;
+    uint32_t m_snapshotChunkIndex = 0;
+    uint32_t m_snapshotLiveEntryNum = 0;
+    std::vector<uint32_t> m_snapshotLiveEntryMask;
+};
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#ifndef SHARC_LIVE_ENTRIES_H
+#define SHARC_LIVE_ENTRIES_H
+
+// List of occupied SHaRC entries. The update pass appends newly inserted entries, the compaction pass
+// moves entries which survived the resolve to the next list. Lists and counters are swapped every frame together with the voxel data
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+RWStructuredBuffer<uint>        u_SharcLiveEntries              : register(u4, space3);
+RWStructuredBuffer<uint>        u_SharcLiveEntriesNext          : register(u5, space3);
+RWStructuredBuffer<uint>        u_SharcLiveEntryMask            : register(u6, space3); // One bit per entry, set while the entry is listed
+RWStructuredBuffer<uint>        u_SharcLiveCounter              : register(u7, space3);
+RWStructuredBuffer<uint>        u_SharcLiveCounterNext          : register(u8, space3);
+
+void SharcLiveEntryAppend(HashGridIndex cacheIndex)
+{
+    if (cacheIndex == HASH_GRID_INVALID_CACHE_INDEX)
+        return;
+
+    const uint maskIndex = cacheIndex >> 5;
+    const uint maskBit = 1u << (cacheIndex & 31);
+
+    // Most hits land on entries which are already listed, skip the atomic for them
+    if (u_SharcLiveEntryMask[maskIndex] & maskBit)
+        return;
+
+    uint maskPrev;
+    InterlockedOr(u_SharcLiveEntryMask[maskIndex], maskBit, maskPrev);
+    if ((maskPrev & maskBit) == 0)
+    {
+        uint listIndex;
+        InterlockedAdd(u_SharcLiveCounter[0], 1, listIndex);
+        u_SharcLiveEntries[listIndex] = cacheIndex;
+    }
+}
+
+void SharcLiveEntryRemove(HashGridIndex cacheIndex)
+{
+    InterlockedAnd(u_SharcLiveEntryMask[cacheIndex >> 5], ~(1u << (cacheIndex & 31)));
+}
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
+
+#endif // SHARC_LIVE_ENTRIES_H
@@ -12,6 +12,7 @@
 #include "LightingCb.h"
 
 #include "SharcCommon.h"
+#include "SharcLiveEntries.h"
 
 #define LINEAR_BLOCK_SIZE           256
 
@@ -23,19 +24,106 @@ RWStructuredBuffer<uint>            u_HashCopyOffsetBuffer      : register(u1, s
 RWStructuredBuffer<uint4>           u_SharcVoxelDataBuffer      : register(u2, space3);
 RWStructuredBuffer<uint4>           u_SharcVoxelDataBufferPrev  : register(u3, space3);
 
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+// Converts the live entry count into indirect arguments for the resolve and compaction passes
+[numthreads(1, 1, 1)]
+void sharcPrepareIndirect(in uint2 did : SV_DispatchThreadID)
+{
+    const uint liveEntryNum = min(u_SharcLiveCounter[0], uint(g_Lighting.sharcEntriesNum));
+
+    u_SharcLiveCounter[1] = (liveEntryNum + LINEAR_BLOCK_SIZE - 1) / LINEAR_BLOCK_SIZE;
+    u_SharcLiveCounter[2] = 1;
+    u_SharcLiveCounter[3] = 1;
+
+    u_SharcLiveCounterNext[0] = 0;
+}
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
+
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+// Table the cache is being migrated to, uses the lists consumed after the next swap
+RWStructuredBuffer<uint64_t>        u_SharcRehashHashEntries        : register(u0, space4);
+RWStructuredBuffer<uint4>           u_SharcRehashVoxelData          : register(u1, space4);
+RWStructuredBuffer<uint>            u_SharcRehashLiveEntries        : register(u2, space4);
+RWStructuredBuffer<uint>            u_SharcRehashLiveEntryMask      : register(u3, space4);
+RWStructuredBuffer<uint>            u_SharcRehashLiveCounter        : register(u4, space4);
+
+// Moves resolved entries from a range of the current table into the new one
+[numthreads(LINEAR_BLOCK_SIZE, 1, 1)]
+void sharcRehash(in uint2 did : SV_DispatchThreadID)
+{
+    const uint entryIndex = g_Lighting.sharcRehashBegin + did.x;
+    if (entryIndex >= uint(g_Lighting.sharcRehashEnd))
+        return;
+
+    const HashGridKey hashKey = u_SharcHashEntriesBuffer[entryIndex];
+    if (hashKey == HASH_GRID_INVALID_HASH_KEY)
+        return;
+
+    HashMapData hashMapData;
+    hashMapData.capacity = g_Lighting.sharcRehashEntriesNum;
+    hashMapData.hashEntriesBuffer = u_SharcRehashHashEntries;
+
+    HashGridIndex cacheIndex;
+    if (!HashMapInsert(hashMapData, hashKey, cacheIndex))
+        return;
+
+    u_SharcRehashVoxelData[cacheIndex] = u_SharcVoxelDataBuffer[entryIndex];
+
+    const uint maskBit = 1u << (cacheIndex & 31);
+    uint maskPrev;
+    InterlockedOr(u_SharcRehashLiveEntryMask[cacheIndex >> 5], maskBit, maskPrev);
+    if ((maskPrev & maskBit) == 0)
+    {
+        uint listIndex;
+        InterlockedAdd(u_SharcRehashLiveCounter[0], 1, listIndex);
+        u_SharcRehashLiveEntries[listIndex] = cacheIndex;
+    }
+}
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
+
 [numthreads(LINEAR_BLOCK_SIZE, 1, 1)]
 void sharcCompaction(in uint2 did : SV_DispatchThreadID)
 {
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+    // Entries evicted by the resolve pass have an invalid hash key, the rest moves to the next list
+    if (did.x >= u_SharcLiveCounter[0])
+        return;
+
+    const uint entryIndex = u_SharcLiveEntries[did.x];
+
+    // Every slot written since the previous clear is listed, resetting them here replaces the full clear of the
+    // buffer the next update accumulates into
+    u_SharcVoxelDataBufferPrev[entryIndex] = uint4(0, 0, 0, 0);
+    if (u_SharcHashEntriesBuffer[entryIndex] != HASH_GRID_INVALID_HASH_KEY)
+    {
+        uint listIndex;
+        InterlockedAdd(u_SharcLiveCounterNext[0], 1, listIndex);
+        u_SharcLiveEntriesNext[listIndex] = entryIndex;
+    }
+    else
+    {
+        SharcLiveEntryRemove(entryIndex);
+    }
+#else // !SHARC_ENABLE_LIVE_ENTRY_LIST
     HashMapData hashMapData;
     hashMapData.capacity = g_Lighting.sharcEntriesNum;
     hashMapData.hashEntriesBuffer = u_SharcHashEntriesBuffer;
 
     SharcCopyHashEntry(did.x, hashMapData, u_HashCopyOffsetBuffer);
+#endif // !SHARC_ENABLE_LIVE_ENTRY_LIST
 }
 
 [numthreads(LINEAR_BLOCK_SIZE, 1, 1)]
 void sharcResolve(in uint2 did : SV_DispatchThreadID)
 {
+    uint entryIndex = did.x;
+#if SHARC_ENABLE_LIVE_ENTRY_LIST
+    if (did.x >= u_SharcLiveCounter[0])
+        return;
+
+    entryIndex = u_SharcLiveEntries[did.x];
+#endif // SHARC_ENABLE_LIVE_ENTRY_LIST
+
     SharcParameters sharcParameters;
 
     sharcParameters.gridParameters.cameraPosition = g_Lighting.sharcCameraPosition.xyz;
@@ -55,7 +143,7 @@ void sharcResolve(in uint2 did : SV_DispatchThreadID)
     resolveParameters.cameraPositionPrev = g_Lighting.sharcCameraPositionPrev.xyz;
     resolveParameters.enableAntiFireflyFilter = g_Lighting.sharcEnableAntifirefly;
 
-    SharcResolveEntry(did.x, sharcParameters, resolveParameters
+    SharcResolveEntry(entryIndex, sharcParameters, resolveParameters
 #if SHARC_DEFERRED_HASH_COMPACTION
     , u_HashCopyOffsetBuffer
 #endif // SHARC_DEFERRED_HASH_COMPACTION
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#ifndef SHARC_TILE_SCHEDULE_H
+#define SHARC_TILE_SCHEDULE_H
+
+// Screen tile counters filled by the query pass and the update ray schedule built from them on the CPU (Host/SharcTileScheduler.h)
+RWStructuredBuffer<uint>        u_SharcTileStats                : register(u1, space0); // Lookup and miss count per tile
+StructuredBuffer<uint>          t_SharcTileRayOffsets           : register(t4, space0); // First update ray of each tile, the total ray count at the end
+
+void SharcTileStatsAdd(uint2 pixel, uint tileSize, uint tileNumX, bool miss)
+{
+    const uint tileIndex = (pixel.y / tileSize) * tileNumX + pixel.x / tileSize;
+
+    InterlockedAdd(u_SharcTileStats[2 * tileIndex + 0], 1);
+    if (miss)
+        InterlockedAdd(u_SharcTileStats[2 * tileIndex + 1], 1);
+}
+
+// Returns the pixel position traced by an update ray
+float2 SharcTileSchedulePixel(uint rayIndex, float2 viewportSize, uint tileSize, uint tileNumX, uint tileNum, uint frameIndex)
+{
+    // Last tile starting at or before the ray, empty tiles share the offset of the next one
+    uint begin = 0;
+    uint end = tileNum;
+    while (end - begin > 1)
+    {
+        const uint middle = (begin + end) / 2;
+        if (t_SharcTileRayOffsets[middle] <= rayIndex)
+            begin = middle;
+        else
+            end = middle;
+    }
+
+    const uint tileIndex = begin;
+    const uint tileRayIndex = rayIndex - t_SharcTileRayOffsets[tileIndex];
+
+    // R2 sequence keeps the rays of a tile stratified, the random start changes every frame
+    uint rngState = InitRNG(uint2(tileIndex, 0), uint2(tileNum, 1), frameIndex);
+    const float2 start = float2(Rand(rngState), Rand(rngState));
+    const float2 position = frac(start + float(tileRayIndex) * float2(0.7548776662f, 0.5698402910f));
+
+    const float2 tileOrigin = float2(tileIndex % tileNumX, tileIndex / tileNumX) * tileSize;
+    const float2 tileExtent = min(float(tileSize).xx, viewportSize - tileOrigin);
+
+    return tileOrigin + position * tileExtent;
+}
+
+#endif // SHARC_TILE_SCHEDULE_H
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "HostTests.h"
+
+#include "FrameProfiler.h"
+
+#include <cmath>
+#include <vector>
+
+namespace
+{
+// CPU time only moves when the test advances it, timers become ready when the test says so
+class FakeFrameProfilerClock : public FrameProfilerClock
+{
+public:
+    explicit FakeFrameProfilerClock(uint32_t timerNum) : m_isReady(timerNum, false), m_times(timerNum, 0.0)
+    {
+    }
+
+    void Advance(double time)
+    {
+        m_cpuTime += time;
+    }
+
+    void SetTimer(uint32_t timerIndex, double time)
+    {
+        m_isReady[timerIndex] = false;
+        m_times[timerIndex] = time;
+    }
+
+    void SetReady(uint32_t timerIndex)
+    {
+        m_isReady[timerIndex] = true;
+    }
+
+    double GetCpuTime() override
+    {
+        return m_cpuTime;
+    }
+
+    bool IsTimerReady(uint32_t timerIndex) override
+    {
+        return m_isReady[timerIndex];
+    }
+
+    double GetTimerTime(uint32_t timerIndex) override
+    {
+        HOST_CHECK(m_isReady[timerIndex]);
+        return m_times[timerIndex];
+    }
+
+private:
+    double m_cpuTime = 0.0;
+    std::vector<bool> m_isReady;
+    std::vector<double> m_times;
+};
+
+// Records a frame with a single scope that takes 'cpuTime' on the CPU and 'gpuTime' on the GPU
+uint32_t RecordFrame(FrameProfiler& profiler, FakeFrameProfilerClock& clock, const char* name, double cpuTime, double gpuTime)
+{
+    profiler.BeginFrame();
+    const uint32_t timerIndex = profiler.BeginScope(name);
+    clock.Advance(cpuTime);
+    profiler.EndScope(timerIndex);
+    clock.SetTimer(timerIndex, gpuTime);
+    profiler.EndFrame();
+
+    return timerIndex;
+}
+
+bool IsNear(double a, double b)
+{
+    return std::abs(a - b) < 1e-9;
+}
+} // namespace
+
+HOST_TEST(FrameProfilerDelayedResolve)
+{
+    FrameProfilerDesc desc;
+    desc.frameLatency = 3;
+    desc.maxScopeNum = 4;
+    FakeFrameProfilerClock clock(desc.frameLatency * desc.maxScopeNum);
+    FrameProfiler profiler(desc, clock);
+
+    const uint32_t timer0 = RecordFrame(profiler, clock, "Frame", 0.002, 0.005);
+    HOST_CHECK(timer0 / desc.maxScopeNum == 0);
+
+    // Nothing is read until the GPU is done with the frame
+    const uint32_t timer1 = RecordFrame(profiler, clock, "Frame", 0.002, 0.006);
+    HOST_CHECK(timer1 / desc.maxScopeNum == 1);
+    HOST_CHECK(profiler.GetResolvedFrameNum() == 0);
+    HOST_CHECK(profiler.GetScopes().empty());
+
+    // A later frame that is ready waits for the earlier one
+    clock.SetReady(timer1);
+    RecordFrame(profiler, clock, "Frame", 0.002, 0.007);
+    HOST_CHECK(profiler.GetResolvedFrameNum() == 0);
+
+    clock.SetReady(timer0);
+    profiler.BeginFrame();
+    HOST_CHECK(profiler.GetResolvedFrameNum() == 2);
+    HOST_CHECK(profiler.GetDroppedFrameNum() == 0);
+    HOST_CHECK(profiler.GetScopes().size() == 1);
+    HOST_CHECK(profiler.GetScopes()[0].name == "Frame");
+    HOST_CHECK(profiler.GetScopes()[0].depth == 0);
+    profiler.EndFrame();
+}
+
+HOST_TEST(FrameProfilerDroppedFrames)
+{
+    FrameProfilerDesc desc;
+    desc.frameLatency = 2;
+    desc.maxScopeNum = 4;
+    FakeFrameProfilerClock clock(desc.frameLatency * desc.maxScopeNum);
+    FrameProfiler profiler(desc, clock);
+
+    // The timers never become ready, every slot is reused while its frame is pending
+    for (uint32_t frameIndex = 0; frameIndex < 5; ++frameIndex)
+        RecordFrame(profiler, clock, "Frame", 0.001, 0.001);
+
+    HOST_CHECK(profiler.GetDroppedFrameNum() == 3);
+    HOST_CHECK(profiler.GetResolvedFrameNum() == 0);
+
+    // The two frames still pending are dropped as their slots come around
+    for (uint32_t frameIndex = 0; frameIndex < 2; ++frameIndex)
+    {
+        profiler.BeginFrame();
+        profiler.EndFrame();
+    }
+    HOST_CHECK(profiler.GetDroppedFrameNum() == 5);
+
+    // Frames without scopes have nothing to wait for and aren't dropped
+    for (uint32_t frameIndex = 0; frameIndex < 4; ++frameIndex)
+    {
+        profiler.BeginFrame();
+        profiler.EndFrame();
+    }
+    HOST_CHECK(profiler.GetDroppedFrameNum() == 5);
+
+    // Scopes beyond the per frame limit get no timer
+    profiler.BeginFrame();
+    uint32_t timers[5];
+    for (uint32_t scopeIndex = 0; scopeIndex < 5; ++scopeIndex)
+        timers[scopeIndex] = profiler.BeginScope("Nested");
+    HOST_CHECK(timers[3] != FrameProfiler::c_InvalidTimer);
+    HOST_CHECK(timers[4] == FrameProfiler::c_InvalidTimer);
+    profiler.EndScope(timers[0]);
+    profiler.EndFrame();
+}
+
+HOST_TEST(FrameProfilerScopePaths)
+{
+    FrameProfilerDesc desc;
+    desc.frameLatency = 2;
+    desc.maxScopeNum = 8;
+    FakeFrameProfilerClock clock(desc.frameLatency * desc.maxScopeNum);
+    FrameProfiler profiler(desc, clock);
+
+    // "Pass" runs twice inside of "Frame" and once on its own, which is a different path
+    profiler.BeginFrame();
+    const uint32_t frameTimer = profiler.BeginScope("Frame");
+    const uint32_t passTimer0 = profiler.BeginScope("Pass");
+    clock.Advance(0.001);
+    profiler.EndScope(passTimer0);
+    const uint32_t passTimer1 = profiler.BeginScope("Pass");
+    clock.Advance(0.002);
+    profiler.EndScope(passTimer1);
+    profiler.EndScope(frameTimer);
+    const uint32_t topPassTimer = profiler.BeginScope("Pass");
+    clock.Advance(0.004);
+    profiler.EndScope(topPassTimer);
+    profiler.EndFrame();
+
+    clock.SetTimer(frameTimer, 0.010);
+    clock.SetTimer(passTimer0, 0.003);
+    clock.SetTimer(passTimer1, 0.005);
+    clock.SetTimer(topPassTimer, 0.007);
+    for (uint32_t timerIndex : { frameTimer, passTimer0, passTimer1, topPassTimer })
+        clock.SetReady(timerIndex);
+
+    profiler.BeginFrame();
+    profiler.EndFrame();
+
+    // In the order of their first occurrence
+    const std::vector<FrameProfilerScope>& scopes = profiler.GetScopes();
+    HOST_CHECK(scopes.size() == 3);
+    if (scopes.size() != 3)
+        return;
+
+    HOST_CHECK(scopes[0].name == "Frame" && scopes[0].depth == 0);
+    HOST_CHECK(IsNear(scopes[0].cpuTime, 0.003) && IsNear(scopes[0].gpuTime, 0.010));
+    HOST_CHECK(scopes[1].name == "Pass" && scopes[1].depth == 1);
+    HOST_CHECK(IsNear(scopes[1].cpuTime, 0.003) && IsNear(scopes[1].gpuTime, 0.008));
+    HOST_CHECK(scopes[2].name == "Pass" && scopes[2].depth == 0);
+    HOST_CHECK(IsNear(scopes[2].cpuTime, 0.004) && IsNear(scopes[2].gpuTime, 0.007));
+}
+
+HOST_TEST(FrameProfilerSmoothing)
+{
+    FrameProfilerDesc desc;
+    desc.frameLatency = 2;
+    desc.maxScopeNum = 4;
+    desc.historyWeight = 0.1f;
+    FakeFrameProfilerClock clock(desc.frameLatency * desc.maxScopeNum);
+    FrameProfiler profiler(desc, clock);
+
+    // The GPU finishes every frame before the next one begins
+    const double gpuTimes[] = { 0.010, 0.020, 0.020 };
+    double expectedGpuTime = 0.0;
+    for (uint32_t frameIndex = 0; frameIndex < 3; ++frameIndex)
+    {
+        clock.SetReady(RecordFrame(profiler, clock, "Frame", 0.001, gpuTimes[frameIndex]));
+        profiler.BeginFrame();
+        profiler.EndFrame();
+
+        // The first sample is taken as is, later ones move the time by the history weight
+        if (frameIndex == 0)
+            expectedGpuTime = gpuTimes[0];
+        else
+            expectedGpuTime += (gpuTimes[frameIndex] - expectedGpuTime) * double(desc.historyWeight);
+
+        HOST_CHECK(profiler.GetScopes().size() == 1);
+        HOST_CHECK(IsNear(profiler.GetScopes()[0].gpuTime, expectedGpuTime));
+        HOST_CHECK(IsNear(profiler.GetScopes()[0].cpuTime, 0.001));
+    }
+
+    HOST_CHECK(IsNear(expectedGpuTime, 0.0119));
+    HOST_CHECK(profiler.GetResolvedFrameNum() == 3);
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "HostTests.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+struct HostTest
+{
+    const char* name;
+    void (*function)();
+};
+
+// Filled by the static initializers of the test files
+std::vector<HostTest>& GetHostTests()
+{
+    static std::vector<HostTest> tests;
+    return tests;
+}
+
+bool g_failed = false;
+} // namespace
+
+void RegisterHostTest(const char* name, void (*function)())
+{
+    GetHostTests().push_back({ name, function });
+}
+
+void ReportHostTestFailure(const char* file, int line, const char* expression)
+{
+    fprintf(stderr, "%s(%d): check failed: %s\n", file, line, expression);
+    g_failed = true;
+}
+
+int main(int argc, char** argv)
+{
+    const char* filter = argc > 1 ? argv[1] : nullptr;
+
+    int testNum = 0;
+    int failedTestNum = 0;
+    for (const HostTest& test : GetHostTests())
+    {
+        if (filter && !strstr(test.name, filter))
+            continue;
+
+        g_failed = false;
+        test.function();
+
+        printf("%s %s\n", g_failed ? "FAILED" : "passed", test.name);
+        failedTestNum += g_failed ? 1 : 0;
+        ++testNum;
+    }
+
+    printf("%d of %d tests passed\n", testNum - failedTestNum, testNum);
+
+    return failedTestNum;
+}
@@ -0,0 +1,30 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+// Minimal self registering test cases. The executable runs all of them, a failed check is reported and the test case
+// carries on, the exit code is the number of failed test cases.
+// Usage: PathtracerHostTests [<name filter>]
+
+void RegisterHostTest(const char* name, void (*function)());
+void ReportHostTestFailure(const char* file, int line, const char* expression);
+
+#define HOST_TEST(name) \
+    static void name(); \
+    static const bool name##Registered = (RegisterHostTest(#name, name), true); \
+    static void name()
+
+#define HOST_CHECK(expression) \
+    do \
+    { \
+        if (!(expression)) \
+            ReportHostTestFailure(__FILE__, __LINE__, #expression); \
+    } while (false)
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "HostTests.h"
+
+#include "NrcCapacityPolicy.h"
+
+// Synthetic traces of the settings the frames request: window resizes, samples per pixel and bounce changes
+
+HOST_TEST(NrcCapacityPolicyRounding)
+{
+    // A small minimum so the headroom shows
+    NrcCapacityPolicyDesc desc;
+    desc.minCapacity = { 64, 64, 1, 1 };
+    NrcCapacityPolicy policy(desc);
+
+    // 25% headroom aligned to 64 pixels, samples per pixel rounded up to a power of two, path vertices as requested
+    NrcCapacity capacity = policy.ComputeCapacity({ 1000, 700, 3, 5 });
+    HOST_CHECK(capacity == NrcCapacity({ 1280, 896, 4, 5 }));
+    HOST_CHECK(capacity.width % 64 == 0 && capacity.height % 64 == 0);
+
+    capacity = policy.ComputeCapacity({ 1024, 1024, 8, 8 });
+    HOST_CHECK(capacity == NrcCapacity({ 1280, 1280, 8, 8 }));
+
+    // Headroom stops at the maximum, requests beyond it are met exactly
+    capacity = policy.ComputeCapacity({ 3500, 2100, 9, 8 });
+    HOST_CHECK(capacity == NrcCapacity({ 3840, 2160, 16, 8 }));
+    capacity = policy.ComputeCapacity({ 5000, 3000, 20, 12 });
+    HOST_CHECK(capacity == NrcCapacity({ 5000, 3000, 20, 12 }));
+
+    // Never below the minimum
+    NrcCapacityPolicy defaultPolicy;
+    capacity = defaultPolicy.ComputeCapacity({ 640, 480, 1, 2 });
+    HOST_CHECK(capacity == defaultPolicy.GetDesc().minCapacity);
+}
+
+HOST_TEST(NrcCapacityPolicyGrowth)
+{
+    NrcCapacityPolicy policy;
+
+    uint64_t frameIndex = 0;
+    HOST_CHECK(policy.Update(frameIndex++, { 1920, 1080, 1, 8 }) == NrcCapacityAction::Reallocate);
+    HOST_CHECK(policy.GetCapacity() == NrcCapacity({ 2432, 1408, 1, 8 }));
+
+    // Only the axes that overflow grow, with headroom
+    HOST_CHECK(policy.Update(frameIndex++, { 2600, 1080, 1, 8 }) == NrcCapacityAction::Reallocate);
+    HOST_CHECK(policy.GetCapacity() == NrcCapacity({ 3264, 1408, 1, 8 }));
+
+    HOST_CHECK(policy.Update(frameIndex++, { 1920, 1500, 1, 8 }) == NrcCapacityAction::Reallocate);
+    HOST_CHECK(policy.GetCapacity() == NrcCapacity({ 3264, 1920, 1, 8 }));
+
+    HOST_CHECK(policy.Update(frameIndex++, { 1920, 1080, 3, 8 }) == NrcCapacityAction::Reallocate);
+    HOST_CHECK(policy.GetCapacity() == NrcCapacity({ 3264, 1920, 4, 8 }));
+
+    HOST_CHECK(policy.Update(frameIndex++, { 1920, 1080, 1, 10 }) == NrcCapacityAction::Reallocate);
+    HOST_CHECK(policy.GetCapacity() == NrcCapacity({ 3264, 1920, 4, 10 }));
+
+    // Everything in between fits now
+    HOST_CHECK(policy.Update(frameIndex++, { 3000, 1800, 4, 10 }) == NrcCapacityAction::Reconfigure);
+    HOST_CHECK(policy.GetReallocationNum() == 5);
+
+    // Reset starts over from the request alone
+    policy.Reset();
+    HOST_CHECK(policy.Update(frameIndex++, { 1920, 1080, 1, 8 }) == NrcCapacityAction::Reallocate);
+    HOST_CHECK(policy.GetCapacity() == NrcCapacity({ 2432, 1408, 1, 8 }));
+}
+
+HOST_TEST(NrcCapacityPolicyResizeTrace)
+{
+    NrcCapacityPolicy policy;
+
+    // A window dragged between sizes inside of the envelope, every size held for a few frames
+    const NrcCapacity requests[] = {
+        { 1920, 1080, 1, 8 }, { 2000, 1100, 1, 8 }, { 2100, 1200, 1, 8 }, { 2400, 1400, 1, 8 }, { 1600, 900, 1, 8 }, { 1600, 900, 1, 6 }, { 1600, 900, 1, 6 },
+    };
+
+    uint64_t frameIndex = 0;
+    uint32_t actionNums[3] = {};
+    for (const NrcCapacity& request : requests)
+    {
+        for (uint32_t repeatIndex = 0; repeatIndex < 4; ++repeatIndex)
+            actionNums[uint32_t(policy.Update(frameIndex++, request))]++;
+    }
+
+    // One allocation, a reconfiguration per change of the settings, nothing while they hold
+    HOST_CHECK(actionNums[uint32_t(NrcCapacityAction::Reallocate)] == 1);
+    HOST_CHECK(actionNums[uint32_t(NrcCapacityAction::Reconfigure)] == 5);
+    HOST_CHECK(actionNums[uint32_t(NrcCapacityAction::None)] == 4 * 7 - 6);
+    HOST_CHECK(policy.GetReallocationNum() == 1);
+    HOST_CHECK(policy.GetReconfigurationNum() == 5);
+    HOST_CHECK(policy.GetCapacity() == NrcCapacity({ 2432, 1408, 1, 8 }));
+}
+
+HOST_TEST(NrcCapacityPolicyShrink)
+{
+    NrcCapacityPolicy policy;
+    const uint32_t shrinkFrameNum = policy.GetDesc().shrinkFrameNum;
+
+    uint64_t frameIndex = 0;
+    policy.Update(frameIndex++, { 3840, 2160, 4, 8 });
+    HOST_CHECK(policy.GetCapacity() == NrcCapacity({ 3840, 2160, 4, 8 }));
+
+    // A quarter of the query paths isn't below the threshold
+    for (uint32_t frame = 0; frame < 2 * shrinkFrameNum; ++frame)
+        policy.Update(frameIndex++, { 1920, 1080, 4, 8 });
+    HOST_CHECK(policy.GetReallocationNum() == 1);
+
+    // Below it, a frame back above the threshold starts the count over
+    HOST_CHECK(policy.Update(frameIndex++, { 1920, 1080, 1, 8 }) == NrcCapacityAction::Reconfigure);
+    for (uint32_t frame = 1; frame < shrinkFrameNum; ++frame)
+        HOST_CHECK(policy.Update(frameIndex++, { 1920, 1080, 1, 8 }) == NrcCapacityAction::None);
+    HOST_CHECK(policy.Update(frameIndex++, { 3840, 2160, 4, 8 }) == NrcCapacityAction::Reconfigure);
+
+    const uint64_t firstBelowFrame = frameIndex;
+    while (frameIndex < firstBelowFrame + shrinkFrameNum)
+        HOST_CHECK(policy.Update(frameIndex++, { 1920, 1080, 1, 8 }) != NrcCapacityAction::Reallocate);
+    HOST_CHECK(policy.GetCapacity() == NrcCapacity({ 3840, 2160, 4, 8 }));
+
+    // 600 frames after the first frame below the threshold the envelope shrinks to what a fresh allocation would pick
+    HOST_CHECK(policy.Update(frameIndex++, { 1920, 1080, 1, 8 }) == NrcCapacityAction::Reallocate);
+    HOST_CHECK(policy.GetCapacity() == NrcCapacity({ 2432, 1408, 1, 8 }));
+    HOST_CHECK(policy.GetReallocationNum() == 2);
+
+    // Which is where it stays
+    for (uint32_t frame = 0; frame < 2 * shrinkFrameNum; ++frame)
+        HOST_CHECK(policy.Update(frameIndex++, { 1920, 1080, 1, 8 }) == NrcCapacityAction::None);
+}
@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "HostTests.h"
+
+#include "NrcStatsRing.h"
+
+#include <vector>
+
+namespace
+{
+// Slots complete when the test says so, the GPU value of a slot is the frame index it was recorded in
+class FakeNrcStatsFence : public NrcStatsFence
+{
+public:
+    explicit FakeNrcStatsFence(uint32_t slotNum) : m_complete(slotNum, false), m_values(slotNum, 0)
+    {
+    }
+
+    void Record(uint32_t slotIndex, uint64_t frameIndex)
+    {
+        m_complete[slotIndex] = false;
+        m_values[slotIndex] = uint32_t(frameIndex);
+    }
+
+    void Complete(uint32_t slotIndex)
+    {
+        m_complete[slotIndex] = true;
+    }
+
+    bool IsSlotComplete(uint32_t slotIndex) override
+    {
+        return m_complete[slotIndex];
+    }
+
+    void ReadSlot(uint32_t slotIndex, NrcFrameStats& stats) override
+    {
+        HOST_CHECK(m_complete[slotIndex]);
+        stats.counterNum = 1;
+        stats.counters[0] = m_values[slotIndex];
+    }
+
+private:
+    std::vector<bool> m_complete;
+    std::vector<uint32_t> m_values;
+};
+
+class CountingNrcStatsSink : public NrcStatsSink
+{
+public:
+    void Write(const NrcFrameStats& stats) override
+    {
+        frameIndices.push_back(stats.frameIndex);
+    }
+
+    std::vector<uint64_t> frameIndices;
+};
+
+void RecordFrame(NrcStatsRing& ring, FakeNrcStatsFence& fence, uint64_t frameIndex)
+{
+    const uint32_t slotIndex = ring.BeginFrame(frameIndex);
+    fence.Record(slotIndex, frameIndex);
+    ring.GetRecordedStats().memorySize = frameIndex * 100;
+    ring.EndFrame();
+}
+} // namespace
+
+HOST_TEST(NrcStatsRingInOrder)
+{
+    NrcStatsDesc desc;
+    desc.frameLatency = 3;
+    FakeNrcStatsFence fence(desc.frameLatency);
+    NrcStatsRing ring(desc, fence);
+    CountingNrcStatsSink sink;
+    ring.SetSink(&sink);
+
+    // The GPU finishes every frame two frames after it was recorded
+    for (uint64_t frameIndex = 0; frameIndex < 10; ++frameIndex)
+    {
+        if (frameIndex >= 2)
+            fence.Complete(uint32_t((frameIndex - 2) % desc.frameLatency));
+
+        RecordFrame(ring, fence, frameIndex);
+    }
+
+    HOST_CHECK(ring.GetReadFrameNum() == 8);
+    HOST_CHECK(ring.GetDroppedFrameNum() == 0);
+    HOST_CHECK(ring.GetHistory().size() == 8);
+    HOST_CHECK(sink.frameIndices.size() == 8);
+    for (uint64_t frameIndex = 0; frameIndex < ring.GetHistory().size(); ++frameIndex)
+    {
+        // The CPU values recorded with the frame and the GPU values read from its slot stay together
+        const NrcFrameStats& stats = ring.GetHistory()[frameIndex];
+        HOST_CHECK(stats.frameIndex == frameIndex);
+        HOST_CHECK(stats.memorySize == frameIndex * 100);
+        HOST_CHECK(stats.counterNum == 1 && stats.counters[0] == frameIndex);
+        HOST_CHECK(sink.frameIndices[frameIndex] == frameIndex);
+    }
+
+    // A newer slot that completed isn't read before the older one
+    FakeNrcStatsFence orderedFence(desc.frameLatency);
+    NrcStatsRing orderedRing(desc, orderedFence);
+    RecordFrame(orderedRing, orderedFence, 0);
+    RecordFrame(orderedRing, orderedFence, 1);
+    orderedFence.Complete(1);
+    RecordFrame(orderedRing, orderedFence, 2);
+    HOST_CHECK(orderedRing.GetHistory().empty());
+
+    orderedFence.Complete(0);
+    orderedFence.Complete(2);
+    orderedRing.BeginFrame(3);
+    HOST_CHECK(orderedRing.GetHistory().size() == 3);
+    for (uint64_t frameIndex = 0; frameIndex < orderedRing.GetHistory().size(); ++frameIndex)
+        HOST_CHECK(orderedRing.GetHistory()[frameIndex].frameIndex == frameIndex);
+}
+
+HOST_TEST(NrcStatsRingDroppedFrames)
+{
+    NrcStatsDesc desc;
+    desc.frameLatency = 2;
+    FakeNrcStatsFence fence(desc.frameLatency);
+    NrcStatsRing ring(desc, fence);
+
+    // Nothing completes, every slot is still pending when it comes around again
+    for (uint64_t frameIndex = 0; frameIndex < 6; ++frameIndex)
+        RecordFrame(ring, fence, frameIndex);
+
+    HOST_CHECK(ring.GetDroppedFrameNum() == 4);
+    HOST_CHECK(ring.GetReadFrameNum() == 0);
+    HOST_CHECK(ring.GetHistory().empty());
+
+    // Once the GPU catches up the frames that weren't overwritten are read, the reused slot holds the new frame
+    fence.Complete(0);
+    fence.Complete(1);
+    RecordFrame(ring, fence, 6);
+    HOST_CHECK(ring.GetDroppedFrameNum() == 4);
+    HOST_CHECK(ring.GetHistory().size() == 2);
+    HOST_CHECK(ring.GetHistory()[0].frameIndex == 4 && ring.GetHistory()[0].counters[0] == 4);
+    HOST_CHECK(ring.GetHistory()[1].frameIndex == 5 && ring.GetHistory()[1].counters[0] == 5);
+
+    // A frame that began but didn't end isn't pending, reusing its slot doesn't count as a drop
+    ring.BeginFrame(7);
+    fence.Complete(0);
+    RecordFrame(ring, fence, 8);
+    HOST_CHECK(ring.GetDroppedFrameNum() == 4);
+
+    // Reset forgets the pending slots without dropping them
+    ring.Reset();
+    HOST_CHECK(ring.GetHistory().empty());
+    RecordFrame(ring, fence, 9);
+    RecordFrame(ring, fence, 10);
+    HOST_CHECK(ring.GetDroppedFrameNum() == 4);
+}
+
+HOST_TEST(NrcStatsRingHistory)
+{
+    NrcStatsDesc desc;
+    desc.frameLatency = 2;
+    desc.historyLength = 4;
+    FakeNrcStatsFence fence(desc.frameLatency);
+    NrcStatsRing ring(desc, fence);
+
+    // The GPU finishes every frame before the next one begins
+    for (uint64_t frameIndex = 0; frameIndex < 10; ++frameIndex)
+    {
+        RecordFrame(ring, fence, frameIndex);
+        fence.Complete(uint32_t(frameIndex % desc.frameLatency));
+    }
+    ring.BeginFrame(10);
+
+    // The oldest frames are trimmed, the read count keeps growing
+    HOST_CHECK(ring.GetReadFrameNum() == 10);
+    HOST_CHECK(ring.GetHistory().size() == 4);
+    for (uint32_t historyIndex = 0; historyIndex < 4; ++historyIndex)
+        HOST_CHECK(ring.GetHistory()[historyIndex].frameIndex == 6 + historyIndex);
+}
+
+HOST_TEST(NrcStatsRingTrainingLoss)
+{
+    NrcStatsDesc desc;
+    desc.frameLatency = 2;
+    desc.historyLength = 4;
+    FakeNrcStatsFence fence(desc.frameLatency);
+    NrcStatsRing ring(desc, fence);
+    HOST_CHECK(ring.GetLastTrainingLoss() == nullptr);
+
+    // The loss is evaluated on frames 2 and 5 only
+    for (uint64_t frameIndex = 0; frameIndex < 8; ++frameIndex)
+    {
+        const uint32_t slotIndex = ring.BeginFrame(frameIndex);
+        fence.Record(slotIndex, frameIndex);
+        if (frameIndex == 2 || frameIndex == 5)
+        {
+            ring.GetRecordedStats().hasTrainingLoss = true;
+            ring.GetRecordedStats().trainingLoss = 0.5f / float(frameIndex);
+        }
+        ring.EndFrame();
+        fence.Complete(slotIndex);
+
+        // Frame 5 isn't read until frame 6 begins
+        const NrcFrameStats* lossStats = ring.GetLastTrainingLoss();
+        if (frameIndex < 3)
+            HOST_CHECK(lossStats == nullptr);
+        else if (frameIndex < 6)
+            HOST_CHECK(lossStats && lossStats->frameIndex == 2 && lossStats->trainingLoss == 0.25f);
+        else
+            HOST_CHECK(lossStats && lossStats->frameIndex == 5 && lossStats->trainingLoss == 0.1f);
+    }
+
+    // Once the frame with the loss is trimmed from the time series there is none
+    for (uint64_t frameIndex = 8; frameIndex < 11; ++frameIndex)
+    {
+        RecordFrame(ring, fence, frameIndex);
+        fence.Complete(uint32_t(frameIndex % desc.frameLatency));
+    }
+    ring.BeginFrame(11);
+    HOST_CHECK(ring.GetHistory().front().frameIndex == 7);
+    HOST_CHECK(ring.GetLastTrainingLoss() == nullptr);
+}
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "HostTests.h"
+
+#include "SceneCache.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+// Two triangles of one geometry, instanced twice
+SceneCacheData CreateCacheData()
+{
+    SceneCacheData data;
+    data.positions = { 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 1.0f, 1.0f, 0.0f };
+    data.normals = { 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f };
+    data.texCoords = { 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 1.0f, 1.0f, 1.0f };
+    data.indices = { 0, 1, 2, 2, 1, 3 };
+
+    SceneCacheMaterial material = {};
+    material.name = data.AddString("Quad");
+    material.baseColor[0] = material.baseColor[1] = material.baseColor[2] = material.baseColor[3] = 1.0f;
+    material.baseColorTexture = data.AddString("Textures/Quad.png");
+    material.metalRoughTexture = material.normalTexture = material.emissiveTexture = c_SceneCacheInvalidString;
+    data.materials.push_back(material);
+
+    data.geometries.push_back({ 0, 6, 0, 4, 0 });
+    data.meshes.push_back({ data.AddString("Quad"), 0, 1, 2, 4 });
+
+    SceneCacheInstance instance = {};
+    instance.transform[0] = instance.transform[5] = instance.transform[10] = 1.0f;
+    data.instances.push_back(instance);
+    instance.transform[3] = 2.0f;
+    data.instances.push_back(instance);
+
+    SceneCacheLight light = {};
+    light.name = data.AddString("Lamp");
+    light.type = uint32_t(SceneCacheLightType::Spot);
+    light.flags = SceneCacheLightFlags_HasDirection;
+    light.direction[1] = -1.0f;
+    data.lights.push_back(light);
+
+    SceneCacheCamera camera = {};
+    camera.name = data.AddString("DefaultCamera");
+    camera.verticalFov = 1.0f;
+    data.cameras.push_back(camera);
+
+    return data;
+}
+
+std::string WriteCache(const SceneCacheData& data)
+{
+    std::stringstream stream;
+    HOST_CHECK(SceneCacheWrite(stream, data));
+
+    return stream.str();
+}
+
+void WriteFile(const std::filesystem::path& path, const std::string& contents)
+{
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    stream.write(contents.data(), contents.size());
+}
+} // namespace
+
+HOST_TEST(SceneCacheRoundTrip)
+{
+    const SceneCacheData data = CreateCacheData();
+    const std::string cache = WriteCache(data);
+
+    SceneCacheReader reader;
+    HOST_CHECK(reader.Open(cache.data(), cache.size()));
+    HOST_CHECK(reader.GetFlags() == 0);
+
+    uint32_t indexNum, geometryNum, instanceNum, materialNum, lightNum, cameraNum;
+    const uint32_t* indices = reader.GetSection<uint32_t>(SceneCacheSection::Indices, indexNum);
+    const SceneCacheGeometry* geometries = reader.GetSection<SceneCacheGeometry>(SceneCacheSection::Geometries, geometryNum);
+    const SceneCacheInstance* instances = reader.GetSection<SceneCacheInstance>(SceneCacheSection::Instances, instanceNum);
+    const SceneCacheMaterial* materials = reader.GetSection<SceneCacheMaterial>(SceneCacheSection::Materials, materialNum);
+    const SceneCacheLight* lights = reader.GetSection<SceneCacheLight>(SceneCacheSection::Lights, lightNum);
+    const SceneCacheCamera* cameras = reader.GetSection<SceneCacheCamera>(SceneCacheSection::Cameras, cameraNum);
+    HOST_CHECK(indexNum == data.indices.size() && memcmp(indices, data.indices.data(), indexNum * sizeof(uint32_t)) == 0);
+    HOST_CHECK(geometryNum == 1 && geometries[0].indexCount == 6 && geometries[0].vertexCount == 4);
+    HOST_CHECK(instanceNum == 2 && instances[1].transform[3] == 2.0f);
+    HOST_CHECK(materialNum == 1 && strcmp(reader.GetString(materials[0].baseColorTexture), "Textures/Quad.png") == 0);
+    HOST_CHECK(strcmp(reader.GetString(materials[0].normalTexture), "") == 0);
+    HOST_CHECK(lightNum == 1 && lights[0].type == uint32_t(SceneCacheLightType::Spot) && lights[0].direction[1] == -1.0f);
+    HOST_CHECK(cameraNum == 1 && strcmp(reader.GetString(cameras[0].name), "DefaultCamera") == 0);
+
+    for (uint32_t section = 0; section < uint32_t(SceneCacheSection::Count); ++section)
+    {
+        uint64_t size;
+        const uint8_t* sectionData = (const uint8_t*)reader.GetSection(SceneCacheSection(section), size);
+        HOST_CHECK(uint64_t(sectionData - (const uint8_t*)cache.data()) % c_SceneCacheAlignment == 0);
+    }
+
+    SceneCacheData partialData = CreateCacheData();
+    partialData.flags = SceneCacheFlags_Partial;
+    const std::string partialCache = WriteCache(partialData);
+    HOST_CHECK(reader.Open(partialCache.data(), partialCache.size()));
+    HOST_CHECK(reader.GetFlags() == SceneCacheFlags_Partial);
+}
+
+HOST_TEST(SceneCacheCorruptedTables)
+{
+    SceneCacheData data = CreateCacheData();
+    data.instances[1].meshIndex = 1;
+    std::string cache = WriteCache(data);
+
+    SceneCacheReader reader;
+    HOST_CHECK(!reader.Open(cache.data(), cache.size()));
+
+    data = CreateCacheData();
+    data.geometries[0].indexCount = 9;
+    cache = WriteCache(data);
+    HOST_CHECK(!reader.Open(cache.data(), cache.size()));
+
+    // The loader addresses the geometries of a mesh relative to its first geometry
+    data = CreateCacheData();
+    data.geometries.push_back({ 0, 3, 0, 3, 0 });
+    data.geometries[0].indexOffset = 3;
+    data.geometries[0].indexCount = 3;
+    data.meshes[0].geometryCount = 2;
+    cache = WriteCache(data);
+    HOST_CHECK(!reader.Open(cache.data(), cache.size()));
+
+    data = CreateCacheData();
+    data.lights[0].type = uint32_t(SceneCacheLightType::Count);
+    cache = WriteCache(data);
+    HOST_CHECK(!reader.Open(cache.data(), cache.size()));
+
+    data = CreateCacheData();
+    data.sources.push_back({ uint32_t(data.strings.size()), 0, 0, 0 });
+    cache = WriteCache(data);
+    HOST_CHECK(!reader.Open(cache.data(), cache.size()));
+
+    // Truncated sections fail the header checks
+    data = CreateCacheData();
+    cache = WriteCache(data);
+    cache.resize(cache.size() - 1);
+    HOST_CHECK(!reader.Open(cache.data(), cache.size()));
+}
+
+HOST_TEST(SceneCacheSourceHashes)
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "PathtracerHostTests.SceneCache";
+    std::filesystem::create_directories(directory / "Models");
+
+    const std::string scene = "{ \"models\": [ \"Models/Quad.gltf\" ] }";
+    const std::string model = "{ \"asset\": { \"version\": \"2.0\" } }";
+    WriteFile(directory / "Quad.scene.json", scene);
+    WriteFile(directory / "Models/Quad.gltf", model);
+
+    SceneCacheData data = CreateCacheData();
+    data.AddSource("Quad.scene.json", scene.data(), scene.size());
+    data.AddSource("Models/Quad.gltf", model.data(), model.size());
+
+    uint64_t size, hash;
+    HOST_CHECK(SceneCacheHashFile(directory / "Models/Quad.gltf", size, hash));
+    HOST_CHECK(size == model.size() && hash == data.sources[1].hash);
+
+    const std::filesystem::path cachePath = directory / "Quad.scene.json.scenecache";
+    HOST_CHECK(SceneCacheWriteFile(cachePath, data));
+
+    SceneCacheReader reader;
+    HOST_CHECK(reader.Open(cachePath));
+    HOST_CHECK(reader.IsCurrent(directory));
+
+    // An edit of the same size with the old modification time is still found
+    std::string editedModel = model;
+    editedModel[editedModel.size() - 4] = '1';
+    const auto writeTime = std::filesystem::last_write_time(directory / "Models/Quad.gltf");
+    WriteFile(directory / "Models/Quad.gltf", editedModel);
+    std::filesystem::last_write_time(directory / "Models/Quad.gltf", writeTime);
+    HOST_CHECK(!reader.IsCurrent(directory));
+
+    // Restoring the contents makes the cache current again, a missing source makes it stale
+    WriteFile(directory / "Models/Quad.gltf", model);
+    HOST_CHECK(reader.IsCurrent(directory));
+
+    std::filesystem::remove(directory / "Quad.scene.json");
+    HOST_CHECK(!reader.IsCurrent(directory));
+
+    // A cache without sources is never current
+    reader.Close();
+    const std::string cache = WriteCache(CreateCacheData());
+    HOST_CHECK(reader.Open(cache.data(), cache.size()));
+    HOST_CHECK(!reader.IsCurrent(directory));
+
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "HostTests.h"
+
+#include "ScratchUsageTracker.h"
+
+HOST_TEST(ScratchUsageTrackerAlignment)
+{
+    ScratchUsageTracker tracker(256);
+    HOST_CHECK(tracker.GetChunkSize() == 256);
+
+    tracker.Reset(1000);
+    HOST_CHECK(tracker.GetChunkSize() == 1024);
+
+    tracker.Request(1);
+    tracker.Request(256);
+    tracker.Request(257);
+    HOST_CHECK(!tracker.EndFrame());
+    HOST_CHECK(tracker.GetFrameSize() == 1024);
+}
+
+HOST_TEST(ScratchUsageTrackerGrowth)
+{
+    ScratchUsageTracker tracker(256);
+    tracker.Reset(1024);
+
+    // Frames are measured on their own, the chunk only grows when a single frame exceeds it
+    for (uint32_t frameIndex = 0; frameIndex < 4; ++frameIndex)
+    {
+        tracker.Request(512);
+        tracker.Request(512);
+        HOST_CHECK(!tracker.EndFrame());
+    }
+    HOST_CHECK(tracker.GetChunkSize() == 1024);
+
+    tracker.Request(1024);
+    tracker.Request(300);
+    HOST_CHECK(tracker.EndFrame());
+    HOST_CHECK(tracker.GetChunkSize() == 1536);
+
+    // Smaller frames don't shrink it
+    HOST_CHECK(!tracker.EndFrame());
+    HOST_CHECK(tracker.GetFrameSize() == 0);
+    HOST_CHECK(tracker.GetChunkSize() == 1536);
+
+    tracker.Reset(0);
+    HOST_CHECK(tracker.GetChunkSize() == 256);
+}
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "HostTests.h"
+
+#include "SharcCapacityController.h"
+
+#include <vector>
+
+// Synthetic occupancy traces, every frame reports the live entry count of the current table and updates the controller
+
+namespace
+{
+const uint32_t c_MiB = 1024 * 1024;
+
+struct TraceFrame
+{
+    SharcCapacityAction action;
+    uint32_t rehashBegin;
+    uint32_t rehashEnd;
+};
+
+TraceFrame RunFrame(SharcCapacityController& controller, uint64_t frameIndex, uint32_t liveEntryNum)
+{
+    controller.ReportOccupancy(frameIndex, liveEntryNum, controller.GetEntriesNum());
+
+    TraceFrame frame;
+    frame.action = controller.Update(frameIndex);
+    controller.GetRehashRange(frame.rehashBegin, frame.rehashEnd);
+
+    return frame;
+}
+
+// Runs a resize from its first frame to the switch, the ranges have to cover the old table in order
+void CheckRehash(SharcCapacityController& controller, uint64_t& frameIndex, uint32_t liveEntryNum, const TraceFrame& beginFrame)
+{
+    const uint32_t entriesNum = controller.GetEntriesNum();
+    const uint32_t rehashFrameNum = controller.GetDesc().rehashFrameNum;
+
+    HOST_CHECK(beginFrame.action == SharcCapacityAction::BeginRehash);
+    HOST_CHECK(controller.IsRehashing());
+    HOST_CHECK(beginFrame.rehashBegin == 0);
+
+    uint32_t rehashEnd = beginFrame.rehashEnd;
+    for (uint32_t rehashFrame = 1; rehashFrame < rehashFrameNum; ++rehashFrame)
+    {
+        // Samples during the resize are ignored
+        const TraceFrame frame = RunFrame(controller, ++frameIndex, liveEntryNum);
+        HOST_CHECK(frame.action == (rehashFrame + 1 == rehashFrameNum ? SharcCapacityAction::Finish : SharcCapacityAction::Rehash));
+        HOST_CHECK(frame.rehashBegin == rehashEnd);
+        HOST_CHECK(frame.rehashEnd > frame.rehashBegin);
+        rehashEnd = frame.rehashEnd;
+
+        if (rehashFrame + 1 < rehashFrameNum)
+            HOST_CHECK(controller.GetEntriesNum() == entriesNum);
+    }
+
+    HOST_CHECK(rehashEnd == entriesNum);
+    HOST_CHECK(!controller.IsRehashing());
+}
+} // namespace
+
+HOST_TEST(SharcCapacityControllerGrowth)
+{
+    SharcCapacityControllerDesc desc;
+    desc.initialEntriesNum = 1 * c_MiB;
+    SharcCapacityController controller(desc);
+
+    // 60% occupancy, three samples above the band aren't enough and a sample inside of it starts over
+    const uint32_t liveEntryNum = 629146;
+    uint64_t frameIndex = 0;
+    for (; frameIndex < 3; ++frameIndex)
+        HOST_CHECK(RunFrame(controller, frameIndex, liveEntryNum).action == SharcCapacityAction::None);
+    HOST_CHECK(RunFrame(controller, frameIndex++, 300000).action == SharcCapacityAction::None);
+
+    for (uint32_t sampleIndex = 0; sampleIndex < 3; ++sampleIndex)
+        HOST_CHECK(RunFrame(controller, frameIndex++, liveEntryNum).action == SharcCapacityAction::None);
+
+    const TraceFrame beginFrame = RunFrame(controller, frameIndex, liveEntryNum);
+    HOST_CHECK(controller.GetLastOccupancy() > desc.growOccupancy);
+
+    // The smallest power of two that places the occupancy at or below 25%: 2M entries would be at 30%
+    const uint32_t targetEntriesNum = controller.GetTargetEntriesNum();
+    HOST_CHECK(targetEntriesNum == 4 * c_MiB);
+    HOST_CHECK(float(liveEntryNum) / float(targetEntriesNum) <= desc.targetOccupancy);
+    HOST_CHECK(float(liveEntryNum) / float(targetEntriesNum / 2) > desc.targetOccupancy);
+
+    CheckRehash(controller, frameIndex, liveEntryNum, beginFrame);
+    HOST_CHECK(controller.GetEntriesNum() == 4 * c_MiB);
+    HOST_CHECK(controller.GetResizeNum() == 1);
+}
+
+HOST_TEST(SharcCapacityControllerShrink)
+{
+    SharcCapacityControllerDesc desc;
+    desc.initialEntriesNum = 4 * c_MiB;
+    SharcCapacityController controller(desc);
+
+    // 1% occupancy needs 120 consecutive samples
+    const uint32_t liveEntryNum = 40000;
+    uint64_t frameIndex = 0;
+    for (; frameIndex < 119; ++frameIndex)
+        HOST_CHECK(RunFrame(controller, frameIndex, liveEntryNum).action == SharcCapacityAction::None);
+
+    // A single sample above the band starts the count over
+    HOST_CHECK(RunFrame(controller, frameIndex++, 3 * c_MiB).action == SharcCapacityAction::None);
+    for (uint32_t sampleIndex = 0; sampleIndex < 119; ++sampleIndex)
+        HOST_CHECK(RunFrame(controller, frameIndex++, liveEntryNum).action == SharcCapacityAction::None);
+
+    // 160000 entries would place it at 25%, capacities don't go below the minimum
+    const TraceFrame beginFrame = RunFrame(controller, frameIndex, liveEntryNum);
+    HOST_CHECK(controller.GetTargetEntriesNum() == desc.minEntriesNum);
+
+    CheckRehash(controller, frameIndex, liveEntryNum, beginFrame);
+    HOST_CHECK(controller.GetEntriesNum() == desc.minEntriesNum);
+}
+
+HOST_TEST(SharcCapacityControllerCooldown)
+{
+    SharcCapacityControllerDesc desc;
+    desc.initialEntriesNum = 1 * c_MiB;
+    SharcCapacityController controller(desc);
+
+    uint64_t frameIndex = 0;
+    for (; frameIndex < 3; ++frameIndex)
+        RunFrame(controller, frameIndex, 629146);
+    CheckRehash(controller, frameIndex, 629146, RunFrame(controller, frameIndex, 629146));
+    HOST_CHECK(controller.GetEntriesNum() == 4 * c_MiB);
+
+    // 75% of the new table is ignored until the cooldown ends
+    const uint64_t switchFrame = frameIndex;
+    while (++frameIndex < switchFrame + desc.cooldownFrameNum)
+        HOST_CHECK(RunFrame(controller, frameIndex, 3 * c_MiB).action == SharcCapacityAction::None);
+
+    for (uint32_t sampleIndex = 0; sampleIndex + 1 < desc.growSampleNum; ++sampleIndex)
+        HOST_CHECK(RunFrame(controller, frameIndex++, 3 * c_MiB).action == SharcCapacityAction::None);
+    HOST_CHECK(RunFrame(controller, frameIndex, 3 * c_MiB).action == SharcCapacityAction::BeginRehash);
+}
+
+HOST_TEST(SharcCapacityControllerSteadyTrace)
+{
+    SharcCapacityControllerDesc desc;
+    desc.initialEntriesNum = 1 * c_MiB;
+    SharcCapacityController controller(desc);
+
+    // A steady workload resizes once, then the working set drops and the table shrinks once. No capacity in between
+    // puts the occupancy back outside of the band
+    uint32_t resizeFrameNum = 0;
+    for (uint64_t frameIndex = 0; frameIndex < 2000; ++frameIndex)
+    {
+        const uint32_t liveEntryNum = frameIndex < 1000 ? 629146 : 40000;
+        if (RunFrame(controller, frameIndex, liveEntryNum).action == SharcCapacityAction::BeginRehash)
+            resizeFrameNum++;
+
+        const float occupancy = float(liveEntryNum) / float(controller.GetEntriesNum());
+        if (frameIndex > 100 && frameIndex < 1000)
+            HOST_CHECK(occupancy > desc.shrinkOccupancy && occupancy < desc.growOccupancy);
+    }
+
+    HOST_CHECK(resizeFrameNum == 2);
+    HOST_CHECK(controller.GetResizeNum() == 2);
+    HOST_CHECK(controller.GetEntriesNum() == desc.minEntriesNum);
+}
+
+HOST_TEST(SharcCapacityControllerLimit)
+{
+    SharcCapacityControllerDesc desc;
+    desc.initialEntriesNum = 4 * c_MiB;
+    SharcCapacityController controller(desc);
+    HOST_CHECK(controller.GetEntriesNumLimit() == desc.maxEntriesNum);
+
+    // Limits are rounded down to a power of two and clamped to the capacity range
+    controller.SetEntriesNumLimit(3 * c_MiB);
+    HOST_CHECK(controller.GetEntriesNumLimit() == 2 * c_MiB);
+    controller.SetEntriesNumLimit(1);
+    HOST_CHECK(controller.GetEntriesNumLimit() == desc.minEntriesNum);
+    controller.SetEntriesNumLimit(~0u);
+    HOST_CHECK(controller.GetEntriesNumLimit() == desc.maxEntriesNum);
+
+    // A table above the limit shrinks without waiting for samples
+    controller.SetEntriesNumLimit(2 * c_MiB);
+    uint64_t frameIndex = 0;
+    const TraceFrame beginFrame = RunFrame(controller, frameIndex, 0);
+    HOST_CHECK(controller.GetTargetEntriesNum() == 2 * c_MiB);
+    CheckRehash(controller, frameIndex, 0, beginFrame);
+    HOST_CHECK(controller.GetEntriesNum() == 2 * c_MiB);
+
+    // Growth stops at the limit, the required capacity still reports what the occupancy asks for
+    frameIndex += desc.cooldownFrameNum;
+    for (uint32_t sampleIndex = 0; sampleIndex < 16; ++sampleIndex)
+        HOST_CHECK(RunFrame(controller, ++frameIndex, 2 * c_MiB).action == SharcCapacityAction::None);
+    HOST_CHECK(controller.GetEntriesNum() == 2 * c_MiB);
+    HOST_CHECK(controller.GetRequiredEntriesNum() == 8 * c_MiB);
+}
@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "HostTests.h"
+
+#include "SharcCpu.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <random>
+
+using namespace SharcCpu;
+
+// Packed voxel data (SHARC_PACKED_VOXEL_DATA) against the 32-bit integer accumulation scaled by SHARC_RADIANCE_SCALE
+
+namespace
+{
+// Platform independent, std::uniform_real_distribution isn't
+float GetRandomFloat(std::mt19937& random)
+{
+    return float(random() >> 8) / float(1u << 24);
+}
+
+float GetMaxComponent(const float3& value)
+{
+    return std::max(value.x, std::max(value.y, value.z));
+}
+
+float GetMaxDifference(const float3& a, const float3& b)
+{
+    return std::max(std::fabs(a.x - b.x), std::max(std::fabs(a.y - b.y), std::fabs(a.z - b.z)));
+}
+
+float3 ResolveVoxelData(const uint4& voxelData)
+{
+    const uint32_t accumulatedRadiance[3] = { voxelData.x, voxelData.y, voxelData.z };
+
+    return SharcResolveAccumulatedRadiance(accumulatedRadiance, SharcGetSampleNum(voxelData.w));
+}
+
+// Rounding to the nearest mantissa step, half of the step of the largest component, plus the float rounding of the encoder
+float GetRGB9E5ErrorBound(const float3& value)
+{
+    return GetMaxComponent(value) / 512.0f * 1.001f + std::exp2(-25.0f);
+}
+} // namespace
+
+HOST_TEST(SharcPackedRadianceErrorBound)
+{
+    std::mt19937 random(1);
+    for (uint32_t i = 0; i < 200000; ++i)
+    {
+        // Magnitudes from 2^-24 to 2^16
+        const float magnitude = std::exp2(GetRandomFloat(random) * 40.0f - 24.0f);
+        const float3 value = { GetRandomFloat(random) * magnitude, GetRandomFloat(random) * magnitude, GetRandomFloat(random) * magnitude };
+        if (GetMaxComponent(value) > c_SharcPackedRadianceMax)
+            continue;
+
+        const float3 unpacked = SharcUnpackRGB9E5(SharcPackRGB9E5(value));
+        HOST_CHECK(GetMaxDifference(unpacked, value) <= GetRGB9E5ErrorBound(value));
+    }
+
+    const float3 clamped = SharcUnpackRGB9E5(SharcPackRGB9E5({ 1e9f, -1.0f, NAN }));
+    HOST_CHECK(clamped.x == c_SharcPackedRadianceMax && clamped.y == 0.0f && clamped.z == 0.0f);
+}
+
+HOST_TEST(SharcPackedVoxelDataErrorBound)
+{
+    std::mt19937 random(2);
+    for (uint32_t i = 0; i < 100000; ++i)
+    {
+        const uint32_t sampleNum = 1 + random() % 4096;
+        const uint32_t accumulatedFrameNum = random() % (c_SharcAccumulatedFrameNumMax + 1);
+        const uint32_t staleFrameNum = random() % (c_SharcStaleFrameNumBitMask + 1);
+        const float magnitude = std::exp2(GetRandomFloat(random) * 12.0f - 6.0f);
+
+        // Same representation as the update pass, capped to stay within 32 bits
+        uint4 voxelData;
+        voxelData.x = uint32_t(std::min(GetRandomFloat(random) * magnitude * sampleNum * c_SharcRadianceScale, 4e9f));
+        voxelData.y = uint32_t(std::min(GetRandomFloat(random) * magnitude * sampleNum * c_SharcRadianceScale, 4e9f));
+        voxelData.z = uint32_t(std::min(GetRandomFloat(random) * magnitude * sampleNum * c_SharcRadianceScale, 4e9f));
+        voxelData.w = (sampleNum << c_SharcSampleNumBitOffset) | (accumulatedFrameNum << c_SharcAccumulatedFrameNumBitOffset) |
+                      (staleFrameNum << c_SharcStaleFrameNumBitOffset);
+
+        const uint4 unpacked = SharcUnpackPackedVoxelData(SharcPackVoxelData(voxelData));
+
+        // Counters are kept as they are
+        HOST_CHECK(unpacked.w == voxelData.w);
+
+        // Converting back to integers adds half a step of the 32-bit representation
+        const float3 radiance = ResolveVoxelData(voxelData);
+        const float bound = GetRGB9E5ErrorBound(radiance) + 0.5f / (sampleNum * c_SharcRadianceScale);
+        HOST_CHECK(GetMaxDifference(ResolveVoxelData(unpacked), radiance) <= bound);
+    }
+
+    // Entries without samples stay empty
+    const uint4 empty = SharcUnpackPackedVoxelData(SharcPackVoxelData({ 123, 456, 789, 0 }));
+    HOST_CHECK(empty.x == 0 && empty.y == 0 && empty.z == 0 && empty.w == 0);
+}
+
+// Both caches see the same samples, the packed history is requantized on every resolve. Radiance feeds back into the
+// anti-firefly filter, so the bound is checked once the entries have converged over a few accumulation windows
+HOST_TEST(SharcPackedCacheErrorBound)
+{
+    for (bool enableLiveEntryList : { false, true })
+    {
+        SharcCacheDesc desc;
+        desc.entriesNum = 1 << 16;
+        desc.enableLiveEntryList = enableLiveEntryList;
+        SharcCache cache(desc);
+
+        desc.packedVoxelData = true;
+        SharcCache packedCache(desc);
+
+        HOST_CHECK(packedCache.GetMemorySize() < cache.GetMemorySize());
+
+        for (uint32_t frameIndex = 0; frameIndex < 60; ++frameIndex)
+        {
+            const float3 cameraPosition = { frameIndex * 0.05f, 1.0f, 0.0f };
+            cache.SetCameraPosition(cameraPosition);
+            packedCache.SetCameraPosition(cameraPosition);
+            cache.BeginFrame();
+            packedCache.BeginFrame();
+
+            const SharcParameters parameters = cache.GetParameters();
+            const SharcParameters packedParameters = packedCache.GetParameters();
+
+            std::mt19937 random(frameIndex);
+            for (uint32_t pathIndex = 0; pathIndex < 4000; ++pathIndex)
+            {
+                SharcState state, packedState;
+                SharcInit(state);
+                SharcInit(packedState);
+
+                for (uint32_t bounce = 0; bounce < 3; ++bounce)
+                {
+                    SharcHitData hitData;
+                    hitData.positionWorld = { GetRandomFloat(random) * 20.0f - 10.0f, GetRandomFloat(random) * 2.0f, GetRandomFloat(random) * 20.0f - 10.0f };
+                    hitData.normalWorld = { 0.0f, 1.0f, 0.0f };
+                    const float3 directLighting = { GetRandomFloat(random) * 5.0f, GetRandomFloat(random) * 5.0f, GetRandomFloat(random) * 5.0f };
+                    const float pathRandom = GetRandomFloat(random);
+
+                    const bool continuePath = cache.UpdateHit(parameters, state, hitData, directLighting, pathRandom);
+                    const bool continuePackedPath = packedCache.UpdateHit(packedParameters, packedState, hitData, directLighting, pathRandom);
+                    if (!continuePath || !continuePackedPath)
+                        break;
+
+                    SharcSetThroughput(state, { 0.5f, 0.5f, 0.5f });
+                    SharcSetThroughput(packedState, { 0.5f, 0.5f, 0.5f });
+                }
+            }
+
+            cache.Resolve();
+            packedCache.Resolve();
+        }
+
+        HOST_CHECK(cache.GetHashEntries() == packedCache.GetHashEntries());
+
+        std::mt19937 random(99);
+        uint32_t hitNum = 0;
+        double relativeErrorSum = 0.0;
+        for (uint32_t queryIndex = 0; queryIndex < 20000; ++queryIndex)
+        {
+            SharcHitData hitData;
+            hitData.positionWorld = { GetRandomFloat(random) * 20.0f - 10.0f, GetRandomFloat(random) * 2.0f, GetRandomFloat(random) * 20.0f - 10.0f };
+            hitData.normalWorld = { 0.0f, 1.0f, 0.0f };
+
+            float3 radiance, packedRadiance;
+            const bool valid = cache.GetCachedRadiance(hitData, radiance);
+            const bool packedValid = packedCache.GetCachedRadiance(hitData, packedRadiance);
+            HOST_CHECK(valid == packedValid);
+            if (!valid || !packedValid)
+                continue;
+
+            // Relative to the largest component, a few requantizations of 1/512 at most
+            const float relativeError = GetMaxDifference(radiance, packedRadiance) / std::max(GetMaxComponent(radiance), 1e-3f);
+            HOST_CHECK(relativeError <= 8.0f / 512.0f);
+            relativeErrorSum += relativeError;
+            ++hitNum;
+        }
+
+        HOST_CHECK(hitNum > 1000);
+        HOST_CHECK(relativeErrorSum / std::max(hitNum, 1u) <= 1.0 / 512.0);
+    }
+}
+
+// The live entry list replaces the full clear of the buffer accumulated into with resets of the listed slots during compaction.
+// Live entry list mode doesn't compact the hash map, so the reference is a cache in the same mode with the whole buffer cleared
+// at the start of every frame. The sample region moves along with the camera, entries behind it go stale and leave the list
+HOST_TEST(SharcLiveEntryListClear)
+{
+    for (bool packedVoxelData : { false, true })
+    {
+        SharcCacheDesc desc;
+        desc.entriesNum = 1 << 16;
+        desc.staleFrameNum = 8;
+        desc.enableLiveEntryList = true;
+        desc.packedVoxelData = packedVoxelData;
+        SharcCache cache(desc);
+        SharcCache liveCache(desc);
+
+        for (uint32_t frameIndex = 0; frameIndex < 40; ++frameIndex)
+        {
+            const float3 cameraPosition = { frameIndex * 0.2f, 1.0f, 0.0f };
+            cache.SetCameraPosition(cameraPosition);
+            liveCache.SetCameraPosition(cameraPosition);
+            cache.BeginFrame();
+            liveCache.BeginFrame();
+
+            // Every slot written on an earlier frame has been reset by the time the frame accumulates into it
+            bool isCleared = true;
+            for (const uint4& voxelData : liveCache.GetVoxelData())
+                isCleared &= voxelData.x == 0 && voxelData.y == 0 && voxelData.z == 0 && voxelData.w == 0;
+            HOST_CHECK(isCleared);
+            HOST_CHECK(liveCache.GetLiveEntryNum() == liveCache.GetOccupiedEntryNum());
+
+            const SharcParameters parameters = cache.GetParameters();
+            const SharcParameters liveParameters = liveCache.GetParameters();
+            std::fill(parameters.voxelDataBuffer, parameters.voxelDataBuffer + desc.entriesNum, uint4());
+
+            std::mt19937 random(frameIndex);
+            for (uint32_t pathIndex = 0; pathIndex < 4000; ++pathIndex)
+            {
+                SharcState state, liveState;
+                SharcInit(state);
+                SharcInit(liveState);
+
+                for (uint32_t bounce = 0; bounce < 3; ++bounce)
+                {
+                    SharcHitData hitData;
+                    hitData.positionWorld = { cameraPosition.x + GetRandomFloat(random) * 8.0f - 4.0f, GetRandomFloat(random) * 2.0f, GetRandomFloat(random) * 8.0f - 4.0f };
+                    hitData.normalWorld = { 0.0f, 1.0f, 0.0f };
+                    const float3 directLighting = { GetRandomFloat(random) * 5.0f, GetRandomFloat(random) * 5.0f, GetRandomFloat(random) * 5.0f };
+                    const float pathRandom = GetRandomFloat(random);
+
+                    const bool continuePath = cache.UpdateHit(parameters, state, hitData, directLighting, pathRandom);
+                    const bool continueLivePath = liveCache.UpdateHit(liveParameters, liveState, hitData, directLighting, pathRandom);
+                    HOST_CHECK(continuePath == continueLivePath);
+                    if (!continuePath || !continueLivePath)
+                        break;
+
+                    SharcSetThroughput(state, { 0.5f, 0.5f, 0.5f });
+                    SharcSetThroughput(liveState, { 0.5f, 0.5f, 0.5f });
+                }
+            }
+
+            cache.Resolve();
+            liveCache.Resolve();
+            HOST_CHECK(cache.GetHashEntries() == liveCache.GetHashEntries());
+        }
+
+        std::mt19937 random(99);
+        uint32_t hitNum = 0;
+        for (uint32_t queryIndex = 0; queryIndex < 20000; ++queryIndex)
+        {
+            SharcHitData hitData;
+            hitData.positionWorld = { 7.8f + GetRandomFloat(random) * 8.0f - 4.0f, GetRandomFloat(random) * 2.0f, GetRandomFloat(random) * 8.0f - 4.0f };
+            hitData.normalWorld = { 0.0f, 1.0f, 0.0f };
+
+            float3 radiance, liveRadiance;
+            const bool valid = cache.GetCachedRadiance(hitData, radiance);
+            const bool liveValid = liveCache.GetCachedRadiance(hitData, liveRadiance);
+            HOST_CHECK(valid == liveValid);
+            if (!valid || !liveValid)
+                continue;
+
+            HOST_CHECK(memcmp(&radiance, &liveRadiance, sizeof(float3)) == 0);
+            ++hitNum;
+        }
+
+        HOST_CHECK(hitNum > 500);
+    }
+}
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "HostTests.h"
+
+#include "SharcSnapshot.h"
+
+#include <cstring>
+#include <filesystem>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace SharcCpu;
+
+namespace
+{
+// Layout of the file, see SharcSnapshot.cpp
+const size_t c_HeaderSize = 256;
+const size_t c_MagicOffset = 0;
+const size_t c_VersionOffset = 4;
+const size_t c_ChunkNumOffset = 16;
+const size_t c_ChunkSize = 32;
+const size_t c_ChunkHashEntriesOffset = 0;
+const size_t c_ChunkHashEntriesSizeOffset = 16;
+
+struct SnapshotData
+{
+    SharcSnapshotDesc desc;
+    std::vector<HashGridKey> hashEntries;
+    std::vector<uint4> voxelData;
+};
+
+// A quarter of the entries is live, voxel data of the empty ones isn't zero and must not survive the round trip
+SnapshotData CreateSnapshotData(uint32_t entriesNum, uint32_t seed)
+{
+    SnapshotData data;
+    data.desc.sceneName = "Bistro.scene.json";
+    data.desc.sceneScale = 42.0f;
+    data.desc.entriesNum = entriesNum;
+    data.hashEntries.resize(entriesNum, c_HashGridInvalidHashKey);
+    data.voxelData.resize(entriesNum);
+
+    std::mt19937 random(seed);
+    auto next = [&random]() { return uint32_t(random()); };
+    for (uint32_t i = 0; i < entriesNum; ++i)
+    {
+        if (next() % 4 == 0)
+        {
+            data.hashEntries[i] = (uint64_t(next()) << 32) | next() | 1;
+            data.voxelData[i] = { next(), 0, next() % 3 == 0 ? 0 : next(), next() };
+        }
+        else
+        {
+            data.voxelData[i] = { next(), 1, 2, 3 };
+        }
+    }
+
+    return data;
+}
+
+std::string WriteSnapshot(const SnapshotData& data, uint32_t chunkEntryNum)
+{
+    std::stringstream stream;
+    HOST_CHECK(SharcSnapshotWrite(stream, data.desc, data.hashEntries.data(), data.voxelData.data(), chunkEntryNum));
+
+    return stream.str();
+}
+
+// Returns false if any chunk fails to decode
+bool ReadAllChunks(const SharcSnapshotReader& reader)
+{
+    std::vector<HashGridKey> hashEntries(reader.GetChunkEntryNum());
+    std::vector<uint4> voxelData(reader.GetChunkEntryNum());
+
+    bool result = true;
+    for (uint32_t chunkIndex = 0; chunkIndex < reader.GetChunkNum(); ++chunkIndex)
+        result &= reader.ReadChunk(chunkIndex, hashEntries.data(), voxelData.data());
+
+    return result;
+}
+
+void CheckSnapshot(const SharcSnapshotReader& reader, const SnapshotData& data)
+{
+    HOST_CHECK(reader.IsOpen());
+    HOST_CHECK(SharcSnapshotIsCompatible(reader.GetDesc(), data.desc));
+    HOST_CHECK(reader.GetDesc().entriesNum == data.desc.entriesNum);
+
+    std::vector<HashGridKey> hashEntries(reader.GetChunkEntryNum());
+    std::vector<uint4> voxelData(reader.GetChunkEntryNum());
+
+    uint32_t entryNum = 0;
+    for (uint32_t chunkIndex = 0; chunkIndex < reader.GetChunkNum(); ++chunkIndex)
+    {
+        uint32_t begin, count;
+        reader.GetChunkRange(chunkIndex, begin, count);
+        HOST_CHECK(begin == entryNum);
+
+        HOST_CHECK(reader.ReadChunk(chunkIndex, hashEntries.data(), voxelData.data()));
+
+        uint32_t liveEntryNum = 0;
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            const bool live = data.hashEntries[begin + i] != c_HashGridInvalidHashKey;
+            const uint4 expectedVoxelData = live ? data.voxelData[begin + i] : uint4();
+
+            HOST_CHECK(hashEntries[i] == data.hashEntries[begin + i]);
+            HOST_CHECK(memcmp(&voxelData[i], &expectedVoxelData, sizeof(uint4)) == 0);
+            liveEntryNum += live ? 1 : 0;
+        }
+        HOST_CHECK(reader.GetChunkLiveEntryNum(chunkIndex) == liveEntryNum);
+
+        entryNum += count;
+    }
+    HOST_CHECK(entryNum == data.desc.entriesNum);
+}
+
+template <typename T>
+void WriteField(std::string& snapshot, size_t offset, T value)
+{
+    memcpy(snapshot.data() + offset, &value, sizeof(value));
+}
+
+template <typename T>
+T ReadField(const std::string& snapshot, size_t offset)
+{
+    T value;
+    memcpy(&value, snapshot.data() + offset, sizeof(value));
+
+    return value;
+}
+} // namespace
+
+HOST_TEST(SharcSnapshotRoundTrip)
+{
+    for (uint32_t entriesNum : { 1u, 31u, 1000u, 200000u })
+    {
+        for (uint32_t chunkEntryNum : { 7u, c_SharcSnapshotChunkEntryNum })
+        {
+            const SnapshotData data = CreateSnapshotData(entriesNum, entriesNum + chunkEntryNum);
+            const std::string snapshot = WriteSnapshot(data, chunkEntryNum);
+
+            SharcSnapshotReader reader;
+            HOST_CHECK(reader.Open(snapshot.data(), snapshot.size()));
+            HOST_CHECK(reader.GetChunkEntryNum() == chunkEntryNum);
+            CheckSnapshot(reader, data);
+        }
+    }
+}
+
+HOST_TEST(SharcSnapshotRoundTripFile)
+{
+    const SnapshotData data = CreateSnapshotData(100000, 1);
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "PathtracerHostTests.sharc";
+
+    HOST_CHECK(SharcSnapshotWriteFile(path, data.desc, data.hashEntries.data(), data.voxelData.data()));
+    {
+        SharcSnapshotReader reader;
+        HOST_CHECK(reader.Open(path));
+        CheckSnapshot(reader, data);
+    }
+
+    std::filesystem::remove(path);
+
+    SharcSnapshotReader reader;
+    HOST_CHECK(!reader.Open(path));
+}
+
+HOST_TEST(SharcSnapshotCompatibility)
+{
+    SharcSnapshotDesc desc;
+    desc.sceneName = "Bistro.scene.json";
+    desc.entriesNum = 1024;
+
+    SharcSnapshotDesc otherDesc = desc;
+    otherDesc.entriesNum = 4096;
+    HOST_CHECK(SharcSnapshotIsCompatible(otherDesc, desc));
+
+    otherDesc = desc;
+    otherDesc.sceneName = "Kitchen.scene.json";
+    HOST_CHECK(!SharcSnapshotIsCompatible(otherDesc, desc));
+
+    otherDesc = desc;
+    otherDesc.sceneScale *= 2.0f;
+    HOST_CHECK(!SharcSnapshotIsCompatible(otherDesc, desc));
+
+    otherDesc = desc;
+    otherDesc.levelBias += 1.0f;
+    HOST_CHECK(!SharcSnapshotIsCompatible(otherDesc, desc));
+}
+
+HOST_TEST(SharcSnapshotCorruptedHeader)
+{
+    const SnapshotData data = CreateSnapshotData(1000, 2);
+    const std::string snapshot = WriteSnapshot(data, 64);
+
+    SharcSnapshotReader reader;
+    HOST_CHECK(!reader.Open(snapshot.data(), 0));
+    HOST_CHECK(!reader.Open(snapshot.data(), c_HeaderSize - 1));
+
+    // Chunk table cut short
+    HOST_CHECK(!reader.Open(snapshot.data(), c_HeaderSize + c_ChunkSize));
+
+    std::string corrupted = snapshot;
+    WriteField(corrupted, c_MagicOffset, ReadField<uint32_t>(snapshot, c_MagicOffset) ^ 1);
+    HOST_CHECK(!reader.Open(corrupted.data(), corrupted.size()));
+
+    corrupted = snapshot;
+    WriteField(corrupted, c_VersionOffset, c_SharcSnapshotVersion + 1);
+    HOST_CHECK(!reader.Open(corrupted.data(), corrupted.size()));
+
+    corrupted = snapshot;
+    WriteField(corrupted, c_ChunkNumOffset, ReadField<uint32_t>(snapshot, c_ChunkNumOffset) + 1);
+    HOST_CHECK(!reader.Open(corrupted.data(), corrupted.size()));
+
+    HOST_CHECK(!reader.IsOpen());
+}
+
+HOST_TEST(SharcSnapshotCorruptedChunkTable)
+{
+    const SnapshotData data = CreateSnapshotData(1000, 3);
+    const std::string snapshot = WriteSnapshot(data, 64);
+    const size_t chunkOffset = c_HeaderSize + 2 * c_ChunkSize;
+
+    // Payloads outside of the file are rejected on open
+    std::string corrupted = snapshot;
+    WriteField<uint64_t>(corrupted, chunkOffset + c_ChunkHashEntriesOffset, corrupted.size() + 1);
+    SharcSnapshotReader reader;
+    HOST_CHECK(!reader.Open(corrupted.data(), corrupted.size()));
+
+    corrupted = snapshot;
+    WriteField<uint32_t>(corrupted, chunkOffset + c_ChunkHashEntriesSizeOffset, uint32_t(corrupted.size()));
+    HOST_CHECK(!reader.Open(corrupted.data(), corrupted.size()));
+
+    // A payload cut short fails to decode, other chunks are still readable
+    corrupted = snapshot;
+    const uint32_t hashEntriesSize = ReadField<uint32_t>(snapshot, chunkOffset + c_ChunkHashEntriesSizeOffset);
+    WriteField<uint32_t>(corrupted, chunkOffset + c_ChunkHashEntriesSizeOffset, hashEntriesSize / 2);
+    HOST_CHECK(reader.Open(corrupted.data(), corrupted.size()));
+
+    std::vector<HashGridKey> hashEntries(reader.GetChunkEntryNum());
+    std::vector<uint4> voxelData(reader.GetChunkEntryNum());
+    HOST_CHECK(!reader.ReadChunk(2, hashEntries.data(), voxelData.data()));
+    HOST_CHECK(reader.ReadChunk(1, hashEntries.data(), voxelData.data()));
+    HOST_CHECK(!reader.ReadChunk(reader.GetChunkNum(), hashEntries.data(), voxelData.data()));
+}
+
+HOST_TEST(SharcSnapshotCorruptedPayload)
+{
+    const SnapshotData data = CreateSnapshotData(20000, 4);
+    const std::string snapshot = WriteSnapshot(data, 1024);
+
+    // Random bit flips past the header either fail to open, fail to decode or decode to different data, none of them
+    // may read or write outside of the buffers
+    std::mt19937 random(5);
+    for (uint32_t i = 0; i < 1000; ++i)
+    {
+        std::string corrupted = snapshot;
+        corrupted[c_HeaderSize + random() % (corrupted.size() - c_HeaderSize)] ^= char(1 << (random() % 8));
+
+        SharcSnapshotReader reader;
+        if (reader.Open(corrupted.data(), corrupted.size()))
+            ReadAllChunks(reader);
+    }
+
+    // Run counts past the end of the chunk
+    std::string corrupted = snapshot;
+    const uint64_t hashEntriesOffset = ReadField<uint64_t>(snapshot, c_HeaderSize + c_ChunkHashEntriesOffset);
+    WriteField<uint32_t>(corrupted, size_t(hashEntriesOffset), 0xffffffffu);
+
+    SharcSnapshotReader reader;
+    HOST_CHECK(reader.Open(corrupted.data(), corrupted.size()));
+    HOST_CHECK(!ReadAllChunks(reader));
+}
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "HostTests.h"
+
+#include "SharcTileScheduler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Synthetic miss maps in place of the counters of the query pass
+
+namespace
+{
+std::vector<uint32_t> Schedule(const SharcTileScheduler& scheduler, uint32_t rayNum)
+{
+    std::vector<uint32_t> rayOffsets(scheduler.GetTileNum() + 1, ~0u);
+    scheduler.Schedule(rayNum, rayOffsets.data());
+
+    return rayOffsets;
+}
+
+// Offsets start at 0, never decrease and end at exactly 'rayNum'
+bool IsValidSchedule(const std::vector<uint32_t>& rayOffsets, uint32_t rayNum)
+{
+    if (rayOffsets.front() != 0 || rayOffsets.back() != rayNum)
+        return false;
+
+    for (uint32_t tileIndex = 0; tileIndex + 1 < uint32_t(rayOffsets.size()); ++tileIndex)
+    {
+        if (rayOffsets[tileIndex + 1] < rayOffsets[tileIndex])
+            return false;
+    }
+
+    return true;
+}
+
+uint32_t GetTileRayNum(const std::vector<uint32_t>& rayOffsets, uint32_t tileIndex)
+{
+    return rayOffsets[tileIndex + 1] - rayOffsets[tileIndex];
+}
+
+std::vector<SharcTileStats> CreateTileStats(const SharcTileScheduler& scheduler, uint32_t lookupNum)
+{
+    return std::vector<SharcTileStats>(scheduler.GetTileNum(), SharcTileStats{ lookupNum, 0 });
+}
+} // namespace
+
+HOST_TEST(SharcTileSchedulerUniform)
+{
+    SharcTileScheduler scheduler(SharcTileSchedulerDesc{});
+    scheduler.Resize(64, 64);
+    HOST_CHECK(scheduler.GetTileNum() == 16);
+
+    // Before any report and with a report without misses the rays are spread by area
+    for (uint32_t reportIndex = 0; reportIndex < 2; ++reportIndex)
+    {
+        const std::vector<uint32_t> rayOffsets = Schedule(scheduler, 16000);
+        HOST_CHECK(IsValidSchedule(rayOffsets, 16000));
+        for (uint32_t tileIndex = 0; tileIndex < scheduler.GetTileNum(); ++tileIndex)
+            HOST_CHECK(GetTileRayNum(rayOffsets, tileIndex) == 1000);
+
+        const std::vector<SharcTileStats> tileStats = CreateTileStats(scheduler, 256);
+        scheduler.ReportTileStats(tileStats.data());
+        HOST_CHECK(scheduler.GetMissRate() == 0.0f);
+    }
+
+    // Fewer rays than tiles still sum up
+    const std::vector<uint32_t> rayOffsets = Schedule(scheduler, 5);
+    HOST_CHECK(IsValidSchedule(rayOffsets, 5));
+    for (uint32_t tileIndex = 0; tileIndex < scheduler.GetTileNum(); ++tileIndex)
+        HOST_CHECK(GetTileRayNum(rayOffsets, tileIndex) <= 1);
+}
+
+HOST_TEST(SharcTileSchedulerEdgeTiles)
+{
+    // 3x2 tiles, the last column is 8 pixels wide and the last row 8 pixels high
+    SharcTileScheduler scheduler(SharcTileSchedulerDesc{});
+    scheduler.Resize(40, 24);
+    HOST_CHECK(scheduler.GetTileNumX() == 3 && scheduler.GetTileNumY() == 2);
+
+    // A ray per pixel
+    const std::vector<uint32_t> rayOffsets = Schedule(scheduler, 40 * 24);
+    HOST_CHECK(IsValidSchedule(rayOffsets, 40 * 24));
+
+    const uint32_t tileAreas[] = { 256, 256, 128, 128, 128, 64 };
+    for (uint32_t tileIndex = 0; tileIndex < scheduler.GetTileNum(); ++tileIndex)
+        HOST_CHECK(GetTileRayNum(rayOffsets, tileIndex) == tileAreas[tileIndex]);
+}
+
+HOST_TEST(SharcTileSchedulerMisses)
+{
+    SharcTileSchedulerDesc desc;
+    desc.uniformFraction = 0.25f;
+    desc.missHistoryWeight = 0.5f;
+    SharcTileScheduler scheduler(desc);
+    scheduler.Resize(64, 64);
+
+    // A quarter of the rays is spread by area, the rest goes to the tiles with misses in proportion
+    std::vector<SharcTileStats> tileStats = CreateTileStats(scheduler, 256);
+    tileStats[5].missNum = 192;
+    tileStats[9].missNum = 64;
+    scheduler.ReportTileStats(tileStats.data());
+    HOST_CHECK(scheduler.GetMissRate() == 256.0f / (16.0f * 256.0f));
+
+    std::vector<uint32_t> rayOffsets = Schedule(scheduler, 16000);
+    HOST_CHECK(IsValidSchedule(rayOffsets, 16000));
+    for (uint32_t tileIndex = 0; tileIndex < scheduler.GetTileNum(); ++tileIndex)
+    {
+        const uint32_t expectedRayNum = 250 + (tileIndex == 5 ? 9000 : 0) + (tileIndex == 9 ? 3000 : 0);
+        HOST_CHECK(GetTileRayNum(rayOffsets, tileIndex) == expectedRayNum);
+    }
+
+    // Misses are smoothed, a tile that stops missing keeps half of its weight for a frame. Both tiles end up at 96
+    tileStats[5].missNum = 0;
+    tileStats[9].missNum = 128;
+    scheduler.ReportTileStats(tileStats.data());
+    rayOffsets = Schedule(scheduler, 16000);
+    HOST_CHECK(IsValidSchedule(rayOffsets, 16000));
+    HOST_CHECK(GetTileRayNum(rayOffsets, 5) == 250 + 6000);
+    HOST_CHECK(GetTileRayNum(rayOffsets, 9) == 250 + 6000);
+
+    // Reset falls back to the uniform distribution
+    scheduler.Reset();
+    rayOffsets = Schedule(scheduler, 16000);
+    for (uint32_t tileIndex = 0; tileIndex < scheduler.GetTileNum(); ++tileIndex)
+        HOST_CHECK(GetTileRayNum(rayOffsets, tileIndex) == 1000);
+}
+
+HOST_TEST(SharcTileSchedulerRandomMissMaps)
+{
+    std::mt19937 random(7);
+    auto next = [&random](uint32_t range) { return uint32_t(random() % range); };
+
+    for (uint32_t iteration = 0; iteration < 200; ++iteration)
+    {
+        SharcTileSchedulerDesc desc;
+        desc.tileSize = 8 + next(25);
+        desc.uniformFraction = float(next(101)) / 100.0f;
+        SharcTileScheduler scheduler(desc);
+
+        const uint32_t width = 1 + next(300);
+        const uint32_t height = 1 + next(200);
+        scheduler.Resize(width, height);
+
+        // Sparse misses, most tiles have none
+        std::vector<SharcTileStats> tileStats = CreateTileStats(scheduler, 64);
+        double missNumSum = 0.0;
+        for (SharcTileStats& stats : tileStats)
+        {
+            stats.missNum = next(4) == 0 ? next(65) : 0;
+            missNumSum += stats.missNum;
+        }
+        scheduler.ReportTileStats(tileStats.data());
+
+        const uint32_t rayNum = next(100000);
+        const std::vector<uint32_t> rayOffsets = Schedule(scheduler, rayNum);
+        HOST_CHECK(IsValidSchedule(rayOffsets, rayNum));
+
+        // Every tile is within a ray of its exact share
+        const double uniformFraction = missNumSum > 0.0 ? double(scheduler.GetDesc().uniformFraction) : 1.0;
+        for (uint32_t tileIndex = 0; tileIndex < scheduler.GetTileNum(); ++tileIndex)
+        {
+            const uint32_t tileX = tileIndex % scheduler.GetTileNumX();
+            const uint32_t tileY = tileIndex / scheduler.GetTileNumX();
+            const double tileArea = double(std::min(desc.tileSize, width - tileX * desc.tileSize)) * double(std::min(desc.tileSize, height - tileY * desc.tileSize));
+
+            double share = tileArea / (double(width) * double(height)) * uniformFraction;
+            if (missNumSum > 0.0)
+                share += double(tileStats[tileIndex].missNum) / missNumSum * (1.0 - uniformFraction);
+
+            HOST_CHECK(std::abs(double(GetTileRayNum(rayOffsets, tileIndex)) - share * rayNum) <= 1.0 + 1e-6 * rayNum);
+        }
+    }
+}
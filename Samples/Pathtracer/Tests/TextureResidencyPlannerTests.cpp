@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "HostTests.h"
+
+#include "TextureResidencyPlanner.h"
+
+#include <vector>
+
+namespace
+{
+// Square RGBA8 texture with a full mip chain
+uint32_t AddSquareTexture(TextureResidencyPlanner& planner, uint32_t size, uint32_t residentMip)
+{
+    std::vector<uint64_t> mipSizes;
+    for (uint32_t mipSize = size; mipSize > 0; mipSize >>= 1)
+        mipSizes.push_back(uint64_t(mipSize) * mipSize * 4);
+
+    return planner.AddTexture(mipSizes.data(), uint32_t(mipSizes.size()), uint32_t(mipSizes.size()) - 1, residentMip);
+}
+} // namespace
+
+HOST_TEST(TextureResidencyPlannerBudget)
+{
+    TextureResidencyDesc desc;
+    desc.budgetSize = 2 << 20;
+    desc.maxStreamInSize = 1ull << 30;
+    desc.tailSize = 4 << 10;
+    TextureResidencyPlanner planner(desc);
+
+    for (uint32_t textureIndex = 0; textureIndex < 4; ++textureIndex)
+        AddSquareTexture(planner, 512, 9);
+
+    // Every texture wants its finest mip, together they need more than twice the budget
+    std::vector<TextureResidencyChange> changes;
+    for (uint64_t frameIndex = 0; frameIndex < 16; ++frameIndex)
+    {
+        for (uint32_t textureIndex = 0; textureIndex < planner.GetTextureNum(); ++textureIndex)
+            planner.RequestMip(textureIndex, 0, frameIndex);
+
+        planner.Update(frameIndex, changes);
+        HOST_CHECK(planner.GetResidentSize() <= desc.budgetSize);
+
+        uint64_t residentSize = 0;
+        for (uint32_t textureIndex = 0; textureIndex < planner.GetTextureNum(); ++textureIndex)
+            residentSize += planner.GetSize(textureIndex, planner.GetResidentMip(textureIndex));
+        HOST_CHECK(residentSize == planner.GetResidentSize());
+    }
+
+    // Mips are granted coarsest first, so the textures end up at the same level
+    for (uint32_t textureIndex = 0; textureIndex < planner.GetTextureNum(); ++textureIndex)
+        HOST_CHECK(planner.GetResidentMip(textureIndex) == 1);
+
+    // A smaller budget evicts at once
+    planner.SetBudgetSize(desc.budgetSize / 4);
+    planner.Update(16, changes);
+    HOST_CHECK(changes.size() == 4);
+    HOST_CHECK(planner.GetResidentSize() <= desc.budgetSize / 4);
+}
+
+HOST_TEST(TextureResidencyPlannerTail)
+{
+    TextureResidencyDesc desc;
+    desc.budgetSize = 0;
+    desc.tailSize = 4 << 10;
+    TextureResidencyPlanner planner(desc);
+
+    // Mips 5 to 9 of a 512x512 texture take 1364 bytes, mip 4 alone takes 4096
+    for (uint32_t textureIndex = 0; textureIndex < 3; ++textureIndex)
+        AddSquareTexture(planner, 512, 9);
+    HOST_CHECK(planner.GetTailMip(0) == 5);
+    HOST_CHECK(planner.GetSize(0, 5) == 1364);
+
+    // The tail streams in even without any budget, and nothing finer does
+    std::vector<TextureResidencyChange> changes;
+    for (uint64_t frameIndex = 0; frameIndex < 4; ++frameIndex)
+    {
+        for (uint32_t textureIndex = 0; textureIndex < planner.GetTextureNum(); ++textureIndex)
+            planner.RequestMip(textureIndex, 0, frameIndex);
+
+        planner.Update(frameIndex, changes);
+        HOST_CHECK(changes.size() == (frameIndex == 0 ? 3 : 0));
+
+        for (uint32_t textureIndex = 0; textureIndex < planner.GetTextureNum(); ++textureIndex)
+            HOST_CHECK(planner.GetResidentMip(textureIndex) == 5);
+        HOST_CHECK(planner.GetResidentSize() == 3 * 1364);
+    }
+
+    // Textures that start out resident are only evicted down to the tail
+    TextureResidencyPlanner residentPlanner(desc);
+    AddSquareTexture(residentPlanner, 512, 0);
+    residentPlanner.Update(0, changes);
+    HOST_CHECK(changes.size() == 1);
+    HOST_CHECK(changes[0].textureIndex == 0 && changes[0].residentMip == 5);
+
+    // Formats that can't start at a finer mip pull the tail towards the finest mip
+    const uint64_t mipSizes[] = { 4096, 1024, 256, 64 };
+    const uint32_t textureIndex = residentPlanner.AddTexture(mipSizes, 4, 1, 3);
+    HOST_CHECK(residentPlanner.GetTailMip(textureIndex) == 1);
+}
+
+HOST_TEST(TextureResidencyPlannerRecency)
+{
+    // A 64x64 texture has its tail at mip 3 (340 bytes), mip 2 takes 1024 bytes. The budget
+    // fits the three tails and mip 2 of two of the textures
+    TextureResidencyDesc desc;
+    desc.budgetSize = 3 * 340 + 2 * 1024;
+    desc.maxStreamInSize = 1ull << 30;
+    desc.tailSize = 1 << 10;
+    desc.requestLifetime = 1;
+    TextureResidencyPlanner planner(desc);
+
+    for (uint32_t textureIndex = 0; textureIndex < 3; ++textureIndex)
+        AddSquareTexture(planner, 64, 3);
+    HOST_CHECK(planner.GetTailMip(0) == 3);
+
+    // Requests end after a frame, the mips stay cached while they fit
+    std::vector<TextureResidencyChange> changes;
+    planner.RequestMip(0, 2, 0);
+    planner.Update(0, changes);
+    planner.RequestMip(1, 2, 1);
+    planner.Update(1, changes);
+    HOST_CHECK(planner.GetResidentMip(0) == 2);
+    HOST_CHECK(planner.GetResidentMip(1) == 2);
+    HOST_CHECK(planner.GetResidentMip(2) == 3);
+
+    // The least recently requested texture makes room
+    planner.RequestMip(2, 2, 2);
+    planner.Update(2, changes);
+    HOST_CHECK(planner.GetResidentMip(0) == 3);
+    HOST_CHECK(planner.GetResidentMip(1) == 2);
+    HOST_CHECK(planner.GetResidentMip(2) == 2);
+
+    planner.RequestMip(0, 2, 3);
+    planner.Update(3, changes);
+    HOST_CHECK(planner.GetResidentMip(0) == 2);
+    HOST_CHECK(planner.GetResidentMip(1) == 3);
+    HOST_CHECK(planner.GetResidentMip(2) == 2);
+
+    // Without new requests the cached mips stay
+    planner.Update(4, changes);
+    HOST_CHECK(changes.empty());
+    HOST_CHECK(planner.GetResidentSize() == desc.budgetSize);
+}
+
+HOST_TEST(TextureResidencyPlannerStreamInLimit)
+{
+    // Mips 2, 1 and 0 of a 64x64 texture take 1, 4 and 16 KB
+    TextureResidencyDesc desc;
+    desc.budgetSize = 1ull << 30;
+    desc.maxStreamInSize = 4 << 10;
+    desc.tailSize = 1 << 10;
+    TextureResidencyPlanner planner(desc);
+
+    for (uint32_t textureIndex = 0; textureIndex < 3; ++textureIndex)
+        AddSquareTexture(planner, 64, 3);
+
+    std::vector<TextureResidencyChange> changes;
+    uint64_t frameIndex = 0;
+    for (; frameIndex < 16; ++frameIndex)
+    {
+        for (uint32_t textureIndex = 0; textureIndex < planner.GetTextureNum(); ++textureIndex)
+            planner.RequestMip(textureIndex, 0, frameIndex);
+
+        const uint64_t residentSize = planner.GetResidentSize();
+        planner.Update(frameIndex, changes);
+
+        // The first mip goes through even if it is larger than the limit on its own
+        const uint64_t streamInSize = planner.GetResidentSize() - residentSize;
+        HOST_CHECK(streamInSize <= desc.maxStreamInSize || changes.size() == 1);
+
+        if (frameIndex == 0)
+        {
+            // Coarsest mips first, mip 1 of the first texture doesn't fit after mip 2 of all three
+            HOST_CHECK(streamInSize == 3 << 10);
+            for (uint32_t textureIndex = 0; textureIndex < planner.GetTextureNum(); ++textureIndex)
+                HOST_CHECK(planner.GetResidentMip(textureIndex) == 2);
+        }
+        else if (frameIndex == 1)
+        {
+            HOST_CHECK(streamInSize == 4 << 10);
+            HOST_CHECK(changes.size() == 1);
+        }
+
+        if (changes.empty())
+            break;
+    }
+
+    // Three frames for mip 1 and three more for the 16 KB mip 0, one texture at a time
+    HOST_CHECK(frameIndex == 7);
+    for (uint32_t textureIndex = 0; textureIndex < planner.GetTextureNum(); ++textureIndex)
+        HOST_CHECK(planner.GetResidentMip(textureIndex) == 0);
+}
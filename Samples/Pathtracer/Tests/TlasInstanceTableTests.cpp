@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "HostTests.h"
+
+#include "TlasInstanceTable.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+// Instance list of a mock scene, reported in full every frame like the application does
+struct MockInstance
+{
+    uint64_t blasAddress;
+    float transform[12];
+};
+
+std::vector<MockInstance> CreateInstances(uint32_t instanceNum)
+{
+    std::vector<MockInstance> instances(instanceNum);
+    for (uint32_t instanceIndex = 0; instanceIndex < instanceNum; ++instanceIndex)
+    {
+        MockInstance& instance = instances[instanceIndex];
+        instance.blasAddress = 0x10000 + (instanceIndex % 4) * 0x1000;
+
+        const float identity[12] = { 1, 0, 0, float(instanceIndex), 0, 1, 0, 0, 0, 0, 1, 0 };
+        std::copy(identity, identity + 12, instance.transform);
+    }
+
+    return instances;
+}
+
+TlasBuildAction ReportFrame(TlasInstanceTable& table, const std::vector<MockInstance>& instances)
+{
+    for (uint32_t instanceIndex = 0; instanceIndex < uint32_t(instances.size()); ++instanceIndex)
+    {
+        table.SetInstanceBlas(instanceIndex, instances[instanceIndex].blasAddress);
+        table.SetInstanceTransform(instanceIndex, instances[instanceIndex].transform);
+    }
+
+    return table.Update();
+}
+
+bool HasRanges(const TlasInstanceTable& table, const std::vector<TlasInstanceRange>& ranges)
+{
+    const std::vector<TlasInstanceRange>& dirtyRanges = table.GetDirtyRanges();
+    if (dirtyRanges.size() != ranges.size())
+        return false;
+
+    for (uint32_t rangeIndex = 0; rangeIndex < uint32_t(ranges.size()); ++rangeIndex)
+    {
+        if (dirtyRanges[rangeIndex].begin != ranges[rangeIndex].begin || dirtyRanges[rangeIndex].end != ranges[rangeIndex].end)
+            return false;
+    }
+
+    return true;
+}
+} // namespace
+
+HOST_TEST(TlasInstanceTableStatic)
+{
+    TlasInstanceTable table(TlasInstanceTableDesc{});
+    std::vector<MockInstance> instances = CreateInstances(64);
+
+    // The first frame uploads every instance and builds
+    table.Reset(uint32_t(instances.size()));
+    HOST_CHECK(table.IsBuildRequired());
+    HOST_CHECK(ReportFrame(table, instances) == TlasBuildAction::Build);
+    HOST_CHECK(HasRanges(table, { { 0, 64 } }));
+    HOST_CHECK(!table.IsBuildRequired());
+
+    // Reporting the same state again changes nothing
+    for (uint32_t frameIndex = 0; frameIndex < 4; ++frameIndex)
+    {
+        HOST_CHECK(ReportFrame(table, instances) == TlasBuildAction::None);
+        HOST_CHECK(table.GetDirtyRanges().empty());
+    }
+}
+
+HOST_TEST(TlasInstanceTableRefit)
+{
+    TlasInstanceTableDesc desc;
+    desc.rangeMergeDistance = 16;
+    TlasInstanceTable table(desc);
+    std::vector<MockInstance> instances = CreateInstances(64);
+    table.Reset(uint32_t(instances.size()));
+    ReportFrame(table, instances);
+
+    // Gaps of fewer than 16 instances merge, 26 is 15 past the end of [3, 11) and 43 is 16 past the end of [3, 27)
+    for (uint32_t instanceIndex : { 26, 3, 10, 43 })
+        instances[instanceIndex].transform[7] += 1.0f;
+
+    HOST_CHECK(ReportFrame(table, instances) == TlasBuildAction::Refit);
+    HOST_CHECK(HasRanges(table, { { 3, 27 }, { 43, 44 } }));
+
+    // A BLAS rebuilt in place is refit as well, the ranges are consumed by the update
+    table.MarkDirty(63);
+    HOST_CHECK(ReportFrame(table, instances) == TlasBuildAction::Refit);
+    HOST_CHECK(HasRanges(table, { { 63, 64 } }));
+
+    HOST_CHECK(ReportFrame(table, instances) == TlasBuildAction::None);
+    HOST_CHECK(table.GetDirtyRanges().empty());
+}
+
+HOST_TEST(TlasInstanceTableBlasChange)
+{
+    TlasInstanceTable table(TlasInstanceTableDesc{});
+    std::vector<MockInstance> instances = CreateInstances(64);
+    table.Reset(uint32_t(instances.size()));
+    ReportFrame(table, instances);
+
+    // A different BLAS address builds even if it is the only change, moved instances go along in the same build
+    instances[5].blasAddress = 0x20000;
+    instances[6].transform[3] += 1.0f;
+    HOST_CHECK(ReportFrame(table, instances) == TlasBuildAction::Build);
+    HOST_CHECK(HasRanges(table, { { 5, 7 } }));
+
+    HOST_CHECK(ReportFrame(table, instances) == TlasBuildAction::None);
+
+    // So does a different instance count
+    instances.push_back(instances.back());
+    table.Reset(uint32_t(instances.size()));
+    HOST_CHECK(ReportFrame(table, instances) == TlasBuildAction::Build);
+    HOST_CHECK(HasRanges(table, { { 0, 65 } }));
+}
+
+HOST_TEST(TlasInstanceTableRefitLimit)
+{
+    TlasInstanceTableDesc desc;
+    desc.maxRefitNum = 4;
+    TlasInstanceTable table(desc);
+    std::vector<MockInstance> instances = CreateInstances(64);
+    table.Reset(uint32_t(instances.size()));
+    HOST_CHECK(ReportFrame(table, instances) == TlasBuildAction::Build);
+
+    // An instance moving every frame refits four times, then the degraded TLAS is built again
+    std::vector<TlasBuildAction> actions;
+    for (uint32_t frameIndex = 0; frameIndex < 12; ++frameIndex)
+    {
+        // Frames without changes don't count towards the limit
+        if (frameIndex == 2)
+            HOST_CHECK(ReportFrame(table, instances) == TlasBuildAction::None);
+
+        instances[20].transform[11] += 0.5f;
+        actions.push_back(ReportFrame(table, instances));
+        HOST_CHECK(HasRanges(table, { { 20, 21 } }));
+    }
+
+    const TlasBuildAction refit = TlasBuildAction::Refit;
+    const TlasBuildAction build = TlasBuildAction::Build;
+    HOST_CHECK(actions == std::vector<TlasBuildAction>({ refit, refit, refit, refit, build, refit, refit, refit, refit, build, refit, refit }));
+}
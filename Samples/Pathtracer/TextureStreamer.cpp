@@ -0,0 +1,397 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "TextureStreamer.h"
+
+#include <donut/engine/SceneGraph.h>
+#include <donut/engine/SceneTypes.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+const uint32_t c_MinDescriptorNum = 64;
+const uint32_t c_MaxDescriptorNum = 1u << 16;
+const uint32_t c_NoFeedback = ~0u;
+
+struct MipLayout
+{
+    uint32_t rowSize;
+    uint32_t rowNum;
+};
+
+MipLayout GetMipLayout(const nvrhi::TextureDesc& desc, uint32_t mip)
+{
+    const nvrhi::FormatInfo& formatInfo = nvrhi::getFormatInfo(desc.format);
+    const uint32_t width = std::max(desc.width >> mip, 1u);
+    const uint32_t height = std::max(desc.height >> mip, 1u);
+
+    MipLayout layout;
+    layout.rowSize = (width + formatInfo.blockSize - 1) / formatInfo.blockSize * formatInfo.bytesPerBlock;
+    layout.rowNum = (height + formatInfo.blockSize - 1) / formatInfo.blockSize;
+
+    return layout;
+}
+} // namespace
+
+TextureStreamer::TextureStreamer(nvrhi::IDevice* device, const TextureResidencyDesc& desc, uint32_t registerSpace, uint32_t frameLatency)
+    : m_device(device)
+    , m_frameLatency(std::max(frameLatency, 1u))
+    , m_planner(desc)
+{
+    nvrhi::BindlessLayoutDesc bindlessLayoutDesc;
+    bindlessLayoutDesc.visibility = nvrhi::ShaderType::All;
+    bindlessLayoutDesc.firstSlot = 0;
+    bindlessLayoutDesc.maxCapacity = c_MaxDescriptorNum;
+    bindlessLayoutDesc.registerSpaces = { nvrhi::BindingLayoutItem::Texture_SRV(registerSpace) };
+    m_bindlessLayout = device->createBindlessLayout(bindlessLayoutDesc);
+
+    m_descriptorTable = device->createDescriptorTable(m_bindlessLayout);
+    GrowDescriptorTable(c_MinDescriptorNum);
+
+    m_feedbackReadbacks.resize(m_frameLatency);
+    CreateBuffers(1);
+}
+
+void TextureStreamer::CreateBuffers(uint32_t sceneSlotNum)
+{
+    m_slots.resize(sceneSlotNum);
+    m_slotTextures.resize(sceneSlotNum, c_NotStreamed);
+    m_slotsDirty = true;
+
+    nvrhi::BufferDesc bufferDesc;
+    bufferDesc.byteSize = sceneSlotNum * sizeof(Slot);
+    bufferDesc.structStride = sizeof(Slot);
+    bufferDesc.keepInitialState = true;
+    bufferDesc.initialState = nvrhi::ResourceStates::ShaderResource;
+    bufferDesc.debugName = "TextureStreamingSlots";
+    m_slotBuffer = m_device->createBuffer(bufferDesc);
+
+    bufferDesc.byteSize = sceneSlotNum * sizeof(uint32_t);
+    bufferDesc.structStride = sizeof(uint32_t);
+    bufferDesc.canHaveUAVs = true;
+    bufferDesc.initialState = nvrhi::ResourceStates::UnorderedAccess;
+    bufferDesc.debugName = "TextureFeedback";
+    m_feedbackBuffer = m_device->createBuffer(bufferDesc);
+
+    bufferDesc = nvrhi::BufferDesc();
+    bufferDesc.byteSize = sceneSlotNum * sizeof(uint32_t);
+    bufferDesc.cpuAccess = nvrhi::CpuAccessMode::Read;
+    bufferDesc.debugName = "TextureFeedbackReadback";
+    for (FeedbackReadback& readback : m_feedbackReadbacks)
+    {
+        readback.buffer = m_device->createBuffer(bufferDesc);
+        readback.pending = false;
+    }
+}
+
+void TextureStreamer::GrowDescriptorTable(uint32_t descriptorNum)
+{
+    const uint32_t capacity = m_descriptorTable->getCapacity();
+    const uint32_t newCapacity = std::min(descriptorNum, c_MaxDescriptorNum);
+    if (newCapacity <= capacity)
+        return;
+
+    // D3D12 moves the table when it grows, frames in flight still use the old one
+    m_device->waitForIdle();
+    m_device->resizeDescriptorTable(m_descriptorTable, newCapacity, true);
+
+    for (uint32_t descriptorIndex = newCapacity; descriptorIndex-- > capacity;)
+        m_freeDescriptors.push_back(descriptorIndex);
+}
+
+uint32_t TextureStreamer::AllocateDescriptor()
+{
+    if (m_freeDescriptors.empty())
+        GrowDescriptorTable(m_descriptorTable->getCapacity() * 2);
+
+    if (m_freeDescriptors.empty())
+        return c_NotStreamed;
+
+    const uint32_t descriptorIndex = m_freeDescriptors.back();
+    m_freeDescriptors.pop_back();
+
+    return descriptorIndex;
+}
+
+void TextureStreamer::AddTextures(const donut::engine::SceneGraph& sceneGraph)
+{
+    std::vector<uint64_t> mipSizes;
+    for (const std::shared_ptr<donut::engine::Material>& material : sceneGraph.GetMaterials())
+    {
+        for (const std::shared_ptr<donut::engine::LoadedTexture>& loadedTexture : { material->baseOrDiffuseTexture, material->metalRoughOrSpecularTexture, material->normalTexture,
+                                                                                     material->emissiveTexture, material->occlusionTexture, material->transmissionTexture })
+        {
+            if (!loadedTexture || !loadedTexture->texture || loadedTexture->bindlessDescriptor.Get() < 0)
+                continue;
+
+            // Cube maps, arrays and textures without mips stay as they are
+            const nvrhi::TextureDesc& desc = loadedTexture->texture->getDesc();
+            if (desc.dimension != nvrhi::TextureDimension::Texture2D || desc.arraySize != 1 || desc.mipLevels < 2)
+                continue;
+
+            // Materials share textures
+            const uint32_t sceneSlot = uint32_t(loadedTexture->bindlessDescriptor.Get());
+            if (sceneSlot >= m_slotTextures.size())
+            {
+                m_slots.resize(sceneSlot + 1);
+                m_slotTextures.resize(sceneSlot + 1, c_NotStreamed);
+            }
+
+            if (m_slotTextures[sceneSlot] != c_NotStreamed)
+                continue;
+
+            m_slotTextures[sceneSlot] = uint32_t(m_textures.size());
+
+            StreamedTexture streamedTexture;
+            streamedTexture.loadedTexture = loadedTexture;
+            streamedTexture.desc = desc;
+            streamedTexture.sceneSlot = sceneSlot;
+            streamedTexture.mips.resize(desc.mipLevels);
+            m_textures.push_back(std::move(streamedTexture));
+
+            // Block compressed textures can only start at a mip made of whole blocks
+            const uint32_t blockSize = nvrhi::getFormatInfo(desc.format).blockSize;
+            uint32_t maxTailMip = 0;
+            while (maxTailMip + 1 < desc.mipLevels && std::max(desc.width >> (maxTailMip + 1), 1u) % blockSize == 0 &&
+                   std::max(desc.height >> (maxTailMip + 1), 1u) % blockSize == 0)
+                maxTailMip++;
+
+            mipSizes.clear();
+            for (uint32_t mip = 0; mip < desc.mipLevels; ++mip)
+            {
+                const MipLayout layout = GetMipLayout(desc, mip);
+                mipSizes.push_back(uint64_t(layout.rowSize) * layout.rowNum);
+            }
+
+            m_planner.AddTexture(mipSizes.data(), desc.mipLevels, maxTailMip, 0);
+        }
+    }
+
+    // Every texture holds a descriptor and, for a few frames after a change, the one it replaced
+    GrowDescriptorTable(uint32_t(m_textures.size()) * 2);
+}
+
+void TextureStreamer::ReadMips(nvrhi::ICommandList* commandList, uint32_t textureIndex, uint32_t firstMip, uint32_t mipNum)
+{
+    const StreamedTexture& streamedTexture = m_textures[textureIndex];
+    const uint32_t residentMip = m_slots[streamedTexture.sceneSlot].residentMip;
+
+    nvrhi::TextureDesc desc = streamedTexture.desc;
+    desc.width = std::max(desc.width >> firstMip, 1u);
+    desc.height = std::max(desc.height >> firstMip, 1u);
+    desc.mipLevels = mipNum;
+    desc.debugName = "TextureStreamingReadback";
+
+    nvrhi::StagingTextureHandle stagingTexture = m_device->createStagingTexture(desc, nvrhi::CpuAccessMode::Read);
+    if (!stagingTexture)
+        return;
+
+    nvrhi::ITexture* texture = streamedTexture.loadedTexture->texture;
+    for (uint32_t mip = 0; mip < mipNum; ++mip)
+        commandList->copyTexture(stagingTexture, nvrhi::TextureSlice().setMipLevel(mip), texture, nvrhi::TextureSlice().setMipLevel(firstMip + mip - residentMip));
+
+    m_mipReadbacks.push_back({ stagingTexture, textureIndex, firstMip, mipNum, m_frameIndex });
+}
+
+void TextureStreamer::ResolveMipReadbacks(uint64_t frameIndex)
+{
+    // Copies recorded 'frameLatency' frames ago have completed
+    while (!m_mipReadbacks.empty() && m_mipReadbacks.front().frameIndex + m_frameLatency <= frameIndex)
+    {
+        const MipReadback& readback = m_mipReadbacks.front();
+        StreamedTexture& streamedTexture = m_textures[readback.textureIndex];
+
+        for (uint32_t mip = 0; mip < readback.mipNum; ++mip)
+        {
+            size_t rowPitch = 0;
+            const uint8_t* data = (const uint8_t*)m_device->mapStagingTexture(readback.stagingTexture, nvrhi::TextureSlice().setMipLevel(mip), nvrhi::CpuAccessMode::Read, &rowPitch);
+            if (!data)
+                continue;
+
+            const MipLayout layout = GetMipLayout(streamedTexture.desc, readback.firstMip + mip);
+            std::vector<uint8_t>& mipData = streamedTexture.mips[readback.firstMip + mip];
+            mipData.resize(size_t(layout.rowSize) * layout.rowNum);
+            for (uint32_t row = 0; row < layout.rowNum; ++row)
+                memcpy(mipData.data() + size_t(row) * layout.rowSize, data + row * rowPitch, layout.rowSize);
+
+            m_device->unmapStagingTexture(readback.stagingTexture);
+        }
+
+        m_mipReadbacks.pop_front();
+    }
+}
+
+void TextureStreamer::Clear()
+{
+    m_textures.clear();
+    m_retiredTextures.clear();
+    m_mipReadbacks.clear();
+    m_planner.Clear();
+
+    std::fill(m_slots.begin(), m_slots.end(), Slot());
+    std::fill(m_slotTextures.begin(), m_slotTextures.end(), c_NotStreamed);
+    m_slotsDirty = true;
+
+    m_freeDescriptors.clear();
+    for (uint32_t descriptorIndex = m_descriptorTable->getCapacity(); descriptorIndex-- > 0;)
+        m_freeDescriptors.push_back(descriptorIndex);
+
+    for (FeedbackReadback& readback : m_feedbackReadbacks)
+        readback.pending = false;
+}
+
+void TextureStreamer::SetBudgetSize(uint64_t budgetSize)
+{
+    m_planner.SetBudgetSize(budgetSize);
+}
+
+bool TextureStreamer::ApplyChange(nvrhi::ICommandList* commandList, const TextureResidencyChange& change)
+{
+    StreamedTexture& streamedTexture = m_textures[change.textureIndex];
+    Slot& slot = m_slots[streamedTexture.sceneSlot];
+    const uint32_t residentMip = change.residentMip;
+
+    // Mips that become resident come from the copy in system memory
+    for (uint32_t mip = residentMip; mip < slot.residentMip; ++mip)
+    {
+        if (streamedTexture.mips[mip].empty())
+            return false;
+    }
+
+    const uint32_t descriptorIndex = AllocateDescriptor();
+    if (descriptorIndex == c_NotStreamed)
+        return false;
+
+    nvrhi::TextureDesc desc = streamedTexture.desc;
+    desc.width = std::max(desc.width >> residentMip, 1u);
+    desc.height = std::max(desc.height >> residentMip, 1u);
+    desc.mipLevels -= residentMip;
+    desc.initialState = nvrhi::ResourceStates::ShaderResource;
+    desc.keepInitialState = true;
+
+    nvrhi::TextureHandle texture = m_device->createTexture(desc);
+    if (!texture)
+    {
+        m_freeDescriptors.push_back(descriptorIndex);
+        return false;
+    }
+
+    // Mips that are streamed out are read back from the texture that still holds them
+    if (residentMip > slot.residentMip)
+        ReadMips(commandList, change.textureIndex, slot.residentMip, residentMip - slot.residentMip);
+
+    nvrhi::ITexture* previousTexture = streamedTexture.loadedTexture->texture;
+    for (uint32_t mip = residentMip; mip < streamedTexture.desc.mipLevels; ++mip)
+    {
+        const nvrhi::TextureSlice slice = nvrhi::TextureSlice().setMipLevel(mip - residentMip);
+        if (mip >= slot.residentMip)
+            commandList->copyTexture(texture, slice, previousTexture, nvrhi::TextureSlice().setMipLevel(mip - slot.residentMip));
+        else
+        {
+            commandList->writeTexture(texture, 0, mip - residentMip, streamedTexture.mips[mip].data(), GetMipLayout(streamedTexture.desc, mip).rowSize);
+            std::vector<uint8_t>().swap(streamedTexture.mips[mip]);
+        }
+    }
+    commandList->setTextureState(texture, nvrhi::AllSubresources, nvrhi::ResourceStates::ShaderResource);
+
+    m_device->writeDescriptorTable(m_descriptorTable, nvrhi::BindingSetItem::Texture_SRV(descriptorIndex, texture));
+
+    // Frames in flight keep using the previous texture through its descriptor
+    m_retiredTextures.push_back({ previousTexture, slot.descriptorIndex, m_frameIndex });
+
+    streamedTexture.loadedTexture->texture = texture;
+    slot.descriptorIndex = descriptorIndex;
+    slot.residentMip = residentMip;
+    m_slotsDirty = true;
+
+    return true;
+}
+
+bool TextureStreamer::BeginFrame(nvrhi::ICommandList* commandList, uint64_t frameIndex, uint32_t sceneSlotNum, bool enableStreaming)
+{
+    m_frameIndex = frameIndex;
+    m_enableStreaming = enableStreaming;
+
+    while (!m_retiredTextures.empty() && m_retiredTextures.front().frameIndex + m_frameLatency <= frameIndex)
+    {
+        if (m_retiredTextures.front().descriptorIndex != c_NotStreamed)
+            m_freeDescriptors.push_back(m_retiredTextures.front().descriptorIndex);
+
+        m_retiredTextures.pop_front();
+    }
+
+    ResolveMipReadbacks(frameIndex);
+
+    bool buffersCreated = false;
+    const uint32_t slotNum = std::max(sceneSlotNum, uint32_t(m_slots.size()));
+    if (m_slotBuffer->getDesc().byteSize < slotNum * sizeof(Slot))
+    {
+        CreateBuffers(slotNum);
+        buffersCreated = true;
+    }
+
+    // Pick up the feedback written into this slot 'frameLatency' frames ago
+    FeedbackReadback& readback = m_feedbackReadbacks[frameIndex % m_frameLatency];
+    if (readback.pending)
+    {
+        const uint32_t* feedback = (const uint32_t*)m_device->mapBuffer(readback.buffer, nvrhi::CpuAccessMode::Read);
+        if (feedback)
+        {
+            const uint32_t feedbackNum = std::min(uint32_t(readback.buffer->getDesc().byteSize / sizeof(uint32_t)), uint32_t(m_slotTextures.size()));
+            for (uint32_t sceneSlot = 0; sceneSlot < feedbackNum; ++sceneSlot)
+            {
+                if (feedback[sceneSlot] != c_NoFeedback && m_slotTextures[sceneSlot] != c_NotStreamed)
+                    m_planner.RequestMip(m_slotTextures[sceneSlot], feedback[sceneSlot], readback.frameIndex);
+            }
+            m_device->unmapBuffer(readback.buffer);
+        }
+        readback.pending = false;
+    }
+
+    // Without streaming every texture returns to its full mip chain
+    if (!enableStreaming)
+    {
+        for (uint32_t textureIndex = 0; textureIndex < m_planner.GetTextureNum(); ++textureIndex)
+            m_planner.RequestMip(textureIndex, 0, frameIndex);
+    }
+
+    m_planner.Update(frameIndex, m_changes);
+    for (const TextureResidencyChange& change : m_changes)
+    {
+        if (!ApplyChange(commandList, change))
+            m_planner.SetResidentMip(change.textureIndex, m_slots[m_textures[change.textureIndex].sceneSlot].residentMip);
+    }
+
+    if (!m_changes.empty())
+        commandList->commitBarriers();
+
+    if (m_slotsDirty)
+    {
+        commandList->writeBuffer(m_slotBuffer, m_slots.data(), m_slots.size() * sizeof(Slot));
+        m_slotsDirty = false;
+    }
+
+    commandList->clearBufferUInt(m_feedbackBuffer, c_NoFeedback);
+
+    return buffersCreated;
+}
+
+void TextureStreamer::EndFrame(nvrhi::ICommandList* commandList)
+{
+    if (!m_enableStreaming)
+        return;
+
+    FeedbackReadback& readback = m_feedbackReadbacks[m_frameIndex % m_frameLatency];
+    commandList->copyBuffer(readback.buffer, 0, m_feedbackBuffer, 0, readback.buffer->getDesc().byteSize);
+    readback.frameIndex = m_frameIndex;
+    readback.pending = true;
+}
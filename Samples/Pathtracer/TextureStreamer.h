@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <nvrhi/nvrhi.h>
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "TextureResidencyPlanner.h"
+
+namespace donut::engine
+{
+class SceneGraph;
+struct LoadedTexture;
+} // namespace donut::engine
+
+// Streams the mips of the scene textures in and out of video memory under a budget, driven by mip feedback of the path tracer.
+// The path tracer writes the finest mip it needs into a buffer with an entry per bindless slot of the scene, the feedback is read
+// back a few frames later and planned by a TextureResidencyPlanner. Textures start out with their full mip chain as loaded,
+// the mips that are streamed out are copied into staging textures and read back without waiting once the copy has completed,
+// only non-resident mips are kept in system memory. A mip that hasn't arrived yet can't be streamed back in until it has.
+// A texture whose resident mips change is recreated with the new mip range in a descriptor table of its own, which grows as
+// needed. The slot table maps the scene slot to the streamed descriptor and its finest mip, and is updated in the command
+// list, so frames in flight keep the texture they were recorded with until it is released.
+
+class TextureStreamer
+{
+public:
+    static const uint32_t c_NotStreamed = ~0u;
+
+    // Matches TextureStreamingSlot in the shaders
+    struct Slot
+    {
+        uint32_t descriptorIndex = c_NotStreamed; // Into the streamed texture table, the scene slot is used if not streamed
+        uint32_t residentMip = 0;
+    };
+
+    TextureStreamer(nvrhi::IDevice* device, const TextureResidencyDesc& desc, uint32_t registerSpace, uint32_t frameLatency);
+
+    // Takes over the 2D textures of the scene materials, textures that aren't created yet are left alone
+    void AddTextures(const donut::engine::SceneGraph& sceneGraph);
+
+    // Drops all textures, the GPU has to be idle
+    void Clear();
+
+    // Picks up the feedback of an earlier frame and applies the planned changes. Returns true if the slot
+    // and feedback buffers were recreated, when the scene descriptor table outgrew them
+    bool BeginFrame(nvrhi::ICommandList* commandList, uint64_t frameIndex, uint32_t sceneSlotNum, bool enableStreaming);
+
+    // Queues the feedback of this frame for readback
+    void EndFrame(nvrhi::ICommandList* commandList);
+
+    void SetBudgetSize(uint64_t budgetSize);
+
+    const TextureResidencyPlanner& GetPlanner() const
+    {
+        return m_planner;
+    }
+
+    nvrhi::IBindingLayout* GetBindlessLayout() const
+    {
+        return m_bindlessLayout;
+    }
+
+    nvrhi::IDescriptorTable* GetDescriptorTable() const
+    {
+        return m_descriptorTable;
+    }
+
+    nvrhi::IBuffer* GetSlotBuffer() const
+    {
+        return m_slotBuffer;
+    }
+
+    nvrhi::IBuffer* GetFeedbackBuffer() const
+    {
+        return m_feedbackBuffer;
+    }
+
+private:
+    struct StreamedTexture
+    {
+        std::shared_ptr<donut::engine::LoadedTexture> loadedTexture;
+        nvrhi::TextureDesc desc; // Full mip chain
+        uint32_t sceneSlot = 0;
+        std::vector<std::vector<uint8_t>> mips; // Non-resident mips in tightly packed rows
+    };
+
+    // Mips streamed out in frame 'frameIndex', 'stagingTexture' starts at 'firstMip'
+    struct MipReadback
+    {
+        nvrhi::StagingTextureHandle stagingTexture;
+        uint32_t textureIndex;
+        uint32_t firstMip;
+        uint32_t mipNum;
+        uint64_t frameIndex;
+    };
+
+    struct RetiredTexture
+    {
+        nvrhi::TextureHandle texture;
+        uint32_t descriptorIndex;
+        uint64_t frameIndex;
+    };
+
+    struct FeedbackReadback
+    {
+        nvrhi::BufferHandle buffer;
+        uint64_t frameIndex = 0;
+        bool pending = false;
+    };
+
+    void CreateBuffers(uint32_t sceneSlotNum);
+    void ReadMips(nvrhi::ICommandList* commandList, uint32_t textureIndex, uint32_t firstMip, uint32_t mipNum);
+    void ResolveMipReadbacks(uint64_t frameIndex);
+    void GrowDescriptorTable(uint32_t descriptorNum);
+    uint32_t AllocateDescriptor();
+    bool ApplyChange(nvrhi::ICommandList* commandList, const TextureResidencyChange& change);
+
+    nvrhi::DeviceHandle m_device;
+    uint32_t m_frameLatency;
+    uint64_t m_frameIndex = 0;
+    bool m_enableStreaming = false;
+
+    TextureResidencyPlanner m_planner;
+    std::vector<StreamedTexture> m_textures; // Same order as in the planner
+    std::vector<TextureResidencyChange> m_changes;
+
+    nvrhi::BindingLayoutHandle m_bindlessLayout;
+    nvrhi::DescriptorTableHandle m_descriptorTable;
+    std::vector<uint32_t> m_freeDescriptors;
+    std::deque<RetiredTexture> m_retiredTextures;
+    std::deque<MipReadback> m_mipReadbacks;
+
+    // Entry per scene slot
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_slotTextures;
+    bool m_slotsDirty = false;
+    nvrhi::BufferHandle m_slotBuffer;
+    nvrhi::BufferHandle m_feedbackBuffer;
+    std::vector<FeedbackReadback> m_feedbackReadbacks;
+};
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+// Replays a synthetic allocation trace on several threads against malloc and the NrcCpuAllocator modes.
+// Usage: NrcAllocatorBenchmark [-threads <num>] [-frames <num>] [-allocations <per thread and frame>] [-framelocal <percent>] [-seed <seed>]
+
+#include "NrcCpuAllocator.h"
+
+#include <algorithm>
+#include <barrier>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct TraceEvent
+{
+    uint32_t allocationIndex;
+    bool isFree;
+};
+
+// Allocations of one thread, the events of every frame in order
+struct ThreadTrace
+{
+    std::vector<uint32_t> sizes;
+    std::vector<std::vector<TraceEvent>> frames;
+};
+
+struct TraceDesc
+{
+    uint32_t threadNum = 4;
+    uint32_t frameNum = 500;
+    uint32_t allocationNum = 1000; // Per thread and frame
+    uint32_t frameLocalPercent = 75; // Freed within their frame, most of the rest lives a few frames
+    uint32_t seed = 1;
+};
+
+uint32_t GetRandomSize(std::mt19937& random, uint32_t minSize, uint32_t maxSize)
+{
+    // Log uniform, small sizes are the most frequent
+    std::uniform_real_distribution<double> distribution(std::log2(double(minSize)), std::log2(double(maxSize)));
+    return uint32_t(std::exp2(distribution(random)));
+}
+
+// Most allocations die within their frame, some live for a few frames and a few until the end
+ThreadTrace CreateThreadTrace(const TraceDesc& desc, uint32_t threadIndex)
+{
+    std::mt19937 random(desc.seed * 7919 + threadIndex);
+    std::uniform_real_distribution<float> chance(0.0f, 1.0f);
+
+    ThreadTrace trace;
+    trace.frames.resize(desc.frameNum);
+
+    std::vector<std::vector<uint32_t>> dueFrees(desc.frameNum);
+    std::vector<uint32_t> persistent;
+    for (uint32_t frameIndex = 0; frameIndex < desc.frameNum; ++frameIndex)
+    {
+        std::vector<TraceEvent>& events = trace.frames[frameIndex];
+        for (uint32_t allocationIndex : dueFrees[frameIndex])
+            events.push_back({ allocationIndex, true });
+
+        std::vector<uint32_t> frameLive;
+        for (uint32_t eventIndex = 0; eventIndex < desc.allocationNum; ++eventIndex)
+        {
+            const float sizeChance = chance(random);
+            const uint32_t size = (sizeChance < 0.7f) ? GetRandomSize(random, 16, 512) : (sizeChance < 0.95f) ? GetRandomSize(random, 512, 16384) : GetRandomSize(random, 16384, 1 << 20);
+
+            const uint32_t allocationIndex = uint32_t(trace.sizes.size());
+            trace.sizes.push_back(size);
+            events.push_back({ allocationIndex, false });
+
+            const float lifetimeChance = chance(random);
+            const float frameLocalChance = desc.frameLocalPercent / 100.0f;
+            if (lifetimeChance < frameLocalChance)
+                frameLive.push_back(allocationIndex);
+            else if (lifetimeChance < frameLocalChance + (1.0f - frameLocalChance) * 0.8f && frameIndex + 1 < desc.frameNum)
+                dueFrees[std::min<uint32_t>(frameIndex + 1 + random() % 8, desc.frameNum - 1)].push_back(allocationIndex);
+            else
+                persistent.push_back(allocationIndex);
+
+            // Free a random allocation of the frame every other step
+            if (!frameLive.empty() && chance(random) < 0.5f)
+            {
+                const size_t liveIndex = random() % frameLive.size();
+                events.push_back({ frameLive[liveIndex], true });
+                frameLive[liveIndex] = frameLive.back();
+                frameLive.pop_back();
+            }
+        }
+
+        for (uint32_t allocationIndex : frameLive)
+            events.push_back({ allocationIndex, true });
+    }
+
+    for (uint32_t allocationIndex : persistent)
+        trace.frames.back().push_back({ allocationIndex, true });
+
+    return trace;
+}
+
+struct ReplayResult
+{
+    double time;
+    uint64_t operationNum;
+};
+
+template <typename AllocateFunction, typename FreeFunction, typename FrameFunction>
+ReplayResult Replay(const std::vector<ThreadTrace>& traces, AllocateFunction allocate, FreeFunction deallocate, FrameFunction nextFrame)
+{
+    const uint32_t threadNum = uint32_t(traces.size());
+    std::barrier frameBarrier(threadNum, [&]() noexcept { nextFrame(); });
+
+    uint64_t operationNum = 0;
+    for (const ThreadTrace& trace : traces)
+        operationNum += trace.sizes.size() * 2;
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    std::vector<std::thread> threads;
+    for (uint32_t threadIndex = 0; threadIndex < threadNum; ++threadIndex)
+    {
+        threads.emplace_back([&, threadIndex]() {
+            const ThreadTrace& trace = traces[threadIndex];
+            std::vector<void*> pointers(trace.sizes.size());
+            for (const std::vector<TraceEvent>& events : trace.frames)
+            {
+                for (const TraceEvent& event : events)
+                {
+                    const uint32_t size = trace.sizes[event.allocationIndex];
+                    if (event.isFree)
+                    {
+                        deallocate(pointers[event.allocationIndex], size);
+                    }
+                    else
+                    {
+                        // Touch the start of the allocation like a real user would
+                        void* pointer = allocate(size);
+                        memset(pointer, 0, std::min<uint32_t>(size, 64));
+                        pointers[event.allocationIndex] = pointer;
+                    }
+                }
+
+                frameBarrier.arrive_and_wait();
+            }
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    ReplayResult result;
+    result.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    result.operationNum = operationNum;
+
+    return result;
+}
+
+void PrintResult(const char* name, const ReplayResult& result, uint64_t reservedSize)
+{
+    printf("%-20s %10.1f ms %8.1f ns/op %10.1f MB reserved\n", name, result.time * 1e3, result.time * 1e9 / double(result.operationNum), reservedSize / (1024.0 * 1024.0));
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    TraceDesc desc;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const uint32_t value = uint32_t(strtoul(argv[i + 1], nullptr, 10));
+        if (strcmp(argv[i], "-threads") == 0)
+            desc.threadNum = std::max(value, 1u);
+        else if (strcmp(argv[i], "-frames") == 0)
+            desc.frameNum = std::max(value, 1u);
+        else if (strcmp(argv[i], "-allocations") == 0)
+            desc.allocationNum = value;
+        else if (strcmp(argv[i], "-framelocal") == 0)
+            desc.frameLocalPercent = std::min(value, 100u);
+        else if (strcmp(argv[i], "-seed") == 0)
+            desc.seed = value;
+        else
+        {
+            fprintf(stderr, "Usage: NrcAllocatorBenchmark [-threads <num>] [-frames <num>] [-allocations <per thread and frame>] [-framelocal <percent>] [-seed <seed>]\n");
+            return 1;
+        }
+    }
+
+    std::vector<ThreadTrace> traces;
+    for (uint32_t threadIndex = 0; threadIndex < desc.threadNum; ++threadIndex)
+        traces.push_back(CreateThreadTrace(desc, threadIndex));
+
+    printf("%u threads, %u frames, %u allocations per thread and frame, %u%% freed within their frame\n", desc.threadNum, desc.frameNum, desc.allocationNum,
+        desc.frameLocalPercent);
+
+    const ReplayResult mallocResult = Replay(
+        traces, [](size_t size) { return malloc(size); }, [](void* pointer, size_t) { free(pointer); }, []() {});
+    PrintResult("malloc", mallocResult, 0);
+
+    const struct
+    {
+        const char* name;
+        NrcAllocatorMode mode;
+    } modes[] = {
+        { "System", NrcAllocatorMode::System },
+        { "Pools", NrcAllocatorMode::Pools },
+        { "PoolsAndFrameArena", NrcAllocatorMode::PoolsAndFrameArena },
+    };
+
+    for (const auto& mode : modes)
+    {
+        NrcCpuAllocatorDesc allocatorDesc;
+        allocatorDesc.mode = mode.mode;
+        NrcCpuAllocator allocator(allocatorDesc);
+
+        uint64_t peakReservedSize = 0;
+        allocator.BeginFrame();
+        const ReplayResult result = Replay(
+            traces, [&](size_t size) { return allocator.Allocate(size); }, [&](void* pointer, size_t size) { allocator.Deallocate(pointer, size); },
+            [&]() {
+                allocator.EndFrame();
+                peakReservedSize = std::max(peakReservedSize, allocator.GetReservedSize());
+                allocator.BeginFrame();
+            });
+        allocator.EndFrame();
+
+        PrintResult(mode.name, result, peakReservedSize);
+    }
+
+    return 0;
+}
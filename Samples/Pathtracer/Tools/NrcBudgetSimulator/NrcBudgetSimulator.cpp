@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+// Runs the NRC training budget controller against a simulated GPU, to tune its gains without a device.
+// The simulated pass time grows with the training work and a scene load that steps through a few phases. Times reach the
+// controller a few frames late and smoothed, like the samples of the frame profiler. The training loss decays with the
+// training work and jumps back up on camera cuts.
+// Usage: NrcBudgetSimulator [-target <ms>] [-kp <gain>] [-ki <gain>] [-kd <gain>] [-delay <frames>] [-smoothing <weight>]
+//                           [-noise <ms>] [-losstarget <loss>] [-seed <seed>] [-csv <file>]
+
+#include "NrcTrainingBudgetController.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <random>
+
+namespace
+{
+struct SimulationDesc
+{
+    uint32_t delayFrameNum = 3;
+    float smoothing = 0.1f; // Weight of a new time in the smoothed samples
+    float noise = 0.1f; // Standard deviation, milliseconds
+
+    // Pass time for a budget: fixed cost plus the work of the budget at the scene load
+    float fixedTime = 0.3f;
+    float timePerIteration = 1.0f; // One iteration over the ideal training dimensions at load 1
+
+    uint32_t lossInterval = 30; // Frames between loss evaluations
+    uint32_t seed = 1;
+};
+
+struct Phase
+{
+    const char* name;
+    uint32_t frameNum;
+    float load;
+    bool cameraCut; // Resets the training loss
+};
+
+const Phase c_Phases[] = {
+    { "Start", 400, 1.0f, true },
+    { "Heavy scene", 400, 1.8f, false },
+    { "Light scene", 400, 0.6f, false },
+    { "Camera cut", 400, 1.0f, true },
+};
+
+float GetWork(const NrcTrainingBudget& budget)
+{
+    // Primary segments are a small share of the training paths
+    return budget.iterationNum * budget.dimensionScale * (0.8f + 0.2f * budget.primarySegmentScale);
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    NrcTrainingBudgetDesc controllerDesc;
+    SimulationDesc desc;
+    const char* csvFileName = nullptr;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const char* value = argv[i + 1];
+        if (strcmp(argv[i], "-target") == 0)
+            controllerDesc.targetTime = float(atof(value));
+        else if (strcmp(argv[i], "-kp") == 0)
+            controllerDesc.proportionalGain = float(atof(value));
+        else if (strcmp(argv[i], "-ki") == 0)
+            controllerDesc.integralGain = float(atof(value));
+        else if (strcmp(argv[i], "-kd") == 0)
+            controllerDesc.derivativeGain = float(atof(value));
+        else if (strcmp(argv[i], "-losstarget") == 0)
+            controllerDesc.lossTarget = float(atof(value));
+        else if (strcmp(argv[i], "-delay") == 0)
+            desc.delayFrameNum = uint32_t(atoi(value));
+        else if (strcmp(argv[i], "-smoothing") == 0)
+            desc.smoothing = std::clamp(float(atof(value)), 0.001f, 1.0f);
+        else if (strcmp(argv[i], "-noise") == 0)
+            desc.noise = float(atof(value));
+        else if (strcmp(argv[i], "-seed") == 0)
+            desc.seed = uint32_t(atoi(value));
+        else if (strcmp(argv[i], "-csv") == 0)
+            csvFileName = value;
+        else
+        {
+            fprintf(stderr, "Usage: NrcBudgetSimulator [-target <ms>] [-kp <gain>] [-ki <gain>] [-kd <gain>] [-delay <frames>] [-smoothing <weight>]\n"
+                            "                          [-noise <ms>] [-losstarget <loss>] [-seed <seed>] [-csv <file>]\n");
+            return 1;
+        }
+    }
+
+    FILE* csvFile = nullptr;
+    if (csvFileName)
+    {
+        csvFile = fopen(csvFileName, "w");
+        if (!csvFile)
+        {
+            fprintf(stderr, "Failed to open '%s'\n", csvFileName);
+            return 1;
+        }
+        fprintf(csvFile, "frame,load,time,sample,effort,iterations,dimension_scale,primary_scale,loss,max_effort\n");
+    }
+
+    NrcTrainingBudgetController controller(controllerDesc);
+    std::mt19937 random(desc.seed);
+    std::normal_distribution<float> noise(0.0f, desc.noise);
+
+    std::deque<float> pendingTimes; // Times of the frames still in flight
+    float smoothedTime = 0.0f;
+    bool hasSmoothedTime = false;
+    float loss = 1.0f;
+
+    printf("Target %.2f ms, gains %.3f/%.3f/%.3f, %u frames of delay\n", controllerDesc.targetTime, controllerDesc.proportionalGain, controllerDesc.integralGain,
+        controllerDesc.derivativeGain, desc.delayFrameNum);
+    printf("%-12s %10s %10s %10s %10s %10s\n", "Phase", "Settle", "Mean time", "Mean error", "Over 10%", "Effort");
+
+    uint64_t frameIndex = 0;
+    for (const Phase& phase : c_Phases)
+    {
+        if (phase.cameraCut)
+            loss = 1.0f;
+
+        // Settled once the sample stays within 10% of the target for 30 frames
+        const uint32_t c_SettleFrameNum = 30;
+        int64_t settleFrame = -1;
+        uint32_t withinFrameNum = 0;
+        double timeSum = 0.0;
+        double errorSum = 0.0;
+        uint32_t overFrameNum = 0;
+
+        for (uint32_t phaseFrame = 0; phaseFrame < phase.frameNum; ++phaseFrame, ++frameIndex)
+        {
+            const NrcTrainingBudget& budget = controller.GetBudget();
+            const float work = GetWork(budget);
+            const float time = std::max(desc.fixedTime + desc.timePerIteration * work * phase.load + noise(random), 0.0f);
+
+            // Converges faster with more training
+            loss = std::max(loss * (1.0f - 0.005f * work), 0.01f);
+
+            pendingTimes.push_back(time);
+            if (pendingTimes.size() > desc.delayFrameNum)
+            {
+                const float readTime = pendingTimes.front();
+                pendingTimes.pop_front();
+                smoothedTime = hasSmoothedTime ? smoothedTime + (readTime - smoothedTime) * desc.smoothing : readTime;
+                hasSmoothedTime = true;
+                controller.ReportTime(frameIndex, smoothedTime);
+            }
+
+            if (frameIndex % desc.lossInterval == 0)
+                controller.ReportTrainingLoss(frameIndex, loss);
+
+            const float relativeError = (time - controllerDesc.targetTime) / controllerDesc.targetTime;
+            timeSum += time;
+            errorSum += std::fabs(relativeError);
+            if (relativeError > 0.1f)
+                overFrameNum++;
+
+            withinFrameNum = (std::fabs(relativeError) < 0.1f) ? withinFrameNum + 1 : 0;
+            if (settleFrame < 0 && withinFrameNum >= c_SettleFrameNum)
+                settleFrame = int64_t(phaseFrame) - c_SettleFrameNum + 1;
+
+            if (csvFile)
+            {
+                fprintf(csvFile, "%llu,%g,%g,%g,%g,%u,%g,%g,%g,%g\n", (unsigned long long)frameIndex, phase.load, time, smoothedTime, budget.effort, budget.iterationNum,
+                    budget.dimensionScale, budget.primarySegmentScale, loss, controller.GetMaxEffort());
+            }
+        }
+
+        char settleText[32];
+        if (settleFrame >= 0)
+            snprintf(settleText, sizeof(settleText), "%lld", (long long)settleFrame);
+        else
+            snprintf(settleText, sizeof(settleText), "never");
+
+        printf("%-12s %10s %9.2fms %9.1f%% %10u %10.2f\n", phase.name, settleText, timeSum / phase.frameNum, errorSum * 100.0 / phase.frameNum, overFrameNum,
+            controller.GetBudget().effort);
+    }
+
+    if (csvFile)
+        fclose(csvFile);
+
+    return 0;
+}
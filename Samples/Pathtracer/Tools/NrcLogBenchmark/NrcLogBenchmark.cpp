@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+// Pushes log messages from several threads, the way the NRC SDK calls its logger, and reports the time spent on the
+// calling threads. Compares a mutex with formatting and output on the calling thread against NrcLogQueue.
+// Usage: NrcLogBenchmark [-threads <num>] [-messages <per thread>] [-capacity <records>] [-ratelimit <records per second>]
+
+#include "NrcLogQueue.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct BenchmarkDesc
+{
+    uint32_t threadNum = 4;
+    uint32_t messageNum = 100000; // Per thread
+    NrcLogQueueDesc queueDesc;
+};
+
+// Mean time per message on the calling threads
+template <typename LogFunction>
+double Run(const BenchmarkDesc& desc, LogFunction log)
+{
+    std::vector<double> threadTimes(desc.threadNum);
+    std::vector<std::thread> threads;
+    for (uint32_t threadIndex = 0; threadIndex < desc.threadNum; ++threadIndex)
+    {
+        threads.emplace_back([&, threadIndex]() {
+            char message[64];
+            snprintf(message, sizeof(message), "Thread %u reporting a verbose SDK message\n", threadIndex);
+
+            const auto startTime = std::chrono::steady_clock::now();
+            for (uint32_t messageIndex = 0; messageIndex < desc.messageNum; ++messageIndex)
+                log(message);
+            threadTimes[threadIndex] = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    double time = 0.0;
+    for (double threadTime : threadTimes)
+        time += threadTime;
+
+    return time * 1e9 / (double(desc.threadNum) * desc.messageNum);
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    BenchmarkDesc desc;
+    desc.queueDesc.maxRecordsPerSecond = 0;
+
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        const uint32_t value = uint32_t(strtoul(argv[i + 1], nullptr, 10));
+        if (strcmp(argv[i], "-threads") == 0)
+            desc.threadNum = std::max(value, 1u);
+        else if (strcmp(argv[i], "-messages") == 0)
+            desc.messageNum = std::max(value, 1u);
+        else if (strcmp(argv[i], "-capacity") == 0)
+            desc.queueDesc.capacity = value;
+        else if (strcmp(argv[i], "-ratelimit") == 0)
+            desc.queueDesc.maxRecordsPerSecond = value;
+        else
+        {
+            fprintf(stderr, "Usage: NrcLogBenchmark [-threads <num>] [-messages <per thread>] [-capacity <records>] [-ratelimit <records per second>]\n");
+            return 1;
+        }
+    }
+
+    // Stands in for the debug output, written by both variants
+    FILE* output = fopen("/dev/null", "w");
+    if (!output)
+    {
+        fprintf(stderr, "Failed to open /dev/null\n");
+        return 1;
+    }
+
+    printf("%u threads, %u messages per thread\n", desc.threadNum, desc.messageNum);
+
+    std::mutex mutex;
+    const double blockingTime = Run(desc, [&](const char* message) {
+        std::lock_guard<std::mutex> lock(mutex);
+        const std::string line = std::string("NRC: ") + message;
+        fputs(line.c_str(), output);
+        fflush(output);
+    });
+    printf("%-12s %8.1f ns/message\n", "Mutex", blockingTime);
+
+    class OutputSink : public NrcLogSink
+    {
+    public:
+        explicit OutputSink(FILE* file) : m_file(file)
+        {
+        }
+
+        void Write(const NrcLogRecord& record) override
+        {
+            char line[c_NrcLogTextSize + 128];
+            FormatNrcLogRecord(record, line, sizeof(line));
+            fprintf(m_file, "%s\n", line);
+        }
+
+        void Flush() override
+        {
+            fflush(m_file);
+        }
+
+    private:
+        FILE* m_file;
+    };
+
+    OutputSink sink(output);
+    NrcLogQueue queue(desc.queueDesc);
+    queue.AddSink(&sink);
+
+    const double queueTime = Run(desc, [&](const char* message) { queue.PushMessage(NrcLogLevel::Info, message); });
+    queue.Flush();
+    printf("%-12s %8.1f ns/message, %llu written, %llu dropped, %llu rate limited\n", "NrcLogQueue", queueTime, (unsigned long long)queue.GetWrittenNum(),
+        (unsigned long long)queue.GetDroppedNum(), (unsigned long long)queue.GetRateLimitedNum());
+
+    queue.RemoveSink(&sink);
+    fclose(output);
+
+    return 0;
+}
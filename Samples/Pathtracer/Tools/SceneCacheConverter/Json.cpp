@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "Json.h"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+const uint32_t c_MaxDepth = 256;
+
+const JsonValue& GetNullValue()
+{
+    static const JsonValue nullValue;
+    return nullValue;
+}
+} // namespace
+
+class JsonParser
+{
+public:
+    JsonParser(const char* text, size_t size) : m_text(text), m_end(text + size), m_position(text)
+    {
+    }
+
+    bool ParseDocument(JsonValue& value, std::string& error)
+    {
+        SkipWhitespace();
+        if (!ParseValue(value, 0))
+        {
+            error = m_error + " at offset " + std::to_string(m_position - m_text);
+            return false;
+        }
+
+        SkipWhitespace();
+        if (m_position != m_end)
+        {
+            error = "Trailing characters at offset " + std::to_string(m_position - m_text);
+            return false;
+        }
+
+        return true;
+    }
+
+private:
+    bool Fail(const char* message)
+    {
+        m_error = message;
+        return false;
+    }
+
+    void SkipWhitespace()
+    {
+        while (m_position < m_end && (*m_position == ' ' || *m_position == '\t' || *m_position == '\n' || *m_position == '\r'))
+            m_position++;
+    }
+
+    bool Consume(const char* literal)
+    {
+        const size_t length = strlen(literal);
+        if (size_t(m_end - m_position) < length || memcmp(m_position, literal, length) != 0)
+            return false;
+
+        m_position += length;
+        return true;
+    }
+
+    bool ParseValue(JsonValue& value, uint32_t depth)
+    {
+        if (depth > c_MaxDepth)
+            return Fail("Nesting too deep");
+
+        if (m_position == m_end)
+            return Fail("Unexpected end of input");
+
+        switch (*m_position)
+        {
+        case '{':
+            return ParseObject(value, depth);
+        case '[':
+            return ParseArray(value, depth);
+        case '"':
+            value.m_type = JsonValue::Type::String;
+            return ParseString(value.m_string);
+        case 't':
+        case 'f':
+            value.m_type = JsonValue::Type::Bool;
+            value.m_bool = (*m_position == 't');
+            return Consume(value.m_bool ? "true" : "false") || Fail("Invalid literal");
+        case 'n':
+            value.m_type = JsonValue::Type::Null;
+            return Consume("null") || Fail("Invalid literal");
+        default:
+            return ParseNumber(value);
+        }
+    }
+
+    bool ParseObject(JsonValue& value, uint32_t depth)
+    {
+        value.m_type = JsonValue::Type::Object;
+        m_position++;
+
+        SkipWhitespace();
+        if (Consume("}"))
+            return true;
+
+        while (true)
+        {
+            SkipWhitespace();
+
+            std::string name;
+            if (m_position == m_end || *m_position != '"' || !ParseString(name))
+                return m_error.empty() ? Fail("Expected a member name") : false;
+
+            SkipWhitespace();
+            if (!Consume(":"))
+                return Fail("Expected ':'");
+
+            SkipWhitespace();
+            if (!ParseValue(value.m_members[name], depth + 1))
+                return false;
+
+            SkipWhitespace();
+            if (Consume("}"))
+                return true;
+
+            if (!Consume(","))
+                return Fail("Expected ',' or '}'");
+        }
+    }
+
+    bool ParseArray(JsonValue& value, uint32_t depth)
+    {
+        value.m_type = JsonValue::Type::Array;
+        m_position++;
+
+        SkipWhitespace();
+        if (Consume("]"))
+            return true;
+
+        while (true)
+        {
+            SkipWhitespace();
+
+            value.m_elements.emplace_back();
+            if (!ParseValue(value.m_elements.back(), depth + 1))
+                return false;
+
+            SkipWhitespace();
+            if (Consume("]"))
+                return true;
+
+            if (!Consume(","))
+                return Fail("Expected ',' or ']'");
+        }
+    }
+
+    static bool ParseHex(const char* digits, uint32_t& codePoint)
+    {
+        codePoint = 0;
+        for (uint32_t i = 0; i < 4; ++i)
+        {
+            const char digit = digits[i];
+            codePoint <<= 4;
+            if (digit >= '0' && digit <= '9')
+                codePoint |= uint32_t(digit - '0');
+            else if (digit >= 'a' && digit <= 'f')
+                codePoint |= uint32_t(digit - 'a' + 10);
+            else if (digit >= 'A' && digit <= 'F')
+                codePoint |= uint32_t(digit - 'A' + 10);
+            else
+                return false;
+        }
+
+        return true;
+    }
+
+    static void AppendUtf8(std::string& string, uint32_t codePoint)
+    {
+        if (codePoint < 0x80)
+        {
+            string += char(codePoint);
+        }
+        else if (codePoint < 0x800)
+        {
+            string += char(0xc0 | (codePoint >> 6));
+            string += char(0x80 | (codePoint & 0x3f));
+        }
+        else if (codePoint < 0x10000)
+        {
+            string += char(0xe0 | (codePoint >> 12));
+            string += char(0x80 | ((codePoint >> 6) & 0x3f));
+            string += char(0x80 | (codePoint & 0x3f));
+        }
+        else
+        {
+            string += char(0xf0 | (codePoint >> 18));
+            string += char(0x80 | ((codePoint >> 12) & 0x3f));
+            string += char(0x80 | ((codePoint >> 6) & 0x3f));
+            string += char(0x80 | (codePoint & 0x3f));
+        }
+    }
+
+    bool ParseString(std::string& string)
+    {
+        m_position++;
+
+        while (m_position < m_end && *m_position != '"')
+        {
+            if (*m_position != '\\')
+            {
+                string += *m_position++;
+                continue;
+            }
+
+            m_position++;
+            if (m_position == m_end)
+                break;
+
+            const char escape = *m_position++;
+            switch (escape)
+            {
+            case '"':
+            case '\\':
+            case '/':
+                string += escape;
+                break;
+            case 'b':
+                string += '\b';
+                break;
+            case 'f':
+                string += '\f';
+                break;
+            case 'n':
+                string += '\n';
+                break;
+            case 'r':
+                string += '\r';
+                break;
+            case 't':
+                string += '\t';
+                break;
+            case 'u':
+            {
+                uint32_t codePoint;
+                if (m_end - m_position < 4 || !ParseHex(m_position, codePoint))
+                    return Fail("Invalid unicode escape");
+                m_position += 4;
+
+                // Surrogate pairs encode code points above the basic plane
+                uint32_t lowSurrogate;
+                if (codePoint >= 0xd800 && codePoint < 0xdc00 && m_end - m_position >= 6 && m_position[0] == '\\' && m_position[1] == 'u' &&
+                    ParseHex(m_position + 2, lowSurrogate) && lowSurrogate >= 0xdc00 && lowSurrogate < 0xe000)
+                {
+                    codePoint = 0x10000 + ((codePoint - 0xd800) << 10) + (lowSurrogate - 0xdc00);
+                    m_position += 6;
+                }
+
+                AppendUtf8(string, codePoint);
+                break;
+            }
+            default:
+                return Fail("Invalid escape sequence");
+            }
+        }
+
+        if (m_position == m_end)
+            return Fail("Unterminated string");
+
+        m_position++;
+        return true;
+    }
+
+    bool ParseNumber(JsonValue& value)
+    {
+        const char* begin = m_position;
+        while (m_position < m_end && (strchr("+-.eE", *m_position) || (*m_position >= '0' && *m_position <= '9')))
+            m_position++;
+
+        if (begin == m_position)
+            return Fail("Unexpected character");
+
+        // strtod needs a terminated string, numbers are short
+        const std::string number(begin, m_position);
+        char* numberEnd = nullptr;
+        value.m_type = JsonValue::Type::Number;
+        value.m_number = strtod(number.c_str(), &numberEnd);
+
+        return (numberEnd == number.c_str() + number.size()) || Fail("Invalid number");
+    }
+
+    const char* m_text;
+    const char* m_end;
+    const char* m_position;
+    std::string m_error;
+};
+
+bool JsonValue::Parse(const char* text, size_t size, JsonValue& value, std::string& error)
+{
+    value = JsonValue();
+
+    JsonParser parser(text, size);
+    return parser.ParseDocument(value, error);
+}
+
+bool JsonValue::AsBool(bool defaultValue) const
+{
+    return (m_type == Type::Bool) ? m_bool : defaultValue;
+}
+
+double JsonValue::AsNumber(double defaultValue) const
+{
+    return (m_type == Type::Number) ? m_number : defaultValue;
+}
+
+int64_t JsonValue::AsInt(int64_t defaultValue) const
+{
+    return (m_type == Type::Number) ? int64_t(m_number) : defaultValue;
+}
+
+const std::string& JsonValue::AsString() const
+{
+    static const std::string emptyString;
+    return (m_type == Type::String) ? m_string : emptyString;
+}
+
+size_t JsonValue::GetSize() const
+{
+    if (m_type == Type::Array)
+        return m_elements.size();
+
+    if (m_type == Type::Object)
+        return m_members.size();
+
+    return 0;
+}
+
+const JsonValue& JsonValue::operator[](size_t index) const
+{
+    if (m_type != Type::Array || index >= m_elements.size())
+        return GetNullValue();
+
+    return m_elements[index];
+}
+
+const JsonValue& JsonValue::operator[](const char* name) const
+{
+    if (m_type != Type::Object)
+        return GetNullValue();
+
+    auto it = m_members.find(name);
+    return (it != m_members.end()) ? it->second : GetNullValue();
+}
+
+bool JsonValue::Has(const char* name) const
+{
+    return m_type == Type::Object && m_members.find(name) != m_members.end();
+}
+
+bool JsonValue::ReadNumbers(float* values, size_t num) const
+{
+    if (m_type != Type::Array || m_elements.size() < num)
+        return false;
+
+    for (size_t i = 0; i < num; ++i)
+    {
+        if (!m_elements[i].IsNumber())
+            return false;
+
+        values[i] = float(m_elements[i].m_number);
+    }
+
+    return true;
+}
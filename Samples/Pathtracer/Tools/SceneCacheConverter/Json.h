@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+// Minimal JSON document model for the scene descriptions and glTF files read by the converter.
+// Lookups of missing members or out of range elements return a null value, so optional fields read as their defaults.
+
+class JsonValue
+{
+public:
+    enum class Type
+    {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object,
+    };
+
+    // Returns false on malformed input, 'error' describes the first problem
+    static bool Parse(const char* text, size_t size, JsonValue& value, std::string& error);
+
+    Type GetType() const
+    {
+        return m_type;
+    }
+
+    bool IsNull() const
+    {
+        return m_type == Type::Null;
+    }
+
+    bool IsArray() const
+    {
+        return m_type == Type::Array;
+    }
+
+    bool IsObject() const
+    {
+        return m_type == Type::Object;
+    }
+
+    bool IsString() const
+    {
+        return m_type == Type::String;
+    }
+
+    bool IsNumber() const
+    {
+        return m_type == Type::Number;
+    }
+
+    bool AsBool(bool defaultValue = false) const;
+    double AsNumber(double defaultValue = 0.0) const;
+    int64_t AsInt(int64_t defaultValue = 0) const;
+    const std::string& AsString() const;
+
+    // Array elements or object members
+    size_t GetSize() const;
+
+    const JsonValue& operator[](size_t index) const;
+    const JsonValue& operator[](const char* name) const;
+
+    bool Has(const char* name) const;
+
+    // Reads the first 'num' elements of an array of numbers, returns false if there are fewer
+    bool ReadNumbers(float* values, size_t num) const;
+
+private:
+    friend class JsonParser;
+
+    Type m_type = Type::Null;
+    bool m_bool = false;
+    double m_number = 0.0;
+    std::string m_string;
+    std::vector<JsonValue> m_elements;
+    std::map<std::string, JsonValue> m_members;
+};
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+// Compiles a scene description or glTF model into a binary scene cache, runs without a GPU.
+// Usage: SceneCacheConverter <scene.json | model.gltf | model.glb> [-o <output>]
+
+#include "SceneCache.h"
+#include "SceneImporter.h"
+
+#include <cstdio>
+#include <cstring>
+
+int main(int argc, char** argv)
+{
+    std::filesystem::path inputPath;
+    std::filesystem::path outputPath;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+            outputPath = argv[++i];
+        else if (inputPath.empty())
+            inputPath = argv[i];
+        else
+            inputPath.clear(), i = argc;
+    }
+
+    if (inputPath.empty())
+    {
+        fprintf(stderr, "Usage: SceneCacheConverter <scene.json | model.gltf | model.glb> [-o <output>]\n");
+        return 1;
+    }
+
+    if (outputPath.empty())
+        outputPath = inputPath.string() + ".scenecache";
+
+    const std::filesystem::path outputDirectory = std::filesystem::absolute(outputPath).parent_path();
+    std::error_code errorCode;
+    std::filesystem::create_directories(outputDirectory, errorCode);
+
+    SceneImporter importer(outputDirectory);
+    if (!importer.Import(inputPath))
+    {
+        fprintf(stderr, "Import failed: %s\n", importer.GetError().c_str());
+        return 1;
+    }
+
+    if (!SceneCacheWriteFile(outputPath, importer.GetData()))
+    {
+        fprintf(stderr, "Cannot write '%s'\n", outputPath.string().c_str());
+        return 1;
+    }
+
+    // Read the result back, the loader runs the same validation
+    SceneCacheReader reader;
+    if (!reader.Open(outputPath) || !reader.IsCurrent(outputDirectory))
+    {
+        fprintf(stderr, "'%s' failed validation\n", outputPath.string().c_str());
+        return 1;
+    }
+
+    const SceneCacheData& data = importer.GetData();
+    printf("%s: %zu source files, %zu meshes, %zu geometries, %zu triangles, %zu vertices, %zu materials, %zu instances, %zu lights, %zu cameras\n",
+        outputPath.string().c_str(), importer.GetSourcePaths().size(), data.meshes.size(), data.geometries.size(), data.indices.size() / 3,
+        data.positions.size() / 3, data.materials.size(), data.instances.size(), data.lights.size(), data.cameras.size());
+
+    if (!importer.GetPartialReason().empty())
+        printf("The cache is partial, %s. The sample loads the scene from its source files\n", importer.GetPartialReason().c_str());
+
+    return 0;
+}
@@ -0,0 +1,829 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#include "SceneImporter.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+const uint32_t c_GlbMagic = 0x46546c67; // "glTF"
+const uint32_t c_GlbChunkJson = 0x4e4f534a;
+const uint32_t c_GlbChunkBin = 0x004e4942;
+
+const uint32_t c_ComponentByte = 5120;
+const uint32_t c_ComponentUnsignedByte = 5121;
+const uint32_t c_ComponentShort = 5122;
+const uint32_t c_ComponentUnsignedShort = 5123;
+const uint32_t c_ComponentUnsignedInt = 5125;
+const uint32_t c_ComponentFloat = 5126;
+
+const int64_t c_ModeTriangles = 4;
+
+// Material extensions whose parameters the cache doesn't store
+const char* const c_UnsupportedMaterialExtensions[] = {
+    "KHR_materials_transmission",
+    "KHR_materials_pbrSpecularGlossiness",
+    "KHR_materials_emissive_strength",
+};
+
+void SetIdentity(float transform[12])
+{
+    const float identity[12] = { 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f };
+    memcpy(transform, identity, sizeof(identity));
+}
+
+// Affine 3x4 product 'a * b', row major
+void MultiplyTransforms(const float a[12], const float b[12], float result[12])
+{
+    float product[12];
+    for (uint32_t row = 0; row < 3; ++row)
+    {
+        for (uint32_t column = 0; column < 4; ++column)
+        {
+            float value = (column == 3) ? a[row * 4 + 3] : 0.0f;
+            for (uint32_t k = 0; k < 3; ++k)
+                value += a[row * 4 + k] * b[k * 4 + column];
+
+            product[row * 4 + column] = value;
+        }
+    }
+
+    memcpy(result, product, sizeof(product));
+}
+
+// Translation, rotation quaternion (x, y, z, w) and scale applied in glTF order, scale first
+void ComposeTransform(const float translation[3], const float rotation[4], const float scale[3], float transform[12])
+{
+    const float x = rotation[0], y = rotation[1], z = rotation[2], w = rotation[3];
+    const float rotationMatrix[3][3] = {
+        { 1.0f - 2.0f * (y * y + z * z), 2.0f * (x * y - z * w), 2.0f * (x * z + y * w) },
+        { 2.0f * (x * y + z * w), 1.0f - 2.0f * (x * x + z * z), 2.0f * (y * z - x * w) },
+        { 2.0f * (x * z - y * w), 2.0f * (y * z + x * w), 1.0f - 2.0f * (x * x + y * y) },
+    };
+
+    for (uint32_t row = 0; row < 3; ++row)
+    {
+        for (uint32_t column = 0; column < 3; ++column)
+            transform[row * 4 + column] = rotationMatrix[row][column] * scale[column];
+
+        transform[row * 4 + 3] = translation[row];
+    }
+}
+
+// Reads "matrix" (column major 4x4) or "translation", "rotation" and a scale stored under 'scaleName'
+void ReadNodeTransform(const JsonValue& node, const char* scaleName, float transform[12])
+{
+    float matrix[16];
+    if (node["matrix"].ReadNumbers(matrix, 16))
+    {
+        for (uint32_t row = 0; row < 3; ++row)
+        {
+            for (uint32_t column = 0; column < 4; ++column)
+                transform[row * 4 + column] = matrix[column * 4 + row];
+        }
+
+        return;
+    }
+
+    float translation[3] = { 0.0f, 0.0f, 0.0f };
+    float rotation[4] = { 0.0f, 0.0f, 0.0f, 1.0f };
+    float scale[3] = { 1.0f, 1.0f, 1.0f };
+    node["translation"].ReadNumbers(translation, 3);
+    node["rotation"].ReadNumbers(rotation, 4);
+    node[scaleName].ReadNumbers(scale, 3);
+
+    ComposeTransform(translation, rotation, scale, transform);
+}
+
+uint32_t GetComponentSize(uint32_t componentType)
+{
+    switch (componentType)
+    {
+    case c_ComponentByte:
+    case c_ComponentUnsignedByte:
+        return 1;
+    case c_ComponentShort:
+    case c_ComponentUnsignedShort:
+        return 2;
+    case c_ComponentUnsignedInt:
+    case c_ComponentFloat:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+uint32_t GetComponentNum(const std::string& type)
+{
+    if (type == "SCALAR")
+        return 1;
+    if (type == "VEC2")
+        return 2;
+    if (type == "VEC3")
+        return 3;
+    if (type == "VEC4")
+        return 4;
+
+    return 0;
+}
+
+template <typename T>
+T ReadUnaligned(const uint8_t* data)
+{
+    T value;
+    memcpy(&value, data, sizeof(T));
+
+    return value;
+}
+
+// Only the component types glTF allows for vertex attributes
+bool ReadComponent(const uint8_t* data, uint32_t componentType, bool normalized, float& value)
+{
+    switch (componentType)
+    {
+    case c_ComponentFloat:
+        value = ReadUnaligned<float>(data);
+        return true;
+    case c_ComponentUnsignedByte:
+        value = float(ReadUnaligned<uint8_t>(data)) / (normalized ? 255.0f : 1.0f);
+        return true;
+    case c_ComponentUnsignedShort:
+        value = float(ReadUnaligned<uint16_t>(data)) / (normalized ? 65535.0f : 1.0f);
+        return true;
+    case c_ComponentByte:
+        value = normalized ? std::max(float(ReadUnaligned<int8_t>(data)) / 127.0f, -1.0f) : float(ReadUnaligned<int8_t>(data));
+        return true;
+    case c_ComponentShort:
+        value = normalized ? std::max(float(ReadUnaligned<int16_t>(data)) / 32767.0f, -1.0f) : float(ReadUnaligned<int16_t>(data));
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool DecodeBase64(const std::string& text, size_t begin, std::vector<uint8_t>& bytes)
+{
+    auto decodeCharacter = [](char character) -> int32_t {
+        if (character >= 'A' && character <= 'Z')
+            return character - 'A';
+        if (character >= 'a' && character <= 'z')
+            return character - 'a' + 26;
+        if (character >= '0' && character <= '9')
+            return character - '0' + 52;
+        if (character == '+')
+            return 62;
+        if (character == '/')
+            return 63;
+        return -1;
+    };
+
+    bytes.clear();
+    uint32_t bits = 0;
+    uint32_t bitNum = 0;
+    for (size_t i = begin; i < text.size() && text[i] != '='; ++i)
+    {
+        const int32_t value = decodeCharacter(text[i]);
+        if (value < 0)
+            return false;
+
+        bits = (bits << 6) | uint32_t(value);
+        bitNum += 6;
+        if (bitNum >= 8)
+        {
+            bitNum -= 8;
+            bytes.push_back(uint8_t(bits >> bitNum));
+        }
+    }
+
+    return true;
+}
+
+// Relative URIs may escape characters, e.g. spaces as %20
+std::string DecodeUri(const std::string& uri)
+{
+    std::string decoded;
+    for (size_t i = 0; i < uri.size(); ++i)
+    {
+        const std::string digits = uri.substr(i + 1, 2);
+        char* digitsEnd = nullptr;
+        const long character = (uri[i] == '%' && digits.size() == 2) ? strtol(digits.c_str(), &digitsEnd, 16) : 0;
+        if (digitsEnd == digits.c_str() + 2)
+        {
+            decoded += char(character);
+            i += 2;
+        }
+        else
+        {
+            decoded += uri[i];
+        }
+    }
+
+    return decoded;
+}
+} // namespace
+
+SceneImporter::SceneImporter(const std::filesystem::path& cacheDirectory) : m_cacheDirectory(cacheDirectory)
+{
+}
+
+bool SceneImporter::Fail(const std::string& error)
+{
+    if (m_error.empty())
+        m_error = error;
+
+    return false;
+}
+
+void SceneImporter::MarkPartial(const std::string& reason)
+{
+    if (m_partialReason.empty())
+        m_partialReason = reason;
+
+    m_data.flags |= SceneCacheFlags_Partial;
+}
+
+bool SceneImporter::ReadFile(const std::filesystem::path& path, std::vector<uint8_t>& contents)
+{
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    if (!stream)
+        return Fail("Cannot open '" + path.string() + "'");
+
+    contents.resize(size_t(stream.tellg()));
+    stream.seekg(0);
+    stream.read((char*)contents.data(), contents.size());
+    if (!stream)
+        return Fail("Cannot read '" + path.string() + "'");
+
+    // Sources are found relative to the cache, the cache stays valid when the directory is moved as a whole
+    const std::filesystem::path sourcePath = std::filesystem::absolute(path).lexically_normal();
+    std::error_code errorCode;
+    const std::filesystem::path relativePath = std::filesystem::relative(sourcePath, m_cacheDirectory, errorCode);
+
+    m_sourcePaths.push_back(path);
+    m_data.AddSource((errorCode || relativePath.empty() ? sourcePath : relativePath).generic_string(), contents.data(), contents.size());
+
+    return true;
+}
+
+bool SceneImporter::Import(const std::filesystem::path& path)
+{
+    const std::string extension = path.extension().string();
+    if (extension == ".gltf" || extension == ".glb")
+    {
+        Model model;
+        if (!ImportGltf(path, model))
+            return false;
+
+        float identity[12];
+        SetIdentity(identity);
+        for (uint32_t rootNode : model.rootNodes)
+            InstantiateModel(model, rootNode, identity);
+
+        return true;
+    }
+
+    std::vector<uint8_t> contents;
+    if (!ReadFile(path, contents))
+        return false;
+
+    JsonValue document;
+    std::string error;
+    if (!JsonValue::Parse((const char*)contents.data(), contents.size(), document, error))
+        return Fail("'" + path.string() + "': " + error);
+
+    return ImportSceneDescription(path, document);
+}
+
+bool SceneImporter::ImportSceneDescription(const std::filesystem::path& path, const JsonValue& document)
+{
+    if (document.Has("animations"))
+        MarkPartial("'" + path.string() + "' has animations");
+
+    const JsonValue& modelPaths = document["models"];
+    std::vector<Model> models(modelPaths.GetSize());
+    for (size_t modelIndex = 0; modelIndex < models.size(); ++modelIndex)
+    {
+        if (!modelPaths[modelIndex].IsString())
+            return Fail("'" + path.string() + "': model " + std::to_string(modelIndex) + " isn't a file name");
+
+        if (!ImportGltf(path.parent_path() / modelPaths[modelIndex].AsString(), models[modelIndex]))
+            return false;
+    }
+
+    float identity[12];
+    SetIdentity(identity);
+
+    const JsonValue& graph = document["graph"];
+    for (size_t nodeIndex = 0; nodeIndex < graph.GetSize(); ++nodeIndex)
+    {
+        if (!ImportSceneNode(graph[nodeIndex], models, identity))
+            return Fail("'" + path.string() + "': invalid graph node");
+    }
+
+    return true;
+}
+
+bool SceneImporter::ImportSceneNode(const JsonValue& node, const std::vector<Model>& models, const float parentTransform[12])
+{
+    float transform[12];
+    ReadNodeTransform(node, "scaling", transform);
+    MultiplyTransforms(parentTransform, transform, transform);
+
+    if (node.Has("type"))
+        ImportSceneLeaf(node, transform);
+
+    if (node.Has("model"))
+    {
+        const int64_t modelIndex = node["model"].AsInt(-1);
+        if (modelIndex < 0 || modelIndex >= int64_t(models.size()))
+            return false;
+
+        const Model& model = models[size_t(modelIndex)];
+        for (uint32_t rootNode : model.rootNodes)
+            InstantiateModel(model, rootNode, transform);
+    }
+
+    const JsonValue& children = node["children"];
+    for (size_t childIndex = 0; childIndex < children.GetSize(); ++childIndex)
+    {
+        if (!ImportSceneNode(children[childIndex], models, transform))
+            return false;
+    }
+
+    return true;
+}
+
+void SceneImporter::ImportSceneLeaf(const JsonValue& node, const float transform[12])
+{
+    const std::string& type = node["type"].AsString();
+    if (type == "PerspectiveCamera")
+    {
+        SceneCacheCamera camera = {};
+        camera.name = m_data.AddString(node["name"].AsString());
+        camera.verticalFov = float(node["verticalFov"].AsNumber(1.0));
+        camera.zNear = float(node["zNear"].AsNumber(1.0));
+        memcpy(camera.transform, transform, sizeof(camera.transform));
+        m_data.cameras.push_back(camera);
+
+        return;
+    }
+
+    SceneCacheLight light = {};
+    if (type == "DirectionalLight")
+        light.type = uint32_t(SceneCacheLightType::Directional);
+    else if (type == "PointLight")
+        light.type = uint32_t(SceneCacheLightType::Point);
+    else if (type == "SpotLight")
+        light.type = uint32_t(SceneCacheLightType::Spot);
+    else
+    {
+        MarkPartial("node type '" + type + "' isn't supported");
+        return;
+    }
+
+    // Defaults of the Donut light types
+    light.name = m_data.AddString(node["name"].AsString());
+    light.color[0] = light.color[1] = light.color[2] = 1.0f;
+    node["color"].ReadNumbers(light.color, 3);
+    light.intensity = float(node[light.type == uint32_t(SceneCacheLightType::Directional) ? "irradiance" : "intensity"].AsNumber(1.0));
+    light.angularSize = float(node["angularSize"].AsNumber(0.53));
+    light.radius = float(node["radius"].AsNumber(0.0));
+    light.range = float(node["range"].AsNumber(0.0));
+    light.innerAngle = float(node["innerAngle"].AsNumber(180.0));
+    light.outerAngle = float(node["outerAngle"].AsNumber(180.0));
+    if (node["direction"].ReadNumbers(light.direction, 3))
+        light.flags |= SceneCacheLightFlags_HasDirection;
+    memcpy(light.transform, transform, sizeof(light.transform));
+
+    m_data.lights.push_back(light);
+}
+
+void SceneImporter::InstantiateModel(const Model& model, uint32_t nodeIndex, const float parentTransform[12])
+{
+    const ModelNode& node = model.nodes[nodeIndex];
+
+    float transform[12];
+    MultiplyTransforms(parentTransform, node.transform, transform);
+
+    if (node.meshIndex >= 0)
+    {
+        SceneCacheInstance instance;
+        instance.meshIndex = uint32_t(node.meshIndex);
+        memcpy(instance.transform, transform, sizeof(transform));
+        m_data.instances.push_back(instance);
+    }
+
+    for (uint32_t child : node.children)
+        InstantiateModel(model, child, transform);
+}
+
+bool SceneImporter::ImportGltf(const std::filesystem::path& path, Model& model)
+{
+    std::vector<uint8_t> contents;
+    if (!ReadFile(path, contents))
+        return false;
+
+    const std::filesystem::path directory = path.parent_path();
+    const char* json = (const char*)contents.data();
+    size_t jsonSize = contents.size();
+    m_buffers.clear();
+
+    // Binary glTF: a header and chunks, the JSON chunk first and an optional BIN chunk holding the first buffer
+    std::vector<uint8_t> binChunk;
+    bool hasBinChunk = false;
+    if (contents.size() >= 12 && ReadUnaligned<uint32_t>(contents.data()) == c_GlbMagic)
+    {
+        json = nullptr;
+        size_t offset = 12;
+        while (offset + 8 <= contents.size())
+        {
+            const uint32_t chunkSize = ReadUnaligned<uint32_t>(contents.data() + offset);
+            const uint32_t chunkType = ReadUnaligned<uint32_t>(contents.data() + offset + 4);
+            offset += 8;
+            if (chunkSize > contents.size() - offset)
+                return Fail("'" + path.string() + "': truncated chunk");
+
+            if (chunkType == c_GlbChunkJson && !json)
+            {
+                json = (const char*)contents.data() + offset;
+                jsonSize = chunkSize;
+            }
+            else if (chunkType == c_GlbChunkBin && !hasBinChunk)
+            {
+                binChunk.assign(contents.data() + offset, contents.data() + offset + chunkSize);
+                hasBinChunk = true;
+            }
+
+            offset += (chunkSize + 3) & ~3u;
+        }
+
+        if (!json)
+            return Fail("'" + path.string() + "': no JSON chunk");
+    }
+
+    JsonValue document;
+    std::string error;
+    if (!JsonValue::Parse(json, jsonSize, document, error))
+        return Fail("'" + path.string() + "': " + error);
+
+    for (const char* unsupported : { "animations", "skins", "cameras" })
+    {
+        if (document.Has(unsupported))
+            MarkPartial("'" + path.string() + "' has " + unsupported);
+    }
+    if (document["extensions"].Has("KHR_lights_punctual"))
+        MarkPartial("'" + path.string() + "' has lights");
+
+    const JsonValue& buffers = document["buffers"];
+    m_buffers.resize(buffers.GetSize());
+    for (size_t bufferIndex = 0; bufferIndex < m_buffers.size(); ++bufferIndex)
+    {
+        const std::string& uri = buffers[bufferIndex]["uri"].AsString();
+        if (uri.empty())
+        {
+            if (bufferIndex != 0 || !hasBinChunk)
+                return Fail("'" + path.string() + "': buffer " + std::to_string(bufferIndex) + " has no data");
+
+            m_buffers[bufferIndex] = std::move(binChunk);
+        }
+        else if (uri.compare(0, 5, "data:") == 0)
+        {
+            const size_t dataBegin = uri.find(";base64,");
+            if (dataBegin == std::string::npos || !DecodeBase64(uri, dataBegin + 8, m_buffers[bufferIndex]))
+                return Fail("'" + path.string() + "': unsupported data URI in buffer " + std::to_string(bufferIndex));
+        }
+        else if (!ReadFile(directory / DecodeUri(uri), m_buffers[bufferIndex]))
+        {
+            return false;
+        }
+    }
+
+    std::vector<uint32_t> materialIndices;
+    std::vector<int32_t> meshIndices;
+    if (!ImportGltfMaterials(document, directory, materialIndices) || !ImportGltfMeshes(document, materialIndices, meshIndices))
+        return Fail("'" + path.string() + "': invalid meshes or materials");
+
+    const JsonValue& nodes = document["nodes"];
+    model.nodes.resize(nodes.GetSize());
+
+    // Nodes form a forest, a node referenced twice would be instanced twice or close a cycle
+    std::vector<uint32_t> referenceNums(model.nodes.size(), 0);
+    auto addReference = [&](int64_t nodeIndex) {
+        return nodeIndex >= 0 && nodeIndex < int64_t(model.nodes.size()) && referenceNums[size_t(nodeIndex)]++ == 0;
+    };
+
+    for (size_t nodeIndex = 0; nodeIndex < model.nodes.size(); ++nodeIndex)
+    {
+        const JsonValue& node = nodes[nodeIndex];
+        ModelNode& modelNode = model.nodes[nodeIndex];
+        ReadNodeTransform(node, "scale", modelNode.transform);
+
+        if (node.Has("mesh"))
+        {
+            const int64_t meshIndex = node["mesh"].AsInt(-1);
+            if (meshIndex < 0 || meshIndex >= int64_t(meshIndices.size()))
+                return Fail("'" + path.string() + "': node " + std::to_string(nodeIndex) + " references an invalid mesh");
+
+            modelNode.meshIndex = meshIndices[size_t(meshIndex)];
+        }
+
+        const JsonValue& children = node["children"];
+        for (size_t childIndex = 0; childIndex < children.GetSize(); ++childIndex)
+        {
+            const int64_t child = children[childIndex].AsInt(-1);
+            if (!addReference(child))
+                return Fail("'" + path.string() + "': node " + std::to_string(nodeIndex) + " has an invalid child");
+
+            modelNode.children.push_back(uint32_t(child));
+        }
+    }
+
+    // Without scenes every node that isn't a child is a root
+    const JsonValue& scenes = document["scenes"];
+    if (scenes.GetSize() == 0)
+    {
+        for (size_t nodeIndex = 0; nodeIndex < model.nodes.size(); ++nodeIndex)
+        {
+            if (referenceNums[nodeIndex] == 0)
+                model.rootNodes.push_back(uint32_t(nodeIndex));
+        }
+    }
+
+    const JsonValue& rootNodes = scenes[size_t(document["scene"].AsInt(0))]["nodes"];
+    for (size_t rootIndex = 0; rootIndex < rootNodes.GetSize(); ++rootIndex)
+    {
+        const int64_t rootNode = rootNodes[rootIndex].AsInt(-1);
+        if (!addReference(rootNode))
+            return Fail("'" + path.string() + "': invalid scene root node");
+
+        model.rootNodes.push_back(uint32_t(rootNode));
+    }
+
+    m_buffers.clear();
+
+    return true;
+}
+
+uint32_t SceneImporter::GetDefaultMaterial()
+{
+    if (m_defaultMaterial == ~0u)
+    {
+        SceneCacheMaterial material = {};
+        material.name = m_data.AddString("Default");
+        material.baseColor[0] = material.baseColor[1] = material.baseColor[2] = material.baseColor[3] = 1.0f;
+        material.roughness = 1.0f;
+        material.alphaCutoff = 0.5f;
+        material.baseColorTexture = material.metalRoughTexture = material.normalTexture = material.emissiveTexture = c_SceneCacheInvalidString;
+
+        m_defaultMaterial = uint32_t(m_data.materials.size());
+        m_data.materials.push_back(material);
+    }
+
+    return m_defaultMaterial;
+}
+
+uint32_t SceneImporter::AddTexture(const JsonValue& document, const JsonValue& textureInfo, const std::filesystem::path& directory)
+{
+    const JsonValue& texture = document["textures"][size_t(textureInfo["index"].AsInt(-1))];
+    const JsonValue& image = document["images"][size_t(texture["source"].AsInt(-1))];
+
+    // Images embedded in buffers or data URIs aren't extracted
+    const std::string& uri = image["uri"].AsString();
+    if (uri.empty() || uri.compare(0, 5, "data:") == 0)
+        return c_SceneCacheInvalidString;
+
+    const std::filesystem::path texturePath = std::filesystem::absolute(directory / DecodeUri(uri)).lexically_normal();
+
+    std::error_code errorCode;
+    const std::filesystem::path relativePath = std::filesystem::relative(texturePath, m_cacheDirectory, errorCode);
+
+    return m_data.AddString((errorCode || relativePath.empty() ? texturePath : relativePath).generic_string());
+}
+
+bool SceneImporter::ImportGltfMaterials(const JsonValue& document, const std::filesystem::path& directory, std::vector<uint32_t>& materialIndices)
+{
+    const JsonValue& materials = document["materials"];
+    for (size_t materialIndex = 0; materialIndex < materials.GetSize(); ++materialIndex)
+    {
+        const JsonValue& material = materials[materialIndex];
+        const JsonValue& pbr = material["pbrMetallicRoughness"];
+
+        for (const char* extension : c_UnsupportedMaterialExtensions)
+        {
+            if (material["extensions"].Has(extension))
+                MarkPartial("material '" + material["name"].AsString() + "' uses " + extension);
+        }
+
+        SceneCacheMaterial cacheMaterial = {};
+        cacheMaterial.name = m_data.AddString(material["name"].AsString());
+
+        cacheMaterial.baseColor[0] = cacheMaterial.baseColor[1] = cacheMaterial.baseColor[2] = cacheMaterial.baseColor[3] = 1.0f;
+        pbr["baseColorFactor"].ReadNumbers(cacheMaterial.baseColor, 4);
+        material["emissiveFactor"].ReadNumbers(cacheMaterial.emissiveColor, 3);
+        cacheMaterial.roughness = float(pbr["roughnessFactor"].AsNumber(1.0));
+        cacheMaterial.metalness = float(pbr["metallicFactor"].AsNumber(1.0));
+        cacheMaterial.alphaCutoff = float(material["alphaCutoff"].AsNumber(0.5));
+
+        const std::string& alphaMode = material["alphaMode"].AsString();
+        if (alphaMode == "MASK")
+            cacheMaterial.flags |= SceneCacheMaterialFlags_AlphaTested;
+        else if (alphaMode == "BLEND")
+            cacheMaterial.flags |= SceneCacheMaterialFlags_AlphaBlended;
+        if (material["doubleSided"].AsBool())
+            cacheMaterial.flags |= SceneCacheMaterialFlags_DoubleSided;
+
+        cacheMaterial.baseColorTexture = AddTexture(document, pbr["baseColorTexture"], directory);
+        cacheMaterial.metalRoughTexture = AddTexture(document, pbr["metallicRoughnessTexture"], directory);
+        cacheMaterial.normalTexture = AddTexture(document, material["normalTexture"], directory);
+        cacheMaterial.emissiveTexture = AddTexture(document, material["emissiveTexture"], directory);
+
+        materialIndices.push_back(uint32_t(m_data.materials.size()));
+        m_data.materials.push_back(cacheMaterial);
+    }
+
+    return true;
+}
+
+bool SceneImporter::GetAccessor(const JsonValue& document, int64_t accessorIndex, Accessor& accessor)
+{
+    const JsonValue& accessorJson = document["accessors"][size_t(accessorIndex)];
+    if (!accessorJson.IsObject() || accessorJson.Has("sparse") || !accessorJson.Has("bufferView"))
+        return false;
+
+    const JsonValue& bufferView = document["bufferViews"][size_t(accessorJson["bufferView"].AsInt(-1))];
+    const int64_t bufferIndex = bufferView["buffer"].AsInt(-1);
+    if (bufferIndex < 0 || bufferIndex >= int64_t(m_buffers.size()))
+        return false;
+
+    accessor.count = uint32_t(accessorJson["count"].AsInt(0));
+    accessor.componentType = uint32_t(accessorJson["componentType"].AsInt(0));
+    accessor.componentNum = GetComponentNum(accessorJson["type"].AsString());
+    accessor.normalized = accessorJson["normalized"].AsBool();
+
+    const uint32_t elementSize = GetComponentSize(accessor.componentType) * accessor.componentNum;
+    if (elementSize == 0)
+        return false;
+
+    accessor.stride = uint32_t(bufferView["byteStride"].AsInt(elementSize));
+
+    const std::vector<uint8_t>& buffer = m_buffers[size_t(bufferIndex)];
+    const uint64_t viewOffset = uint64_t(bufferView["byteOffset"].AsInt(0));
+    const uint64_t viewSize = uint64_t(bufferView["byteLength"].AsInt(0));
+    const uint64_t accessorOffset = uint64_t(accessorJson["byteOffset"].AsInt(0));
+    const uint64_t accessorSize = accessor.count ? uint64_t(accessor.count - 1) * accessor.stride + elementSize : 0;
+    if (viewOffset + viewSize > buffer.size() || accessorOffset + accessorSize > viewSize)
+        return false;
+
+    accessor.data = buffer.data() + viewOffset + accessorOffset;
+
+    return true;
+}
+
+bool SceneImporter::ReadFloats(const Accessor& accessor, uint32_t componentNum, std::vector<float>& values)
+{
+    if (accessor.componentNum < componentNum)
+        return false;
+
+    const uint32_t componentSize = GetComponentSize(accessor.componentType);
+    for (uint32_t element = 0; element < accessor.count; ++element)
+    {
+        const uint8_t* elementData = accessor.data + size_t(element) * accessor.stride;
+        for (uint32_t component = 0; component < componentNum; ++component)
+        {
+            float value;
+            if (!ReadComponent(elementData + component * componentSize, accessor.componentType, accessor.normalized, value))
+                return false;
+
+            values.push_back(value);
+        }
+    }
+
+    return true;
+}
+
+bool SceneImporter::ImportGltfMeshes(const JsonValue& document, const std::vector<uint32_t>& materialIndices, std::vector<int32_t>& meshIndices)
+{
+    const JsonValue& meshes = document["meshes"];
+    for (size_t meshIndex = 0; meshIndex < meshes.GetSize(); ++meshIndex)
+    {
+        const JsonValue& mesh = meshes[meshIndex];
+
+        SceneCacheMesh cacheMesh = {};
+        cacheMesh.name = m_data.AddString(mesh["name"].AsString());
+        cacheMesh.geometryOffset = uint32_t(m_data.geometries.size());
+
+        const JsonValue& primitives = mesh["primitives"];
+        for (size_t primitiveIndex = 0; primitiveIndex < primitives.GetSize(); ++primitiveIndex)
+        {
+            const JsonValue& primitive = primitives[primitiveIndex];
+            const JsonValue& attributes = primitive["attributes"];
+
+            // Points and lines aren't ray traced
+            if (primitive["mode"].AsInt(c_ModeTriangles) != c_ModeTriangles)
+                continue;
+
+            Accessor positions;
+            if (!GetAccessor(document, attributes["POSITION"].AsInt(-1), positions) || positions.componentType != c_ComponentFloat)
+                return false;
+
+            SceneCacheGeometry geometry = {};
+            geometry.vertexOffset = uint32_t(m_data.positions.size() / 3);
+            geometry.vertexCount = positions.count;
+            geometry.indexOffset = uint32_t(m_data.indices.size());
+
+            if (!ReadFloats(positions, 3, m_data.positions))
+                return false;
+
+            // Attributes a primitive doesn't have are zero, every vertex has all of them
+            Accessor attribute;
+            if (attributes.Has("NORMAL"))
+            {
+                if (!GetAccessor(document, attributes["NORMAL"].AsInt(-1), attribute) || attribute.count != positions.count || !ReadFloats(attribute, 3, m_data.normals))
+                    return false;
+            }
+            else
+            {
+                m_data.normals.resize(m_data.positions.size(), 0.0f);
+            }
+
+            if (attributes.Has("TEXCOORD_0"))
+            {
+                if (!GetAccessor(document, attributes["TEXCOORD_0"].AsInt(-1), attribute) || attribute.count != positions.count || !ReadFloats(attribute, 2, m_data.texCoords))
+                    return false;
+            }
+            else
+            {
+                m_data.texCoords.resize(m_data.positions.size() / 3 * 2, 0.0f);
+            }
+
+            if (primitive.Has("indices"))
+            {
+                Accessor indices;
+                if (!GetAccessor(document, primitive["indices"].AsInt(-1), indices) || indices.componentNum != 1)
+                    return false;
+
+                for (uint32_t i = 0; i < indices.count; ++i)
+                {
+                    const uint8_t* indexData = indices.data + size_t(i) * indices.stride;
+
+                    uint32_t index;
+                    if (indices.componentType == c_ComponentUnsignedInt)
+                        index = ReadUnaligned<uint32_t>(indexData);
+                    else if (indices.componentType == c_ComponentUnsignedShort)
+                        index = ReadUnaligned<uint16_t>(indexData);
+                    else if (indices.componentType == c_ComponentUnsignedByte)
+                        index = ReadUnaligned<uint8_t>(indexData);
+                    else
+                        return false;
+
+                    if (index >= positions.count)
+                        return false;
+
+                    m_data.indices.push_back(index);
+                }
+            }
+            else
+            {
+                for (uint32_t i = 0; i < positions.count; ++i)
+                    m_data.indices.push_back(i);
+            }
+
+            // Incomplete triangles are dropped
+            geometry.indexCount = (uint32_t(m_data.indices.size()) - geometry.indexOffset) / 3 * 3;
+            m_data.indices.resize(geometry.indexOffset + geometry.indexCount);
+
+            const int64_t materialIndex = primitive["material"].AsInt(-1);
+            if (materialIndex >= int64_t(materialIndices.size()))
+                return false;
+
+            geometry.materialIndex = (materialIndex >= 0) ? materialIndices[size_t(materialIndex)] : GetDefaultMaterial();
+
+            cacheMesh.triangleNum += geometry.indexCount / 3;
+            cacheMesh.vertexNum += geometry.vertexCount;
+            m_data.geometries.push_back(geometry);
+        }
+
+        cacheMesh.geometryCount = uint32_t(m_data.geometries.size()) - cacheMesh.geometryOffset;
+        if (cacheMesh.geometryCount == 0)
+        {
+            meshIndices.push_back(-1);
+            continue;
+        }
+
+        meshIndices.push_back(int32_t(m_data.meshes.size()));
+        m_data.meshes.push_back(cacheMesh);
+    }
+
+    return true;
+}
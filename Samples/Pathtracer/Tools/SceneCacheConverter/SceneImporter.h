@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2025, NVIDIA CORPORATION.  All rights reserved.
+ *
+ * NVIDIA CORPORATION and its licensors retain all intellectual property
+ * and proprietary rights in and to this software, related documentation
+ * and any modifications thereto.  Any use, reproduction, disclosure or
+ * distribution of this software and related documentation without an express
+ * license agreement from NVIDIA CORPORATION is strictly prohibited.
+ */
+
+#pragma once
+
+#include "Json.h"
+#include "SceneCache.h"
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Reads a scene description (*.scene.json) or a single glTF model (.gltf, .glb) into SceneCacheData.
+// Scene descriptions list their models and place them with a node graph, every model is read once and instanced by the
+// graph. Triangle meshes, materials and the node hierarchy of the models are kept, as are the perspective cameras and
+// lights of the scene description. Animations, skins, the cameras and lights of glTF models and some material extensions
+// are skipped and mark the cache as partial, skinned meshes keep their bind pose.
+
+class SceneImporter
+{
+public:
+    // Texture paths are stored relative to 'cacheDirectory'
+    explicit SceneImporter(const std::filesystem::path& cacheDirectory);
+
+    bool Import(const std::filesystem::path& path);
+
+    const SceneCacheData& GetData() const
+    {
+        return m_data;
+    }
+
+    // Every file read, the cache records their sizes and content hashes
+    const std::vector<std::filesystem::path>& GetSourcePaths() const
+    {
+        return m_sourcePaths;
+    }
+
+    const std::string& GetError() const
+    {
+        return m_error;
+    }
+
+    // First content that made the cache partial, empty if it holds the whole scene
+    const std::string& GetPartialReason() const
+    {
+        return m_partialReason;
+    }
+
+private:
+    struct ModelNode
+    {
+        int32_t meshIndex = -1; // Index into the cache meshes
+        float transform[12]; // Relative to the parent
+        std::vector<uint32_t> children;
+    };
+
+    struct Model
+    {
+        std::vector<ModelNode> nodes;
+        std::vector<uint32_t> rootNodes;
+    };
+
+    struct Accessor
+    {
+        const uint8_t* data = nullptr;
+        uint32_t count = 0;
+        uint32_t componentType = 0;
+        uint32_t componentNum = 0;
+        uint32_t stride = 0;
+        bool normalized = false;
+    };
+
+    bool Fail(const std::string& error);
+    void MarkPartial(const std::string& reason);
+
+    bool ReadFile(const std::filesystem::path& path, std::vector<uint8_t>& contents);
+    bool ImportSceneDescription(const std::filesystem::path& path, const JsonValue& document);
+    bool ImportSceneNode(const JsonValue& node, const std::vector<Model>& models, const float parentTransform[12]);
+    void ImportSceneLeaf(const JsonValue& node, const float transform[12]);
+    bool ImportGltf(const std::filesystem::path& path, Model& model);
+    bool ImportGltfMaterials(const JsonValue& document, const std::filesystem::path& directory, std::vector<uint32_t>& materialIndices);
+    bool ImportGltfMeshes(const JsonValue& document, const std::vector<uint32_t>& materialIndices, std::vector<int32_t>& meshIndices);
+    bool GetAccessor(const JsonValue& document, int64_t accessorIndex, Accessor& accessor);
+    bool ReadFloats(const Accessor& accessor, uint32_t componentNum, std::vector<float>& values);
+    void InstantiateModel(const Model& model, uint32_t nodeIndex, const float parentTransform[12]);
+
+    uint32_t GetDefaultMaterial();
+    uint32_t AddTexture(const JsonValue& document, const JsonValue& textureInfo, const std::filesystem::path& directory);
+
+    std::filesystem::path m_cacheDirectory;
+
+    SceneCacheData m_data;
+    std::vector<std::filesystem::path> m_sourcePaths;
+    std::string m_error;
+    std::string m_partialReason;
+
+    // Buffers of the glTF file being read
+    std::vector<std::vector<uint8_t>> m_buffers;
+    uint32_t m_defaultMaterial = ~0u;
+};